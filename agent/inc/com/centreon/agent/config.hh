@@ -43,6 +43,10 @@ class config {
   std::string _ca_name;
   std::string _host;
   bool _reverse_connection;
+  std::string _retention_directory;
+  unsigned _retention_max_size;
+  unsigned _retention_max_age;
+  unsigned _retention_replay_rate;
 
  public:
   config(const std::string& path);
@@ -63,6 +67,12 @@ class config {
   const std::string& get_ca_name() const { return _ca_name; }
   const std::string& get_host() const { return _host; }
   bool use_reverse_connection() const { return _reverse_connection; }
+  const std::string& get_retention_directory() const {
+    return _retention_directory;
+  }
+  unsigned get_retention_max_size() const { return _retention_max_size; }
+  unsigned get_retention_max_age() const { return _retention_max_age; }
+  unsigned get_retention_replay_rate() const { return _retention_replay_rate; }
 };
 };  // namespace com::centreon::agent
 
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CENTREON_AGENT_DISK_BUFFER_HH
+#define CENTREON_AGENT_DISK_BUFFER_HH
+
+#include <filesystem>
+#include <fstream>
+
+#include "check.hh"
+
+namespace com::centreon::agent {
+
+/**
+ * @brief on disk fifo of ExportMetricsServiceRequest used when engine is not
+ * reachable
+ * Requests are serialized in segment files of a directory. Each record is
+ * made of its size, its storage time and the serialized request.
+ * Size of the buffer is bounded: when it's exceeded, oldest segments are
+ * removed. Records older than max_age are also thrown away.
+ * The read position is saved in a file so that a restarted agent doesn't send
+ * twice the same data.
+ * This object is not thread safe, owner must protect it.
+ */
+class disk_buffer {
+  struct segment {
+    uint64_t seq;
+    uint64_t size;
+    time_point last_write;
+  };
+
+  std::filesystem::path _directory;
+  uint64_t _max_size;
+  duration _max_age;
+  uint64_t _segment_max_size;
+  std::shared_ptr<spdlog::logger> _logger;
+
+  std::deque<segment> _segments;
+  // size of all segment files
+  uint64_t _total_size = 0;
+  // read position in the first segment
+  uint64_t _read_offset = 0;
+
+  std::ofstream _writer;
+  std::ifstream _reader;
+  uint64_t _reader_seq = 0;
+
+  std::filesystem::path _segment_path(uint64_t seq) const;
+  std::filesystem::path _offset_path() const;
+  void _load();
+  void _save_offset();
+  void _open_new_segment();
+  void _remove_first_segment();
+  void _enforce_limits();
+
+ public:
+  disk_buffer(const std::string& directory,
+              uint64_t max_size,
+              const duration& max_age,
+              const std::shared_ptr<spdlog::logger>& logger);
+
+  disk_buffer(const disk_buffer&) = delete;
+  disk_buffer& operator=(const disk_buffer&) = delete;
+
+  void push(const ::opentelemetry::proto::collector::metrics::v1::
+                ExportMetricsServiceRequest& request);
+
+  bool pop(::opentelemetry::proto::collector::metrics::v1::
+               ExportMetricsServiceRequest& request,
+           size_t max_bytes);
+
+  bool empty() const;
+
+  uint64_t size() const { return _total_size - _read_offset; }
+};
+
+}  // namespace com::centreon::agent
+
+#endif
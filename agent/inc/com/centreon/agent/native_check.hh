@@ -0,0 +1,114 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CENTREON_AGENT_NATIVE_CHECK_HH
+#define CENTREON_AGENT_NATIVE_CHECK_HH
+
+#include <optional>
+
+#include "check.hh"
+
+namespace com::centreon::agent {
+
+/**
+ * @brief check measured by the agent itself, without any process
+ * The command line looks like "native:<type> [key=value]..." where type is one
+ * of cpu, memory, swap, load, filesystem, uptime or processes.
+ * Accepted keys are warning, critical (thresholds compared to the main value
+ * of the check), path (mount point of filesystem check) and name (command
+ * name counted by processes check).
+ * Output and perfdata are the ones a plugin would give, so results are sent
+ * to engine as if a process had been executed.
+ */
+class native_check : public check {
+ public:
+  enum class check_type {
+    cpu,
+    memory,
+    swap,
+    load,
+    filesystem,
+    uptime,
+    processes
+  };
+
+  static constexpr std::string_view prefix = "native:";
+
+ private:
+  check_type _type;
+  std::optional<double> _warning;
+  std::optional<double> _critical;
+  std::string _path;
+  std::string _process_name;
+
+  // cpu counters of the previous check (total and idle jiffies)
+  uint64_t _cpu_total = 0;
+  uint64_t _cpu_idle = 0;
+
+  void _parse_command_line();
+
+  unsigned _status_of(double value) const;
+  com::centreon::common::perfdata _perfdata(const std::string& name,
+                                            double value,
+                                            const std::string& unit,
+                                            double min,
+                                            double max,
+                                            bool with_thresholds) const;
+
+  unsigned _check_cpu(std::list<com::centreon::common::perfdata>& perfs,
+                      std::string& output);
+  unsigned _check_memory(std::list<com::centreon::common::perfdata>& perfs,
+                         std::string& output,
+                         bool swap) const;
+  unsigned _check_load(std::list<com::centreon::common::perfdata>& perfs,
+                       std::string& output) const;
+  unsigned _check_filesystem(std::list<com::centreon::common::perfdata>& perfs,
+                             std::string& output) const;
+  unsigned _check_uptime(std::list<com::centreon::common::perfdata>& perfs,
+                         std::string& output) const;
+  unsigned _check_processes(std::list<com::centreon::common::perfdata>& perfs,
+                            std::string& output) const;
+
+ public:
+  native_check(const std::shared_ptr<asio::io_context>& io_context,
+               const std::shared_ptr<spdlog::logger>& logger,
+               time_point exp,
+               const std::string& serv,
+               const std::string& cmd_name,
+               const std::string& cmd_line,
+               const engine_to_agent_request_ptr& cnf,
+               check::completion_handler&& handler);
+
+  static bool is_native(const std::string& cmd_line);
+
+  static std::shared_ptr<check> load(
+      const std::shared_ptr<asio::io_context>& io_context,
+      const std::shared_ptr<spdlog::logger>& logger,
+      time_point exp,
+      const std::string& serv,
+      const std::string& cmd_name,
+      const std::string& cmd_line,
+      const engine_to_agent_request_ptr& cnf,
+      check::completion_handler&& handler);
+
+  void start_check(const duration& timeout) override;
+};
+
+}  // namespace com::centreon::agent
+
+#endif
@@ -22,6 +22,7 @@
 #include "com/centreon/common/grpc/grpc_client.hh"
 
 #include "bireactor.hh"
+#include "disk_buffer.hh"
 #include "scheduler.hh"
 
 namespace com::centreon::agent {
@@ -59,6 +60,11 @@ class client_reactor
 /**
  * @brief this object not only manages connection to engine, but also embed
  * check scheduler
+ * If a retention disk_buffer is given, metrics are stored in it while engine
+ * is not connected (no message received from engine on current stream). Once
+ * reconnected, stored metrics are coalesced and replayed at replay_rate
+ * messages per second. Until retention is empty, new metrics are also stored
+ * in it in order to keep them in order.
  *
  */
 class streaming_client : public common::grpc::grpc_client_base,
@@ -72,6 +78,16 @@ class streaming_client : public common::grpc::grpc_client_base,
   std::shared_ptr<client_reactor> _reactor;
   std::shared_ptr<scheduler> _sched;
 
+  std::shared_ptr<disk_buffer> _retention;
+  duration _replay_period;
+  asio::system_timer _replay_timer;
+  // true when engine has sent something on current stream
+  bool _connected = false;
+  bool _replaying = false;
+
+  // maximum size of a replayed message
+  static constexpr size_t replay_max_bytes = 0x100000;
+
   /**
    * @brief All attributes of this object are protected by this mutex
    *
@@ -84,17 +100,24 @@ class streaming_client : public common::grpc::grpc_client_base,
 
   void _send(const std::shared_ptr<MessageFromAgent>& request);
 
+  void _start_replay();
+  void _replay_timer_handler(const boost::system::error_code& err);
+
  public:
   streaming_client(const std::shared_ptr<boost::asio::io_context>& io_context,
                    const std::shared_ptr<spdlog::logger>& logger,
                    const std::shared_ptr<common::grpc::grpc_config>& conf,
-                   const std::string& supervised_host);
+                   const std::string& supervised_host,
+                   const std::shared_ptr<disk_buffer>& retention = nullptr,
+                   unsigned replay_rate = 10);
 
   static std::shared_ptr<streaming_client> load(
       const std::shared_ptr<boost::asio::io_context>& io_context,
       const std::shared_ptr<spdlog::logger>& logger,
       const std::shared_ptr<common::grpc::grpc_config>& conf,
-      const std::string& supervised_host);
+      const std::string& supervised_host,
+      const std::shared_ptr<disk_buffer>& retention = nullptr,
+      unsigned replay_rate = 10);
 
   void on_incomming_request(const std::shared_ptr<client_reactor>& caller,
                             const std::shared_ptr<MessageToAgent>& request);
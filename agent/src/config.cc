@@ -89,6 +89,26 @@ const std::string_view config::config_schema(R"(
             "description:": "Maximum number of log files to keep. Supernumerary files will be deleted. To be valid, log_files_max_size must be also be provided",
             "type": "integer",
             "min": 1
+        },
+        "retention_directory": {
+            "description": "Directory where metrics are stored while engine is not reachable. If omitted, these metrics are lost",
+            "type": "string",
+            "minLength": 1
+        },
+        "retention_max_size": {
+            "description:": "Maximum size (in megabytes) of stored metrics. Oldest ones are dropped beyond. Default: 100",
+            "type": "integer",
+            "min": 1
+        },
+        "retention_max_age": {
+            "description:": "Maximum age (in seconds) of stored metrics. Older ones are not sent to engine. Default: 86400",
+            "type": "integer",
+            "min": 1
+        },
+        "retention_replay_rate": {
+            "description:": "Maximum number of messages per second sent to engine when stored metrics are replayed. Default: 10",
+            "type": "integer",
+            "min": 1
         }
     },
     "required": [
@@ -145,4 +165,9 @@ config::config(const std::string& path) {
     _host = boost::asio::ip::host_name();
   }
   _reverse_connection = json_config.get_bool("reverse_connection", false);
+  _retention_directory = json_config.get_string("retention_directory", "");
+  _retention_max_size = json_config.get_unsigned("retention_max_size", 100);
+  _retention_max_age = json_config.get_unsigned("retention_max_age", 86400);
+  _retention_replay_rate =
+      json_config.get_unsigned("retention_replay_rate", 10);
 }
@@ -104,6 +104,16 @@ config::config(const std::string& registry_key) {
     _host = boost::asio::ip::host_name();
   }
   _reverse_connection = get_bool("reverse_connection");
+  _retention_directory = get_sz_reg_or_default("retention_directory", "");
+  _retention_max_size = get_unsigned("retention_max_size");
+  if (!_retention_max_size)
+    _retention_max_size = 100;
+  _retention_max_age = get_unsigned("retention_max_age");
+  if (!_retention_max_age)
+    _retention_max_age = 86400;
+  _retention_replay_rate = get_unsigned("retention_replay_rate");
+  if (!_retention_replay_rate)
+    _retention_replay_rate = 10;
 
   RegCloseKey(h_key);
 }
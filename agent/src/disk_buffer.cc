@@ -0,0 +1,283 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "disk_buffer.hh"
+
+using namespace com::centreon::agent;
+using ::opentelemetry::proto::collector::metrics::v1::
+    ExportMetricsServiceRequest;
+
+namespace {
+/**
+ * @brief header of each record written in a segment file
+ *
+ */
+#pragma pack(push, 1)
+struct record_header {
+  uint32_t size;
+  // seconds since epoch
+  int64_t stored;
+};
+#pragma pack(pop)
+}  // namespace
+
+/**
+ * @brief Construct a new disk buffer object and load segments already present
+ * in directory
+ *
+ * @param directory directory where segment files are stored, it's created if
+ * needed
+ * @param max_size maximum size of all segment files
+ * @param max_age records older than that are not replayed
+ * @param logger
+ */
+disk_buffer::disk_buffer(const std::string& directory,
+                         uint64_t max_size,
+                         const duration& max_age,
+                         const std::shared_ptr<spdlog::logger>& logger)
+    : _directory(directory),
+      _max_size(max_size),
+      _max_age(max_age),
+      _segment_max_size(std::max<uint64_t>(max_size / 16, 0x10000)),
+      _logger(logger) {
+  std::filesystem::create_directories(_directory);
+  _load();
+}
+
+std::filesystem::path disk_buffer::_segment_path(uint64_t seq) const {
+  return _directory / fmt::format("{:020}.seg", seq);
+}
+
+std::filesystem::path disk_buffer::_offset_path() const {
+  return _directory / "read_offset";
+}
+
+/**
+ * @brief read segment list and read offset from directory
+ *
+ */
+void disk_buffer::_load() {
+  std::vector<uint64_t> seqs;
+  for (const auto& entry : std::filesystem::directory_iterator(_directory)) {
+    if (entry.path().extension() != ".seg")
+      continue;
+    uint64_t seq;
+    if (absl::SimpleAtoi(entry.path().stem().string(), &seq))
+      seqs.push_back(seq);
+  }
+  std::sort(seqs.begin(), seqs.end());
+
+  uint64_t offset_seq = 0;
+  uint64_t offset = 0;
+  std::ifstream offset_file(_offset_path());
+  if (!(offset_file >> offset_seq >> offset)) {
+    offset_seq = 0;
+    offset = 0;
+  }
+
+  time_point now = std::chrono::system_clock::now();
+  for (uint64_t seq : seqs) {
+    std::filesystem::path path = _segment_path(seq);
+    // this segment has already been replayed
+    if (seq < offset_seq) {
+      std::filesystem::remove(path);
+      continue;
+    }
+    uint64_t size = std::filesystem::file_size(path);
+    _segments.push_back({seq, size, now});
+    _total_size += size;
+  }
+  if (!_segments.empty() && _segments.front().seq == offset_seq) {
+    _read_offset = std::min(offset, _segments.front().size);
+  }
+  if (!_segments.empty()) {
+    SPDLOG_LOGGER_INFO(_logger, "{} bytes to replay found in {}", size(),
+                       _directory.string());
+    _writer.open(_segment_path(_segments.back().seq),
+                 std::ios::binary | std::ios::app);
+  }
+}
+
+/**
+ * @brief save current read position so that a restarted agent will start from
+ * it
+ *
+ */
+void disk_buffer::_save_offset() {
+  std::ofstream offset_file(_offset_path(), std::ios::trunc);
+  if (_segments.empty())
+    offset_file << 0 << ' ' << 0;
+  else
+    offset_file << _segments.front().seq << ' ' << _read_offset;
+}
+
+void disk_buffer::_open_new_segment() {
+  uint64_t seq = _segments.empty() ? 0 : _segments.back().seq + 1;
+  _writer.close();
+  _writer.open(_segment_path(seq), std::ios::binary | std::ios::trunc);
+  _segments.push_back({seq, 0, std::chrono::system_clock::now()});
+}
+
+void disk_buffer::_remove_first_segment() {
+  const segment& first = _segments.front();
+  if (_reader.is_open() && _reader_seq == first.seq)
+    _reader.close();
+  if (_segments.size() == 1)
+    _writer.close();
+  std::error_code err;
+  std::filesystem::remove(_segment_path(first.seq), err);
+  _total_size -= first.size;
+  _read_offset = 0;
+  _segments.pop_front();
+}
+
+/**
+ * @brief remove oldest segments if buffer is too big or too old
+ *
+ */
+void disk_buffer::_enforce_limits() {
+  time_point oldest = std::chrono::system_clock::now() - _max_age;
+  while (_segments.size() > 1 && (_total_size > _max_size ||
+                                  _segments.front().last_write < oldest)) {
+    SPDLOG_LOGGER_WARN(_logger,
+                       "retention limit reached, {} bytes of metrics dropped",
+                       _segments.front().size - _read_offset);
+    _remove_first_segment();
+  }
+}
+
+/**
+ * @brief store a request at the end of the buffer
+ *
+ * @param request
+ */
+void disk_buffer::push(const ExportMetricsServiceRequest& request) {
+  std::string serialized = request.SerializeAsString();
+  uint64_t record_size = sizeof(record_header) + serialized.size();
+
+  if (_segments.empty() ||
+      (_segments.back().size > 0 &&
+       _segments.back().size + record_size > _segment_max_size)) {
+    _open_new_segment();
+  }
+
+  record_header header{
+      static_cast<uint32_t>(serialized.size()),
+      std::chrono::duration_cast<std::chrono::seconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count()};
+  _writer.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  _writer.write(serialized.data(), serialized.size());
+  _writer.flush();
+  if (!_writer) {
+    SPDLOG_LOGGER_ERROR(_logger, "fail to write in {}",
+                        _segment_path(_segments.back().seq).string());
+    _writer.clear();
+  }
+
+  segment& last = _segments.back();
+  last.size += record_size;
+  last.last_write = std::chrono::system_clock::now();
+  _total_size += record_size;
+  if (_segments.size() == 1 && _read_offset == 0)
+    _save_offset();
+
+  _enforce_limits();
+}
+
+/**
+ * @brief read oldest records and merge them in one request
+ *
+ * @param request request filled with records, it's cleared first
+ * @param max_bytes records are merged until this size of serialized records is
+ * reached (at least one record is read)
+ * @return true if request contains something
+ */
+bool disk_buffer::pop(ExportMetricsServiceRequest& request, size_t max_bytes) {
+  request.Clear();
+  size_t bytes = 0;
+  bool got = false;
+  int64_t oldest = std::chrono::duration_cast<std::chrono::seconds>(
+                       (std::chrono::system_clock::now() - _max_age)
+                           .time_since_epoch())
+                       .count();
+
+  _enforce_limits();
+  std::string serialized;
+  while (!_segments.empty()) {
+    segment& first = _segments.front();
+    if (_read_offset >= first.size) {
+      // everything has been read in the last segment, we restart with an empty
+      // buffer
+      _remove_first_segment();
+      continue;
+    }
+
+    if (!_reader.is_open() || _reader_seq != first.seq) {
+      _reader.close();
+      _reader.open(_segment_path(first.seq), std::ios::binary);
+      _reader_seq = first.seq;
+    }
+    _reader.clear();
+    _reader.seekg(_read_offset);
+
+    record_header header;
+    if (!_reader.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        _read_offset + sizeof(header) + header.size > first.size) {
+      SPDLOG_LOGGER_ERROR(_logger, "corrupted retention file {}, skip it",
+                          _segment_path(first.seq).string());
+      _read_offset = first.size;
+      continue;
+    }
+    if (got && bytes + header.size > max_bytes)
+      break;
+
+    serialized.resize(header.size);
+    if (!_reader.read(serialized.data(), header.size)) {
+      SPDLOG_LOGGER_ERROR(_logger, "fail to read retention file {}, skip it",
+                          _segment_path(first.seq).string());
+      _read_offset = first.size;
+      continue;
+    }
+    _read_offset += sizeof(header) + header.size;
+
+    if (header.stored < oldest)
+      continue;
+
+    ExportMetricsServiceRequest stored;
+    if (!stored.ParseFromString(serialized)) {
+      SPDLOG_LOGGER_ERROR(_logger, "unparsable record in retention file {}",
+                          _segment_path(first.seq).string());
+      continue;
+    }
+    request.MergeFrom(stored);
+    bytes += header.size;
+    got = true;
+  }
+  _save_offset();
+  return got;
+}
+
+/**
+ * @brief return true if there is nothing to replay
+ *
+ */
+bool disk_buffer::empty() const {
+  return _segments.empty() ||
+         (_segments.size() == 1 && _read_offset >= _segments.front().size);
+}
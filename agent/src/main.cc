@@ -183,8 +183,22 @@ int main(int argc, char* argv[]) {
     _streaming_server = streaming_server::load(g_io_context, g_logger,
                                                grpc_conf, conf->get_host());
   } else {
-    _streaming_client = streaming_client::load(g_io_context, g_logger,
-                                               grpc_conf, conf->get_host());
+    std::shared_ptr<disk_buffer> retention;
+    if (!conf->get_retention_directory().empty()) {
+      try {
+        retention = std::make_shared<disk_buffer>(
+            conf->get_retention_directory(),
+            static_cast<uint64_t>(conf->get_retention_max_size()) * 0x100000,
+            std::chrono::seconds(conf->get_retention_max_age()), g_logger);
+      } catch (const std::exception& e) {
+        SPDLOG_LOGGER_ERROR(g_logger,
+                            "fail to use {} as retention directory: {}",
+                            conf->get_retention_directory(), e.what());
+      }
+    }
+    _streaming_client = streaming_client::load(
+        g_io_context, g_logger, grpc_conf, conf->get_host(), retention,
+        conf->get_retention_replay_rate());
   }
 
   try {
@@ -0,0 +1,442 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <sys/statvfs.h>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/strings/match.h>
+#include <absl/strings/numbers.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "check_exec.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+#include "native_check.hh"
+
+using namespace com::centreon::agent;
+
+static constexpr std::array<std::string_view, 4> _status_labels = {
+    "OK", "WARNING", "CRITICAL", "UNKNOWN"};
+
+/**
+ * @brief Construct a new native check object (don't use constructor, use
+ * native_check::load instead)
+ *
+ * @param io_context
+ * @param logger
+ * @param exp start expected
+ * @param serv
+ * @param cmd_name
+ * @param cmd_line native:<type> [key=value]...
+ * @param cnf agent configuration
+ * @param handler completion handler
+ */
+native_check::native_check(const std::shared_ptr<asio::io_context>& io_context,
+                           const std::shared_ptr<spdlog::logger>& logger,
+                           time_point exp,
+                           const std::string& serv,
+                           const std::string& cmd_name,
+                           const std::string& cmd_line,
+                           const engine_to_agent_request_ptr& cnf,
+                           check::completion_handler&& handler)
+    : check(io_context,
+            logger,
+            exp,
+            serv,
+            cmd_name,
+            cmd_line,
+            cnf,
+            std::move(handler)),
+      _type(check_type::cpu),
+      _path("/") {
+  _parse_command_line();
+}
+
+/**
+ * @brief return true if cmd_line must be executed by a native_check
+ *
+ * @param cmd_line
+ */
+bool native_check::is_native(const std::string& cmd_line) {
+  return absl::StartsWith(cmd_line, prefix);
+}
+
+/**
+ * @brief create a native_check if command line begins with "native:",
+ * otherwise a check_exec. This function can be used as a scheduler
+ * check_builder
+ *
+ * @return std::shared_ptr<check>
+ */
+std::shared_ptr<check> native_check::load(
+    const std::shared_ptr<asio::io_context>& io_context,
+    const std::shared_ptr<spdlog::logger>& logger,
+    time_point exp,
+    const std::string& serv,
+    const std::string& cmd_name,
+    const std::string& cmd_line,
+    const engine_to_agent_request_ptr& cnf,
+    check::completion_handler&& handler) {
+  if (!is_native(cmd_line)) {
+    return check_exec::load(io_context, logger, exp, serv, cmd_name, cmd_line,
+                            cnf, std::move(handler));
+  }
+  return std::make_shared<native_check>(io_context, logger, exp, serv,
+                                        cmd_name, cmd_line, cnf,
+                                        std::move(handler));
+}
+
+/**
+ * @brief parse command line, it throws an exception if it's not valid
+ *
+ */
+void native_check::_parse_command_line() {
+  std::vector<std::string_view> args =
+      absl::StrSplit(std::string_view(get_command_line()).substr(prefix.size()),
+                     absl::ByAnyChar(" \t"), absl::SkipEmpty());
+  if (args.empty()) {
+    throw exceptions::msg_fmt("no native check type in '{}'",
+                              get_command_line());
+  }
+
+  static const absl::flat_hash_map<std::string_view, check_type> types = {
+      {"cpu", check_type::cpu},
+      {"memory", check_type::memory},
+      {"swap", check_type::swap},
+      {"load", check_type::load},
+      {"filesystem", check_type::filesystem},
+      {"uptime", check_type::uptime},
+      {"processes", check_type::processes}};
+  auto type = types.find(args[0]);
+  if (type == types.end()) {
+    throw exceptions::msg_fmt("unknown native check type '{}'", args[0]);
+  }
+  _type = type->second;
+
+  for (auto arg = args.begin() + 1; arg != args.end(); ++arg) {
+    std::pair<std::string_view, std::string_view> key_value =
+        absl::StrSplit(*arg, absl::MaxSplits('=', 1));
+    double threshold;
+    if (key_value.first == "warning" || key_value.first == "critical") {
+      if (!absl::SimpleAtod(key_value.second, &threshold)) {
+        throw exceptions::msg_fmt("bad threshold '{}' in '{}'", *arg,
+                                  get_command_line());
+      }
+      if (key_value.first == "warning")
+        _warning = threshold;
+      else
+        _critical = threshold;
+    } else if (key_value.first == "path") {
+      _path = key_value.second;
+    } else if (key_value.first == "name") {
+      _process_name = key_value.second;
+    } else {
+      throw exceptions::msg_fmt("unknown argument '{}' in '{}'", *arg,
+                                get_command_line());
+    }
+  }
+}
+
+/**
+ * @brief start a check, measure is done synchronously as it only reads /proc
+ * but completion handler is called asynchronously as in check_exec
+ *
+ * @param timeout
+ */
+void native_check::start_check(const duration& timeout) {
+  check::start_check(timeout);
+
+  std::list<com::centreon::common::perfdata> perfs;
+  std::string output;
+  unsigned status = 3;
+  try {
+    switch (_type) {
+      case check_type::cpu:
+        status = _check_cpu(perfs, output);
+        break;
+      case check_type::memory:
+        status = _check_memory(perfs, output, false);
+        break;
+      case check_type::swap:
+        status = _check_memory(perfs, output, true);
+        break;
+      case check_type::load:
+        status = _check_load(perfs, output);
+        break;
+      case check_type::filesystem:
+        status = _check_filesystem(perfs, output);
+        break;
+      case check_type::uptime:
+        status = _check_uptime(perfs, output);
+        break;
+      case check_type::processes:
+        status = _check_processes(perfs, output);
+        break;
+    }
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(_logger, "serv {} fail to execute {}: {}",
+                        get_service(), get_command_line(), e.what());
+    perfs.clear();
+    status = 3;
+    output = fmt::format("Fail to execute {} : {}", get_command_line(),
+                         e.what());
+  }
+
+  _io_context->post([me = check::shared_from_this(),
+                     start_check_index = _get_running_check_index(), status,
+                     perfs = std::move(perfs),
+                     output = fmt::format("{}: {}", _status_labels[status],
+                                          output)]() {
+    me->on_completion(start_check_index, status, perfs, {output});
+  });
+}
+
+/**
+ * @brief compare value to thresholds, the higher the worse
+ *
+ * @param value
+ * @return unsigned 0: ok, 1: warning, 2: critical
+ */
+unsigned native_check::_status_of(double value) const {
+  if (_critical && value >= *_critical)
+    return 2;
+  if (_warning && value >= *_warning)
+    return 1;
+  return 0;
+}
+
+/**
+ * @brief build a perfdata as a plugin would do
+ *
+ * @param with_thresholds if true, warning and critical are set from command
+ * line
+ */
+com::centreon::common::perfdata native_check::_perfdata(
+    const std::string& name,
+    double value,
+    const std::string& unit,
+    double min,
+    double max,
+    bool with_thresholds) const {
+  com::centreon::common::perfdata perf;
+  perf.name(std::string(name));
+  perf.unit(std::string(unit));
+  perf.value(value);
+  perf.min(min);
+  perf.max(max);
+  if (with_thresholds) {
+    if (_warning) {
+      perf.warning_low(0);
+      perf.warning(*_warning);
+    }
+    if (_critical) {
+      perf.critical_low(0);
+      perf.critical(*_critical);
+    }
+  }
+  return perf;
+}
+
+/**
+ * @brief cpu usage since previous check, or since boot for the first one
+ *
+ */
+unsigned native_check::_check_cpu(
+    std::list<com::centreon::common::perfdata>& perfs,
+    std::string& output) {
+  std::ifstream stat("/proc/stat");
+  std::string label;
+  stat >> label;
+  if (label != "cpu") {
+    throw exceptions::msg_fmt("unable to read /proc/stat");
+  }
+  // user nice system idle iowait irq softirq steal
+  uint64_t counters[8] = {0};
+  for (uint64_t& counter : counters)
+    stat >> counter;
+  if (!stat) {
+    throw exceptions::msg_fmt("unable to read /proc/stat");
+  }
+
+  uint64_t total = 0;
+  for (uint64_t counter : counters)
+    total += counter;
+  uint64_t idle = counters[3] + counters[4];
+
+  uint64_t delta_total = total - _cpu_total;
+  uint64_t delta_idle = idle - _cpu_idle;
+  _cpu_total = total;
+  _cpu_idle = idle;
+
+  double usage =
+      delta_total ? 100.0 * (delta_total - delta_idle) / delta_total : 0;
+  unsigned status = _status_of(usage);
+  output = fmt::format("CPU usage {:.2f}%", usage);
+  perfs.emplace_back(_perfdata("cpu.utilization.percent", usage, "%", 0, 100,
+                               true));
+  return status;
+}
+
+/**
+ * @brief memory or swap usage read from /proc/meminfo
+ *
+ * @param swap if true swap is checked, otherwise memory
+ */
+unsigned native_check::_check_memory(
+    std::list<com::centreon::common::perfdata>& perfs,
+    std::string& output,
+    bool swap) const {
+  std::ifstream meminfo("/proc/meminfo");
+  if (!meminfo) {
+    throw exceptions::msg_fmt("unable to read /proc/meminfo");
+  }
+  const std::string_view total_label = swap ? "SwapTotal:" : "MemTotal:";
+  const std::string_view free_label = swap ? "SwapFree:" : "MemAvailable:";
+  std::optional<uint64_t> total_kb, free_kb;
+  std::string label;
+  uint64_t value;
+  std::string unit;
+  while (meminfo >> label >> value) {
+    if (label == total_label)
+      total_kb = value;
+    else if (label == free_label)
+      free_kb = value;
+    std::getline(meminfo, unit);
+  }
+  if (!total_kb || !free_kb) {
+    throw exceptions::msg_fmt("unable to read {} in /proc/meminfo",
+                              swap ? "swap" : "memory");
+  }
+
+  const char* what = swap ? "swap" : "memory";
+  const char* display_name = swap ? "Swap" : "Memory";
+  double total = *total_kb * 1024.0;
+  double used = (*total_kb - std::min(*free_kb, *total_kb)) * 1024.0;
+  double usage = total > 0 ? 100.0 * used / total : 0;
+  unsigned status = _status_of(usage);
+  output = fmt::format("{} usage {:.2f}% ({:.0f} of {:.0f} bytes used)",
+                       display_name, usage, used, total);
+  perfs.emplace_back(
+      _perfdata(fmt::format("{}.usage.bytes", what), used, "B", 0, total,
+                false));
+  perfs.emplace_back(_perfdata(fmt::format("{}.usage.percent", what), usage,
+                               "%", 0, 100, true));
+  return status;
+}
+
+/**
+ * @brief load average read from /proc/loadavg, thresholds are compared to
+ * load1
+ *
+ */
+unsigned native_check::_check_load(
+    std::list<com::centreon::common::perfdata>& perfs,
+    std::string& output) const {
+  std::ifstream loadavg("/proc/loadavg");
+  double load1, load5, load15;
+  if (!(loadavg >> load1 >> load5 >> load15)) {
+    throw exceptions::msg_fmt("unable to read /proc/loadavg");
+  }
+  unsigned status = _status_of(load1);
+  output = fmt::format("Load average {:.2f}, {:.2f}, {:.2f}", load1, load5,
+                       load15);
+  perfs.emplace_back(_perfdata("load1", load1, "", 0, NAN, true));
+  perfs.emplace_back(_perfdata("load5", load5, "", 0, NAN, false));
+  perfs.emplace_back(_perfdata("load15", load15, "", 0, NAN, false));
+  return status;
+}
+
+/**
+ * @brief usage of the filesystem mounted on path
+ *
+ */
+unsigned native_check::_check_filesystem(
+    std::list<com::centreon::common::perfdata>& perfs,
+    std::string& output) const {
+  struct statvfs fs;
+  if (statvfs(_path.c_str(), &fs)) {
+    throw exceptions::msg_fmt("unable to stat {}: {}", _path,
+                              strerror(errno));
+  }
+  double total = static_cast<double>(fs.f_blocks) * fs.f_frsize;
+  double used =
+      static_cast<double>(fs.f_blocks - std::min(fs.f_bfree, fs.f_blocks)) *
+      fs.f_frsize;
+  double usage = total > 0 ? 100.0 * used / total : 0;
+  unsigned status = _status_of(usage);
+  output = fmt::format("{} usage {:.2f}% ({:.0f} of {:.0f} bytes used)", _path,
+                       usage, used, total);
+  perfs.emplace_back(_perfdata(_path + "#storage.space.usage.bytes", used, "B",
+                               0, total, false));
+  perfs.emplace_back(_perfdata(_path + "#storage.space.usage.percent", usage,
+                               "%", 0, 100, true));
+  return status;
+}
+
+/**
+ * @brief uptime read from /proc/uptime, thresholds are ignored
+ *
+ */
+unsigned native_check::_check_uptime(
+    std::list<com::centreon::common::perfdata>& perfs,
+    std::string& output) const {
+  std::ifstream uptime_file("/proc/uptime");
+  double uptime;
+  if (!(uptime_file >> uptime)) {
+    throw exceptions::msg_fmt("unable to read /proc/uptime");
+  }
+  output = fmt::format("System uptime is {} seconds",
+                       static_cast<uint64_t>(uptime));
+  perfs.emplace_back(_perfdata("uptime", uptime, "s", 0, NAN, false));
+  return 0;
+}
+
+/**
+ * @brief number of processes, if a name is given, only processes with this
+ * command name (/proc/<pid>/comm) are counted
+ *
+ */
+unsigned native_check::_check_processes(
+    std::list<com::centreon::common::perfdata>& perfs,
+    std::string& output) const {
+  unsigned count = 0;
+  std::string comm;
+  for (const auto& entry : std::filesystem::directory_iterator("/proc")) {
+    const std::string pid = entry.path().filename().string();
+    if (pid.empty() ||
+        !std::all_of(pid.begin(), pid.end(),
+                     [](char c) { return c >= '0' && c <= '9'; })) {
+      continue;
+    }
+    if (!_process_name.empty()) {
+      // process may have exited since directory has been read
+      std::ifstream comm_file(entry.path() / "comm");
+      if (!std::getline(comm_file, comm) || comm != _process_name)
+        continue;
+    }
+    ++count;
+  }
+  unsigned status = _status_of(count);
+  if (_process_name.empty())
+    output = fmt::format("{} processes", count);
+  else
+    output = fmt::format("{} processes named {}", count, _process_name);
+  perfs.emplace_back(_perfdata("processes", count, "", 0, NAN, true));
+  return status;
+}
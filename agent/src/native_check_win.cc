@@ -0,0 +1,41 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "check_exec.hh"
+#include "native_check.hh"
+
+using namespace com::centreon::agent;
+
+/**
+ * @brief native checks read /proc, they are not available on windows, so all
+ * checks are executed by check_exec
+ *
+ * @return std::shared_ptr<check>
+ */
+std::shared_ptr<check> native_check::load(
+    const std::shared_ptr<asio::io_context>& io_context,
+    const std::shared_ptr<spdlog::logger>& logger,
+    time_point exp,
+    const std::string& serv,
+    const std::string& cmd_name,
+    const std::string& cmd_line,
+    const engine_to_agent_request_ptr& cnf,
+    check::completion_handler&& handler) {
+  return check_exec::load(io_context, logger, exp, serv, cmd_name, cmd_line,
+                          cnf, std::move(handler));
+}
@@ -17,7 +17,7 @@
  */
 
 #include "streaming_client.hh"
-#include "check_exec.hh"
+#include "native_check.hh"
 #include "com/centreon/common/defer.hh"
 #include "version.hh"
 
@@ -90,16 +90,24 @@ void client_reactor::shutdown() {
  * @param io_context
  * @param conf
  * @param supervised_hosts
+ * @param retention where metrics are stored while engine is not connected (may
+ * be null)
+ * @param replay_rate max number of retention messages sent per second
  */
 streaming_client::streaming_client(
     const std::shared_ptr<boost::asio::io_context>& io_context,
     const std::shared_ptr<spdlog::logger>& logger,
     const std::shared_ptr<common::grpc::grpc_config>& conf,
-    const std::string& supervised_host)
+    const std::string& supervised_host,
+    const std::shared_ptr<disk_buffer>& retention,
+    unsigned replay_rate)
     : com::centreon::common::grpc::grpc_client_base(conf, logger),
       _io_context(io_context),
       _logger(logger),
-      _supervised_host(supervised_host) {
+      _supervised_host(supervised_host),
+      _retention(retention),
+      _replay_period(std::chrono::seconds(1) / std::max(replay_rate, 1u)),
+      _replay_timer(*io_context) {
   _stub = std::move(AgentService::NewStub(_channel));
 }
 
@@ -119,7 +127,7 @@ void streaming_client::_start() {
           parent->_send(request);
         }
       },
-      check_exec::load);
+      native_check::load);
   _create_reactor();
 }
 
@@ -133,6 +141,7 @@ void streaming_client::_create_reactor() {
   if (_reactor) {
     _reactor->shutdown();
   }
+  _connected = false;
   _reactor = std::make_shared<client_reactor>(
       _io_context, _logger, shared_from_this(), get_conf()->get_hostport());
   client_reactor::register_stream(_reactor);
@@ -160,30 +169,94 @@ void streaming_client::_create_reactor() {
  * @param io_context
  * @param conf
  * @param supervised_hosts list of host to supervise (match to engine config)
+ * @param retention where metrics are stored while engine is not connected (may
+ * be null)
+ * @param replay_rate max number of retention messages sent per second
  * @return std::shared_ptr<streaming_client>
  */
 std::shared_ptr<streaming_client> streaming_client::load(
     const std::shared_ptr<boost::asio::io_context>& io_context,
     const std::shared_ptr<spdlog::logger>& logger,
     const std::shared_ptr<common::grpc::grpc_config>& conf,
-    const std::string& supervised_host) {
+    const std::string& supervised_host,
+    const std::shared_ptr<disk_buffer>& retention,
+    unsigned replay_rate) {
   std::shared_ptr<streaming_client> ret = std::make_shared<streaming_client>(
-      io_context, logger, conf, supervised_host);
+      io_context, logger, conf, supervised_host, retention, replay_rate);
   ret->_start();
   return ret;
 }
 
 /**
  * @brief send a request to engine
+ * metrics are stored in retention if engine is not connected or if older
+ * metrics are waiting to be replayed
  *
  * @param request
  */
 void streaming_client::_send(const std::shared_ptr<MessageFromAgent>& request) {
   std::lock_guard l(_protect);
+  if (_retention && request->has_otel_request() &&
+      (!_connected || !_retention->empty())) {
+    try {
+      _retention->push(request->otel_request());
+    } catch (const std::exception& e) {
+      SPDLOG_LOGGER_ERROR(_logger, "fail to store metrics in retention: {}",
+                          e.what());
+    }
+    return;
+  }
   if (_reactor)
     _reactor->write(request);
 }
 
+/**
+ * @brief start replay of retention if not yet started
+ * _protect must be locked
+ *
+ */
+void streaming_client::_start_replay() {
+  if (_replaying || !_retention || _retention->empty())
+    return;
+  SPDLOG_LOGGER_INFO(_logger, "replay {} bytes of stored metrics",
+                     _retention->size());
+  _replaying = true;
+  _replay_timer.expires_from_now(_replay_period);
+  _replay_timer.async_wait(
+      [me = shared_from_this()](const boost::system::error_code& err) {
+        me->_replay_timer_handler(err);
+      });
+}
+
+/**
+ * @brief send one coalesced message of stored metrics and rearm timer while
+ * connected and retention not empty
+ *
+ * @param err
+ */
+void streaming_client::_replay_timer_handler(
+    const boost::system::error_code& err) {
+  std::lock_guard l(_protect);
+  _replaying = false;
+  if (err || !_connected || !_reactor) {
+    return;
+  }
+  try {
+    std::shared_ptr<MessageFromAgent> to_send =
+        std::make_shared<MessageFromAgent>();
+    if (_retention->pop(*to_send->mutable_otel_request(), replay_max_bytes)) {
+      _reactor->write(to_send);
+    }
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(_logger, "fail to read stored metrics: {}", e.what());
+  }
+  if (_retention->empty()) {
+    SPDLOG_LOGGER_INFO(_logger, "all stored metrics have been replayed");
+  } else {
+    _start_replay();
+  }
+}
+
 /**
  * @brief
  *
@@ -193,6 +266,13 @@ void streaming_client::_send(const std::shared_ptr<MessageFromAgent>& request) {
 void streaming_client::on_incomming_request(
     const std::shared_ptr<client_reactor>& caller,
     const std::shared_ptr<MessageToAgent>& request) {
+  {
+    std::lock_guard l(_protect);
+    if (caller == _reactor && !_connected) {
+      _connected = true;
+      _start_replay();
+    }
+  }
   // incoming request is used in main thread
   _io_context->post([request, sched = _sched]() { sched->update(request); });
 }
@@ -207,6 +287,7 @@ void streaming_client::on_error(const std::shared_ptr<client_reactor>& caller) {
   std::lock_guard l(_protect);
   if (caller == _reactor) {
     _reactor.reset();
+    _connected = false;
     common::defer(_io_context, std::chrono::seconds(10),
                   [me = shared_from_this()] { me->_create_reactor(); });
   }
@@ -220,6 +301,7 @@ void streaming_client::on_error(const std::shared_ptr<client_reactor>& caller) {
 void streaming_client::shutdown() {
   std::lock_guard l(_protect);
   _sched->stop();
+  _replay_timer.cancel();
   if (_reactor) {
     _reactor->shutdown();
   }
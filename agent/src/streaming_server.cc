@@ -17,7 +17,7 @@
  */
 
 #include "streaming_server.hh"
-#include "check_exec.hh"
+#include "native_check.hh"
 #include "scheduler.hh"
 #include "version.hh"
 
@@ -83,7 +83,7 @@ void server_reactor::_start() {
           parent->write(request);
         }
       },
-      check_exec::load);
+      native_check::load);
 
   // identifies to engine
   std::shared_ptr<MessageFromAgent> who_i_am =
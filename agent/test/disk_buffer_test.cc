@@ -0,0 +1,109 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <gtest/gtest.h>
+
+#include "disk_buffer.hh"
+
+using namespace com::centreon::agent;
+using ::opentelemetry::proto::collector::metrics::v1::
+    ExportMetricsServiceRequest;
+
+static const std::string retention_dir("/tmp/agent_disk_buffer_test");
+
+class disk_buffer_test : public ::testing::Test {
+ protected:
+  void SetUp() override { std::filesystem::remove_all(retention_dir); }
+  void TearDown() override { std::filesystem::remove_all(retention_dir); }
+
+  static ExportMetricsServiceRequest create_request(const std::string& host,
+                                                    size_t padding = 0) {
+    ExportMetricsServiceRequest request;
+    auto* attrib =
+        request.add_resource_metrics()->mutable_resource()->add_attributes();
+    attrib->set_key("host.name");
+    attrib->mutable_value()->set_string_value(host + std::string(padding, ' '));
+    return request;
+  }
+
+  static std::string host_of(const ExportMetricsServiceRequest& request,
+                             int index) {
+    std::string ret = request.resource_metrics(index)
+                          .resource()
+                          .attributes(0)
+                          .value()
+                          .string_value();
+    boost::trim(ret);
+    return ret;
+  }
+};
+
+TEST_F(disk_buffer_test, coalesce) {
+  disk_buffer buff(retention_dir, 0x100000, std::chrono::hours(1),
+                   spdlog::default_logger());
+  ASSERT_TRUE(buff.empty());
+  buff.push(create_request("host1"));
+  buff.push(create_request("host2"));
+  buff.push(create_request("host3"));
+  ASSERT_FALSE(buff.empty());
+
+  ExportMetricsServiceRequest request;
+  ASSERT_TRUE(buff.pop(request, 0x10000));
+  ASSERT_EQ(request.resource_metrics_size(), 3);
+  ASSERT_EQ(host_of(request, 0), "host1");
+  ASSERT_EQ(host_of(request, 2), "host3");
+  ASSERT_TRUE(buff.empty());
+  ASSERT_FALSE(buff.pop(request, 0x10000));
+}
+
+TEST_F(disk_buffer_test, restart) {
+  ExportMetricsServiceRequest request;
+  {
+    disk_buffer buff(retention_dir, 0x100000, std::chrono::hours(1),
+                     spdlog::default_logger());
+    buff.push(create_request("host1", 100));
+    buff.push(create_request("host2", 100));
+    // max_bytes is reached with the first record
+    ASSERT_TRUE(buff.pop(request, 10));
+    ASSERT_EQ(request.resource_metrics_size(), 1);
+    ASSERT_EQ(host_of(request, 0), "host1");
+  }
+  disk_buffer buff(retention_dir, 0x100000, std::chrono::hours(1),
+                   spdlog::default_logger());
+  ASSERT_FALSE(buff.empty());
+  ASSERT_TRUE(buff.pop(request, 0x10000));
+  ASSERT_EQ(request.resource_metrics_size(), 1);
+  ASSERT_EQ(host_of(request, 0), "host2");
+  ASSERT_TRUE(buff.empty());
+}
+
+TEST_F(disk_buffer_test, max_size) {
+  disk_buffer buff(retention_dir, 0x20000, std::chrono::hours(1),
+                   spdlog::default_logger());
+  for (int i = 0; i < 100; ++i) {
+    buff.push(create_request(fmt::format("host{}", i), 0x1000));
+  }
+  // at most one segment over the limit
+  ASSERT_LT(buff.size(), 0x30000);
+
+  ExportMetricsServiceRequest request;
+  ASSERT_TRUE(buff.pop(request, 0x100000));
+  // oldest ones have been dropped, last one is kept
+  ASSERT_NE(host_of(request, 0), "host0");
+  ASSERT_EQ(host_of(request, request.resource_metrics_size() - 1), "host99");
+}
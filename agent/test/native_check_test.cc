@@ -0,0 +1,196 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <gtest/gtest.h>
+
+#include "check_exec.hh"
+#include "native_check.hh"
+
+using namespace com::centreon::agent;
+
+extern std::shared_ptr<asio::io_context> g_io_context;
+
+static const std::string serv("serv");
+static const std::string cmd_name("command");
+
+struct native_result {
+  std::mutex mut;
+  std::condition_variable cond;
+  bool completed = false;
+  int status;
+  std::list<com::centreon::common::perfdata> perfdata;
+  std::list<std::string> outputs;
+
+  void wait() {
+    std::unique_lock l(mut);
+    cond.wait(l, [this] { return completed; });
+  }
+};
+
+static std::shared_ptr<check> create_check(const std::string& command_line,
+                                           native_result& result) {
+  return native_check::load(
+      g_io_context, spdlog::default_logger(), time_point(), serv, cmd_name,
+      command_line, engine_to_agent_request_ptr(),
+      [&result](const std::shared_ptr<com::centreon::agent::check>& caller,
+                int status,
+                const std::list<com::centreon::common::perfdata>& perfdata,
+                const std::list<std::string>& outputs) {
+        {
+          std::lock_guard l(result.mut);
+          result.status = status;
+          result.perfdata = perfdata;
+          result.outputs = outputs;
+          result.completed = true;
+        }
+        result.cond.notify_one();
+      });
+}
+
+TEST(native_check_test, not_native) {
+  static const std::string command_line("/bin/echo hello");
+  native_result result;
+  std::shared_ptr<check> chk = create_check(command_line, result);
+  ASSERT_TRUE(std::dynamic_pointer_cast<check_exec>(chk));
+}
+
+TEST(native_check_test, bad_command_line) {
+  static const std::string unknown_type("native:toto");
+  static const std::string bad_threshold("native:cpu warning=abc");
+  static const std::string bad_arg("native:cpu foo=bar");
+  native_result result;
+  ASSERT_THROW(create_check(unknown_type, result), std::exception);
+  ASSERT_THROW(create_check(bad_threshold, result), std::exception);
+  ASSERT_THROW(create_check(bad_arg, result), std::exception);
+}
+
+TEST(native_check_test, uptime) {
+  static const std::string command_line("native:uptime");
+  native_result result;
+  std::shared_ptr<check> chk = create_check(command_line, result);
+  ASSERT_TRUE(std::dynamic_pointer_cast<native_check>(chk));
+  chk->start_check(std::chrono::seconds(1));
+  result.wait();
+  ASSERT_EQ(result.status, 0);
+  ASSERT_EQ(result.outputs.size(), 1);
+  ASSERT_EQ(result.outputs.begin()->substr(0, 21), "OK: System uptime is ");
+  ASSERT_EQ(result.perfdata.size(), 1);
+  ASSERT_EQ(result.perfdata.begin()->name(), "uptime");
+  ASSERT_GT(result.perfdata.begin()->value(), 0);
+}
+
+TEST(native_check_test, filesystem_critical) {
+  static const std::string command_line(
+      "native:filesystem path=/ warning=0 critical=0");
+  native_result result;
+  std::shared_ptr<check> chk = create_check(command_line, result);
+  chk->start_check(std::chrono::seconds(1));
+  result.wait();
+  ASSERT_EQ(result.status, 2);
+  ASSERT_EQ(result.outputs.begin()->substr(0, 12), "CRITICAL: / ");
+  ASSERT_EQ(result.perfdata.size(), 2);
+  ASSERT_EQ(result.perfdata.rbegin()->critical(), 0);
+}
+
+TEST(native_check_test, processes) {
+  static const std::string command_line("native:processes warning=1000000");
+  native_result result;
+  std::shared_ptr<check> chk = create_check(command_line, result);
+  chk->start_check(std::chrono::seconds(1));
+  result.wait();
+  ASSERT_EQ(result.status, 0);
+  ASSERT_EQ(result.perfdata.size(), 1);
+  ASSERT_GE(result.perfdata.begin()->value(), 1);
+}
+
+TEST(native_check_test, memory_warning) {
+  static const std::string command_line(
+      "native:memory warning=0 critical=101");
+  native_result result;
+  std::shared_ptr<check> chk = create_check(command_line, result);
+  chk->start_check(std::chrono::seconds(1));
+  result.wait();
+  ASSERT_EQ(result.status, 1);
+  ASSERT_EQ(result.outputs.begin()->substr(0, 22), "WARNING: Memory usage ");
+  ASSERT_EQ(result.perfdata.size(), 2);
+  const auto& bytes = *result.perfdata.begin();
+  const auto& percent = *result.perfdata.rbegin();
+  ASSERT_EQ(bytes.name(), "memory.usage.bytes");
+  ASSERT_GT(bytes.max(), 0);
+  ASSERT_LE(bytes.value(), bytes.max());
+  ASSERT_EQ(percent.name(), "memory.usage.percent");
+  ASSERT_GE(percent.value(), 0);
+  ASSERT_LE(percent.value(), 100);
+  ASSERT_EQ(percent.warning(), 0);
+  ASSERT_EQ(percent.critical(), 101);
+}
+
+TEST(native_check_test, swap) {
+  static const std::string command_line("native:swap");
+  native_result result;
+  std::shared_ptr<check> chk = create_check(command_line, result);
+  chk->start_check(std::chrono::seconds(1));
+  result.wait();
+  ASSERT_EQ(result.status, 0);
+  ASSERT_EQ(result.outputs.begin()->substr(0, 15), "OK: Swap usage ");
+  ASSERT_EQ(result.perfdata.size(), 2);
+  ASSERT_EQ(result.perfdata.begin()->name(), "swap.usage.bytes");
+  ASSERT_EQ(result.perfdata.rbegin()->name(), "swap.usage.percent");
+  ASSERT_GE(result.perfdata.rbegin()->value(), 0);
+  ASSERT_LE(result.perfdata.rbegin()->value(), 100);
+}
+
+TEST(native_check_test, cpu_critical) {
+  static const std::string command_line("native:cpu critical=0");
+  native_result result;
+  std::shared_ptr<check> chk = create_check(command_line, result);
+  // the first check gives the usage since boot, the second one the usage
+  // since the first one
+  for (int i = 0; i < 2; ++i) {
+    {
+      std::lock_guard l(result.mut);
+      result.completed = false;
+    }
+    chk->start_check(std::chrono::seconds(1));
+    result.wait();
+    ASSERT_EQ(result.status, 2);
+    ASSERT_EQ(result.outputs.begin()->substr(0, 20), "CRITICAL: CPU usage ");
+    ASSERT_EQ(result.perfdata.size(), 1);
+    ASSERT_EQ(result.perfdata.begin()->name(), "cpu.utilization.percent");
+    ASSERT_GE(result.perfdata.begin()->value(), 0);
+    ASSERT_LE(result.perfdata.begin()->value(), 100);
+    ASSERT_EQ(result.perfdata.begin()->critical(), 0);
+  }
+}
+
+TEST(native_check_test, load) {
+  static const std::string command_line("native:load warning=1000000");
+  native_result result;
+  std::shared_ptr<check> chk = create_check(command_line, result);
+  chk->start_check(std::chrono::seconds(1));
+  result.wait();
+  ASSERT_EQ(result.status, 0);
+  ASSERT_EQ(result.outputs.begin()->substr(0, 17), "OK: Load average ");
+  ASSERT_EQ(result.perfdata.size(), 3);
+  auto perf = result.perfdata.begin();
+  ASSERT_EQ(perf->name(), "load1");
+  ASSERT_EQ(perf->warning(), 1000000);
+  ASSERT_GE(perf->value(), 0);
+  ASSERT_EQ((++perf)->name(), "load5");
+  ASSERT_EQ((++perf)->name(), "load15");
+}
@@ -93,7 +93,8 @@ enum data_element {
   de_remove_poller = 6,
   de_welcome = 7,
   de_pb_ack = 8,
-  de_pb_stop = 9
+  de_pb_stop = 9,
+  de_pb_config_ack = 10
 };
 }
 namespace neb {
@@ -152,7 +153,9 @@ enum data_element {
   de_pb_service_group = 51,
   de_pb_service_group_member = 52,
   de_pb_host_parent = 53,
-  de_pb_instance_configuration = 54
+  de_pb_instance_configuration = 54,
+  de_pb_service_status_delta = 55,
+  de_pb_host_status_delta = 56
 };
 }  // namespace neb
 namespace storage {
@@ -24,6 +24,7 @@
 #include "com/centreon/broker/io/data.hh"
 #include "com/centreon/broker/sql/database_config.hh"
 #include "com/centreon/broker/sql/mysql.hh"
+#include "com/centreon/broker/stats/center.hh"
 #include "com/centreon/broker/time/timeperiod.hh"
 #include "com/centreon/broker/timestamp.hh"
 
@@ -37,6 +38,10 @@ namespace bam {
  * "com/centreon/broker/bam/availability_thread.hh"
  *  @brief Availability thread
  *
+ *  Once a day, or when asked by a rebuild, this thread computes the BA
+ *  availabilities. Days are built in parallel by as many workers as there
+ *  are connections in the database configuration, each worker using its own
+ *  connection.
  */
 class availability_thread final {
  public:
@@ -60,14 +65,16 @@ class availability_thread final {
  private:
   void _delete_all_availabilities();
   void _build_availabilities(time_t midnight);
-  void _build_daily_availabilities(int thread_id,
-                                   time_t day_start,
-                                   time_t day_end);
-  void _write_availability(int thread_id,
-                           availability_builder const& builder,
-                           uint32_t ba_id,
-                           time_t day_start,
-                           uint32_t timeperiod_id);
+  void _build_days(const std::vector<std::pair<time_t, time_t>>& days,
+                   int thread_id);
+  size_t _build_daily_availabilities(int thread_id,
+                                     time_t day_start,
+                                     time_t day_end);
+  size_t _write_availabilities(
+      int thread_id,
+      const std::map<std::pair<uint32_t, uint32_t>,
+                     std::unique_ptr<availability_builder>>& builders,
+      time_t day_start);
 
   time_t _compute_next_midnight();
   void _open_database();
@@ -88,6 +95,14 @@ class availability_thread final {
   std::string _bas_to_rebuild;
   std::condition_variable _wait;
 
+  /* Work shared by the workers of a build. */
+  std::atomic<size_t> _next_day;
+  std::mutex _error_m;
+  std::string _error;
+
+  std::shared_ptr<stats::center> _center;
+  BamAvailabilityStats* _stats;
+
   /* Logger */
   std::shared_ptr<spdlog::logger> _logger;
 };
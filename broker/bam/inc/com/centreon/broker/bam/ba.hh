@@ -149,6 +149,8 @@ class ba : public computable, public service_listener {
   void set_level_critical(double level);
   void set_level_warning(double level);
   void update_from(computable* child, io::stream* visitor) override;
+  void update_from_children(const std::vector<computable*>& children,
+                            io::stream* visitor) override;
   std::string object_info() const override;
   void dump(const std::string& filename) const;
   void dump(std::ofstream& output) const override;
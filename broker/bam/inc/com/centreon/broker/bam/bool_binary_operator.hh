@@ -53,6 +53,8 @@ class bool_binary_operator : public bool_value {
   bool_binary_operator& operator=(const bool_binary_operator&) = delete;
   void set_left(const std::shared_ptr<bool_value>& left);
   void set_right(std::shared_ptr<bool_value> const& right);
+  const std::shared_ptr<bool_value>& get_left() const;
+  const std::shared_ptr<bool_value>& get_right() const;
   bool state_known() const override;
   bool in_downtime() const override;
   void update_from(computable* child, io::stream* visitor) override;
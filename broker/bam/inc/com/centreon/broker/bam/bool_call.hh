@@ -48,6 +48,8 @@ class bool_call : public bool_value {
   std::string const& get_name() const;
   void set_expression(std::shared_ptr<bool_value> expression);
   void update_from(computable* child, io::stream* visitor) override;
+  std::string object_info() const override;
+  void dump(std::ofstream& output) const override;
 };
 }  // namespace com::centreon::broker::bam
 
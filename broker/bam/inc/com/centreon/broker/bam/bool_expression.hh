@@ -21,6 +21,7 @@
 
 #include "bbdo/bam/state.hh"
 #include "bbdo/bam_state.pb.h"
+#include "com/centreon/broker/bam/bool_program.hh"
 #include "com/centreon/broker/bam/computable.hh"
 #include "impact_values.hh"
 
@@ -35,11 +36,18 @@ class bool_value;
  *
  *  Stores and entire boolean expression made of multiple boolean
  *  operations and evaluate them to match the kpi interface.
+ *
+ *  When possible, the expression is compiled into a bool_program. Its
+ *  services are then directly linked to this object and the operators of the
+ *  tree are not used anymore, unless the expression is called by another
+ *  one (see attach_tree()).
  */
-class bool_expression : public computable {
+class bool_expression : public computable,
+                        public std::enable_shared_from_this<bool_expression> {
   const uint32_t _id;
   const bool _impact_if;
   std::shared_ptr<bool_value> _expression;
+  std::unique_ptr<bool_program> _program;
 
  public:
   bool_expression(uint32_t id,
@@ -52,9 +60,12 @@ class bool_expression : public computable {
   bool state_known() const;
   void set_expression(std::shared_ptr<bool_value> const& expression);
   std::shared_ptr<bool_value> get_expression() const;
+  void attach_tree();
   bool in_downtime() const;
   uint32_t get_id() const;
   void update_from(computable* child, io::stream* visitor) override;
+  void update_from_children(const std::vector<computable*>& children,
+                            io::stream* visitor) override;
   std::string object_info() const override;
   void dump(std::ofstream& output) const override;
 };
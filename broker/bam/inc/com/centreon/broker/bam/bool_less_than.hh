@@ -38,6 +38,7 @@ class bool_less_than : public bool_binary_operator {
   ~bool_less_than() noexcept = default;
   bool_less_than(const bool_less_than&) = delete;
   bool_less_than& operator=(const bool_less_than&) = delete;
+  bool is_strict() const;
   double value_hard() const override;
   bool boolean_value() const override;
   std::string object_info() const override;
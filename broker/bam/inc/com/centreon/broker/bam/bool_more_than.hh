@@ -37,6 +37,7 @@ class bool_more_than : public bool_binary_operator {
   bool_more_than(const bool_more_than&) = delete;
   ~bool_more_than() noexcept = default;
   bool_more_than& operator=(const bool_more_than&) = delete;
+  bool is_strict() const;
   double value_hard() const override;
   bool boolean_value() const override;
   std::string object_info() const override;
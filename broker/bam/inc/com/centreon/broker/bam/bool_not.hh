@@ -42,6 +42,7 @@ class bool_not : public bool_value {
   ~bool_not() noexcept = default;
   bool_not& operator=(const bool_not&) = delete;
   void set_value(std::shared_ptr<bool_value>& value);
+  const bool_value::ptr& get_value() const;
   double value_hard() const override;
   bool boolean_value() const override;
   double value_soft();
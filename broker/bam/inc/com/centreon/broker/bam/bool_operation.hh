@@ -31,6 +31,7 @@ namespace com::centreon::broker::bam {
  *  mathematical operation between two bool_value.
  */
 class bool_operation : public bool_binary_operator {
+ public:
   enum operation_type {
     addition,
     substraction,
@@ -38,6 +39,8 @@ class bool_operation : public bool_binary_operator {
     division,
     modulo
   };
+
+ private:
   const operation_type _type;
 
  public:
@@ -46,6 +49,7 @@ class bool_operation : public bool_binary_operator {
   ~bool_operation() noexcept override = default;
   bool_operation(const bool_operation&) = delete;
   bool_operation& operator=(const bool_operation&) = delete;
+  operation_type get_type() const;
   double value_hard() const override;
   bool boolean_value() const override;
   bool state_known() const override;
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_BAM_BOOL_PROGRAM_HH
+#define CCB_BAM_BOOL_PROGRAM_HH
+
+#include "com/centreon/broker/bam/bool_service.hh"
+
+namespace com::centreon::broker::bam {
+/**
+ *  @class bool_program bool_program.hh "com/centreon/broker/bam/bool_program.hh"
+ *  @brief Boolean expression lowered to a linear stack program.
+ *
+ *  The tree of bool_value built by exp_builder is compiled into a postfix
+ *  sequence of instructions. Services are referenced by their index in a
+ *  dense array of states and each operator owns a slot in a dense array of
+ *  node states, so an evaluation is a single loop without virtual calls.
+ *
+ *  Operator slots keep the same cached values as the bool_binary_operator
+ *  they come from and are only refreshed when an operand changed, so the
+ *  program gives the same results as the tree, including for unknown states
+ *  and downtimes.
+ */
+class bool_program {
+ public:
+  enum opcode : uint8_t {
+    push_constant,
+    push_service,
+    op_not,
+    op_and,
+    op_or,
+    op_xor,
+    op_equal,
+    op_not_equal,
+    op_more_than,
+    op_more_or_equal,
+    op_less_than,
+    op_less_or_equal,
+    op_addition,
+    op_substraction,
+    op_multiplication,
+    op_division,
+    op_modulo
+  };
+
+  struct instruction {
+    opcode op;
+    /* Index of the constant, of the service or of the operator slot. */
+    uint32_t arg;
+  };
+
+ private:
+  /* What a node gives to its parent, i.e. its bool_value interface. */
+  struct operand {
+    double value = 0;
+    bool boolean = false;
+    bool known = false;
+    bool in_downtime = false;
+    /* Would the node have notified its parent? */
+    bool changed = false;
+  };
+
+  /* Cached values of a binary operator. */
+  struct node {
+    double left_hard = 0;
+    double right_hard = 0;
+    bool known = false;
+    bool in_downtime = false;
+    bool boolean_value = false;
+  };
+
+  std::vector<instruction> _code;
+  std::vector<operand> _constants;
+  std::vector<bool_service::ptr> _services;
+  std::vector<operand> _service_states;
+  std::vector<node> _nodes;
+  std::vector<operand> _stack;
+  operand _result;
+  bool _changed = false;
+
+  /* Links from services to the operators of the tree, they are removed by
+   * detach_tree() and restored by attach_tree(). */
+  std::vector<std::pair<bool_service::ptr, bool_value::ptr>> _tree_links;
+  bool _tree_attached = true;
+
+  bool_program() = default;
+  bool _compile(const bool_value::ptr& value,
+                const bool_value::ptr& parent,
+                uint32_t depth);
+  bool _refresh_services();
+  void _run(bool force);
+  static void _update_node(opcode op,
+                           node& n,
+                           const operand& left,
+                           const operand& right);
+  static void _node_output(opcode op, const node& n, operand& out);
+
+ public:
+  static std::unique_ptr<bool_program> compile(const bool_value::ptr& root);
+  bool_program(const bool_program&) = delete;
+  bool_program& operator=(const bool_program&) = delete;
+  ~bool_program() noexcept = default;
+  void detach_tree();
+  void attach_tree();
+  const std::vector<bool_service::ptr>& services() const;
+  const std::vector<instruction>& code() const;
+  void evaluate();
+  bool take_change();
+  double value_hard() const;
+  bool boolean_value() const;
+  bool state_known() const;
+  bool in_downtime() const;
+};
+}  // namespace com::centreon::broker::bam
+
+#endif  // !CCB_BAM_BOOL_PROGRAM_HH
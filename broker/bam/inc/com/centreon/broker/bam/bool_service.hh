@@ -33,7 +33,7 @@ namespace com::centreon::broker::bam {
  *  This class compares the state of a service to compute a boolean
  *  value.
  */
-class bool_service : public bool_value, public service_listener {
+class bool_service final : public bool_value, public service_listener {
   const uint32_t _host_id;
   const uint32_t _service_id;
   short _state_hard;
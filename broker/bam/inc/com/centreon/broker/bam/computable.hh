@@ -30,10 +30,21 @@ namespace com::centreon::broker::bam {
  *  provides an effective way to compute whole part of the BA/KPI tree.
  */
 class computable {
+ public:
+  class batch;
+
  protected:
   std::list<std::weak_ptr<computable>> _parents;
   std::shared_ptr<spdlog::logger> _logger;
 
+ private:
+  /* Length of the longest path from a leaf to this node. A parent is always
+   * higher than its children, so sorting by height gives a topological
+   * order of the tree. */
+  uint32_t _height = 0;
+
+  void _raise_height(uint32_t height);
+
  public:
   computable(const std::shared_ptr<spdlog::logger>& logger) : _logger(logger) {}
   computable(const computable&) = delete;
@@ -51,6 +62,8 @@ class computable {
    *  @param[in] visitor This is used to manage events
    */
   virtual void update_from(computable* child, io::stream* visitor) = 0;
+  virtual void update_from_children(const std::vector<computable*>& children,
+                                    io::stream* visitor);
   void remove_parent(const std::shared_ptr<computable>& parent);
   /**
    * @brief This method is used by the dump() method. It gives a summary of this
@@ -68,6 +81,41 @@ class computable {
   virtual void dump(std::ofstream& output) const = 0;
   void dump_parents(std::ofstream& output) const;
 };
+
+/**
+ *  @class computable::batch computable.hh
+ *  "com/centreon/broker/bam/computable.hh"
+ *  @brief Defer the propagation of changes through the BA/KPI tree.
+ *
+ *  While a batch is alive on the current thread, notify_parents_of_change()
+ *  only marks the parents as dirty. When the batch is committed, dirty nodes
+ *  are recomputed once each, from the leaves to the top-level BAs, so a BA
+ *  shared by several changed KPIs is evaluated and visited only once.
+ *
+ *  Batches do not nest: a batch created while another one is active is
+ *  inactive and the outer one does the work.
+ */
+class computable::batch {
+  static thread_local batch* _current;
+
+  io::stream* const _visitor;
+  const bool _active;
+  std::shared_ptr<spdlog::logger> _logger;
+  std::map<std::pair<uint32_t, computable*>,
+           std::pair<std::shared_ptr<computable>, std::vector<computable*>>>
+      _dirty;
+
+  friend class computable;
+
+  void _mark(const std::shared_ptr<computable>& parent, computable* child);
+
+ public:
+  batch(io::stream* visitor, const std::shared_ptr<spdlog::logger>& logger);
+  batch(const batch&) = delete;
+  batch& operator=(const batch&) = delete;
+  ~batch() noexcept;
+  void commit();
+};
 }  // namespace com::centreon::broker::bam
 
 #endif  // !CCB_BAM_COMPUTABLE_HH
@@ -26,6 +26,10 @@ using namespace com::centreon::exceptions;
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::bam;
 
+/* Maximum number of rows inserted by one query in
+ * mod_bam_reporting_ba_availabilities. */
+static constexpr size_t max_rows_per_insert = 500;
+
 /**
  *  Constructor.
  *
@@ -43,6 +47,9 @@ availability_thread::availability_thread(
       _mutex{},
       _should_exit(false),
       _should_rebuild_all(false),
+      _next_day{0},
+      _center{stats::center::instance_ptr()},
+      _stats{_center->register_bam_availability()},
       _logger{logger} {}
 
 /**
@@ -176,7 +183,6 @@ void availability_thread::_build_availabilities(time_t midnight) {
   time_t first_day = 0;
   time_t last_day = midnight;
   std::string query_str;
-  int thread_id;
 
   // Get the first day of rebuilding. If a complete rebuilding was asked,
   // it's the day of the chronogically first event to rebuild.
@@ -189,8 +195,7 @@ void availability_thread::_build_availabilities(time_t midnight) {
     try {
       std::promise<database::mysql_result> promise;
       std::future<database::mysql_result> future = promise.get_future();
-      thread_id =
-          _mysql->run_query_and_get_result(query_str, std::move(promise));
+      _mysql->run_query_and_get_result(query_str, std::move(promise));
       database::mysql_result res(future.get());
       if (!_mysql->fetch_row(res))
         throw msg_fmt("no events matching BAs to rebuild");
@@ -218,8 +223,7 @@ void availability_thread::_build_availabilities(time_t midnight) {
     try {
       std::promise<database::mysql_result> promise;
       std::future<database::mysql_result> future = promise.get_future();
-      thread_id =
-          _mysql->run_query_and_get_result(query_str, std::move(promise));
+      _mysql->run_query_and_get_result(query_str, std::move(promise));
       database::mysql_result res(future.get());
       if (!_mysql->fetch_row(res)) {
         _logger->error("no availability in table");
@@ -242,27 +246,98 @@ void availability_thread::_build_availabilities(time_t midnight) {
       "BAM-BI: availability thread writing availabilities from: {} to {}",
       first_day, last_day);
 
-  // Write the availabilities day after day.
+  // The deletion must be done before any insertion on other connections.
+  _mysql->commit();
+
+  std::vector<std::pair<time_t, time_t>> days;
   while (first_day < last_day) {
     time_t next_day =
         time::timeperiod::add_round_days_to_midnight(first_day, 3600 * 24);
-    _build_daily_availabilities(thread_id, first_day, next_day);
+    days.emplace_back(first_day, next_day);
     first_day = next_day;
   }
+  if (days.empty())
+    return;
+
+  // One worker per connection, and the current thread is the first one.
+  size_t workers = std::min(
+      static_cast<size_t>(std::max(_mysql->connections_count(), 1)),
+      days.size());
+  _logger->info("BAM-BI: building availabilities of {} days with {} workers",
+                days.size(), workers);
+  _center->execute([stats = _stats, workers, count = days.size(),
+                    now = ::time(nullptr)] {
+    stats->set_workers(workers);
+    stats->set_days_to_build(count);
+    stats->set_days_built(0);
+    stats->set_rows_written(0);
+    stats->set_started_at(now);
+    stats->set_finished_at(0);
+  });
+
+  _next_day = 0;
+  _error.clear();
+  std::vector<std::thread> threads;
+  threads.reserve(workers - 1);
+  for (size_t i = 1; i < workers; i++)
+    threads.emplace_back(&availability_thread::_build_days, this,
+                         std::cref(days), static_cast<int>(i));
+  _build_days(days, 0);
+  for (auto& t : threads)
+    t.join();
+
+  _center->update(&BamAvailabilityStats::set_finished_at, _stats,
+                  static_cast<int64_t>(::time(nullptr)));
+  if (!_error.empty())
+    throw msg_fmt("BAM-BI: availability thread could not build the data: {}",
+                  _error);
+  _mysql->commit();
+}
+
+/**
+ *  @brief Worker of the availabilities build. Days are taken one after the
+ *  other from the days list until it is empty or an error occurs.
+ *
+ *  @param[in] days       The days to build, as (start, end) pairs.
+ *  @param[in] thread_id  The database connection of this worker.
+ */
+void availability_thread::_build_days(
+    const std::vector<std::pair<time_t, time_t>>& days,
+    int thread_id) {
+  size_t i;
+  while ((i = _next_day++) < days.size()) {
+    try {
+      size_t rows = _build_daily_availabilities(thread_id, days[i].first,
+                                                days[i].second);
+      _center->execute([stats = _stats, rows] {
+        stats->set_days_built(stats->days_built() + 1);
+        stats->set_rows_written(stats->rows_written() + rows);
+      });
+    } catch (const std::exception& e) {
+      _logger->error("BAM-BI: availability worker {} failed on day {}: {}",
+                     thread_id, days[i].first, e.what());
+      std::lock_guard<std::mutex> lck(_error_m);
+      if (_error.empty())
+        _error = e.what();
+      _next_day = days.size();
+    }
+  }
 }
 
 /**
  *  @brief  Build all the availabilities of a day.
  *
- *  This is called from the context of the availability thread.
+ *  This is called from the context of an availability worker.
  *
- *  @param[in] q         A SQL query object.
+ *  @param[in] thread_id The database connection to use.
  *  @param[in] day_start The start of the day.
  *  @param[in] day_end   The first second of the next day.
+ *
+ *  @return The number of availabilities written.
  */
-void availability_thread::_build_daily_availabilities(int thread_id,
-                                                      time_t day_start,
-                                                      time_t day_end) {
+size_t availability_thread::_build_daily_availabilities(int thread_id,
+                                                        time_t day_start,
+                                                        time_t day_end) {
   _logger->info(
       "BAM-BI: availability thread writing daily availability for day : {}-{}",
       day_start, day_end);
@@ -381,50 +456,66 @@ void availability_thread::_build_daily_availabilities(int thread_id,
   }
 
   _logger->debug("{} builder(s) to write availabilities", builders.size());
-  // For each builder, write the availabilities.
-  for (auto it = builders.begin(), end = builders.end(); it != end; ++it)
-    _write_availability(thread_id, *it->second, it->first.first, day_start,
-                        it->first.second);
+  return _write_availabilities(thread_id, builders, day_start);
 }
 
 /**
- *  Write an availability to the database. *One* row is inserted by ba and by
- *  day.
+ *  Write the availabilities of a day to the database. *One* row is inserted by
+ *  ba, timeperiod and day, rows are grouped in multi-rows insertions.
  *
  *  @param[in] thread_id              Index to one connection to the database.
- *  @param[in] builder                The builder of an availability.
- *  @param[in] ba_id                  The id of the ba.
+ *  @param[in] builders               The builders of the availabilities,
+ *                                    indexed by ba id and timeperiod id.
  *  @param[in] day_start              The start of the day.
- *  @param[in] timeperiod_id          The id of the timeperiod.
+ *
+ *  @return The number of rows written.
  */
-void availability_thread::_write_availability(
+size_t availability_thread::_write_availabilities(
     int thread_id,
-    availability_builder const& builder,
-    uint32_t ba_id,
-    time_t day_start,
-    uint32_t timeperiod_id) {
+    const std::map<std::pair<uint32_t, uint32_t>,
+                   std::unique_ptr<availability_builder>>& builders,
+    time_t day_start) {
   _logger->debug(
-      "BAM-BI: availability thread writing availability for BA {} at day {} "
-      "(timeperiod {})",
-      ba_id, day_start, timeperiod_id);
+      "BAM-BI: availability thread writing {} availabilities at day {}",
+      builders.size(), day_start);
 
-  std::string query_str(fmt::format(
+  constexpr std::string_view insert_str(
       "INSERT INTO mod_bam_reporting_ba_availabilities "
       "(ba_id, time_id, timeperiod_id, timeperiod_is_default,"
       " available, unavailable, degraded,"
       " unknown, downtime, alert_unavailable_opened,"
       " alert_degraded_opened, alert_unknown_opened,"
-      " nb_downtime)"
-      " VALUES ({},{},{},{},{},{},{},{},{},{},{},{},{})",
-      ba_id, day_start, timeperiod_id, builder.get_timeperiod_is_default(),
-      builder.get_available(), builder.get_unavailable(),
-      builder.get_degraded(), builder.get_unknown(), builder.get_downtime(),
-      builder.get_unavailable_opened(), builder.get_degraded_opened(),
-      builder.get_unknown_opened(), builder.get_downtime_opened()));
-
-  _logger->debug("Query: {}", query_str);
-  _mysql->run_query(query_str, database::mysql_error::insert_availability,
-                    thread_id);
+      " nb_downtime) VALUES ");
+  std::string query_str;
+  size_t rows = 0;
+  for (auto it = builders.begin(), end = builders.end(); it != end; ++it) {
+    const availability_builder& builder = *it->second;
+    if (query_str.empty())
+      query_str = insert_str;
+    else
+      query_str.push_back(',');
+    fmt::format_to(std::back_inserter(query_str),
+                   "({},{},{},{},{},{},{},{},{},{},{},{},{})", it->first.first,
+                   day_start, it->first.second,
+                   builder.get_timeperiod_is_default(),
+                   builder.get_available(), builder.get_unavailable(),
+                   builder.get_degraded(), builder.get_unknown(),
+                   builder.get_downtime(), builder.get_unavailable_opened(),
+                   builder.get_degraded_opened(), builder.get_unknown_opened(),
+                   builder.get_downtime_opened());
+    if (++rows % max_rows_per_insert == 0) {
+      _logger->trace("Query: {}", query_str);
+      _mysql->run_query(query_str, database::mysql_error::insert_availability,
+                        thread_id);
+      query_str.clear();
+    }
+  }
+  if (!query_str.empty()) {
+    _logger->trace("Query: {}", query_str);
+    _mysql->run_query(query_str, database::mysql_error::insert_availability,
+                      thread_id);
+  }
+  return rows;
 }
 
 /**
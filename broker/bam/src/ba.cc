@@ -589,33 +589,53 @@ void ba::set_level_warning(double level) {
  * @param visitor The visitor to handle events.
  */
 void ba::update_from(computable* child, io::stream* visitor) {
-  _logger->trace("ba::update_from (BA {})", _id);
-  // Get impact.
-  impact_values new_hard_impact;
-  impact_values new_soft_impact;
-  kpi* kpi_child = static_cast<kpi*>(child);
-  kpi_child->impact_hard(new_hard_impact);
-  kpi_child->impact_soft(new_soft_impact);
-  bool kpi_in_downtime(kpi_child->in_downtime());
+  update_from_children({child}, visitor);
+}
+
+/**
+ * @brief Update this computable with the modifications of several children.
+ * Impacts of all the children are applied before the inherited downtime is
+ * computed and the BA status event is emitted, so they are done once whatever
+ * the number of changed children.
+ *
+ * @param children The children that changed.
+ * @param visitor The visitor to handle events.
+ */
+void ba::update_from_children(const std::vector<computable*>& children,
+                              io::stream* visitor) {
+  _logger->trace("ba::update_from_children (BA {}, {} KPI)", _id,
+                 children.size());
   bool previous_in_downtime = _in_downtime;
+  bool changed = false;
+
+  for (computable* child : children) {
+    // Get impact.
+    impact_values new_hard_impact;
+    impact_values new_soft_impact;
+    kpi* kpi_child = static_cast<kpi*>(child);
+    kpi_child->impact_hard(new_hard_impact);
+    kpi_child->impact_soft(new_soft_impact);
+    bool kpi_in_downtime(kpi_child->in_downtime());
+
+    // Logging.
+    SPDLOG_LOGGER_DEBUG(
+        _logger,
+        "BAM: BA {}, '{}' is getting notified of child update (KPI {}, impact "
+        "{}, last state change {}, downtime {})",
+        _id, _name, kpi_child->get_id(), new_hard_impact.get_nominal(),
+        kpi_child->get_last_state_change(), kpi_in_downtime);
 
-  // Logging.
-  SPDLOG_LOGGER_DEBUG(
-      _logger,
-      "BAM: BA {}, '{}' is getting notified of child update (KPI {}, impact "
-      "{}, last state change {}, downtime {})",
-      _id, _name, kpi_child->get_id(), new_hard_impact.get_nominal(),
-      kpi_child->get_last_state_change(), kpi_in_downtime);
-
-  timestamp last_state_change(kpi_child->get_last_state_change());
-  if (!last_state_change.is_null())
-    _last_kpi_update = std::max(_last_kpi_update, last_state_change);
-
-  // Apply new data.
-  SPDLOG_LOGGER_TRACE(_logger, "BAM: BA {} updated from KPI {}", _id,
-                      kpi_child->get_id());
-  bool changed = _apply_changes(kpi_child, new_hard_impact, new_soft_impact,
-                                kpi_in_downtime);
+    timestamp last_state_change(kpi_child->get_last_state_change());
+    if (!last_state_change.is_null())
+      _last_kpi_update = std::max(_last_kpi_update, last_state_change);
+
+    // Apply new data.
+    SPDLOG_LOGGER_TRACE(_logger, "BAM: BA {} updated from KPI {}", _id,
+                        kpi_child->get_id());
+    if (_apply_changes(kpi_child, new_hard_impact, new_soft_impact,
+                       kpi_in_downtime))
+      changed = true;
+  }
   SPDLOG_LOGGER_TRACE(_logger, "BA {} has changed: {}", _id, changed);
 
   // Check for inherited downtimes.
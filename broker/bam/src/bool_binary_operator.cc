@@ -75,6 +75,24 @@ void bool_binary_operator::set_right(std::shared_ptr<bool_value> const& right) {
   _update_state();
 }
 
+/**
+ *  Get left member.
+ *
+ *  @return Left member of the boolean operator.
+ */
+const std::shared_ptr<bool_value>& bool_binary_operator::get_left() const {
+  return _left;
+}
+
+/**
+ *  Get right member.
+ *
+ *  @return Right member of the boolean operator.
+ */
+const std::shared_ptr<bool_value>& bool_binary_operator::get_right() const {
+  return _right;
+}
+
 /**
  *  Get if the state is known, i.e has been computed at least once.
  *
@@ -98,3 +98,28 @@ void bool_call::update_from(computable* child [[maybe_unused]],
   if (child == _expression.get())
     notify_parents_of_change(visitor);
 }
+
+/**
+ * @brief This method is used by the dump() method. It gives a summary of this
+ * computable main informations.
+ *
+ * @return A multiline strings with various informations.
+ */
+std::string bool_call::object_info() const {
+  return fmt::format("CALL {}\nknown: {}\nvalue: {}", _name,
+                     state_known() ? "true" : "false",
+                     boolean_value() ? "true" : "false");
+}
+
+/**
+ * @brief Recursive or not method that writes object informations to the
+ * output stream. If there are children, each one dump() is then called.
+ *
+ * @param output An output stream.
+ */
+void bool_call::dump(std::ofstream& output) const {
+  if (_expression)
+    output << fmt::format("\"{}\" -> \"{}\"\n", object_info(),
+                          _expression->object_info());
+  dump_parents(output);
+}
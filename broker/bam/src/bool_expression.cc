@@ -43,7 +43,11 @@ bool_expression::bool_expression(uint32_t id,
  *  @return Either OK (0) or CRITICAL (2).
  */
 state bool_expression::get_state() const {
-  bool v = _expression->boolean_value();
+  bool v;
+  if (_program)
+    v = _program->boolean_value();
+  else
+    v = _expression->boolean_value();
   state retval = v == _impact_if ? state_critical : state_ok;
   _logger->debug(
       "BAM: boolean expression {} - impact if: {} - value: {} - state: {}", _id,
@@ -57,6 +61,8 @@ state bool_expression::get_state() const {
  *  @return  True if the state is known.
  */
 bool bool_expression::state_known() const {
+  if (_program)
+    return _program->state_known();
   return _expression->state_known();
 }
 
@@ -66,6 +72,8 @@ bool bool_expression::state_known() const {
  *  @return  True if the boolean expression is in downtime.
  */
 bool bool_expression::in_downtime() const {
+  if (_program)
+    return _program->in_downtime();
   return _expression->in_downtime();
 }
 
@@ -79,13 +87,42 @@ std::shared_ptr<bool_value> bool_expression::get_expression() const {
 }
 
 /**
- *  Set evaluable boolean expression.
+ *  Set evaluable boolean expression. It is compiled if possible, its services
+ *  are then linked to this object instead of the tree operators and the
+ *  program is evaluated by update_from(), so this object must be owned by a
+ *  shared_ptr when this method is called.
  *
  *  @param[in] expression Boolean expression.
  */
 void bool_expression::set_expression(
     const std::shared_ptr<bool_value>& expression) {
   _expression = expression;
+  _program = bool_program::compile(expression);
+  if (_program) {
+    _logger->debug(
+        "BAM: boolean expression {} compiled into {} instructions on {} "
+        "services",
+        _id, _program->code().size(), _program->services().size());
+    _program->detach_tree();
+    if (auto self = weak_from_this().lock()) {
+      for (auto& s : _program->services())
+        s->add_parent(self);
+    }
+  } else
+    _logger->debug(
+        "BAM: boolean expression {} can not be compiled, it is evaluated as a "
+        "tree",
+        _id);
+}
+
+/**
+ * @brief Keep the operators of the tree up to date even if the expression is
+ * compiled. It is needed when the tree is read by a bool_call from another
+ * expression, otherwise the call would see frozen values.
+ */
+void bool_expression::attach_tree() {
+  if (_program)
+    _program->attach_tree();
 }
 
 uint32_t bool_expression::get_id() const {
@@ -100,10 +137,30 @@ uint32_t bool_expression::get_id() const {
  */
 void bool_expression::update_from(computable* child, io::stream* visitor) {
   _logger->trace("bool_expression::update_from");
-  if (child == _expression.get())
+  if (_program) {
+    _program->evaluate();
+    if (_program->take_change())
+      notify_parents_of_change(visitor);
+  } else if (child == _expression.get())
     notify_parents_of_change(visitor);
 }
 
+/**
+ * @brief Update this computable with the modifications of several children.
+ * When the expression is compiled, it is evaluated only once.
+ *
+ * @param children The children that changed.
+ * @param visitor The visitor to handle events.
+ */
+void bool_expression::update_from_children(
+    const std::vector<computable*>& children,
+    io::stream* visitor) {
+  if (_program)
+    update_from(nullptr, visitor);
+  else
+    computable::update_from_children(children, visitor);
+}
+
 /**
  * @brief This method is used by the dump() method. It gives a summary of this
  * computable main informations.
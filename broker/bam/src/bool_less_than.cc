@@ -30,6 +30,15 @@ bool_less_than::bool_less_than(bool strict,
                                const std::shared_ptr<spdlog::logger>& logger)
     : bool_binary_operator(logger), _strict{strict} {}
 
+/**
+ *  Is the operator strict?
+ *
+ *  @return  True if the operator is strict.
+ */
+bool bool_less_than::is_strict() const {
+  return _strict;
+}
+
 /**
  *  Get the hard value.
  *
@@ -31,6 +31,15 @@ bool_more_than::bool_more_than(bool strict,
                                const std::shared_ptr<spdlog::logger>& logger)
     : bool_binary_operator(logger), _strict{strict} {}
 
+/**
+ *  Is the operator strict?
+ *
+ *  @return  True if the operator is strict.
+ */
+bool bool_more_than::is_strict() const {
+  return _strict;
+}
+
 /**
  *  Get the hard value.
  *
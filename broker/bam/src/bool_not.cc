@@ -41,6 +41,15 @@ void bool_not::set_value(std::shared_ptr<bool_value>& value) {
   _value = value;
 }
 
+/**
+ *  Get value object.
+ *
+ *  @return Value object whose value is negated.
+ */
+const bool_value::ptr& bool_not::get_value() const {
+  return _value;
+}
+
 /**
  *  Get the hard value.
  *
@@ -39,6 +39,15 @@ bool_operation::bool_operation(const std::string& op,
             : (op == "%") ? modulo
                           : addition} {}
 
+/**
+ *  Get the operation type.
+ *
+ *  @return The operation type.
+ */
+bool_operation::operation_type bool_operation::get_type() const {
+  return _type;
+}
+
 /**
  *  Get the hard value.
  *
@@ -0,0 +1,462 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/bam/bool_program.hh"
+
+#include <cmath>
+
+#include "com/centreon/broker/bam/bool_and.hh"
+#include "com/centreon/broker/bam/bool_constant.hh"
+#include "com/centreon/broker/bam/bool_equal.hh"
+#include "com/centreon/broker/bam/bool_less_than.hh"
+#include "com/centreon/broker/bam/bool_more_than.hh"
+#include "com/centreon/broker/bam/bool_not.hh"
+#include "com/centreon/broker/bam/bool_not_equal.hh"
+#include "com/centreon/broker/bam/bool_operation.hh"
+#include "com/centreon/broker/bam/bool_or.hh"
+#include "com/centreon/broker/bam/bool_xor.hh"
+
+using namespace com::centreon::broker::bam;
+
+static constexpr double eps = 0.000001;
+
+/**
+ * @brief Compile a boolean expression tree.
+ *
+ * @param root The root of the tree.
+ *
+ * @return The program or nullptr if the tree contains nodes that can not be
+ * compiled (e.g. calls to other expressions).
+ */
+std::unique_ptr<bool_program> bool_program::compile(
+    const bool_value::ptr& root) {
+  if (!root)
+    return nullptr;
+  std::unique_ptr<bool_program> retval(new bool_program);
+  if (!retval->_compile(root, nullptr, 1))
+    return nullptr;
+
+  /* The initial states of the operators are the ones computed by their
+   * set_left()/set_right(). */
+  retval->_refresh_services();
+  retval->_run(true);
+  retval->_changed = false;
+  return retval;
+}
+
+/**
+ * @brief Emit the instructions of value, children first.
+ *
+ * @param value The node to compile.
+ * @param parent Its parent in the tree, nullptr for the root.
+ * @param depth The stack size once value is pushed.
+ *
+ * @return false if the node is not supported.
+ */
+bool bool_program::_compile(const bool_value::ptr& value,
+                            const bool_value::ptr& parent,
+                            uint32_t depth) {
+  if (_stack.size() < depth)
+    _stack.resize(depth);
+
+  if (auto c = std::dynamic_pointer_cast<bool_constant>(value)) {
+    operand o;
+    o.value = c->value_hard();
+    o.boolean = c->boolean_value();
+    o.known = true;
+    _code.push_back({push_constant, static_cast<uint32_t>(_constants.size())});
+    _constants.push_back(o);
+    return true;
+  }
+
+  if (auto s = std::dynamic_pointer_cast<bool_service>(value)) {
+    _code.push_back({push_service, static_cast<uint32_t>(_services.size())});
+    _services.push_back(s);
+    _service_states.emplace_back();
+    if (parent)
+      _tree_links.emplace_back(s, parent);
+    return true;
+  }
+
+  if (auto n = std::dynamic_pointer_cast<bool_not>(value)) {
+    if (!n->get_value() || !_compile(n->get_value(), value, depth))
+      return false;
+    _code.push_back({op_not, 0});
+    return true;
+  }
+
+  auto b = std::dynamic_pointer_cast<bool_binary_operator>(value);
+  if (!b || !b->get_left() || !b->get_right())
+    return false;
+
+  opcode op;
+  if (std::dynamic_pointer_cast<bool_and>(b))
+    op = op_and;
+  else if (std::dynamic_pointer_cast<bool_or>(b))
+    op = op_or;
+  else if (std::dynamic_pointer_cast<bool_xor>(b))
+    op = op_xor;
+  else if (std::dynamic_pointer_cast<bool_equal>(b))
+    op = op_equal;
+  else if (std::dynamic_pointer_cast<bool_not_equal>(b))
+    op = op_not_equal;
+  else if (auto m = std::dynamic_pointer_cast<bool_more_than>(b))
+    op = m->is_strict() ? op_more_than : op_more_or_equal;
+  else if (auto l = std::dynamic_pointer_cast<bool_less_than>(b))
+    op = l->is_strict() ? op_less_than : op_less_or_equal;
+  else if (auto o = std::dynamic_pointer_cast<bool_operation>(b)) {
+    switch (o->get_type()) {
+      case bool_operation::addition:
+        op = op_addition;
+        break;
+      case bool_operation::substraction:
+        op = op_substraction;
+        break;
+      case bool_operation::multiplication:
+        op = op_multiplication;
+        break;
+      case bool_operation::division:
+        op = op_division;
+        break;
+      case bool_operation::modulo:
+        op = op_modulo;
+        break;
+      default:
+        return false;
+    }
+  } else
+    return false;
+
+  if (!_compile(b->get_left(), value, depth) ||
+      !_compile(b->get_right(), value, depth + 1))
+    return false;
+  _code.push_back({op, static_cast<uint32_t>(_nodes.size())});
+  _nodes.emplace_back();
+  return true;
+}
+
+/**
+ * @brief Remove the links between the services and the operators of the tree,
+ * so that service changes are not computed twice. The tree is still usable
+ * for dumps but its operators are not updated anymore.
+ */
+void bool_program::detach_tree() {
+  if (!_tree_attached)
+    return;
+  for (auto& l : _tree_links)
+    l.first->remove_parent(l.second);
+  _tree_attached = false;
+}
+
+/**
+ * @brief Restore the links removed by detach_tree(). It is needed when the
+ * tree is read by someone else than the program, e.g. a bool_call to the
+ * expression.
+ */
+void bool_program::attach_tree() {
+  if (_tree_attached)
+    return;
+  for (auto& l : _tree_links)
+    l.first->add_parent(l.second);
+  _tree_attached = true;
+}
+
+/**
+ * @brief Accessor to the services used by the program.
+ *
+ * @return A vector of bool_service, the index of each one is the argument of
+ * its push_service instructions.
+ */
+const std::vector<bool_service::ptr>& bool_program::services() const {
+  return _services;
+}
+
+/**
+ * @brief Accessor to the instructions of the program.
+ *
+ * @return The instructions in execution order.
+ */
+const std::vector<bool_program::instruction>& bool_program::code() const {
+  return _code;
+}
+
+/**
+ * @brief Copy the services states into the dense array. A service is marked
+ * as changed when it would have notified its parent.
+ *
+ * @return true if at least one service changed.
+ */
+bool bool_program::_refresh_services() {
+  bool retval = false;
+  for (size_t i = 0; i < _services.size(); ++i) {
+    const bool_service& s = *_services[i];
+    operand& o = _service_states[i];
+    double value = s.value_hard();
+    bool known = s.state_known();
+    bool in_downtime = s.in_downtime();
+    o.changed =
+        value != o.value || known != o.known || in_downtime != o.in_downtime;
+    o.value = value;
+    o.boolean = s.boolean_value();
+    o.known = known;
+    o.in_downtime = in_downtime;
+    retval |= o.changed;
+  }
+  return retval;
+}
+
+/**
+ * @brief Evaluate the program if some of its services changed since the last
+ * evaluation.
+ */
+void bool_program::evaluate() {
+  if (_refresh_services())
+    _run(false);
+}
+
+/**
+ * @brief Tell if the result changed since the last call to this function, in
+ * which case the tree root would have notified its parents.
+ *
+ * @return true if the result changed.
+ */
+bool bool_program::take_change() {
+  bool retval = _changed;
+  _changed = false;
+  return retval;
+}
+
+/**
+ * @brief Execute the instructions.
+ *
+ * @param force If true, all the operators are recomputed, otherwise only
+ * those with changed operands are.
+ */
+void bool_program::_run(bool force) {
+  operand* stack = _stack.data();
+  uint32_t sp = 0;
+  for (const instruction& i : _code) {
+    switch (i.op) {
+      case push_constant:
+        stack[sp++] = _constants[i.arg];
+        break;
+      case push_service:
+        stack[sp++] = _service_states[i.arg];
+        break;
+      case op_not: {
+        operand& o = stack[sp - 1];
+        o.boolean = std::abs(o.value) < ::eps;
+        o.value = o.boolean;
+      } break;
+      default: {
+        const operand& right = stack[--sp];
+        operand& left = stack[sp - 1];
+        node& n = _nodes[i.arg];
+        bool changed = false;
+        if (force)
+          _update_node(i.op, n, left, right);
+        else {
+          if (left.changed && (left.known != n.known ||
+                               std::abs(n.left_hard - left.value) > ::eps)) {
+            _update_node(i.op, n, left, right);
+            changed = true;
+          }
+          if (right.changed && (right.known != n.known ||
+                                std::abs(n.right_hard - right.value) > ::eps)) {
+            _update_node(i.op, n, left, right);
+            changed = true;
+          }
+        }
+        _node_output(i.op, n, left);
+        left.changed = changed;
+      } break;
+    }
+  }
+  _result = stack[0];
+  _changed |= _result.changed;
+}
+
+/**
+ * @brief Recompute the cached values of an operator from its operands, as
+ * the _update_state() method of the corresponding bool_binary_operator.
+ *
+ * @param op The operator.
+ * @param n Its cached values.
+ * @param left Its left operand.
+ * @param right Its right operand.
+ */
+void bool_program::_update_node(opcode op,
+                                node& n,
+                                const operand& left,
+                                const operand& right) {
+  if (op == op_and) {
+    if (left.known && !left.boolean) {
+      n.left_hard = 0;
+      n.boolean_value = false;
+      n.known = true;
+      return;
+    } else if (right.known && !right.boolean) {
+      n.right_hard = 0;
+      n.boolean_value = false;
+      n.known = true;
+      return;
+    }
+  } else if (op == op_or) {
+    if (left.known && left.boolean) {
+      n.left_hard = 1;
+      n.boolean_value = true;
+      n.known = true;
+      return;
+    } else if (right.known && right.boolean) {
+      n.right_hard = 1;
+      n.boolean_value = true;
+      n.known = true;
+      return;
+    }
+  }
+
+  n.known = left.known && right.known;
+  if (n.known) {
+    n.left_hard = left.value;
+    n.right_hard = right.value;
+    n.in_downtime = left.in_downtime || right.in_downtime;
+  }
+  if (op == op_and)
+    n.boolean_value = n.known && std::abs(n.left_hard) > ::eps &&
+                      std::abs(n.right_hard) > ::eps;
+  else if (op == op_or)
+    n.boolean_value = false;
+}
+
+/**
+ * @brief Compute what an operator gives to its parent from its cached values,
+ * as the value_hard(), boolean_value(), state_known() and in_downtime()
+ * methods of the corresponding bool_binary_operator.
+ *
+ * @param op The operator.
+ * @param n Its cached values.
+ * @param out The operand to fill.
+ */
+void bool_program::_node_output(opcode op, const node& n, operand& out) {
+  const double l = n.left_hard;
+  const double r = n.right_hard;
+  out.known = n.known;
+  out.in_downtime = n.in_downtime;
+  switch (op) {
+    case op_and:
+    case op_or:
+      out.boolean = n.boolean_value;
+      break;
+    case op_xor:
+      out.boolean = (std::abs(l) > ::eps) ^ (std::abs(r) > ::eps);
+      break;
+    case op_equal:
+      out.boolean = n.known && std::fabs(l - r) < COMPARE_EPSILON;
+      break;
+    case op_not_equal:
+      out.boolean = std::fabs(l - r) >= COMPARE_EPSILON;
+      break;
+    case op_more_than:
+      out.boolean = l > r;
+      break;
+    case op_more_or_equal:
+      out.boolean = l >= r;
+      break;
+    case op_less_than:
+      out.boolean = l < r;
+      break;
+    case op_less_or_equal:
+      out.boolean = l <= r;
+      break;
+    case op_addition:
+      out.value = l + r;
+      out.boolean = out.value;
+      return;
+    case op_substraction:
+      out.value = l - r;
+      out.boolean = out.value;
+      return;
+    case op_multiplication:
+      out.value = l * r;
+      out.boolean = std::fabs(out.value) > COMPARE_EPSILON;
+      return;
+    case op_division:
+      if (std::fabs(r) < COMPARE_EPSILON) {
+        out.value = NAN;
+        out.boolean = false;
+        out.known = false;
+      } else {
+        out.value = l / r;
+        out.boolean = out.value;
+      }
+      return;
+    case op_modulo: {
+      long long left_val = static_cast<long long>(l);
+      long long right_val = static_cast<long long>(r);
+      if (right_val == 0) {
+        out.value = NAN;
+        out.boolean = false;
+      } else {
+        out.value = left_val % right_val;
+        out.boolean = out.value;
+      }
+      if (std::fabs(r) < COMPARE_EPSILON)
+        out.known = false;
+      return;
+    }
+    default:
+      break;
+  }
+  out.value = out.boolean;
+}
+
+/**
+ *  Get the hard value.
+ *
+ *  @return Evaluation of the expression with hard values.
+ */
+double bool_program::value_hard() const {
+  return _result.value;
+}
+
+/**
+ *  Get the hard value as a boolean.
+ *
+ *  @return Evaluation of the expression with hard values.
+ */
+bool bool_program::boolean_value() const {
+  return _result.boolean;
+}
+
+/**
+ *  Get if the state is known, i.e has been computed at least once.
+ *
+ *  @return  True if the state is known.
+ */
+bool bool_program::state_known() const {
+  return _result.known;
+}
+
+/**
+ *  Is this expression in downtime?
+ *
+ *  @return  True if this expression is in downtime.
+ */
+bool bool_program::in_downtime() const {
+  return _result.in_downtime;
+}
@@ -18,8 +18,12 @@
 
 #include "com/centreon/broker/bam/computable.hh"
 
+#include <algorithm>
+
 using namespace com::centreon::broker::bam;
 
+thread_local computable::batch* computable::batch::_current = nullptr;
+
 /**
  *  Add a new parent.
  *
@@ -30,6 +34,23 @@ void computable::add_parent(std::shared_ptr<computable> const& parent) {
     if (it->lock().get() == parent.get())
       return;
   _parents.push_back(std::weak_ptr<computable>(parent));
+  parent->_raise_height(_height + 1);
+}
+
+/**
+ * @brief Make sure this node is at least at the given height, and propagate
+ * the change to its parents.
+ *
+ * @param height The minimal height of this node.
+ */
+void computable::_raise_height(uint32_t height) {
+  if (height <= _height)
+    return;
+  _height = height;
+  for (auto& p : _parents) {
+    if (std::shared_ptr<computable> parent = p.lock())
+      parent->_raise_height(_height + 1);
+  }
 }
 
 /**
@@ -54,12 +75,34 @@ void computable::remove_parent(std::shared_ptr<computable> const& parent) {
  */
 void computable::notify_parents_of_change(io::stream* visitor) {
   _logger->trace("{}::notify_parents_of_change: ", typeid(*this).name());
+  batch* current = batch::_current;
+  if (current && current->_visitor == visitor) {
+    for (auto& p : _parents) {
+      if (std::shared_ptr<computable> parent = p.lock())
+        current->_mark(parent, this);
+    }
+    return;
+  }
   for (auto& p : _parents) {
     if (std::shared_ptr<computable> parent = p.lock())
       parent->update_from(this, visitor);
   }
 }
 
+/**
+ * @brief Update this object because there were changes in several children.
+ * The default implementation just calls update_from() for each of them, nodes
+ * that can aggregate these changes should override it.
+ *
+ * @param children The children that changed, without duplicates.
+ * @param visitor Used to handle events.
+ */
+void computable::update_from_children(const std::vector<computable*>& children,
+                                      io::stream* visitor) {
+  for (computable* child : children)
+    update_from(child, visitor);
+}
+
 /**
  * @brief Add to the output stream informations about this computable parents.
  *
@@ -72,3 +115,63 @@ void computable::dump_parents(std::ofstream& output) const {
                             parent->object_info());
   }
 }
+
+/**
+ * @brief Constructor. The batch becomes the current one of this thread if
+ * there is not already one.
+ *
+ * @param visitor The visitor used to handle events, only changes notified
+ * with this visitor are deferred.
+ * @param logger The logger used if the recomputation fails on destruction.
+ */
+computable::batch::batch(io::stream* visitor,
+                         const std::shared_ptr<spdlog::logger>& logger)
+    : _visitor{visitor}, _active{_current == nullptr}, _logger{logger} {
+  if (_active)
+    _current = this;
+}
+
+/**
+ * @brief Destructor. Pending changes are committed.
+ */
+computable::batch::~batch() noexcept {
+  if (!_active)
+    return;
+  try {
+    commit();
+  } catch (const std::exception& e) {
+    _logger->error("BAM: could not propagate changes in the BA tree: {}",
+                   e.what());
+  }
+  _current = nullptr;
+}
+
+/**
+ * @brief Mark parent as needing a recomputation because of child.
+ *
+ * @param parent The node to recompute.
+ * @param child One of its changed children.
+ */
+void computable::batch::_mark(const std::shared_ptr<computable>& parent,
+                              computable* child) {
+  auto& entry = _dirty[{parent->_height, parent.get()}];
+  if (!entry.first)
+    entry.first = parent;
+  if (std::find(entry.second.begin(), entry.second.end(), child) ==
+      entry.second.end())
+    entry.second.push_back(child);
+}
+
+/**
+ * @brief Recompute the dirty nodes, lowest first. Nodes marked during the
+ * recomputation are always higher than the current one, so each node is
+ * recomputed only once.
+ */
+void computable::batch::commit() {
+  if (!_active)
+    return;
+  while (!_dirty.empty()) {
+    auto node = _dirty.extract(_dirty.begin());
+    node.mapped().first->update_from_children(node.mapped().second, _visitor);
+  }
+}
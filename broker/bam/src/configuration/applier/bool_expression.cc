@@ -175,8 +175,14 @@ void applier::bool_expression::_resolve_expression_calls() {
             (*call_it)->get_name(), it->second.cfg.get_name());
         break;
       } else {
-        (*call_it)->set_expression(
-            _applied[found->second].obj->get_expression());
+        /* The call reads the tree of the called expression, it must not be
+         * left frozen by the compilation of the expression. */
+        auto& called = _applied[found->second].obj;
+        called->attach_tree();
+        auto expression = called->get_expression();
+        (*call_it)->set_expression(expression);
+        if (expression)
+          expression->add_parent(*call_it);
       }
     }
   }
@@ -18,6 +18,7 @@
 
 #include "com/centreon/broker/bam/service_book.hh"
 
+#include "com/centreon/broker/bam/computable.hh"
 #include "com/centreon/broker/bam/internal.hh"
 #include "com/centreon/broker/neb/downtime.hh"
 #include "com/centreon/broker/neb/service_status.hh"
@@ -83,6 +84,7 @@ void service_book::update(const std::shared_ptr<neb::pb_acknowledgement>& t,
     return;
   auto& svc_state = found->second.state;
   svc_state.acknowledged = time_is_undefined(t->obj().deletion_time());
+  computable::batch propagation(visitor, _logger);
   for (auto l : found->second.listeners)
     l->service_update(t, visitor);
 }
@@ -101,6 +103,7 @@ void service_book::update(const std::shared_ptr<neb::acknowledgement>& t,
     return;
   auto& svc_state = found->second.state;
   svc_state.acknowledged = t->deletion_time.is_null();
+  computable::batch propagation(visitor, _logger);
   for (auto l : found->second.listeners)
     l->service_update(t, visitor);
 }
@@ -117,6 +120,7 @@ void service_book::update(const std::shared_ptr<neb::downtime>& t,
   auto found = _book.find(std::make_pair(t->host_id, t->service_id));
   if (found == _book.end())
     return;
+  computable::batch propagation(visitor, _logger);
   for (auto l : found->second.listeners)
     l->service_update(t, visitor);
 }
@@ -134,6 +138,7 @@ void service_book::update(const std::shared_ptr<neb::pb_downtime>& t,
       _book.find(std::make_pair(t->obj().host_id(), t->obj().service_id()));
   if (found == _book.end())
     return;
+  computable::batch propagation(visitor, _logger);
   for (auto l : found->second.listeners)
     l->service_update(t, visitor);
 }
@@ -156,6 +161,7 @@ void service_book::update(const std::shared_ptr<neb::service_status>& t,
   svc_state.last_check = t->last_check;
   svc_state.state_type = t->state_type;
 
+  computable::batch propagation(visitor, _logger);
   for (auto l : found->second.listeners)
     l->service_update(t, visitor);
 }
@@ -181,6 +187,7 @@ void service_book::update(const std::shared_ptr<neb::pb_service>& t,
   svc_state.current_state = static_cast<State>(o.state());
   svc_state.state_type = o.state_type();
 
+  computable::batch propagation(visitor, _logger);
   for (auto l : found->second.listeners)
     l->service_update(t, visitor);
 }
@@ -206,6 +213,7 @@ void service_book::update(const std::shared_ptr<neb::pb_service_status>& t,
   svc_state.current_state = static_cast<State>(o.state());
   svc_state.state_type = o.state_type();
 
+  computable::batch propagation(visitor, _logger);
   for (auto l : found->second.listeners)
     l->service_update(t, visitor);
 }
@@ -241,6 +249,7 @@ void service_book::save_to_cache(persistent_cache& cache) const {
  */
 void service_book::apply_services_state(const ServicesBookState& state) {
   _logger->trace("BAM: applying services state from cache");
+  computable::batch propagation(nullptr, _logger);
   for (auto& svc : state.service()) {
     auto found = _book.find(std::make_pair(svc.host_id(), svc.service_id()));
     if (found == _book.end())
@@ -382,6 +382,81 @@ TEST_F(BamBA, KpiServiceWorstState) {
   }
 }
 
+/**
+ *  Check that KPI changes made in a batch are only propagated to the BA when
+ *  the batch is committed, and that the BA then takes all of them into
+ *  account.
+ *
+ *                 ----------------
+ *         ________|   BA(Worst)  |___________
+ *        /        ----------------           \
+ *       |                  |                 |
+ *  KPI1(C20%:W10%)   KPI2(C20%:W10%)  KPI3(C20%:W10%)
+ *       |                  |                 |
+ *      H1S1               H2S1             H3S1
+ */
+TEST_F(BamBA, KpiServiceBatchedWorstState) {
+  // Build BAM objects.
+  std::shared_ptr<bam::ba> test_ba{
+      std::make_shared<bam::ba_worst>(1, 1, 4, true, _logger)};
+
+  std::vector<std::shared_ptr<bam::kpi_service>> kpis;
+
+  for (int i = 0; i < 3; i++) {
+    auto s = std::make_shared<bam::kpi_service>(
+        i + 1, 1, i + 1, 1, fmt::format("service {}", i), _logger);
+    s->set_impact_warning(10);
+    s->set_impact_critical(20);
+    s->set_state_hard(bam::state_ok);
+    s->set_state_soft(s->get_state_hard());
+    test_ba->add_impact(s);
+    s->add_parent(test_ba);
+    kpis.push_back(s);
+  }
+
+  time_t now(time(nullptr));
+
+  auto ss{std::make_shared<neb::service_status>()};
+  ss->service_id = 1;
+  ss->last_check = now + 1;
+
+  {
+    bam::computable::batch propagation(_visitor.get(), _logger);
+    for (size_t j = 0; j < kpis.size(); j++) {
+      ss->host_id = j + 1;
+      ss->last_hard_state = j == 1 ? 2 : 1;
+      ss->current_state = ss->last_hard_state;
+      kpis[j]->service_update(ss, _visitor.get());
+
+      /* Nothing is propagated to the BA before the commit. */
+      ASSERT_EQ(test_ba->get_state_hard(), bam::state_ok);
+    }
+    propagation.commit();
+    ASSERT_EQ(test_ba->get_state_soft(), bam::state_critical);
+    ASSERT_EQ(test_ba->get_state_hard(), bam::state_critical);
+
+    /* A committed batch stays usable. */
+    ss->host_id = 2;
+    ss->last_check = now + 2;
+    ss->last_hard_state = 0;
+    ss->current_state = ss->last_hard_state;
+    kpis[1]->service_update(ss, _visitor.get());
+    ASSERT_EQ(test_ba->get_state_hard(), bam::state_critical);
+  }
+
+  /* The destructor commits pending changes. */
+  ASSERT_EQ(test_ba->get_state_soft(), bam::state_warning);
+  ASSERT_EQ(test_ba->get_state_hard(), bam::state_warning);
+
+  /* Without batch, changes are propagated at once. */
+  ss->host_id = 3;
+  ss->last_check = now + 3;
+  ss->last_hard_state = 2;
+  ss->current_state = ss->last_hard_state;
+  kpis[2]->service_update(ss, _visitor.get());
+  ASSERT_EQ(test_ba->get_state_hard(), bam::state_critical);
+}
+
 /**
  *  Check that a KPI change at BA recompute does not mess with the BA
  *  value.
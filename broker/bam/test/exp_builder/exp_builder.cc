@@ -21,7 +21,9 @@
 #include <memory>
 #include "bbdo/neb.pb.h"
 #include "com/centreon/broker/bam/ba_impact.hh"
+#include "com/centreon/broker/bam/bool_call.hh"
 #include "com/centreon/broker/bam/bool_expression.hh"
+#include "com/centreon/broker/bam/bool_program.hh"
 #include "com/centreon/broker/bam/bool_value.hh"
 #include "com/centreon/broker/bam/exp_parser.hh"
 #include "com/centreon/broker/bam/kpi_boolexp.hh"
@@ -557,15 +559,15 @@ TEST_F(BamExpBuilder, ExpressionWithService) {
   bam::exp_builder builder(p.get_postfix(), mapping, _logger);
   bam::bool_value::ptr b(builder.get_tree());
 
-  bam::bool_expression exp(1, true, _logger);
-  exp.set_expression(b);
+  auto exp = std::make_shared<bam::bool_expression>(1, true, _logger);
+  exp->set_expression(b);
 
   bam::service_book book(_logger);
   for (auto& svc : builder.get_services())
     book.listen(svc->get_host_id(), svc->get_service_id(), svc.get());
 
-  ASSERT_FALSE(exp.state_known());
-  ASSERT_FALSE(exp.get_state());
+  ASSERT_FALSE(exp->state_known());
+  ASSERT_FALSE(exp->get_state());
 
   auto svc1 = std::make_shared<neb::pb_service_status>();
   svc1->mut_obj().set_host_id(1);
@@ -575,16 +577,16 @@ TEST_F(BamExpBuilder, ExpressionWithService) {
 
   book.update(svc1);
 
-  ASSERT_TRUE(exp.state_known());
-  ASSERT_TRUE(exp.get_state());
+  ASSERT_TRUE(exp->state_known());
+  ASSERT_TRUE(exp->get_state());
 
   svc1->mut_obj().set_state(ServiceStatus::CRITICAL);
   svc1->mut_obj().set_last_hard_state(ServiceStatus::CRITICAL);
 
   book.update(svc1);
 
-  ASSERT_TRUE(exp.state_known());
-  ASSERT_FALSE(exp.get_state());
+  ASSERT_TRUE(exp->state_known());
+  ASSERT_FALSE(exp->get_state());
 }
 
 TEST_F(BamExpBuilder, ReverseExpressionWithService) {
@@ -596,15 +598,15 @@ TEST_F(BamExpBuilder, ReverseExpressionWithService) {
   bam::exp_builder builder(p.get_postfix(), mapping, _logger);
   bam::bool_value::ptr b(builder.get_tree());
 
-  bam::bool_expression exp(1, false, _logger);
-  exp.set_expression(b);
+  auto exp = std::make_shared<bam::bool_expression>(1, false, _logger);
+  exp->set_expression(b);
 
   bam::service_book book(_logger);
   for (auto& svc : builder.get_services())
     book.listen(svc->get_host_id(), svc->get_service_id(), svc.get());
 
-  ASSERT_FALSE(exp.state_known());
-  ASSERT_TRUE(exp.get_state());
+  ASSERT_FALSE(exp->state_known());
+  ASSERT_TRUE(exp->get_state());
 
   auto svc1 = std::make_shared<neb::pb_service_status>();
   svc1->mut_obj().set_host_id(1);
@@ -614,16 +616,16 @@ TEST_F(BamExpBuilder, ReverseExpressionWithService) {
 
   book.update(svc1);
 
-  ASSERT_TRUE(exp.state_known());
-  ASSERT_FALSE(exp.get_state());
+  ASSERT_TRUE(exp->state_known());
+  ASSERT_FALSE(exp->get_state());
 
   svc1->mut_obj().set_state(ServiceStatus::CRITICAL);
   svc1->mut_obj().set_last_hard_state(ServiceStatus::CRITICAL);
 
   book.update(svc1);
 
-  ASSERT_TRUE(exp.state_known());
-  ASSERT_TRUE(exp.get_state());
+  ASSERT_TRUE(exp->state_known());
+  ASSERT_TRUE(exp->get_state());
 }
 
 TEST_F(BamExpBuilder, KpiBoolexpWithService) {
@@ -1100,3 +1102,95 @@ TEST_F(BamExpBuilder, BoolexpKpiServiceAndBoolExpressionAndOperator) {
   ASSERT_TRUE(kpi->ok_state());
   ASSERT_EQ(ba->get_state_hard(), 0);
 }
+
+TEST_F(BamExpBuilder, ProgramMatchesTree) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/neb/10-neb.so");
+  bam::exp_parser p(
+      "(({host_1 service_1} {IS} {CRITICAL}) {AND} ({host_1 service_2} {NOT} "
+      "{OK})) {OR} ({host_1 service_3} {IS} {WARNING})");
+  bam::hst_svc_mapping mapping(_logger);
+  mapping.set_service("host_1", "service_1", 1, 1, true);
+  mapping.set_service("host_1", "service_2", 1, 2, true);
+  mapping.set_service("host_1", "service_3", 1, 3, true);
+  bam::exp_builder builder(p.get_postfix(), mapping, _logger);
+  bam::bool_value::ptr b(builder.get_tree());
+
+  auto program = bam::bool_program::compile(b);
+  ASSERT_TRUE(program);
+  ASSERT_EQ(program->services().size(), 3u);
+
+  bam::service_book book(_logger);
+  for (auto& svc : builder.get_services())
+    book.listen(svc->get_host_id(), svc->get_service_id(), svc.get());
+
+  program->evaluate();
+  ASSERT_EQ(program->state_known(), b->state_known());
+  ASSERT_EQ(program->boolean_value(), b->boolean_value());
+
+  auto svc = std::make_shared<neb::pb_service_status>();
+  svc->mut_obj().set_host_id(1);
+  for (int i = 0; i < 64; i++) {
+    int states = i;
+    for (int j = 1; j <= 3; j++) {
+      svc->mut_obj().set_service_id(j);
+      svc->mut_obj().set_state(static_cast<ServiceStatus::State>(states & 3));
+      svc->mut_obj().set_last_hard_state(
+          static_cast<ServiceStatus::State>(states & 3));
+      svc->mut_obj().set_scheduled_downtime_depth(j == 2 && (i & 1));
+      states >>= 2;
+      book.update(svc);
+
+      program->evaluate();
+      ASSERT_EQ(program->state_known(), b->state_known());
+      ASSERT_EQ(program->boolean_value(), b->boolean_value());
+      ASSERT_EQ(program->in_downtime(), b->in_downtime());
+    }
+  }
+}
+
+TEST_F(BamExpBuilder, CalledCompiledExpressionIsUpToDate) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/neb/10-neb.so");
+  bam::exp_parser p(
+      "{host_1 service_1} {IS} {CRITICAL} {AND} {host_1 service_2} {IS} "
+      "{CRITICAL}");
+  bam::hst_svc_mapping mapping(_logger);
+  mapping.set_service("host_1", "service_1", 1, 1, true);
+  mapping.set_service("host_1", "service_2", 1, 2, true);
+  bam::exp_builder builder(p.get_postfix(), mapping, _logger);
+  bam::bool_value::ptr b(builder.get_tree());
+
+  auto called = std::make_shared<bam::bool_expression>(1, false, _logger);
+  called->set_expression(b);
+  b->add_parent(called);
+
+  /* As done by the applier when it resolves the calls. */
+  auto call = std::make_shared<bam::bool_call>("called", _logger);
+  called->attach_tree();
+  call->set_expression(called->get_expression());
+  b->add_parent(call);
+
+  bam::service_book book(_logger);
+  for (auto& svc : builder.get_services())
+    book.listen(svc->get_host_id(), svc->get_service_id(), svc.get());
+
+  auto svc = std::make_shared<neb::pb_service_status>();
+  svc->mut_obj().set_host_id(1);
+  for (uint32_t id : {1u, 2u}) {
+    svc->mut_obj().set_service_id(id);
+    svc->mut_obj().set_state(ServiceStatus::CRITICAL);
+    svc->mut_obj().set_last_hard_state(ServiceStatus::CRITICAL);
+    book.update(svc);
+  }
+  ASSERT_TRUE(call->state_known());
+  ASSERT_TRUE(call->boolean_value());
+  ASSERT_EQ(called->get_state(), 0);
+
+  svc->mut_obj().set_service_id(2);
+  svc->mut_obj().set_state(ServiceStatus::OK);
+  svc->mut_obj().set_last_hard_state(ServiceStatus::OK);
+  book.update(svc);
+  ASSERT_FALSE(call->boolean_value());
+  ASSERT_EQ(called->get_state(), 2);
+}
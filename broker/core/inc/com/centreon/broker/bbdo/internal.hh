@@ -44,6 +44,9 @@ using pb_stop =
     com::centreon::broker::io::protobuf<Stop,
                                         make_type(io::bbdo, bbdo::de_pb_stop)>;
 
+using pb_config_ack = com::centreon::broker::io::
+    protobuf<ConfigAck, make_type(io::bbdo, bbdo::de_pb_config_ack)>;
+
 using pb_bench = com::centreon::broker::io::
     protobuf<Bench, make_type(io::extcmd, extcmd::de_pb_bench)>;
 
@@ -0,0 +1,100 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_BBDO_STATUS_DELTA_HH
+#define CCB_BBDO_STATUS_DELTA_HH
+
+#include <nlohmann/json.hpp>
+
+#include "bbdo/events.hh"
+#include "bbdo/neb.pb.h"
+#include "com/centreon/broker/io/protobuf.hh"
+
+namespace com::centreon::broker::bbdo {
+
+/**
+ * @class status_delta status_delta.hh
+ * "com/centreon/broker/bbdo/status_delta.hh"
+ * @brief Delta encoding of ServiceStatus and HostStatus events, used by the
+ * bbdo stream when the DELTA_STATUS extension is negotiated.
+ *
+ * On the output side, the last status sent for each resource is kept and the
+ * following ones are replaced by ServiceStatusDelta/HostStatusDelta events
+ * that only contain the changed fields.
+ * On the input side, the last status received for each resource is kept and
+ * full events are rebuilt from deltas, so streams behind the bbdo one
+ * (unified_sql, lua...) only receive ServiceStatus and HostStatus events.
+ *
+ * States are bound to a connection, a new connection begins with full events.
+ */
+class status_delta {
+ public:
+  static constexpr std::string_view extension_name = "DELTA_STATUS";
+
+  using pb_service_status =
+      io::protobuf<ServiceStatus, make_type(io::neb, neb::de_pb_service_status)>;
+  using pb_service_status_delta =
+      io::protobuf<ServiceStatusDelta,
+                   make_type(io::neb, neb::de_pb_service_status_delta)>;
+  using pb_host_status =
+      io::protobuf<HostStatus, make_type(io::neb, neb::de_pb_host_status)>;
+  using pb_host_status_delta =
+      io::protobuf<HostStatusDelta,
+                   make_type(io::neb, neb::de_pb_host_status_delta)>;
+
+ private:
+  absl::flat_hash_map<std::pair<uint64_t, uint64_t>, ServiceStatus> _services;
+  absl::flat_hash_map<uint64_t, HostStatus> _hosts;
+
+  /* sizes of the full events and of what is really transmitted */
+  uint64_t _full_size;
+  uint64_t _sent_size;
+  uint64_t _delta_count;
+
+  std::shared_ptr<spdlog::logger> _logger;
+
+  template <typename full_event, typename delta_event, typename key_type>
+  std::shared_ptr<io::data> _encode(
+      absl::flat_hash_map<key_type, typename full_event::pb_type>& last,
+      const key_type& key,
+      uint32_t key_fields,
+      const std::shared_ptr<io::data>& d);
+
+  template <typename full_event, typename delta_event, typename key_type>
+  std::shared_ptr<io::data> _decode(
+      absl::flat_hash_map<key_type, typename full_event::pb_type>& last,
+      const key_type& key,
+      const std::shared_ptr<io::data>& d);
+
+ public:
+  status_delta(const std::shared_ptr<spdlog::logger>& logger);
+  status_delta(const status_delta&) = delete;
+  status_delta& operator=(const status_delta&) = delete;
+
+  std::shared_ptr<io::data> encode(const std::shared_ptr<io::data>& d);
+  std::shared_ptr<io::data> decode(const std::shared_ptr<io::data>& d);
+
+  uint64_t get_full_size() const { return _full_size; }
+  uint64_t get_sent_size() const { return _sent_size; }
+  uint64_t get_delta_count() const { return _delta_count; }
+  void statistics(nlohmann::json& tree) const;
+};
+
+}  // namespace com::centreon::broker::bbdo
+
+#endif  // !CCB_BBDO_STATUS_DELTA_HH
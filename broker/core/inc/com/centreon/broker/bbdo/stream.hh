@@ -20,6 +20,7 @@
 #define CCB_BBDO_STREAM_HH
 
 #include "bbdo/bbdo/bbdo_version.hh"
+#include "com/centreon/broker/bbdo/status_delta.hh"
 #include "com/centreon/broker/io/extension.hh"
 #include "com/centreon/broker/io/raw.hh"
 #include "com/centreon/broker/io/stream.hh"
@@ -153,6 +154,12 @@ class stream : public io::stream {
   std::list<std::shared_ptr<io::extension>> _extensions;
   bbdo::bbdo_version _bbdo_version;
 
+  /**
+   * Set when the DELTA_STATUS extension is negotiated, statuses are delta
+   * encoded by write() on output streams and rebuilt by read() on input ones.
+   */
+  std::unique_ptr<status_delta> _status_delta;
+
   /* bbdo logger */
   std::shared_ptr<spdlog::logger> _logger;
 
@@ -162,6 +169,9 @@ class stream : public io::stream {
   std::string _get_extension_names(bool mandatory) const;
   std::string _poller_name;
   uint64_t _poller_id = 0u;
+  /* Last time the configuration acknowledgements to send were looked for. */
+  time_t _last_config_ack_check = 0;
+  void _send_config_ack();
   io::data* unserialize(uint32_t event_type,
                         uint32_t source_id,
                         uint32_t destination_id,
@@ -133,6 +133,7 @@ struct resource_info {
 class global_cache : public std::enable_shared_from_this<global_cache> {
  private:
   static std::shared_ptr<global_cache> _instance;
+  static std::atomic_uint64_t _generation;
   size_t _file_size;
 
   void _open(size_t initial_size_on_create, const void* address = 0);
@@ -154,6 +155,15 @@ class global_cache : public std::enable_shared_from_this<global_cache> {
 
   virtual void managed_map(bool create [[maybe_unused]]) {}
 
+  /**
+   * @brief must be called by writers each time a name, unit or severity
+   * really changes (not when the same value is stored again)
+   *
+   */
+  static void bump_generation() {
+    _generation.fetch_add(1, std::memory_order_release);
+  }
+
  public:
   using pointer = std::shared_ptr<global_cache>;
 
@@ -165,6 +175,18 @@ class global_cache : public std::enable_shared_from_this<global_cache> {
 
   static pointer instance_ptr() { return _instance; }
 
+  /**
+   * @brief this counter is incremented each time a label-like data (metric
+   * name or unit, resource name or severity) is created or modified. It allows
+   * readers to keep rendered data outside of the cache and to check, without
+   * any lock, that they are still valid.
+   *
+   * @return uint64_t
+   */
+  static uint64_t generation() {
+    return _generation.load(std::memory_order_acquire);
+  }
+
   virtual ~global_cache();
 
   /**
@@ -20,6 +20,7 @@
 #define CCB_CONFIG_APPLIER_STATE_HH
 
 #include <absl/container/flat_hash_map.h>
+#include <optional>
 
 #include "com/centreon/broker/config/applier/modules.hh"
 #include "com/centreon/broker/config/state.hh"
@@ -48,6 +49,7 @@ class state {
   bbdo::bbdo_version _bbdo_version;
   std::string _poller_name;
   size_t _pool_size;
+  bool _segmented_queue_files;
   modules _modules;
 
   static stats _stats_conf;
@@ -55,6 +57,13 @@ class state {
   absl::flat_hash_map<uint64_t, std::string> _connected_pollers;
   mutable std::mutex _connected_pollers_m;
 
+  /* Configuration acknowledgements (see bbdo::pb_config_ack). On broker, the
+   * fingerprints to send to each poller. On cbmod, the last fingerprint
+   * received from broker. */
+  absl::flat_hash_map<uint64_t, uint64_t> _config_acks_to_send;
+  std::optional<uint64_t> _config_ack_received;
+  std::mutex _config_acks_m;
+
   state(const std::shared_ptr<spdlog::logger>& logger);
   ~state() noexcept = default;
 
@@ -72,11 +81,16 @@ class state {
   bbdo::bbdo_version get_bbdo_version() const noexcept;
   uint32_t poller_id() const noexcept;
   size_t pool_size() const noexcept;
+  bool segmented_queue_files() const noexcept;
   const std::string& poller_name() const noexcept;
   modules& get_modules();
   void add_poller(uint64_t poller_id, const std::string& poller_name);
   void remove_poller(uint64_t poller_id);
   bool has_connection_from_poller(uint64_t poller_id) const;
+  void add_config_ack(uint64_t poller_id, uint64_t fingerprint);
+  std::optional<uint64_t> pop_config_ack(uint64_t poller_id);
+  void set_config_ack_received(uint64_t fingerprint);
+  std::optional<uint64_t> pop_config_ack_received();
   static stats& mut_stats_conf();
   static const stats& stats_conf();
 };
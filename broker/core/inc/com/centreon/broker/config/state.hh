@@ -47,6 +47,10 @@ class state {
   std::string _command_protocol;
   std::list<endpoint> _endpoints;
   int _event_queue_max_size;
+  int _neb_events_batch_size;
+  int _neb_events_batch_latency;
+  int _latency_sampling;
+  std::string _queue_files_backend;
   std::string _module_dir;
   std::list<std::string> _module_list;
   std::map<std::string, std::string> _params;
@@ -117,6 +121,14 @@ class state {
   std::list<endpoint> const& endpoints() const noexcept;
   void event_queue_max_size(int val) noexcept;
   int event_queue_max_size() const noexcept;
+  void neb_events_batch_size(int val) noexcept;
+  int neb_events_batch_size() const noexcept;
+  void neb_events_batch_latency(int val) noexcept;
+  int neb_events_batch_latency() const noexcept;
+  void latency_sampling(int val) noexcept;
+  int latency_sampling() const noexcept;
+  void queue_files_backend(const std::string& backend);
+  const std::string& queue_files_backend() const noexcept;
   std::string const& module_directory() const noexcept;
   void module_directory(std::string const& dir);
   std::list<std::string>& module_list() noexcept;
@@ -18,6 +18,8 @@
 
 #ifndef CCB_FILE_DISK_ACCESSOR_HH
 #define CCB_FILE_DISK_ACCESSOR_HH
+#include <sys/uio.h>
+
 #include <atomic>
 
 namespace com::centreon::broker {
@@ -49,6 +51,9 @@ class disk_accessor {
   void remove(const std::string& name);
   fd fopen(const std::string& name, const char* mode);
   void fclose(fd f);
+  int allocate(int fd, off_t size);
+  ssize_t pwritev(int fd, const struct iovec* iov, int iovcnt, off_t offset);
+  ssize_t pread(int fd, void* buf, size_t count, off_t offset);
 };
 }  // namespace file
 
@@ -0,0 +1,114 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_FILE_SEGMENT_SPLITTER_HH
+#define CCB_FILE_SEGMENT_SPLITTER_HH
+
+#include "com/centreon/broker/file/splitted_file.hh"
+
+namespace com::centreon::broker::file {
+/**
+ *  @class segment_splitter segment_splitter.hh
+ * "com/centreon/broker/file/segment_splitter.hh"
+ *  @brief Queue file made of preallocated segments.
+ *
+ *  This is an alternative to splitter for queue files. The logical file is
+ *  made of segments named like the base path followed by ".seg" and the
+ *  segment number. Each segment is allocated with its full size when created
+ *  and begins with a header page. The header contains the offset of the end
+ *  of written data, data begin after the header page.
+ *
+ *  Written data are accumulated in a buffer, they are written with a single
+ *  pwritev() call when the buffer is full. A write of a big block is done
+ *  directly from the caller buffer with the buffer content, without copy.
+ *
+ *  The end of data on disk is published in _published as
+ *  (segment id << 32 | offset). The reader loads it without locking, so as
+ *  long as it is late, reading does not need _write_m. This mutex is only
+ *  locked by the reader when it reached the published end, to flush the
+ *  buffer or to remove an entirely read file.
+ */
+class segment_splitter : public splitted_file {
+ public:
+  struct header {
+    char magic[8];
+    uint64_t data_end;
+  };
+  /* Data begin after the header page. */
+  static constexpr uint32_t header_size = 4096u;
+  static constexpr size_t write_batch_size = 1024u * 1024u;
+
+ private:
+  const bool _auto_delete;
+  const std::string _base_path;
+  const uint32_t _max_file_size;
+  const size_t _batch_size;
+
+  /* Reader side, there is only one consumer. */
+  int _rfd;
+  int32_t _rid;
+  uint32_t _roffset;
+  /* End of data of the read segment once known, 0 otherwise. */
+  uint32_t _rend;
+
+  std::mutex _write_m;
+  int _wfd;
+  std::atomic_int _wid;
+  uint32_t _wcapacity;
+  /* End of data written in the current write segment, _buffer excluded. */
+  uint32_t _woffset;
+  std::vector<char> _buffer;
+  std::atomic_uint64_t _published;
+
+  void _publish();
+  void _open_write_segment();
+  void _close_write_segment();
+  void _write_batch(const void* data, size_t size);
+  void _write_header(uint32_t data_end);
+  bool _open_read_segment();
+  void _close_read_segment();
+  uint32_t _read_data_end();
+
+ public:
+  segment_splitter(const std::string& path,
+                   uint32_t max_file_size = 100000000u,
+                   bool auto_delete = false);
+  ~segment_splitter() noexcept;
+  segment_splitter(const segment_splitter&) = delete;
+  segment_splitter& operator=(const segment_splitter&) = delete;
+  void close() override final;
+  long read(void* buffer, long max_size) override;
+  void remove_all_files() override;
+  void seek(long offset,
+            fs_file::seek_whence whence = fs_file::seek_start) override;
+  long tell() override;
+  long write(void const* buffer, long size) override;
+  void flush() override;
+
+  std::string get_file_path(int id = 0) const override;
+  int32_t get_rid() const override;
+  long get_roffset() const override;
+  int32_t get_wid() const override;
+  long get_woffset() const override;
+  size_t max_file_size() const override;
+
+  static bool exists(const std::string& path);
+};
+}  // namespace com::centreon::broker::file
+
+#endif  // !CCB_FILE_SEGMENT_SPLITTER_HH
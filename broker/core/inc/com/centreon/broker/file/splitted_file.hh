@@ -0,0 +1,49 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_FILE_SPLITTED_FILE_HH
+#define CCB_FILE_SPLITTED_FILE_HH
+
+#include "com/centreon/broker/file/fs_file.hh"
+
+namespace com::centreon::broker::file {
+/**
+ *  @class splitted_file splitted_file.hh
+ * "com/centreon/broker/file/splitted_file.hh"
+ *  @brief Interface of a logical file made of several real files.
+ *
+ *  It is implemented by splitter (stdio files) and segment_splitter
+ *  (preallocated segments). The file stream works with both of them.
+ */
+class splitted_file : public fs_file {
+ public:
+  splitted_file() = default;
+  virtual ~splitted_file() noexcept = default;
+  splitted_file(const splitted_file&) = delete;
+  splitted_file& operator=(const splitted_file&) = delete;
+  virtual void remove_all_files() = 0;
+  virtual std::string get_file_path(int id = 0) const = 0;
+  virtual int32_t get_rid() const = 0;
+  virtual long get_roffset() const = 0;
+  virtual int32_t get_wid() const = 0;
+  virtual long get_woffset() const = 0;
+  virtual size_t max_file_size() const = 0;
+};
+}  // namespace com::centreon::broker::file
+
+#endif  // !CCB_FILE_SPLITTED_FILE_HH
@@ -19,7 +19,7 @@
 #ifndef CCB_FILE_SPLITTER_HH
 #define CCB_FILE_SPLITTER_HH
 
-#include "com/centreon/broker/file/fs_file.hh"
+#include "com/centreon/broker/file/splitted_file.hh"
 
 namespace com::centreon::broker::file {
 /**
@@ -59,7 +59,7 @@ namespace com::centreon::broker::file {
  *
  *  _woffset and _roffset are offsets from the files begin to write or read.
  */
-class splitter : public fs_file {
+class splitter : public splitted_file {
   bool _auto_delete;
   std::string _base_path;
   const uint32_t _max_file_size;
@@ -84,19 +84,21 @@ class splitter : public fs_file {
   splitter& operator=(const splitter&) = delete;
   void close() override final;
   long read(void* buffer, long max_size) override;
-  void remove_all_files();
+  void remove_all_files() override;
   void seek(long offset,
             fs_file::seek_whence whence = fs_file::seek_start) override;
   long tell() override;
   long write(void const* buffer, long size) override;
   void flush() override;
 
-  std::string get_file_path(int id = 0) const;
-  int32_t get_rid() const;
-  long get_roffset() const;
-  int32_t get_wid() const;
-  long get_woffset() const;
-  size_t max_file_size() const;
+  std::string get_file_path(int id = 0) const override;
+  int32_t get_rid() const override;
+  long get_roffset() const override;
+  int32_t get_wid() const override;
+  long get_woffset() const override;
+  size_t max_file_size() const override;
+
+  static bool exists(const std::string& path);
 };
 }  // namespace com::centreon::broker::file
 
@@ -20,7 +20,7 @@
 #define CCB_FILE_STREAM_HH
 
 #include "broker.pb.h"
-#include "com/centreon/broker/file/splitter.hh"
+#include "com/centreon/broker/file/splitted_file.hh"
 #include "com/centreon/broker/io/stream.hh"
 #include "com/centreon/broker/stats/center.hh"
 
@@ -32,7 +32,7 @@ namespace com::centreon::broker::file {
  *  Read and write data to a stream.
  */
 class stream : public io::stream {
-  splitter _splitter;
+  std::unique_ptr<splitted_file> _splitter;
   QueueFileStats* _stats;
   std::time_t _last_stats;
   std::time_t _last_stats_perc;
@@ -50,7 +50,8 @@ class stream : public io::stream {
   stream(const std::string& path,
          QueueFileStats* s,
          uint32_t max_file_size = 100000000u,
-         bool auto_delete = false);
+         bool auto_delete = false,
+         bool segmented = false);
   ~stream() noexcept = default;
   stream(const stream&) = delete;
   stream& operator=(const stream&) = delete;
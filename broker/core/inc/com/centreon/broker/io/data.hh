@@ -68,6 +68,10 @@ class data {
 
   uint32_t source_id;
   uint32_t destination_id;
+  /* Steady clock time in nanoseconds when this event was published in the
+   * multiplexing engine if it is sampled for latency statistics, 0 otherwise.
+   * It is neither copied nor serialized. */
+  int64_t sampled_at;
 
   static uint32_t broker_id;
 };
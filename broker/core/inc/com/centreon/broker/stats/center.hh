@@ -21,6 +21,7 @@
 
 #include <absl/synchronization/mutex.h>
 #include "broker.pb.h"
+#include "com/centreon/broker/stats/latency_histogram.hh"
 
 namespace com::centreon::broker::stats {
 /**
@@ -64,11 +65,18 @@ class center {
   EngineStats* register_engine() ABSL_LOCKS_EXCLUDED(_stats_m);
   ConflictManagerStats* register_conflict_manager()
       ABSL_LOCKS_EXCLUDED(_stats_m);
+  BamAvailabilityStats* register_bam_availability()
+      ABSL_LOCKS_EXCLUDED(_stats_m);
   void unregister_muxer(const std::string& name) ABSL_LOCKS_EXCLUDED(_stats_m);
   void update_muxer(std::string name,
                     std::string queue_file,
                     uint32_t size,
                     uint32_t unack) ABSL_LOCKS_EXCLUDED(_stats_m);
+  void update_muxer_latency(const std::string& name,
+                            latency_histogram& enqueue,
+                            latency_histogram& read,
+                            latency_histogram& ack)
+      ABSL_LOCKS_EXCLUDED(_stats_m);
   void init_queue_file(std::string muxer,
                        std::string queue_file,
                        uint32_t max_file_size) ABSL_LOCKS_EXCLUDED(_stats_m);
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_STATS_LATENCY_HISTOGRAM_HH
+#define CCB_STATS_LATENCY_HISTOGRAM_HH
+
+#include "broker.pb.h"
+
+namespace com::centreon::broker::stats {
+/**
+ * @brief Histogram of latencies expressed in microseconds.
+ *
+ * Buckets are organized as in HDR histograms: each power of two is split in
+ * 2^sub_bucket_bits linear sub-buckets, so the relative error of a recorded
+ * value is less than 1 / 2^sub_bucket_bits whatever its magnitude. Values
+ * greater than 2^max_exponent microseconds (about 19 hours) are stored in
+ * the last bucket.
+ *
+ * Counters are atomics updated with relaxed ordering, so record() never
+ * blocks and can be called concurrently from several threads. Readers may see
+ * a slightly inconsistent snapshot, which is fine for statistics.
+ *
+ * The histogram is meant to be windowed: fill_and_reset() exports the values
+ * recorded since the previous call and starts a new window.
+ */
+class latency_histogram {
+ public:
+  static constexpr uint32_t sub_bucket_bits = 3;
+  static constexpr uint32_t sub_bucket_count = 1u << sub_bucket_bits;
+  static constexpr uint32_t max_exponent = 36;
+  static constexpr uint32_t bucket_count =
+      (max_exponent - sub_bucket_bits + 2) * sub_bucket_count;
+
+ private:
+  std::array<std::atomic_uint64_t, bucket_count> _buckets;
+  std::atomic_uint64_t _count;
+  std::atomic_uint64_t _max;
+
+  using snapshot = std::array<uint64_t, bucket_count>;
+  static uint64_t _percentile(const snapshot& buckets,
+                              uint64_t total,
+                              uint64_t max,
+                              double p) noexcept;
+  static void _fill(StageLatency* stats,
+                    const snapshot& buckets,
+                    uint64_t total,
+                    uint64_t max) noexcept;
+
+ public:
+  latency_histogram();
+  latency_histogram(const latency_histogram&) = delete;
+  latency_histogram& operator=(const latency_histogram&) = delete;
+
+  static uint32_t bucket_index(uint64_t value) noexcept;
+  static uint64_t bucket_value(uint32_t index) noexcept;
+
+  void record(uint64_t value) noexcept;
+  uint64_t count() const noexcept;
+  uint64_t max() const noexcept;
+  uint64_t percentile(double p) const noexcept;
+  void fill(StageLatency* stats) const noexcept;
+  void fill_and_reset(StageLatency* stats) noexcept;
+};
+
+}  // namespace com::centreon::broker::stats
+
+#endif  // !CCB_STATS_LATENCY_HISTOGRAM_HH
@@ -64,6 +64,7 @@ class callback_caller;
 class engine {
   static absl::Mutex _load_m;
   static std::shared_ptr<engine> _instance;
+  static std::atomic_uint32_t _latency_sampling;
 
   enum state { not_started, running, stopped };
 
@@ -76,6 +77,7 @@ class engine {
   state _state ABSL_GUARDED_BY(_kiew_m);
   std::deque<std::shared_ptr<io::data>> _kiew ABSL_GUARDED_BY(_kiew_m);
   uint32_t _unprocessed_events ABSL_GUARDED_BY(_kiew_m);
+  uint32_t _sampling_counter ABSL_GUARDED_BY(_kiew_m);
 
   // Subscriber.
   std::vector<std::weak_ptr<muxer>> _muxers ABSL_GUARDED_BY(_kiew_m);
@@ -91,6 +93,7 @@ class engine {
   engine(const std::shared_ptr<spdlog::logger>& logger);
   std::string _cache_file_path() const;
   bool _send_to_subscribers(send_to_mux_callback_type&& callback);
+  void _sample(io::data& d) ABSL_EXCLUSIVE_LOCKS_REQUIRED(_kiew_m);
 
   friend class detail::callback_caller;
 
@@ -98,6 +101,8 @@ class engine {
   static void load() ABSL_LOCKS_EXCLUDED(_load_m);
   static void unload() ABSL_LOCKS_EXCLUDED(_load_m);
   static std::shared_ptr<engine> instance_ptr();
+  static void latency_sampling(uint32_t rate) noexcept;
+  static uint32_t latency_sampling() noexcept;
 
   engine(const engine&) = delete;
   engine& operator=(const engine&) = delete;
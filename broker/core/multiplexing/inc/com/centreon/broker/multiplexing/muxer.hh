@@ -26,6 +26,7 @@
 #include "com/centreon/broker/multiplexing/engine.hh"
 #include "com/centreon/broker/multiplexing/muxer_filter.hh"
 #include "com/centreon/broker/persistent_file.hh"
+#include "com/centreon/broker/stats/latency_histogram.hh"
 
 namespace com::centreon::broker::multiplexing {
 /**
@@ -86,6 +87,16 @@ class muxer : public io::stream, public std::enable_shared_from_this<muxer> {
 
   std::shared_ptr<stats::center> _center;
   std::time_t _last_stats;
+  std::time_t _last_latency_stats;
+
+  /* Latencies of the events sampled by the engine, from their publication in
+   * the engine to their push in this muxer, their read by the endpoint and
+   * their acknowledgement. They are exported and emptied every
+   * _latency_window seconds, so the statistics describe the last window. */
+  static constexpr std::time_t _latency_window = 60;
+  stats::latency_histogram _enqueue_latency;
+  stats::latency_histogram _read_latency;
+  stats::latency_histogram _ack_latency;
 
   /* The map of running muxers with the mutex to protect it. */
   static absl::Mutex _running_muxers_m;
@@ -102,6 +113,8 @@ class muxer : public io::stream, public std::enable_shared_from_this<muxer> {
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(_events_m);
 
   void _update_stats(void) noexcept ABSL_EXCLUSIVE_LOCKS_REQUIRED(_events_m);
+  static void _record_latency(stats::latency_histogram& histogram,
+                              const std::shared_ptr<io::data>& event) noexcept;
 
   muxer(std::string name,
         const std::shared_ptr<engine>& parent,
@@ -172,6 +185,7 @@ bool muxer::read(container& to_fill, size_t max_to_read) noexcept {
 
   size_t nb_read = 0;
   while (_pos != _events.end() && nb_read < max_to_read) {
+    _record_latency(_read_latency, *_pos);
     to_fill.push_back(*_pos);
     ++_pos;
     ++nb_read;
@@ -37,6 +37,7 @@ using log_v2 = com::centreon::common::log_v2::log_v2;
 // Class instance.
 std::shared_ptr<engine> engine::_instance{nullptr};
 absl::Mutex engine::_load_m;
+std::atomic_uint32_t engine::_latency_sampling{128};
 
 /**
  *  Get engine instance.
@@ -47,6 +48,41 @@ std::shared_ptr<engine> engine::instance_ptr() {
   return _instance;
 }
 
+/**
+ * @brief Set the latency sampling rate: one published event out of rate is
+ * timestamped so that muxers can measure its latency. 0 disables sampling.
+ *
+ * @param rate The sampling rate.
+ */
+void engine::latency_sampling(uint32_t rate) noexcept {
+  _latency_sampling = rate;
+}
+
+/**
+ * @brief Get the latency sampling rate.
+ *
+ * @return The sampling rate.
+ */
+uint32_t engine::latency_sampling() noexcept {
+  return _latency_sampling;
+}
+
+/**
+ * @brief Timestamp the given event if it is chosen by the sampling. The
+ * timestamp is then used by muxers to fill their latency histograms.
+ *
+ * @param d The event published.
+ */
+void engine::_sample(io::data& d) {
+  uint32_t rate = _latency_sampling;
+  if (rate && ++_sampling_counter >= rate) {
+    _sampling_counter = 0;
+    d.sampled_at = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                       .count();
+  }
+}
+
 /**
  * @brief Load engine instance. The argument is the total size allowed for
  * queue files.
@@ -111,10 +147,12 @@ void engine::publish(const std::shared_ptr<io::data>& e) {
         break;
       case not_started:
         SPDLOG_LOGGER_TRACE(_logger, "engine::publish one event to queue");
+        _sample(*e);
         _kiew.push_back(e);
         break;
       default:
         SPDLOG_LOGGER_TRACE(_logger, "engine::publish one event to queue_");
+        _sample(*e);
         _kiew.push_back(e);
         have_to_send = true;
         break;
@@ -141,14 +179,18 @@ void engine::publish(const std::deque<std::shared_ptr<io::data>>& to_publish) {
       case not_started:
         SPDLOG_LOGGER_TRACE(_logger, "engine::publish {} event to queue",
                             to_publish.size());
-        for (auto& e : to_publish)
+        for (auto& e : to_publish) {
+          _sample(*e);
           _kiew.push_back(e);
+        }
         break;
       default:
         SPDLOG_LOGGER_TRACE(_logger, "engine::publish {} event to queue_",
                             to_publish.size());
-        for (auto& e : to_publish)
+        for (auto& e : to_publish) {
+          _sample(*e);
           _kiew.push_back(e);
+        }
         have_to_send = true;
         break;
     }
@@ -296,6 +338,7 @@ void engine::unsubscribe_muxer(const muxer* subscriber) {
 engine::engine(const std::shared_ptr<spdlog::logger>& logger)
     : _state{not_started},
       _unprocessed_events{0u},
+      _sampling_counter{0u},
       _center{stats::center::instance_ptr()},
       _stats{_center->register_engine()},
       _sending_to_subscribers{false},
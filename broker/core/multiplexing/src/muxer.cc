@@ -92,6 +92,7 @@ muxer::muxer(std::string name,
       _events_size{0u},
       _center{stats::center::instance_ptr()},
       _last_stats{std::time(nullptr)},
+      _last_latency_stats{_last_stats},
       _logger{log_v2::instance().get(log_v2::CORE)} {
   absl::SetMutexDeadlockDetectionMode(absl::OnDeadlockCycle::kAbort);
   absl::EnableMutexInvariantDebugging(true);
@@ -247,6 +248,7 @@ void muxer::ack_events(int count) {
             _name, _events_size, count, i);
         break;
       }
+      _record_latency(_ack_latency, _events.front());
       _events.pop_front();
       --_events_size;
     }
@@ -383,6 +385,7 @@ void muxer::publish(const std::deque<std::shared_ptr<io::data>>& event_queue) {
 
         at_least_one_push_to_queue = true;
 
+        _record_latency(_enqueue_latency, event);
         _push_to_queue(event);
       }
       _logger->trace("muxer::publish ({}) loop finished", _name);
@@ -423,6 +426,7 @@ void muxer::publish(const std::deque<std::shared_ptr<io::data>>& event_queue) {
         _file = std::make_unique<persistent_file>(_queue_file_name, s);
       }
       try {
+        _record_latency(_enqueue_latency, event);
         _file->write(event);
         SPDLOG_LOGGER_TRACE(
             _logger,
@@ -468,6 +472,7 @@ bool muxer::read(std::shared_ptr<io::data>& event, time_t deadline) {
     if (_pos != _events.end()) {
       event = *_pos;
       ++_pos;
+      _record_latency(_read_latency, event);
       if (event)
         timed_out = false;
     } else
@@ -477,6 +482,7 @@ bool muxer::read(std::shared_ptr<io::data>& event, time_t deadline) {
   else {
     event = *_pos;
     ++_pos;
+    _record_latency(_read_latency, event);
   }
 
   _update_stats();
@@ -733,6 +739,28 @@ void muxer::_update_stats() noexcept {
      * object asynchronously. */
     _center->update_muxer(_name, _file ? _queue_file_name : "", _events_size,
                           std::distance(_events.begin(), _pos));
+    if (now - _last_latency_stats >= _latency_window) {
+      _last_latency_stats = now;
+      _center->update_muxer_latency(_name, _enqueue_latency, _read_latency,
+                                    _ack_latency);
+    }
+  }
+}
+
+/**
+ * @brief If the event has been sampled by the engine, add to the histogram
+ * the time elapsed since its publication.
+ *
+ * @param histogram The histogram of the current stage.
+ * @param event The event.
+ */
+void muxer::_record_latency(stats::latency_histogram& histogram,
+                            const std::shared_ptr<io::data>& event) noexcept {
+  if (event && event->sampled_at) {
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count();
+    histogram.record(std::max<int64_t>(now - event->sampled_at, 0) / 1000);
   }
 }
 
@@ -309,6 +309,7 @@ class mysql_bulk_bind : public mysql_bind_base {
   size_t rows_count() const;
 
   size_t current_row() const;
+  void set_current_row(size_t row);
   void next_row();
   void reserve(size_t size);
 };
@@ -197,3 +197,15 @@ void mysql_bulk_bind::reserve(size_t size) {
 void mysql_bulk_bind::next_row() {
   ++_current_row;
 }
+
+/**
+ * @brief Move the current row index back to an already filled row, so that
+ * its values can be replaced. The index must not be greater than the rows
+ * count.
+ *
+ * @param row The row index.
+ */
+void mysql_bulk_bind::set_current_row(size_t row) {
+  assert(row <= rows_count());
+  _current_row = row;
+}
@@ -21,6 +21,7 @@
 #include "com/centreon/broker/bbdo/acceptor.hh"
 #include "com/centreon/broker/bbdo/connector.hh"
 #include "com/centreon/broker/bbdo/factory.hh"
+#include "com/centreon/broker/bbdo/status_delta.hh"
 #include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/config/parser.hh"
 #include "com/centreon/broker/io/protocols.hh"
@@ -106,6 +107,22 @@ io::endpoint* factory::new_endpoint(
     if (it == cfg.params.end() || it->second != "no")
       negotiate = true;
     extensions = _extensions(cfg);
+
+    /* Delta encoding of statuses: input endpoints are always able to decode
+     * them, output ones encode them only if it is configured. */
+    bool delta_status = cfg.get_io_type() == config::endpoint::input;
+    it = cfg.params.find("delta_status");
+    if (!delta_status && it != cfg.params.end() &&
+        !absl::SimpleAtob(it->second, &delta_status)) {
+      logger->error(
+          "factory: cannot parse the 'delta_status' boolean: the content is "
+          "'{}'",
+          it->second);
+      delta_status = false;
+    }
+    if (delta_status && !grpc_serialized)
+      extensions.push_back(std::make_shared<io::extension>(
+          std::string(status_delta::extension_name), true, false));
   }
 
   // Ack limit.
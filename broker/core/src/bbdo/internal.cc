@@ -54,6 +54,8 @@ void bbdo::load() {
                    &bbdo::pb_ack::operations);
   e.register_event(make_type(io::bbdo, bbdo::de_pb_stop), "Stop",
                    &bbdo::pb_stop::operations);
+  e.register_event(make_type(io::bbdo, bbdo::de_pb_config_ack), "ConfigAck",
+                   &bbdo::pb_config_ack::operations);
   e.register_event(make_type(io::local, local::de_pb_stop), "LocStop",
                    &local::pb_stop::operations);
 
@@ -0,0 +1,272 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/bbdo/status_delta.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::bbdo;
+
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+using google::protobuf::RepeatedField;
+
+/**
+ * @brief compare a singular field of two messages of the same type
+ *
+ * @return true if values are equal
+ */
+static bool field_equals(const Reflection* refl,
+                         const Message& left,
+                         const Message& right,
+                         const FieldDescriptor* f) {
+  switch (f->cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+      return refl->GetInt32(left, f) == refl->GetInt32(right, f);
+    case FieldDescriptor::CPPTYPE_INT64:
+      return refl->GetInt64(left, f) == refl->GetInt64(right, f);
+    case FieldDescriptor::CPPTYPE_UINT32:
+      return refl->GetUInt32(left, f) == refl->GetUInt32(right, f);
+    case FieldDescriptor::CPPTYPE_UINT64:
+      return refl->GetUInt64(left, f) == refl->GetUInt64(right, f);
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      return refl->GetDouble(left, f) == refl->GetDouble(right, f);
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      return refl->GetFloat(left, f) == refl->GetFloat(right, f);
+    case FieldDescriptor::CPPTYPE_BOOL:
+      return refl->GetBool(left, f) == refl->GetBool(right, f);
+    case FieldDescriptor::CPPTYPE_ENUM:
+      return refl->GetEnumValue(left, f) == refl->GetEnumValue(right, f);
+    case FieldDescriptor::CPPTYPE_STRING: {
+      std::string left_scratch, right_scratch;
+      return refl->GetStringReference(left, f, &left_scratch) ==
+             refl->GetStringReference(right, f, &right_scratch);
+    }
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief compute current - previous
+ *
+ * @param previous last status transmitted
+ * @param current status to transmit
+ * @param key_fields fields with a number lower or equal are always kept in
+ * changes (host_id, service_id)
+ * @param changes filled with current fields that differ from previous
+ * @param cleared filled with the numbers of the fields reset to their default
+ * value
+ * @return false if the message contains fields that can't be delta encoded
+ */
+static bool make_delta(const Message& previous,
+                       const Message& current,
+                       uint32_t key_fields,
+                       Message& changes,
+                       RepeatedField<uint32_t>& cleared) {
+  const google::protobuf::Descriptor* desc = current.GetDescriptor();
+  const Reflection* refl = current.GetReflection();
+  changes.CopyFrom(current);
+  for (int i = 0; i < desc->field_count(); ++i) {
+    const FieldDescriptor* f = desc->field(i);
+    if (f->is_repeated() || f->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE)
+      return false;
+    if (static_cast<uint32_t>(f->number()) <= key_fields)
+      continue;
+    if (field_equals(refl, previous, current, f))
+      refl->ClearField(&changes, f);
+    else if (!refl->HasField(current, f))
+      cleared.Add(f->number());
+  }
+  return true;
+}
+
+/**
+ * @brief apply a delta to the last status received
+ *
+ */
+static void apply_delta(Message& previous,
+                        const Message& changes,
+                        const RepeatedField<uint32_t>& cleared) {
+  // in proto3, MergeFrom only copies singular fields that are not default
+  previous.MergeFrom(changes);
+  const google::protobuf::Descriptor* desc = previous.GetDescriptor();
+  const Reflection* refl = previous.GetReflection();
+  for (uint32_t field_number : cleared) {
+    const FieldDescriptor* f = desc->FindFieldByNumber(field_number);
+    if (f)
+      refl->ClearField(&previous, f);
+  }
+}
+
+status_delta::status_delta(const std::shared_ptr<spdlog::logger>& logger)
+    : _full_size{0}, _sent_size{0}, _delta_count{0}, _logger{logger} {}
+
+/**
+ * @brief replace d by a delta event if it's smaller
+ *
+ * @param last last status sent per resource
+ * @param key resource key
+ * @param key_fields number of the last field of the key
+ * @param d full event
+ * @return std::shared_ptr<io::data> d or a delta event
+ */
+template <typename full_event, typename delta_event, typename key_type>
+std::shared_ptr<io::data> status_delta::_encode(
+    absl::flat_hash_map<key_type, typename full_event::pb_type>& last,
+    const key_type& key,
+    uint32_t key_fields,
+    const std::shared_ptr<io::data>& d) {
+  const typename full_event::pb_type& current =
+      std::static_pointer_cast<full_event>(d)->obj();
+  size_t full_size = current.ByteSizeLong();
+  _full_size += full_size;
+
+  auto found = last.find(key);
+  if (found == last.end()) {
+    last.emplace(key, current);
+    _sent_size += full_size;
+    return d;
+  }
+
+  auto delta = std::make_shared<delta_event>();
+  delta->source_id = d->source_id;
+  delta->destination_id = d->destination_id;
+  bool can_delta =
+      make_delta(found->second, current, key_fields,
+                 *delta->mut_obj().mutable_changes(),
+                 *delta->mut_obj().mutable_cleared_fields());
+  found->second.CopyFrom(current);
+
+  size_t delta_size = can_delta ? delta->obj().ByteSizeLong() : full_size;
+  if (delta_size >= full_size) {
+    _sent_size += full_size;
+    return d;
+  }
+  _sent_size += delta_size;
+  ++_delta_count;
+  return delta;
+}
+
+/**
+ * @brief rebuild a full event from a delta one
+ *
+ * @param last last status received per resource
+ * @param key resource key
+ * @param d delta event
+ * @return std::shared_ptr<io::data> the full event, d if there is no
+ * previous status for this resource
+ */
+template <typename full_event, typename delta_event, typename key_type>
+std::shared_ptr<io::data> status_delta::_decode(
+    absl::flat_hash_map<key_type, typename full_event::pb_type>& last,
+    const key_type& key,
+    const std::shared_ptr<io::data>& d) {
+  const auto& delta = std::static_pointer_cast<delta_event>(d)->obj();
+  auto found = last.find(key);
+  if (found == last.end()) {
+    SPDLOG_LOGGER_ERROR(_logger,
+                        "BBDO: delta status of type {:x} received for an "
+                        "unknown resource of host {}, it is ignored",
+                        d->type(), delta.changes().host_id());
+    return d;
+  }
+  apply_delta(found->second, delta.changes(), delta.cleared_fields());
+  _sent_size += delta.ByteSizeLong();
+  _full_size += found->second.ByteSizeLong();
+  ++_delta_count;
+  return std::make_shared<full_event>(found->second, d->source_id,
+                                      d->destination_id);
+}
+
+/**
+ * @brief output side: replaces ServiceStatus and HostStatus events by delta
+ * events when possible, other events are returned as is.
+ *
+ * @param d event to send
+ * @return std::shared_ptr<io::data> event to serialize
+ */
+std::shared_ptr<io::data> status_delta::encode(
+    const std::shared_ptr<io::data>& d) {
+  switch (d->type()) {
+    case pb_service_status::static_type(): {
+      const ServiceStatus& ss =
+          std::static_pointer_cast<pb_service_status>(d)->obj();
+      return _encode<pb_service_status, pb_service_status_delta>(
+          _services, std::make_pair(ss.host_id(), ss.service_id()),
+          ServiceStatus::kServiceIdFieldNumber, d);
+    }
+    case pb_host_status::static_type():
+      return _encode<pb_host_status, pb_host_status_delta>(
+          _hosts, std::static_pointer_cast<pb_host_status>(d)->obj().host_id(),
+          HostStatus::kHostIdFieldNumber, d);
+    default:
+      return d;
+  }
+}
+
+/**
+ * @brief input side: keeps the last ServiceStatus and HostStatus received and
+ * rebuilds full events from delta ones, other events are returned as is.
+ *
+ * @param d received event
+ * @return std::shared_ptr<io::data> event to publish
+ */
+std::shared_ptr<io::data> status_delta::decode(
+    const std::shared_ptr<io::data>& d) {
+  switch (d->type()) {
+    case pb_service_status::static_type(): {
+      const ServiceStatus& ss =
+          std::static_pointer_cast<pb_service_status>(d)->obj();
+      _services[std::make_pair(ss.host_id(), ss.service_id())] = ss;
+      return d;
+    }
+    case pb_service_status_delta::static_type(): {
+      const ServiceStatus& changes =
+          std::static_pointer_cast<pb_service_status_delta>(d)->obj().changes();
+      return _decode<pb_service_status, pb_service_status_delta>(
+          _services, std::make_pair(changes.host_id(), changes.service_id()),
+          d);
+    }
+    case pb_host_status::static_type(): {
+      const HostStatus& hs = std::static_pointer_cast<pb_host_status>(d)->obj();
+      _hosts[hs.host_id()] = hs;
+      return d;
+    }
+    case pb_host_status_delta::static_type():
+      return _decode<pb_host_status, pb_host_status_delta>(
+          _hosts,
+          std::static_pointer_cast<pb_host_status_delta>(d)
+              ->obj()
+              .changes()
+              .host_id(),
+          d);
+    default:
+      return d;
+  }
+}
+
+/**
+ * @brief fill stream statistics with the bandwidth saved by delta encoding
+ *
+ */
+void status_delta::statistics(nlohmann::json& tree) const {
+  tree["bbdo_delta_status_events"] = static_cast<double>(_delta_count);
+  tree["bbdo_delta_status_full_size"] = static_cast<double>(_full_size);
+  tree["bbdo_delta_status_sent_size"] = static_cast<double>(_sent_size);
+}
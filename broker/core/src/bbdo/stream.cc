@@ -896,6 +896,17 @@ void stream::negotiate(stream::negotiation_type neg) {
   for (auto& ext : _extensions) {
     // Find matching extension in peer extension list.
     auto peer_it{std::find(peer_ext.begin(), peer_ext.end(), ext->name())};
+    // DELTA_STATUS is not a substream, it is applied by this stream.
+    if (ext->name() == status_delta::extension_name) {
+      if (peer_it != peer_ext.end() && !_grpc_serialized &&
+          _bbdo_version.major_v >= 3) {
+        SPDLOG_LOGGER_INFO(_logger, "BBDO: applying extension '{}'",
+                           ext->name());
+        _status_delta = std::make_unique<status_delta>(_logger);
+      } else
+        _status_delta.reset();
+      continue;
+    }
     // Apply extension if found.
     if (peer_it != peer_ext.end()) {
       if (std::find(running_config.begin(), running_config.end(),
@@ -1068,6 +1079,19 @@ bool stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
         multiplexing::publisher pblshr;
         pblshr.write(loc_stop);
       } break;
+      case pb_config_ack::static_type(): {
+        const ConfigAck& config_ack =
+            std::static_pointer_cast<const pb_config_ack>(d)->obj();
+        SPDLOG_LOGGER_INFO(
+            _logger,
+            "BBDO: received configuration acknowledgement {:016x} for poller "
+            "{}",
+            config_ack.config_fingerprint(), config_ack.poller_id());
+        if (config_ack.poller_id() ==
+            config::applier::state::instance().poller_id())
+          config::applier::state::instance().set_config_ack_received(
+              config_ack.config_fingerprint());
+      } break;
       default:
         break;
     }
@@ -1087,6 +1111,8 @@ bool stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
    *  * an event has been returned but we could not unserialize it.
    */
   if (!timed_out) {
+    if (_status_delta && d)
+      d = _status_delta->decode(d);
     ++_events_received_since_last_ack;
     SPDLOG_LOGGER_TRACE(_logger, "{} events to acknowledge",
                         _events_received_since_last_ack);
@@ -1097,6 +1123,10 @@ bool stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
     _last_sent_ack = now;
     send_event_acknowledgement();
   }
+  if (_is_input && _negotiated && _last_config_ack_check != now) {
+    _last_config_ack_check = now;
+    _send_config_ack();
+  }
   return !timed_out;
 }
 
@@ -1382,6 +1412,9 @@ void stream::statistics(nlohmann::json& tree) const {
   tree["bbdo_unacknowledged_events"] =
       static_cast<double>(_events_received_since_last_ack);
 
+  if (_status_delta)
+    _status_delta->statistics(tree);
+
   if (_substream)
     _substream->statistics(tree);
 }
@@ -1410,7 +1443,10 @@ void stream::_write(const std::shared_ptr<io::data>& d) {
  *  @return Number of events acknowledged.
  */
 int32_t stream::write(std::shared_ptr<io::data> const& d) {
-  _write(d);
+  if (_status_delta && !_is_input)
+    _write(_status_delta->encode(d));
+  else
+    _write(d);
 
   int32_t retval = _acknowledged_events;
   _acknowledged_events -= retval;
@@ -1446,3 +1482,23 @@ void stream::send_event_acknowledgement() {
     _events_received_since_last_ack = 0;
   }
 }
+
+/**
+ * @brief Send to the peer poller the configuration acknowledgement broker may
+ * have for it. It tells the poller which configuration is stored by broker,
+ * or that its whole configuration is needed.
+ */
+void stream::_send_config_ack() {
+  std::optional<uint64_t> fingerprint =
+      config::applier::state::instance().pop_config_ack(_poller_id);
+  if (fingerprint) {
+    SPDLOG_LOGGER_INFO(
+        _logger,
+        "BBDO: sending configuration acknowledgement {:016x} to poller {}",
+        *fingerprint, _poller_id);
+    auto config_ack = std::make_shared<pb_config_ack>();
+    config_ack->mut_obj().set_poller_id(_poller_id);
+    config_ack->mut_obj().set_config_fingerprint(*fingerprint);
+    _write(config_ack);
+  }
+}
@@ -33,6 +33,7 @@ inline std::string operator+(const std::string& left,
 }
 
 std::shared_ptr<global_cache> global_cache::_instance;
+std::atomic_uint64_t global_cache::_generation(0);
 
 global_cache::global_cache(const std::string& file_path,
                            const std::shared_ptr<spdlog::logger>& logger)
@@ -186,6 +187,7 @@ global_cache::pointer global_cache::load(const std::string& file_path,
   if (!_instance) {
     _instance = pointer(new global_cache_data(file_path));
     _instance->_open(initial_size, address);
+    bump_generation();
   }
   return _instance;
 }
@@ -196,6 +198,7 @@ global_cache::pointer global_cache::load(const std::string& file_path,
  */
 void global_cache::unload() {
   _instance.reset();
+  bump_generation();
 }
 
 /**
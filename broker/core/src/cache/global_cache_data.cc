@@ -73,9 +73,11 @@ void global_cache_data::set_metric_info(uint64_t metric_id,
       metric_info& to_update = *exist->second;
       if (to_update.name != name) {
         to_update.name.assign(name.data(), name.length());
+        bump_generation();
       }
       if (to_update.unit != unit) {
         to_update.unit.assign(unit.data(), unit.length());
+        bump_generation();
       }
       to_update.min = min;
       to_update.max = max;
@@ -89,6 +91,7 @@ void global_cache_data::set_metric_info(uint64_t metric_id,
                                         _file->get_segment_manager());
 
       _metric_info->emplace(metric_id, to_add);
+      bump_generation();
     }
   } catch (const interprocess::bad_alloc& e) {
     SPDLOG_LOGGER_DEBUG(_logger, "file full => grow");
@@ -149,10 +152,15 @@ void global_cache_data::store_host(uint64_t host_id,
       _id_to_host->emplace(host_id,
                            resource_info(host_name, resource_id, severity_id,
                                          _file->get_segment_manager()));
+      bump_generation();
     } else {
       if (host_name.compare(0, exist->second.name.length(),
                             exist->second.name.c_str())) {
         exist->second.name.assign(host_name.data(), host_name.length());
+        bump_generation();
+      }
+      if (exist->second.severity_id != severity_id) {
+        bump_generation();
       }
       exist->second.resource_id = resource_id;
       exist->second.severity_id = severity_id;
@@ -191,11 +199,16 @@ void global_cache_data::store_service(
           host_serv_pair(host_id, service_id),
           resource_info(service_description, resource_id, severity_id,
                         _file->get_segment_manager()));
+      bump_generation();
     } else {
       if (service_description.compare(0, exist->second.name.length(),
                                       exist->second.name.c_str())) {
         exist->second.name.assign(service_description.data(),
                                   service_description.length());
+        bump_generation();
+      }
+      if (exist->second.severity_id != severity_id) {
+        bump_generation();
       }
       exist->second.resource_id = resource_id;
       exist->second.severity_id = severity_id;
@@ -50,6 +50,8 @@ state::state(const std::shared_ptr<spdlog::logger>& logger)
     : _poller_id(0),
       _rpc_port(0),
       _bbdo_version{2u, 0u, 0u},
+      _pool_size(0),
+      _segmented_queue_files(false),
       _modules{logger} {}
 
 /**
@@ -113,6 +115,9 @@ void state::apply(const com::centreon::broker::config::state& s, bool run_mux) {
   // Thread pool size.
   _pool_size = s.pool_size();
 
+  // Queue files backend.
+  _segmented_queue_files = s.queue_files_backend() == "segments";
+
   // Set cache directory.
   _cache_dir = s.cache_directory();
   if (_cache_dir.empty())
@@ -139,6 +144,10 @@ void state::apply(const com::centreon::broker::config::state& s, bool run_mux) {
   com::centreon::broker::multiplexing::muxer::event_queue_max_size(
       s.event_queue_max_size());
 
+  // Sampling of events used to measure muxers latencies.
+  com::centreon::broker::multiplexing::engine::latency_sampling(
+      std::max(s.latency_sampling(), 0));
+
   com::centreon::broker::config::state st{s};
 
   // Apply input and output configuration.
@@ -230,6 +239,16 @@ size_t state::pool_size() const noexcept {
   return _pool_size;
 }
 
+/**
+ * @brief Tell if queue files are made of preallocated segments
+ * (file::segment_splitter) instead of stdio files (file::splitter).
+ *
+ * @return A boolean.
+ */
+bool state::segmented_queue_files() const noexcept {
+  return _segmented_queue_files;
+}
+
 /**
  *  Unload singleton.
  */
@@ -299,3 +318,59 @@ bool state::has_connection_from_poller(uint64_t poller_id) const {
   std::lock_guard<std::mutex> lck(_connected_pollers_m);
   return _connected_pollers.contains(poller_id);
 }
+
+/**
+ * @brief Ask to send a configuration acknowledgement to a poller. It is sent
+ * by the BBDO stream connected to this poller, a previous acknowledgement
+ * not yet sent is replaced.
+ *
+ * @param poller_id The poller ID.
+ * @param fingerprint The fingerprint of the configuration stored for this
+ * poller, 0 to ask the poller to send its whole configuration.
+ */
+void state::add_config_ack(uint64_t poller_id, uint64_t fingerprint) {
+  std::lock_guard<std::mutex> lck(_config_acks_m);
+  _config_acks_to_send[poller_id] = fingerprint;
+}
+
+/**
+ * @brief Get the configuration acknowledgement to send to a poller, if any.
+ * It is removed from the ones to send.
+ *
+ * @param poller_id The poller ID.
+ *
+ * @return A configuration fingerprint or nothing.
+ */
+std::optional<uint64_t> state::pop_config_ack(uint64_t poller_id) {
+  std::lock_guard<std::mutex> lck(_config_acks_m);
+  auto found = _config_acks_to_send.find(poller_id);
+  if (found == _config_acks_to_send.end())
+    return std::nullopt;
+  uint64_t retval = found->second;
+  _config_acks_to_send.erase(found);
+  return retval;
+}
+
+/**
+ * @brief Store the configuration acknowledgement received from broker, until
+ * cbmod gets it.
+ *
+ * @param fingerprint The configuration fingerprint acknowledged by broker.
+ */
+void state::set_config_ack_received(uint64_t fingerprint) {
+  std::lock_guard<std::mutex> lck(_config_acks_m);
+  _config_ack_received = fingerprint;
+}
+
+/**
+ * @brief Get the last configuration acknowledgement received from broker, if
+ * any. It is then forgotten.
+ *
+ * @return A configuration fingerprint or nothing.
+ */
+std::optional<uint64_t> state::pop_config_ack_received() {
+  std::lock_guard<std::mutex> lck(_config_acks_m);
+  std::optional<uint64_t> retval;
+  retval.swap(_config_ack_received);
+  return retval;
+}
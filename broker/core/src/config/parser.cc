@@ -275,7 +275,31 @@ state parser::parse(std::string const& file) {
                                       &state::event_queue_max_size,
                                       &json::is_number, &json::get<int>))
           ;
-        else if (it.key() == "event_queues_total_size") {
+        else if (get_conf<int, state>({it.key(), it.value()},
+                                      "latency_sampling", retval,
+                                      &state::latency_sampling,
+                                      &json::is_number, &json::get<int>))
+          ;
+        else if (get_conf<int, state>({it.key(), it.value()},
+                                      "neb_events_batch_size", retval,
+                                      &state::neb_events_batch_size,
+                                      &json::is_number, &json::get<int>))
+          ;
+        else if (get_conf<int, state>({it.key(), it.value()},
+                                      "neb_events_batch_latency", retval,
+                                      &state::neb_events_batch_latency,
+                                      &json::is_number, &json::get<int>))
+          ;
+        else if (get_conf<state>({it.key(), it.value()},
+                                 "queue_files_backend", retval,
+                                 &state::queue_files_backend,
+                                 &json::is_string)) {
+          if (retval.queue_files_backend() != "stdio" &&
+              retval.queue_files_backend() != "segments")
+            throw msg_fmt(
+                "config parser: cannot parse key 'queue_files_backend': value "
+                "must be 'stdio' or 'segments'");
+        } else if (it.key() == "event_queues_total_size") {
           auto eqts = check_and_read<uint64_t>(json_document["centreonBroker"],
                                                "event_queues_total_size");
           retval.event_queues_total_size(eqts.value());
@@ -37,6 +37,10 @@ state::state()
       _bbdo_version(BBDO_VERSION_MAJOR, BBDO_VERSION_MINOR, BBDO_VERSION_PATCH),
       _command_protocol{"json"},
       _event_queue_max_size{10000},
+      _neb_events_batch_size{1000},
+      _neb_events_batch_latency{100},
+      _latency_sampling{128},
+      _queue_files_backend{"stdio"},
       _poller_id{0},
       _pool_size{0},
       _log_conf{"/var/log/centreon-broker/",
@@ -62,6 +66,10 @@ state::state(const state& other)
       _command_protocol(other._command_protocol),
       _endpoints(other._endpoints),
       _event_queue_max_size(other._event_queue_max_size),
+      _neb_events_batch_size(other._neb_events_batch_size),
+      _neb_events_batch_latency(other._neb_events_batch_latency),
+      _latency_sampling(other._latency_sampling),
+      _queue_files_backend(other._queue_files_backend),
       _module_dir(other._module_dir),
       _module_list(other._module_list),
       _params(other._params),
@@ -93,6 +101,10 @@ state& state::operator=(state const& other) {
     _command_protocol = other._command_protocol;
     _endpoints = other._endpoints;
     _event_queue_max_size = other._event_queue_max_size;
+    _neb_events_batch_size = other._neb_events_batch_size;
+    _neb_events_batch_latency = other._neb_events_batch_latency;
+    _latency_sampling = other._latency_sampling;
+    _queue_files_backend = other._queue_files_backend;
     _module_dir = other._module_dir;
     _module_list = other._module_list;
     _params = other._params;
@@ -116,6 +128,10 @@ void state::clear() {
   _command_protocol = "json";
   _endpoints.clear();
   _event_queue_max_size = 10000;
+  _neb_events_batch_size = 1000;
+  _neb_events_batch_latency = 100;
+  _latency_sampling = 128;
+  _queue_files_backend = "stdio";
   _module_dir.clear();
   _module_list.clear();
   _params.clear();
@@ -294,6 +310,80 @@ int state::event_queue_max_size() const noexcept {
   return _event_queue_max_size;
 }
 
+/**
+ *  Set the maximum number of events staged by cbmod during an engine event
+ *  loop iteration before they are published. 0 or 1 disables staging.
+ *
+ *  @param[in] val Size limit.
+ */
+void state::neb_events_batch_size(int val) noexcept {
+  _neb_events_batch_size = val;
+}
+
+/**
+ *  Get the maximum number of events staged by cbmod.
+ *
+ *  @return The size limit.
+ */
+int state::neb_events_batch_size() const noexcept {
+  return _neb_events_batch_size;
+}
+
+/**
+ *  Set the maximum duration in milliseconds an event can be staged by cbmod.
+ *
+ *  @param[in] val Duration in milliseconds.
+ */
+void state::neb_events_batch_latency(int val) noexcept {
+  _neb_events_batch_latency = val;
+}
+
+/**
+ *  Get the maximum duration in milliseconds an event can be staged by cbmod.
+ *
+ *  @return The duration in milliseconds.
+ */
+int state::neb_events_batch_latency() const noexcept {
+  return _neb_events_batch_latency;
+}
+
+/**
+ *  Set the latency sampling rate: one event out of val published in the
+ *  multiplexing engine is used to measure muxers latencies. 0 disables it.
+ *
+ *  @param[in] val The sampling rate.
+ */
+void state::latency_sampling(int val) noexcept {
+  _latency_sampling = val;
+}
+
+/**
+ *  Get the latency sampling rate.
+ *
+ *  @return The sampling rate.
+ */
+int state::latency_sampling() const noexcept {
+  return _latency_sampling;
+}
+
+/**
+ *  Set the backend used for queue files, "stdio" or "segments".
+ *
+ *  @param[in] backend The backend name.
+ */
+void state::queue_files_backend(const std::string& backend) {
+  _queue_files_backend = backend;
+}
+
+/**
+ *  Get the backend used for queue files.
+ *
+ *  @return "stdio" or "segments".
+ */
+const std::string& state::queue_files_backend() const noexcept {
+  return _queue_files_backend;
+}
+
 /**
  *  Get the module directory.
  *
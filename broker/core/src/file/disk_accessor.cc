@@ -16,6 +16,10 @@
  * For more information : contact@centreon.com
  */
 #include "com/centreon/broker/file/disk_accessor.hh"
+
+#include <fcntl.h>
+#include <unistd.h>
+
 #include "common/log_v2/log_v2.hh"
 
 using namespace com::centreon::broker::file;
@@ -160,3 +164,62 @@ disk_accessor::fd disk_accessor::fopen(const std::string& name,
 void disk_accessor::fclose(disk_accessor::fd f) {
   ::fclose(f);
 }
+
+/**
+ * @brief Allocate the size bytes of a file with posix_fallocate(). A check of
+ * the limit size is done, the whole allocated size is counted in the current
+ * size because files are removed with remove().
+ *
+ * @param fd The file descriptor.
+ * @param size The size to allocate from the file beginning.
+ *
+ * @return 0 on success, otherwise an error number.
+ */
+int disk_accessor::allocate(int fd, off_t size) {
+  if (_limit_size != 0 && _current_size + size > _limit_size) {
+    log_v2::instance()
+        .get(log_v2::CORE)
+        ->error(
+            "disk_accessor: the limit size of {} bytes is reached for queue "
+            "files. "
+            "New events written to disk are lost",
+            _limit_size);
+    return ENOSPC;
+  }
+  int retval = posix_fallocate(fd, 0, size);
+  if (retval == 0)
+    _current_size += size;
+  return retval;
+}
+
+/**
+ * @brief A binding to the pwritev() function. Written bytes are not counted,
+ * files written with it are allocated with allocate().
+ *
+ * @param fd
+ * @param iov
+ * @param iovcnt
+ * @param offset
+ *
+ * @return The number of bytes written or -1 on error.
+ */
+ssize_t disk_accessor::pwritev(int fd,
+                               const struct iovec* iov,
+                               int iovcnt,
+                               off_t offset) {
+  return ::pwritev(fd, iov, iovcnt, offset);
+}
+
+/**
+ * @brief A binding to the pread() function.
+ *
+ * @param fd
+ * @param buf
+ * @param count
+ * @param offset
+ *
+ * @return The number of bytes read or -1 on error.
+ */
+ssize_t disk_accessor::pread(int fd, void* buf, size_t count, off_t offset) {
+  return ::pread(fd, buf, count, offset);
+}
@@ -0,0 +1,618 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/file/segment_splitter.hh"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <absl/strings/match.h>
+
+#include "com/centreon/broker/exceptions/shutdown.hh"
+#include "com/centreon/broker/file/disk_accessor.hh"
+#include "com/centreon/broker/misc/filesystem.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+#include "common/log_v2/log_v2.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::file;
+
+using com::centreon::common::log_v2::log_v2;
+
+namespace {
+constexpr char segment_magic[8] = {'C', 'B', 'Q', 'S', 'E', 'G', '0', '1'};
+
+/**
+ * @brief Split a path into its directory and its file name.
+ *
+ * @param path
+ *
+ * @return A pair (directory ended by '/', file name).
+ */
+std::pair<std::string, std::string> split_path(const std::string& path) {
+  size_t last_slash = path.find_last_of('/');
+  if (last_slash == std::string::npos)
+    return {"./", path};
+  else
+    return {path.substr(0, last_slash + 1), path.substr(last_slash + 1)};
+}
+
+/**
+ * @brief Get the segment ids of a segment_splitter from the files on disk.
+ *
+ * @param path The base path of the segment_splitter.
+ * @param size If not null, the size of these files is stored in it.
+ *
+ * @return The ids of the existing segments.
+ */
+std::vector<int32_t> segment_ids(const std::string& path, size_t* size) {
+  std::vector<int32_t> retval;
+  auto [base_dir, base_name] = split_path(path);
+  std::list<std::string> parts{
+      misc::filesystem::dir_content_with_filter(base_dir, base_name + ".seg*")};
+  size_t offset = base_dir.size() + base_name.size() + 4;
+  struct stat file_stat;
+  for (auto& f : parts) {
+    int32_t val;
+    if (f.size() <= offset ||
+        !absl::SimpleAtoi(absl::string_view(f).substr(offset), &val) ||
+        val < 0)
+      continue;
+    retval.push_back(val);
+    if (size && stat(f.c_str(), &file_stat) == 0)
+      *size += file_stat.st_size;
+  }
+  return retval;
+}
+}  // namespace
+
+/**
+ *  Build a new segment_splitter.
+ *
+ *  @param[in] path           Base path to file.
+ *  @param[in] max_file_size  Size of each segment, 0 for the default size.
+ *  @param[in] auto_delete    True to delete segments as they are read.
+ */
+segment_splitter::segment_splitter(const std::string& path,
+                                   uint32_t max_file_size,
+                                   bool auto_delete)
+    : _auto_delete{auto_delete},
+      _base_path{path},
+      _max_file_size{max_file_size == 0u
+                         ? 100000000u
+                         : std::max(max_file_size, 2 * header_size)},
+      _batch_size{std::min<size_t>(write_batch_size,
+                                   _max_file_size - header_size)},
+      _rfd{-1},
+      _rid{0},
+      _roffset{header_size},
+      _rend{0},
+      _wfd{-1},
+      _wid{0},
+      _wcapacity{0},
+      _woffset{header_size} {
+  _buffer.reserve(_batch_size);
+
+  size_t size = 0;
+  std::vector<int32_t> ids{segment_ids(_base_path, &size)};
+  disk_accessor::instance().set_current_size(size);
+
+  std::lock_guard<std::mutex> lck(_write_m);
+  if (ids.empty())
+    _publish();
+  else {
+    auto [first, last] = std::minmax_element(ids.begin(), ids.end());
+    _rid = *first;
+    _wid = *last;
+    _open_write_segment();
+  }
+}
+
+/**
+ *  Destructor.
+ */
+segment_splitter::~segment_splitter() noexcept {
+  close();
+}
+
+/**
+ *  Write the buffer on disk and close files open by the segment_splitter.
+ */
+void segment_splitter::close() {
+  std::lock_guard<std::mutex> lck(_write_m);
+  try {
+    _close_write_segment();
+  } catch (const std::exception& e) {
+    log_v2::instance()
+        .get(log_v2::BBDO)
+        ->error("segment_splitter: {}", e.what());
+    ::close(_wfd);
+    _wfd = -1;
+  }
+  _close_read_segment();
+}
+
+/**
+ *  Read data.
+ *
+ *  @param[out] buffer    Output buffer.
+ *  @param[in]  max_size  Maximum number of bytes that can be read.
+ *
+ *  @return Number of bytes read.
+ */
+long segment_splitter::read(void* buffer, long max_size) {
+  for (;;) {
+    /* No lock here, data before the published position are on disk. */
+    uint64_t published = _published.load(std::memory_order_acquire);
+    int32_t pwid = published >> 32;
+    uint32_t end = header_size;
+    if (_rfd >= 0 || _open_read_segment())
+      end = _rid < pwid ? _read_data_end() : static_cast<uint32_t>(published);
+    else if (_rid < pwid) {
+      ++_rid;
+      continue;
+    }
+
+    if (_roffset < end) {
+      ssize_t rb = disk_accessor::instance().pread(
+          _rfd, buffer, std::min<size_t>(max_size, end - _roffset), _roffset);
+      if (rb < 0) {
+        if (errno == EAGAIN || errno == EINTR)
+          return 0;
+        char msg[1024];
+        throw msg_fmt("error while reading file '{}': {}", get_file_path(_rid),
+                      strerror_r(errno, msg, sizeof(msg)));
+      }
+      if (rb == 0) {
+        log_v2::instance()
+            .get(log_v2::BBDO)
+            ->error("segment_splitter: unexpected end of file '{}'",
+                    get_file_path(_rid));
+        _roffset = end;
+        continue;
+      }
+      uint32_t previous = _roffset;
+      _roffset += rb;
+      /* Read batches won't be read again, they can leave the page cache. */
+      if (previous / _batch_size != _roffset / _batch_size)
+        posix_fadvise(_rfd, 0, _roffset / _batch_size * _batch_size,
+                      POSIX_FADV_DONTNEED);
+      return rb;
+    }
+
+    if (_rid < pwid) {
+      /* This segment is entirely read and won't be written anymore. */
+      std::string file_path(get_file_path(_rid));
+      _close_read_segment();
+      if (_auto_delete) {
+        log_v2::instance()
+            .get(log_v2::BBDO)
+            ->info("file: end of file '{}' reached, erasing it", file_path);
+        disk_accessor::instance().remove(file_path);
+      }
+      ++_rid;
+      continue;
+    }
+
+    /* Everything published is read, remaining data are in the buffer. */
+    {
+      std::lock_guard<std::mutex> lck(_write_m);
+      if (!_buffer.empty()) {
+        _write_batch(nullptr, 0);
+        continue;
+      }
+      if (_published.load(std::memory_order_relaxed) != published)
+        continue;
+      if (_auto_delete && _rfd >= 0) {
+        std::string file_path(get_file_path(_rid));
+        log_v2::instance()
+            .get(log_v2::BBDO)
+            ->info("file: end of file '{}' reached, erasing it", file_path);
+        _close_read_segment();
+        if (_wfd >= 0) {
+          ::close(_wfd);
+          _wfd = -1;
+        }
+        disk_accessor::instance().remove(file_path);
+        _woffset = header_size;
+        _publish();
+      }
+    }
+    throw exceptions::shutdown("No more data to read");
+  }
+}
+
+/**
+ *  Throw an exception.
+ *
+ *  @param[in] offset  Unused.
+ *  @param[in] whence  Unused.
+ */
+void segment_splitter::seek(long offset, fs_file::seek_whence whence) {
+  (void)offset;
+  (void)whence;
+  throw msg_fmt("cannot seek within a splitted file");
+}
+
+/**
+ *  Get current position.
+ *
+ *  @return Current position in file.
+ */
+long segment_splitter::tell() {
+  return _roffset;
+}
+
+/**
+ *  Write data. They are stored in the buffer until it is full. If the current
+ *  segment is full, only the part of data that fits in it is written.
+ *
+ *  @param[in] buffer  Data.
+ *  @param[in] size    Number of bytes in buffer.
+ *
+ *  @return Number of bytes written.
+ */
+long segment_splitter::write(void const* buffer, long size) {
+  std::lock_guard<std::mutex> lck(_write_m);
+  if (_wfd < 0)
+    _open_write_segment();
+
+  size_t avail = _wcapacity - _woffset - _buffer.size();
+  if (avail == 0) {
+    _close_write_segment();
+    ++_wid;
+    _open_write_segment();
+    avail = _wcapacity - _woffset;
+  }
+
+  size_t count = std::min<size_t>(size, avail);
+  if (_buffer.size() + count >= _batch_size)
+    _write_batch(buffer, count);
+  else
+    _buffer.insert(_buffer.end(), static_cast<const char*>(buffer),
+                   static_cast<const char*>(buffer) + count);
+  return count;
+}
+
+/**
+ *  Write the buffer on disk.
+ */
+void segment_splitter::flush() {
+  std::lock_guard<std::mutex> lck(_write_m);
+  if (_wfd >= 0)
+    _write_batch(nullptr, 0);
+}
+
+/**
+ *  Get the file path matching the ID.
+ *
+ *  @param[in] id Current ID.
+ */
+std::string segment_splitter::get_file_path(int id) const {
+  return fmt::format("{}.seg{}", _base_path, id);
+}
+
+/**
+ *  Get the size of segments.
+ *
+ *  @return Max file size.
+ */
+size_t segment_splitter::max_file_size() const {
+  return _max_file_size;
+}
+
+/**
+ *  Get current read ID.
+ *
+ *  @return Current read ID.
+ */
+int32_t segment_splitter::get_rid() const {
+  return _rid;
+}
+
+/**
+ *  Get current read offset.
+ *
+ *  @return Current read offset.
+ */
+long segment_splitter::get_roffset() const {
+  return _roffset;
+}
+
+/**
+ *  Get current write ID.
+ *
+ *  @return Current write ID.
+ */
+int32_t segment_splitter::get_wid() const {
+  return _wid;
+}
+
+/**
+ *  Get the offset of data written on disk in the current write segment.
+ *
+ *  @return Current write offset.
+ */
+long segment_splitter::get_woffset() const {
+  return static_cast<uint32_t>(_published.load(std::memory_order_relaxed));
+}
+
+/**
+ *  Remove all the files the segment_splitter is concerned by. Files written
+ *  by a splitter with the same base path are also removed.
+ */
+void segment_splitter::remove_all_files() {
+  std::lock_guard<std::mutex> lck(_write_m);
+  _close_read_segment();
+  if (_wfd >= 0) {
+    ::close(_wfd);
+    _wfd = -1;
+  }
+  _buffer.clear();
+
+  auto [base_dir, base_name] = split_path(_base_path);
+  std::list<std::string> parts{
+      misc::filesystem::dir_content_with_filter(base_dir, base_name + '*')};
+  size_t offset = base_dir.size() + base_name.size();
+  for (const std::string& f : parts) {
+    absl::string_view suffix = absl::string_view(f).substr(offset);
+    if (absl::StartsWith(suffix, ".seg"))
+      suffix.remove_prefix(4);
+    int32_t val;
+    if (suffix.empty() || absl::SimpleAtoi(suffix, &val))
+      disk_accessor::instance().remove(f);
+  }
+
+  /* No more files, we reset rid and wid. */
+  _rid = 0;
+  _wid = 0;
+  _woffset = header_size;
+  _publish();
+}
+
+/**
+ * @brief Tell if segments of a segment_splitter exist with this base path.
+ *
+ * @param path The base path.
+ *
+ * @return A boolean.
+ */
+bool segment_splitter::exists(const std::string& path) {
+  return !segment_ids(path, nullptr).empty();
+}
+
+/**
+ * @brief Make the data written in the current write segment available to the
+ * reader. This call must be protected by the _write_m mutex.
+ */
+void segment_splitter::_publish() {
+  _published.store(static_cast<uint64_t>(_wid) << 32 | _woffset,
+                   std::memory_order_release);
+}
+
+/**
+ * @brief Open the segment _wid in write mode, it is created and allocated if
+ * needed. An invalid segment is skipped. This call must be protected by the
+ * _write_m mutex.
+ */
+void segment_splitter::_open_write_segment() {
+  auto logger = log_v2::instance().get(log_v2::BBDO);
+  for (;;) {
+    std::string fname(get_file_path(_wid));
+    int fd = ::open(fname.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+    if (fd < 0) {
+      char msg[1024];
+      throw msg_fmt("cannot open '{}' to read/write: {}", fname,
+                    strerror_r(errno, msg, sizeof(msg)));
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat)) {
+      char msg[1024];
+      ::close(fd);
+      throw msg_fmt("cannot stat '{}': {}", fname,
+                    strerror_r(errno, msg, sizeof(msg)));
+    }
+
+    if (file_stat.st_size == 0) {
+      int err = disk_accessor::instance().allocate(fd, _max_file_size);
+      if (err) {
+        char msg[1024];
+        ::close(fd);
+        disk_accessor::instance().remove(fname);
+        throw msg_fmt("cannot allocate {} bytes for '{}': {}", _max_file_size,
+                      fname, strerror_r(err, msg, sizeof(msg)));
+      }
+      _wfd = fd;
+      _wcapacity = _max_file_size;
+      _woffset = header_size;
+      _write_header(_woffset);
+      logger->debug("segment_splitter: write open new segment '{}'", fname);
+    } else {
+      header h;
+      ssize_t rb = disk_accessor::instance().pread(fd, &h, sizeof(h), 0);
+      if (rb != sizeof(h) || memcmp(h.magic, segment_magic, sizeof(h.magic)) ||
+          h.data_end < header_size ||
+          h.data_end > static_cast<uint64_t>(file_stat.st_size) ||
+          h.data_end > std::numeric_limits<uint32_t>::max()) {
+        logger->error(
+            "segment_splitter: '{}' is not a valid queue file segment, it is "
+            "skipped",
+            fname);
+        ::close(fd);
+        ++_wid;
+        continue;
+      }
+      _wfd = fd;
+      _wcapacity = std::min<uint64_t>(file_stat.st_size,
+                                      std::numeric_limits<uint32_t>::max());
+      _woffset = h.data_end;
+      logger->debug("segment_splitter: write open '{}' at offset {}", fname,
+                    _woffset);
+    }
+    break;
+  }
+  _publish();
+}
+
+/**
+ * @brief Write the buffer and close the write segment. This call must be
+ * protected by the _write_m mutex.
+ */
+void segment_splitter::_close_write_segment() {
+  if (_wfd >= 0) {
+    _write_batch(nullptr, 0);
+    ::close(_wfd);
+    _wfd = -1;
+  }
+}
+
+/**
+ * @brief Write the buffer followed by size bytes of data at the end of the
+ * write segment with one system call, then update the segment header and
+ * publish the new end of data. This call must be protected by the _write_m
+ * mutex.
+ *
+ * @param data Data written after the buffer, they are not copied.
+ * @param size Size of data.
+ */
+void segment_splitter::_write_batch(const void* data, size_t size) {
+  iovec iov[2];
+  int count = 0;
+  if (!_buffer.empty())
+    iov[count++] = {_buffer.data(), _buffer.size()};
+  if (size)
+    iov[count++] = {const_cast<void*>(data), size};
+  if (count == 0)
+    return;
+
+  size_t total = _buffer.size() + size;
+  size_t done = 0;
+  iovec* v = iov;
+  while (done < total) {
+    ssize_t wb =
+        disk_accessor::instance().pwritev(_wfd, v, count, _woffset + done);
+    if (wb < 0) {
+      if (errno == EINTR)
+        continue;
+      char msg[1024];
+      throw msg_fmt("cannot write to file '{}': {}", get_file_path(_wid),
+                    strerror_r(errno, msg, sizeof(msg)));
+    }
+    done += wb;
+    /* Partial write, we skip what has been written. */
+    for (size_t n = wb; n > 0;) {
+      if (n >= v->iov_len) {
+        n -= v->iov_len;
+        ++v;
+        --count;
+      } else {
+        v->iov_base = static_cast<char*>(v->iov_base) + n;
+        v->iov_len -= n;
+        n = 0;
+      }
+    }
+  }
+  _woffset += total;
+  _buffer.clear();
+  _write_header(_woffset);
+  _publish();
+}
+
+/**
+ * @brief Write the header of the write segment. This call must be protected by
+ * the _write_m mutex.
+ *
+ * @param data_end The end of data in the segment.
+ */
+void segment_splitter::_write_header(uint32_t data_end) {
+  header h;
+  memcpy(h.magic, segment_magic, sizeof(h.magic));
+  h.data_end = data_end;
+  iovec iov{&h, sizeof(h)};
+  if (disk_accessor::instance().pwritev(_wfd, &iov, 1, 0) != sizeof(h)) {
+    char msg[1024];
+    throw msg_fmt("cannot write header of file '{}': {}", get_file_path(_wid),
+                  strerror_r(errno, msg, sizeof(msg)));
+  }
+}
+
+/**
+ * @brief Open the segment _rid in read mode.
+ *
+ * @return True on success, false if the segment does not exist.
+ */
+bool segment_splitter::_open_read_segment() {
+  std::string fname(get_file_path(_rid));
+  int fd = ::open(fname.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    if (errno == ENOENT)
+      return false;
+    char msg[1024];
+    throw msg_fmt("cannot open '{}' to read: {}", fname,
+                  strerror_r(errno, msg, sizeof(msg)));
+  }
+  posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+  log_v2::instance()
+      .get(log_v2::BBDO)
+      ->debug("segment_splitter: read open '{}'", fname);
+  _rfd = fd;
+  _roffset = header_size;
+  _rend = 0;
+  return true;
+}
+
+/**
+ * @brief Close the read segment.
+ */
+void segment_splitter::_close_read_segment() {
+  if (_rfd >= 0) {
+    ::close(_rfd);
+    _rfd = -1;
+  }
+  _roffset = header_size;
+  _rend = 0;
+}
+
+/**
+ * @brief Get the end of data of the read segment from its header. It must only
+ * be called once the segment is not written anymore.
+ *
+ * @return An offset in the segment.
+ */
+uint32_t segment_splitter::_read_data_end() {
+  if (_rend == 0) {
+    header h;
+    ssize_t rb = disk_accessor::instance().pread(_rfd, &h, sizeof(h), 0);
+    if (rb == sizeof(h) && !memcmp(h.magic, segment_magic, sizeof(h.magic)) &&
+        h.data_end >= header_size &&
+        h.data_end <= std::numeric_limits<uint32_t>::max())
+      _rend = h.data_end;
+    else {
+      log_v2::instance()
+          .get(log_v2::BBDO)
+          ->error(
+              "segment_splitter: '{}' is not a valid queue file segment, it is "
+              "skipped",
+              get_file_path(_rid));
+      _rend = header_size;
+    }
+  }
+  return _rend;
+}
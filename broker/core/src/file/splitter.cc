@@ -36,6 +36,52 @@ using namespace com::centreon::broker::file;
 
 using com::centreon::common::log_v2::log_v2;
 
+namespace {
+/**
+ * @brief Get the IDs of the existing file parts of a splitter. File parts are
+ * suffixed with their order number. A file named /var/lib/foo would have
+ * parts named /var/lib/foo, /var/lib/foo1, /var/lib/foo2, ... in this order.
+ *
+ * @param path The base path.
+ * @param size If not null, the total size of the parts is added to it.
+ *
+ * @return The IDs of the parts, not sorted.
+ */
+std::vector<int32_t> part_ids(const std::string& path, size_t* size) {
+  std::vector<int32_t> retval;
+  std::string base_dir;
+  std::string base_name;
+  size_t last_slash(path.find_last_of('/'));
+  if (last_slash == std::string::npos) {
+    base_dir = ".";
+    base_name = path;
+  } else {
+    base_dir = path.substr(0, last_slash);
+    base_name = path.substr(last_slash + 1);
+  }
+  std::list<std::string> parts{
+      misc::filesystem::dir_content_with_filter(base_dir, base_name + '*')};
+  size_t offset{base_dir.size() + base_name.size()};
+  if (!base_dir.empty() && base_dir.back() != '/')
+    offset++;
+  struct stat file_stat;
+  for (auto& f : parts) {
+    const char* ptr{f.c_str() + offset};
+    int val = 0;
+    if (*ptr) {  // Not empty, conversion needed.
+      char* endptr = nullptr;
+      val = strtol(ptr, &endptr, 10);
+      if (endptr && *endptr)  // Invalid conversion.
+        continue;
+    }
+    retval.push_back(val);
+    if (size && stat(f.c_str(), &file_stat) == 0)
+      *size += file_stat.st_size;
+  }
+  return retval;
+}
+}  // namespace
+
 /**
  *  Build a new splitter.
  *
@@ -58,48 +104,15 @@ splitter::splitter(std::string const& path,
       _write_m{},
       _wfile{},
       _woffset{0} {
-  // Get IDs of already existing file parts. File parts are suffixed
-  // with their order number. A file named /var/lib/foo would have
-  // parts named /var/lib/foo, /var/lib/foo1, /var/lib/foo2, ...
-  // in this order.
-  std::string base_dir;
-  std::string base_name;
-  {
-    size_t last_slash(_base_path.find_last_of('/'));
-    if (last_slash == std::string::npos) {
-      base_dir = ".";
-      base_name = _base_path;
-    } else {
-      base_dir = _base_path.substr(0, last_slash);
-      base_name = _base_path.substr(last_slash + 1);
-    }
-  }
-  std::list<std::string> parts{
-      misc::filesystem::dir_content_with_filter(base_dir, base_name + '*')};
+  // Get IDs of already existing file parts.
   _rid = std::numeric_limits<int>::max();
   _wid = 0;
-  size_t offset{base_dir.size() + base_name.size()};
-  if (!base_dir.empty() && base_dir.back() != '/')
-    offset++;
   size_t size = 0;
-  struct stat file_stat;
-  for (auto& f : parts) {
-    const char* ptr{f.c_str() + offset};
-    int val = 0;
-    if (*ptr) {  // Not empty, conversion needed.
-      char* endptr = nullptr;
-      val = strtol(ptr, &endptr, 10);
-      if (endptr && *endptr)  // Invalid conversion.
-        continue;
-    }
-
+  for (int32_t val : part_ids(_base_path, &size)) {
     if (val < _rid)
       _rid = val;
     if (val > _wid)
       _wid = val;
-
-    if (stat(f.c_str(), &file_stat) == 0)
-      size += file_stat.st_size;
   }
   disk_accessor::instance().set_current_size(size);
 
@@ -459,3 +472,16 @@ bool splitter::_open_write_file() {
   }
   return true;
 }
+
+/**
+ * @brief Tell if file parts of a splitter exist with this base path. The first
+ * parts may already have been read and removed, so all the parts are looked
+ * for.
+ *
+ * @param path The base path.
+ *
+ * @return A boolean.
+ */
+bool splitter::exists(const std::string& path) {
+  return !part_ids(path, nullptr).empty();
+}
@@ -29,7 +29,7 @@ uint32_t data::broker_id(0);
  *  Constructor.
  */
 data::data(uint32_t type)
-    : _type(type), source_id(broker_id), destination_id(0) {
+    : _type(type), source_id(broker_id), destination_id(0), sampled_at(0) {
   assert(type);
 }
 
@@ -41,7 +41,8 @@ data::data(uint32_t type)
 data::data(data const& other)
     : _type(other._type),
       source_id(other.source_id),
-      destination_id(other.destination_id) {}
+      destination_id(other.destination_id),
+      sampled_at(0) {}
 
 /**
  *  Assignment operator.
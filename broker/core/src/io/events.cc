@@ -231,6 +231,8 @@ events::events() {
                  &bbdo::pb_ack::operations);
   register_event(make_type(io::bbdo, bbdo::de_pb_stop), "Stop",
                  &bbdo::pb_stop::operations);
+  register_event(make_type(io::bbdo, bbdo::de_pb_config_ack), "ConfigAck",
+                 &bbdo::pb_config_ack::operations);
   register_event(bbdo::pb_bench::static_type(), "Bench",
                  &bbdo::pb_bench::operations);
 
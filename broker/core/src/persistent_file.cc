@@ -20,7 +20,10 @@
 
 #include "com/centreon/broker/bbdo/stream.hh"
 #include "com/centreon/broker/compression/stream.hh"
+#include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/file/opener.hh"
+#include "com/centreon/broker/file/segment_splitter.hh"
+#include "com/centreon/broker/file/splitter.hh"
 #include "com/centreon/broker/file/stream.hh"
 #include "com/centreon/broker/stats/center.hh"
 #include "common/log_v2/log_v2.hh"
@@ -37,9 +40,15 @@ using log_v2 = com::centreon::common::log_v2::log_v2;
  */
 persistent_file::persistent_file(const std::string& path, QueueFileStats* stats)
     : io::stream("persistent_file") {
-  // On-disk file.
+  // On-disk file. Files left by the other backend are read first.
   constexpr uint32_t max_size{100000000u};
-  _splitter = std::make_shared<file::stream>(path, stats, max_size, true);
+  bool segmented = config::applier::state::loaded() &&
+                   config::applier::state::instance().segmented_queue_files();
+  if (segmented ? file::splitter::exists(path)
+                : file::segment_splitter::exists(path))
+    segmented = !segmented;
+  _splitter =
+      std::make_shared<file::stream>(path, stats, max_size, true, segmented);
 
   // Compression layer.
   auto cs{std::make_shared<compression::stream>()};
@@ -149,6 +149,26 @@ void center::update_muxer(std::string name,
   }
 }
 
+/**
+ * @brief Update the latency statistics of a muxer with the values recorded
+ * in the histograms since the previous call. The histograms are emptied.
+ *
+ * @param name The muxer name.
+ * @param enqueue Latencies until events are pushed in the muxer.
+ * @param read Latencies until events are read from the muxer.
+ * @param ack Latencies until events are acknowledged.
+ */
+void center::update_muxer_latency(const std::string& name,
+                                  latency_histogram& enqueue,
+                                  latency_histogram& read,
+                                  latency_histogram& ack) {
+  absl::MutexLock lck(&_stats_m);
+  auto ms = &(*_stats.mutable_processing()->mutable_muxers())[name];
+  enqueue.fill_and_reset(ms->mutable_enqueue_latency());
+  read.fill_and_reset(ms->mutable_read_latency());
+  ack.fill_and_reset(ms->mutable_ack_latency());
+}
+
 void center::init_queue_file(std::string muxer,
                              std::string queue_file,
                              uint32_t max_file_size) {
@@ -175,6 +195,17 @@ ConflictManagerStats* center::register_conflict_manager() {
   return _stats.mutable_conflict_manager();
 }
 
+/**
+ * @brief When the BAM availability thread is created, it calls this method to
+ * declare itself to the stats center.
+ *
+ * @return A pointer to the availabilities statistics.
+ */
+BamAvailabilityStats* center::register_bam_availability() {
+  absl::MutexLock lck(&_stats_m);
+  return _stats.mutable_bam_availability();
+}
+
 /**
  * @brief Convert the protobuf statistics object to a json string.
  *
@@ -0,0 +1,204 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/stats/latency_histogram.hh"
+
+#include <cmath>
+
+using namespace com::centreon::broker::stats;
+
+/**
+ * @brief Constructor. The histogram is empty.
+ */
+latency_histogram::latency_histogram() : _count{0}, _max{0} {
+  for (auto& b : _buckets)
+    b.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Compute the index of the bucket containing the given value.
+ *
+ * @param value A latency in microseconds.
+ *
+ * @return An index in [0, bucket_count[.
+ */
+uint32_t latency_histogram::bucket_index(uint64_t value) noexcept {
+  if (value < sub_bucket_count)
+    return value;
+  uint32_t msb = 63 - __builtin_clzll(value);
+  if (msb > max_exponent)
+    return bucket_count - 1;
+  return (msb - sub_bucket_bits + 1) * sub_bucket_count +
+         ((value >> (msb - sub_bucket_bits)) & (sub_bucket_count - 1));
+}
+
+/**
+ * @brief Get a value representing the given bucket, that is the middle of the
+ * range of values stored in it.
+ *
+ * @param index The bucket index.
+ *
+ * @return A latency in microseconds.
+ */
+uint64_t latency_histogram::bucket_value(uint32_t index) noexcept {
+  uint32_t block = index / sub_bucket_count;
+  uint64_t sub = index % sub_bucket_count;
+  if (block == 0)
+    return sub;
+  uint32_t shift = block - 1;
+  uint64_t lower = (sub_bucket_count + sub) << shift;
+  return lower + ((1ull << shift) - 1) / 2;
+}
+
+/**
+ * @brief Add a value to the histogram.
+ *
+ * @param value A latency in microseconds.
+ */
+void latency_histogram::record(uint64_t value) noexcept {
+  /* _count first, so that fill_and_reset() never removes from it a value it
+   * does not contain yet. */
+  _count.fetch_add(1, std::memory_order_relaxed);
+  _buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+  uint64_t m = _max.load(std::memory_order_relaxed);
+  while (value > m &&
+         !_max.compare_exchange_weak(m, value, std::memory_order_relaxed))
+    ;
+}
+
+/**
+ * @brief Number of values recorded since the histogram creation or its last
+ * reset.
+ *
+ * @return A number of values.
+ */
+uint64_t latency_histogram::count() const noexcept {
+  return _count.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief The greatest value recorded since the histogram creation or its last
+ * reset.
+ *
+ * @return A latency in microseconds.
+ */
+uint64_t latency_histogram::max() const noexcept {
+  return _max.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Compute the given percentile of a snapshot of the buckets.
+ *
+ * @param buckets The bucket counters.
+ * @param total The sum of the bucket counters.
+ * @param max The greatest value recorded in them.
+ * @param p A percentage in ]0, 100].
+ *
+ * @return A latency in microseconds, 0 if the snapshot is empty.
+ */
+uint64_t latency_histogram::_percentile(const snapshot& buckets,
+                                        uint64_t total,
+                                        uint64_t max,
+                                        double p) noexcept {
+  if (total == 0)
+    return 0;
+
+  uint64_t target = static_cast<uint64_t>(std::ceil(total * p / 100));
+  if (target == 0)
+    target = 1;
+  uint64_t sum = 0;
+  for (uint32_t i = 0; i < bucket_count; ++i) {
+    sum += buckets[i];
+    if (sum >= target) {
+      /* In the highest bucket, the max is a better estimation. */
+      return sum == total ? max : std::min(bucket_value(i), max);
+    }
+  }
+  return max;
+}
+
+/**
+ * @brief Compute the given percentile of the recorded values.
+ *
+ * @param p A percentage in ]0, 100].
+ *
+ * @return A latency in microseconds, 0 if the histogram is empty.
+ */
+uint64_t latency_histogram::percentile(double p) const noexcept {
+  uint64_t total = 0;
+  snapshot buckets;
+  for (uint32_t i = 0; i < bucket_count; ++i) {
+    buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+    total += buckets[i];
+  }
+  return _percentile(buckets, total, max(), p);
+}
+
+/**
+ * @brief Fill the given protobuf message with the main percentiles of a
+ * snapshot of the buckets. Values are converted in seconds.
+ *
+ * @param stats The message to fill.
+ * @param buckets The bucket counters.
+ * @param total The sum of the bucket counters.
+ * @param max The greatest value recorded in them.
+ */
+void latency_histogram::_fill(StageLatency* stats,
+                              const snapshot& buckets,
+                              uint64_t total,
+                              uint64_t max) noexcept {
+  stats->set_count(total);
+  stats->set_p50(_percentile(buckets, total, max, 50) / 1000000.0);
+  stats->set_p90(_percentile(buckets, total, max, 90) / 1000000.0);
+  stats->set_p99(_percentile(buckets, total, max, 99) / 1000000.0);
+  stats->set_max(max / 1000000.0);
+}
+
+/**
+ * @brief Fill the given protobuf message with the main percentiles of this
+ * histogram. Values are converted in seconds.
+ *
+ * @param stats The message to fill.
+ */
+void latency_histogram::fill(StageLatency* stats) const noexcept {
+  uint64_t total = 0;
+  snapshot buckets;
+  for (uint32_t i = 0; i < bucket_count; ++i) {
+    buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+    total += buckets[i];
+  }
+  _fill(stats, buckets, total, max());
+}
+
+/**
+ * @brief Fill the given protobuf message with the values recorded since the
+ * previous call and empty the histogram. Each bucket is taken and reset
+ * atomically, so a value recorded concurrently is counted in one window only.
+ *
+ * @param stats The message to fill.
+ */
+void latency_histogram::fill_and_reset(StageLatency* stats) noexcept {
+  uint64_t total = 0;
+  snapshot buckets;
+  for (uint32_t i = 0; i < bucket_count; ++i) {
+    buckets[i] = _buckets[i].exchange(0, std::memory_order_relaxed);
+    total += buckets[i];
+  }
+  _count.fetch_sub(total, std::memory_order_relaxed);
+  _fill(stats, buckets, total, _max.exchange(0, std::memory_order_relaxed));
+}
@@ -0,0 +1,198 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "com/centreon/broker/bbdo/status_delta.hh"
+#include "common/log_v2/log_v2.hh"
+
+using namespace com::centreon::broker;
+using com::centreon::common::log_v2::log_v2;
+using google::protobuf::util::MessageDifferencer;
+
+using pb_service_status = bbdo::status_delta::pb_service_status;
+using pb_host_status = bbdo::status_delta::pb_host_status;
+
+/**
+ * @brief send d through an encoder, serialize and unserialize it as the bbdo
+ * stream would do and rebuild it with the decoder
+ *
+ */
+static std::shared_ptr<io::data> transmit(bbdo::status_delta& encoder,
+                                          bbdo::status_delta& decoder,
+                                          const std::shared_ptr<io::data>& d) {
+  std::shared_ptr<io::data> sent = encoder.encode(d);
+  const io::event_info::event_operations* ops;
+  switch (sent->type()) {
+    case pb_service_status::static_type():
+      ops = &pb_service_status::operations;
+      break;
+    case bbdo::status_delta::pb_service_status_delta::static_type():
+      ops = &bbdo::status_delta::pb_service_status_delta::operations;
+      break;
+    case pb_host_status::static_type():
+      ops = &pb_host_status::operations;
+      break;
+    default:
+      ops = &bbdo::status_delta::pb_host_status_delta::operations;
+      break;
+  }
+  std::string buffer = ops->serialize(*sent);
+  std::shared_ptr<io::data> received(
+      ops->unserialize(buffer.data(), buffer.size()));
+  return decoder.decode(received);
+}
+
+/**
+ * @brief a service status as sent by cbmod after a check
+ *
+ */
+static std::shared_ptr<pb_service_status> make_service_status(
+    uint64_t host_id,
+    uint64_t service_id,
+    time_t now) {
+  auto ret = std::make_shared<pb_service_status>();
+  ServiceStatus& obj = ret->mut_obj();
+  obj.set_host_id(host_id);
+  obj.set_service_id(service_id);
+  obj.set_checked(true);
+  obj.set_state(ServiceStatus::OK);
+  obj.set_state_type(ServiceStatus::HARD);
+  obj.set_last_state_change(now - 86400);
+  obj.set_last_hard_state_change(now - 86400);
+  obj.set_last_time_ok(now);
+  obj.set_output(
+      "OK: Disk / - total: 49.98 GB used: 12.37 GB (24.75%) free: 37.61 GB");
+  obj.set_long_output("Partition / is OK\nPartition /var is OK");
+  obj.set_perfdata(
+      "'used'=12370MB;40000;45000;0;49980 'free'=37610MB;;;0;49980 "
+      "'used_prct'=24.75%;80;90;0;100");
+  obj.set_percent_state_change(0);
+  obj.set_latency(0.125);
+  obj.set_execution_time(0.347);
+  obj.set_last_check(now);
+  obj.set_next_check(now + 300);
+  obj.set_should_be_scheduled(true);
+  obj.set_check_attempt(1);
+  obj.set_internal_id(0);
+  return ret;
+}
+
+TEST(BbdoStatusDelta, ServiceRoundTrip) {
+  auto logger = log_v2::instance().get(log_v2::BBDO);
+  bbdo::status_delta encoder(logger), decoder(logger);
+
+  auto ss = make_service_status(12, 25, 1700000000);
+  auto received = transmit(encoder, decoder, ss);
+  ASSERT_EQ(received->type(), pb_service_status::static_type());
+  ASSERT_EQ(encoder.get_delta_count(), 0u);
+
+  // only check times change
+  ss = std::make_shared<pb_service_status>(*ss);
+  ss->mut_obj().set_last_check(1700000300);
+  ss->mut_obj().set_next_check(1700000600);
+  ss->mut_obj().set_last_time_ok(1700000300);
+  received = transmit(encoder, decoder, ss);
+  ASSERT_EQ(encoder.get_delta_count(), 1u);
+  ASSERT_EQ(decoder.get_delta_count(), 1u);
+  ASSERT_EQ(received->type(), pb_service_status::static_type());
+  ASSERT_TRUE(MessageDifferencer::Equals(
+      std::static_pointer_cast<pb_service_status>(received)->obj(),
+      ss->obj()));
+
+  // fields reset to their default value
+  ss = std::make_shared<pb_service_status>(*ss);
+  ss->mut_obj().set_long_output("");
+  ss->mut_obj().set_check_attempt(0);
+  ss->mut_obj().set_state(ServiceStatus::CRITICAL);
+  received = transmit(encoder, decoder, ss);
+  ASSERT_EQ(encoder.get_delta_count(), 2u);
+  ASSERT_TRUE(MessageDifferencer::Equals(
+      std::static_pointer_cast<pb_service_status>(received)->obj(),
+      ss->obj()));
+
+  // another service is not impacted
+  auto other = make_service_status(12, 26, 1700000000);
+  received = transmit(encoder, decoder, other);
+  ASSERT_EQ(encoder.get_delta_count(), 2u);
+  ASSERT_TRUE(MessageDifferencer::Equals(
+      std::static_pointer_cast<pb_service_status>(received)->obj(),
+      other->obj()));
+}
+
+TEST(BbdoStatusDelta, HostRoundTrip) {
+  auto logger = log_v2::instance().get(log_v2::BBDO);
+  bbdo::status_delta encoder(logger), decoder(logger);
+
+  auto hs = std::make_shared<pb_host_status>();
+  hs->mut_obj().set_host_id(12);
+  hs->mut_obj().set_output("OK - 127.0.0.1 rta 0.030ms lost 0%");
+  hs->mut_obj().set_perfdata("rta=0.030ms;3000.000;5000.000;0; pl=0%;80;100;0;100");
+  hs->mut_obj().set_last_check(1700000000);
+  transmit(encoder, decoder, hs);
+
+  hs = std::make_shared<pb_host_status>(*hs);
+  hs->mut_obj().set_last_check(1700000060);
+  auto received = transmit(encoder, decoder, hs);
+  ASSERT_EQ(encoder.get_delta_count(), 1u);
+  ASSERT_EQ(received->type(), pb_host_status::static_type());
+  ASSERT_TRUE(MessageDifferencer::Equals(
+      std::static_pointer_cast<pb_host_status>(received)->obj(), hs->obj()));
+}
+
+TEST(BbdoStatusDelta, UnknownResource) {
+  auto logger = log_v2::instance().get(log_v2::BBDO);
+  bbdo::status_delta encoder(logger), decoder(logger);
+
+  auto ss = make_service_status(12, 25, 1700000000);
+  encoder.encode(ss);
+  ss = std::make_shared<pb_service_status>(*ss);
+  ss->mut_obj().set_last_check(1700000300);
+  // decoder didn't receive the first full event
+  auto received = decoder.decode(encoder.encode(ss));
+  ASSERT_EQ(received->type(),
+            bbdo::status_delta::pb_service_status_delta::static_type());
+}
+
+/**
+ * @brief replay a stream of 10 checks of 10000 services where only one result
+ * in twenty has a new output, more than two thirds of the bytes must be saved
+ *
+ */
+TEST(BbdoStatusDelta, Bandwidth) {
+  auto logger = log_v2::instance().get(log_v2::BBDO);
+  bbdo::status_delta encoder(logger), decoder(logger);
+  constexpr unsigned nb_services = 10000;
+  constexpr unsigned nb_checks = 10;
+
+  for (unsigned check = 0; check < nb_checks; ++check) {
+    time_t now = 1700000000 + check * 300;
+    for (unsigned serv = 0; serv < nb_services; ++serv) {
+      auto ss = make_service_status(1 + serv / 20, 1 + serv, now);
+      ss->mut_obj().set_latency(0.001 * ((serv + check) % 17));
+      ss->mut_obj().set_execution_time(0.01 * ((serv * check) % 31));
+      if (!((serv + check) % 20))
+        ss->mut_obj().set_output(
+            fmt::format("OK: Disk / - used: {}.{} GB", serv % 50, check));
+      transmit(encoder, decoder, ss);
+    }
+  }
+  ASSERT_EQ(encoder.get_delta_count(), nb_services * (nb_checks - 1));
+  ASSERT_LT(encoder.get_sent_size(), encoder.get_full_size() / 3);
+}
@@ -0,0 +1,193 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/file/segment_splitter.hh"
+#include <gtest/gtest.h>
+#include "com/centreon/broker/exceptions/shutdown.hh"
+#include "com/centreon/broker/file/disk_accessor.hh"
+#include "com/centreon/broker/file/splitter.hh"
+#include "com/centreon/broker/misc/filesystem.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+
+class FileSegmentSplitter : public ::testing::Test {
+ public:
+  void SetUp() override {
+    file::disk_accessor::load(1000000u);
+    _path = "/tmp/segqueue";
+    _remove_files();
+  }
+
+  void TearDown() override {
+    _remove_files();
+    file::disk_accessor::unload();
+  }
+
+ protected:
+  std::string _path;
+
+  void _remove_files() {
+    std::list<std::string> parts{
+        misc::filesystem::dir_content_with_filter("/tmp/", "segqueue*")};
+    for (std::string const& f : parts)
+      std::remove(f.c_str());
+  }
+
+  static std::vector<char> _data(size_t size) {
+    std::vector<char> retval(size);
+    for (size_t i = 0; i < size; ++i)
+      retval[i] = i % 251;
+    return retval;
+  }
+
+  /* Read everything until the shutdown exception. */
+  static std::vector<char> _read_all(file::segment_splitter& f) {
+    std::vector<char> retval;
+    char buffer[1000];
+    try {
+      for (;;) {
+        long rb = f.read(buffer, sizeof(buffer));
+        retval.insert(retval.end(), buffer, buffer + rb);
+      }
+    } catch (const exceptions::shutdown&) {
+    }
+    return retval;
+  }
+};
+
+// Given a segment_splitter without any file
+// When read() is called
+// Then an exceptions::shutdown exception is thrown
+// And no file is created.
+TEST_F(FileSegmentSplitter, FirstReadNoData) {
+  file::segment_splitter f(_path, 20000, true);
+  char buffer[10];
+  ASSERT_THROW(f.read(buffer, sizeof(buffer)), exceptions::shutdown);
+  ASSERT_FALSE(misc::filesystem::file_exists(f.get_file_path(0)));
+}
+
+// Given a segment_splitter
+// When data smaller than a write batch are written
+// Then they are read back, they are taken from the write buffer if needed
+// And the segment is removed once read.
+TEST_F(FileSegmentSplitter, WriteThenRead) {
+  file::segment_splitter f(_path, 20000, true);
+  std::vector<char> data{_data(1000)};
+  ASSERT_EQ(f.write(data.data(), data.size()), 1000);
+  ASSERT_TRUE(misc::filesystem::file_exists(f.get_file_path(0)));
+  ASSERT_EQ(misc::filesystem::file_size(f.get_file_path(0)), 20000);
+  ASSERT_EQ(_read_all(f), data);
+  ASSERT_FALSE(misc::filesystem::file_exists(f.get_file_path(0)));
+}
+
+// Given a segment_splitter with segments of 20000 bytes
+// When 100000 bytes are written
+// Then several segments are created
+// And data are read back in the same order.
+TEST_F(FileSegmentSplitter, SplitInSegments) {
+  file::segment_splitter f(_path, 20000, true);
+  std::vector<char> data{_data(100000)};
+  for (size_t i = 0; i < data.size();)
+    i += f.write(data.data() + i, std::min<size_t>(700, data.size() - i));
+  ASSERT_GE(f.get_wid(), 6);
+  ASSERT_EQ(_read_all(f), data);
+  for (int i = 0; i <= f.get_wid(); ++i)
+    ASSERT_FALSE(misc::filesystem::file_exists(f.get_file_path(i)));
+}
+
+// Given a segment_splitter where data are written
+// When it is destroyed and a new one is created with the same path
+// Then the new one reads the data.
+TEST_F(FileSegmentSplitter, Resume) {
+  std::vector<char> data{_data(50000)};
+  {
+    file::segment_splitter f(_path, 20000, true);
+    for (size_t i = 0; i < data.size();)
+      i += f.write(data.data() + i, data.size() - i);
+  }
+  ASSERT_TRUE(file::segment_splitter::exists(_path));
+  file::segment_splitter f(_path, 20000, true);
+  ASSERT_EQ(_read_all(f), data);
+}
+
+// Given a stdio splitter whose first file part has been read and removed
+// When stdio files are looked for with the same path
+// Then they are found even if the base path does not exist anymore.
+TEST_F(FileSegmentSplitter, StdioPartsLeftBehind) {
+  std::vector<char> data{_data(50000)};
+  {
+    file::splitter f(_path, 10000, true);
+    for (size_t i = 0; i < data.size();)
+      i += f.write(data.data() + i, std::min<size_t>(1000, data.size() - i));
+    char buffer[1000];
+    long read = 0;
+    while (f.get_rid() == 0)
+      read += f.read(buffer, sizeof(buffer));
+    ASSERT_GT(read, 0);
+  }
+  ASSERT_FALSE(misc::filesystem::file_exists(_path));
+  ASSERT_TRUE(misc::filesystem::file_exists(_path + "1"));
+  ASSERT_TRUE(file::splitter::exists(_path));
+  ASSERT_FALSE(file::segment_splitter::exists(_path));
+}
+
+// Given a disk accessor limited to 50000 bytes
+// When a segment_splitter with segments of 20000 bytes needs a third segment
+// Then write() throws an exception.
+TEST_F(FileSegmentSplitter, DiskLimit) {
+  file::disk_accessor::unload();
+  file::disk_accessor::load(50000u);
+  file::segment_splitter f(_path, 20000, true);
+  std::vector<char> data{_data(100000)};
+  size_t written = 0;
+  ASSERT_THROW(
+      {
+        while (written < data.size())
+          written += f.write(data.data() + written, data.size() - written);
+      },
+      msg_fmt);
+  ASSERT_EQ(written, 2 * (20000 - file::segment_splitter::header_size));
+}
+
+// Given a segment_splitter
+// When a thread writes while another one reads
+// Then the reader gets all the data in the same order.
+TEST_F(FileSegmentSplitter, ConcurrentReadWrite) {
+  file::segment_splitter f(_path, 20000, true);
+  std::vector<char> data{_data(500000)};
+
+  std::thread writer([&f, &data] {
+    for (size_t i = 0; i < data.size();)
+      i += f.write(data.data() + i, std::min<size_t>(100, data.size() - i));
+  });
+
+  std::vector<char> result;
+  char buffer[1000];
+  while (result.size() < data.size()) {
+    try {
+      long rb = f.read(buffer, sizeof(buffer));
+      result.insert(result.end(), buffer, buffer + rb);
+    } catch (const exceptions::shutdown&) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+  writer.join();
+  ASSERT_EQ(result, data);
+}
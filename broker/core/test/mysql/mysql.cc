@@ -1595,6 +1595,69 @@ TEST_F(DatabaseStorageTest, BulkStatementWithNullStr) {
   }
 }
 
+// Given a mysql object and a bulk statement
+// When rows of its bind are replaced, some null values by real values
+// Then only the new values are written in the database.
+TEST_F(DatabaseStorageTest, BulkStatementWithReplacedRows) {
+  database_config db_cfg("MySQL", "127.0.0.1", MYSQL_SOCKET, 3306, "root",
+                         "centreon", "centreon_storage", 5, true, 5);
+  auto ms{std::make_unique<mysql>(db_cfg)};
+  if (ms->support_bulk_statement()) {
+    std::string query1{"DROP TABLE IF EXISTS ut_test"};
+    std::string query2{
+        "CREATE TABLE ut_test (id BIGINT UNSIGNED NOT NULL AUTO_INCREMENT "
+        "PRIMARY KEY, unit_name CHAR(30), value DOUBLE, warn FLOAT, crit "
+        "FLOAT, hidden enum('0', '1') DEFAULT '0', metric VARCHAR(30) "
+        "CHARACTER SET utf8mb4 DEFAULT NULL) DEFAULT CHARSET=utf8mb4"};
+    ms->run_query(query1);
+    ms->commit();
+    ms->run_query(query2);
+    ms->commit();
+
+    std::string query(
+        "INSERT INTO ut_test (unit_name, value, warn, crit, metric) VALUES "
+        "(?,?,?,?,?)");
+    mysql_bulk_stmt stmt(query);
+    ms->prepare_statement(stmt);
+
+    constexpr int TOTAL = 100;
+
+    auto bb = stmt.create_bind();
+    for (int j = 0; j < TOTAL; j++) {
+      bb->set_null_str(0);
+      bb->set_null_f64(1);
+      bb->set_value_as_f32(2, 12.0f);
+      bb->set_value_as_f32(3, 25.0f);
+      bb->set_value_as_str(4, "m");
+      bb->next_row();
+    }
+    for (int j = 0; j < TOTAL; j++) {
+      bb->set_current_row(j);
+      bb->set_value_as_str(0, fmt::format("unit_{}", j));
+      bb->set_value_as_f64(1, j);
+      bb->set_value_as_f32(2, 13.0f);
+      bb->set_value_as_f32(3, 26.0f);
+      bb->set_value_as_str(4, fmt::format("metric_{}", j));
+    }
+    bb->set_current_row(TOTAL);
+    ASSERT_EQ(bb->rows_count(), static_cast<size_t>(TOTAL));
+    stmt.set_bind(std::move(bb));
+    ms->run_statement(stmt);
+    ms->commit();
+    std::string query3{
+        "SELECT count(*) from ut_test WHERE unit_name = CONCAT('unit_', "
+        "CAST(value AS UNSIGNED)) AND warn = 13 AND crit = 26 AND metric = "
+        "CONCAT('metric_', CAST(value AS UNSIGNED))"};
+    std::promise<mysql_result> promise;
+    std::future<mysql_result> future = promise.get_future();
+    ms->run_query_and_get_result(query3, std::move(promise));
+    mysql_result res(future.get());
+
+    ASSERT_TRUE(ms->fetch_row(res));
+    ASSERT_EQ(res.value_as_i32(0), TOTAL);
+  }
+}
+
 TEST_F(DatabaseStorageTest, RepeatStatementsWithNull) {
   database_config db_cfg("MySQL", "127.0.0.1", MYSQL_SOCKET, 3306, "root",
                          "centreon", "centreon_storage", 5, true, 5);
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/stats/latency_histogram.hh"
+#include <gtest/gtest.h>
+
+using namespace com::centreon::broker;
+
+// Given values covering the whole range of a latency_histogram
+// When their bucket is computed
+// Then indexes are increasing and the bucket value is close to the value.
+TEST(StatsLatencyHistogram, Buckets) {
+  uint32_t previous = 0;
+  for (uint64_t v = 1; v < (1ull << 36); v += v / 7 + 1) {
+    uint32_t idx = stats::latency_histogram::bucket_index(v);
+    ASSERT_LT(idx, stats::latency_histogram::bucket_count);
+    ASSERT_GE(idx, previous);
+    previous = idx;
+    uint64_t bv = stats::latency_histogram::bucket_value(idx);
+    ASSERT_LE(std::abs(static_cast<double>(bv) - v) / v, 1.0 / 8);
+  }
+  ASSERT_EQ(stats::latency_histogram::bucket_index(1ull << 50),
+            stats::latency_histogram::bucket_count - 1);
+}
+
+// Given an empty latency_histogram
+// Then its percentiles are 0.
+TEST(StatsLatencyHistogram, Empty) {
+  stats::latency_histogram h;
+  ASSERT_EQ(h.count(), 0u);
+  ASSERT_EQ(h.percentile(50), 0u);
+  ASSERT_EQ(h.max(), 0u);
+}
+
+// Given a latency_histogram filled with values from 1 to 10000
+// When percentiles are computed
+// Then they are close to the exact ones.
+TEST(StatsLatencyHistogram, Percentiles) {
+  stats::latency_histogram h;
+  for (uint64_t v = 1; v <= 10000; ++v)
+    h.record(v);
+  ASSERT_EQ(h.count(), 10000u);
+  ASSERT_EQ(h.max(), 10000u);
+  ASSERT_NEAR(h.percentile(50), 5000, 5000 / 8);
+  ASSERT_NEAR(h.percentile(99), 9900, 9900 / 8);
+  ASSERT_EQ(h.percentile(100), 10000u);
+
+  StageLatency pb;
+  h.fill(&pb);
+  ASSERT_EQ(pb.count(), 10000u);
+  ASSERT_NEAR(pb.p50(), 0.005, 0.005 / 8);
+  ASSERT_DOUBLE_EQ(pb.max(), 0.01);
+}
+
+// Given a latency_histogram filled with values from 1 to 1000
+// When it is exported with fill_and_reset()
+// Then the export contains these values
+// And the next export only contains the values recorded after.
+TEST(StatsLatencyHistogram, FillAndReset) {
+  stats::latency_histogram h;
+  for (uint64_t v = 1; v <= 1000; ++v)
+    h.record(v);
+
+  StageLatency pb;
+  h.fill_and_reset(&pb);
+  ASSERT_EQ(pb.count(), 1000u);
+  ASSERT_DOUBLE_EQ(pb.max(), 0.001);
+  ASSERT_EQ(h.count(), 0u);
+  ASSERT_EQ(h.max(), 0u);
+  ASSERT_EQ(h.percentile(50), 0u);
+
+  h.record(10);
+  h.fill_and_reset(&pb);
+  ASSERT_EQ(pb.count(), 1u);
+  ASSERT_DOUBLE_EQ(pb.p50(), 0.00001);
+  ASSERT_DOUBLE_EQ(pb.max(), 0.00001);
+
+  h.fill_and_reset(&pb);
+  ASSERT_EQ(pb.count(), 0u);
+  ASSERT_EQ(pb.p99(), 0);
+}
+
+// Given a latency_histogram
+// When several threads record values concurrently
+// Then no value is lost.
+TEST(StatsLatencyHistogram, Concurrent) {
+  stats::latency_histogram h;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+    threads.emplace_back([&h, i] {
+      for (uint64_t v = 0; v < 100000; ++v)
+        h.record(v % 1000 + i);
+    });
+  for (auto& t : threads)
+    t.join();
+  ASSERT_EQ(h.count(), 400000u);
+  ASSERT_EQ(h.max(), 1002u);
+}
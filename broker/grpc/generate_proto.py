@@ -257,6 +257,8 @@ package com.centreon.broker.stream;
     fp.write(file_message_centreon_event)
     fp.write("""
     }
+    // several events sent in one message, only to peers that announce it
+    repeated CentreonEvent batch = 125;
     uint32 destination_id = 126;
     uint32 source_id = 127;
 }
@@ -32,13 +32,32 @@ class grpc_config : public com::centreon::common::grpc::grpc_config {
    */
   const bool _grpc_serialized;
 
+  /**
+   * @brief events waiting while a message is written are sent in one batch
+   * message of at most _batch_max_events events and _batch_max_size bytes.
+   * Batches are only sent to peers that announce they can read them.
+   * _batch_max_events = 0 disables batches.
+   *
+   */
+  const uint32_t _batch_max_events;
+  const uint32_t _batch_max_size;
+
  public:
   using pointer = std::shared_ptr<grpc_config>;
 
-  grpc_config() : _grpc_serialized(false) {}
+  static constexpr uint32_t default_batch_max_events = 1000;
+  // stays far below the 4MB grpc default max receive message size
+  static constexpr uint32_t default_batch_max_size = 1024 * 1024;
+
+  grpc_config()
+      : _grpc_serialized(false),
+        _batch_max_events(default_batch_max_events),
+        _batch_max_size(default_batch_max_size) {}
   grpc_config(const std::string& hostp)
       : com::centreon::common::grpc::grpc_config(hostp),
-        _grpc_serialized(false) {}
+        _grpc_serialized(false),
+        _batch_max_events(default_batch_max_events),
+        _batch_max_size(default_batch_max_size) {}
   grpc_config(const std::string& hostp,
               bool crypted,
               const std::string& certificate,
@@ -48,7 +67,9 @@ class grpc_config : public com::centreon::common::grpc::grpc_config {
               const std::string& ca_name,
               bool compression,
               int second_keepalive_interval,
-              bool grpc_serialized)
+              bool grpc_serialized,
+              uint32_t batch_max_events = default_batch_max_events,
+              uint32_t batch_max_size = default_batch_max_size)
       : com::centreon::common::grpc::grpc_config(hostp,
                                                  crypted,
                                                  certificate,
@@ -58,12 +79,16 @@ class grpc_config : public com::centreon::common::grpc::grpc_config {
                                                  compression,
                                                  second_keepalive_interval),
         _authorization(authorization),
-        _grpc_serialized(grpc_serialized) {}
+        _grpc_serialized(grpc_serialized),
+        _batch_max_events(batch_max_events),
+        _batch_max_size(batch_max_size) {}
 
   constexpr const std::string& get_authorization() const {
     return _authorization;
   }
   constexpr bool get_grpc_serialized() const { return _grpc_serialized; }
+  constexpr uint32_t get_batch_max_events() const { return _batch_max_events; }
+  constexpr uint32_t get_batch_max_size() const { return _batch_max_size; }
 };
 
 }  // namespace com::centreon::broker::grpc
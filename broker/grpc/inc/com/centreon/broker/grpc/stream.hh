@@ -32,6 +32,7 @@ std::ostream& operator<<(std::ostream&, const CentreonEvent&);
 namespace grpc {
 
 extern const std::string authorization_header;
+extern const std::string batch_header;
 
 struct detail_centreon_event;
 std::ostream& operator<<(std::ostream&, const detail_centreon_event&);
@@ -51,6 +52,7 @@ struct detail_centreon_event {
  * This the goal of this struct.
  * At destruction, it releases protobuf object from grpc_event.
  * Destruction of protobuf object is the job of shared_ptr<io::protobuf>
+ * In the same way, a batch message doesn't own the events of batched.
  */
 struct event_with_data {
   using pointer = std::shared_ptr<event_with_data>;
@@ -58,6 +60,7 @@ struct event_with_data {
   std::shared_ptr<io::data> bbdo_event;
   typedef google::protobuf::Message* (grpc_event_type::*releaser_type)();
   releaser_type releaser;
+  std::vector<pointer> batched;
 
   event_with_data() : releaser(nullptr) {}
 
@@ -72,6 +75,9 @@ struct event_with_data {
     if (releaser) {
       (grpc_event.*releaser)();
     }
+    while (!grpc_event.batch().empty()) {
+      grpc_event.mutable_batch()->ReleaseLast();
+    }
   }
 };
 
@@ -93,17 +99,25 @@ class stream : public io::stream,
   event_ptr _read_current;
   std::condition_variable _read_cond;
   std::mutex _read_m;
+  // number of batch messages received
+  std::atomic_uint64_t _read_batch_count = 0;
 
   std::atomic_bool _write_pending = false;
+  // message on the wire
+  event_with_data::pointer _write_current;
   std::condition_variable _write_cond;
   std::mutex _write_m;
 
+  // peer has told it can read batch messages
+  std::atomic_bool _peer_accepts_batch = false;
+
   grpc_config::pointer _conf;
   const std::string_view _class_name;
 
   std::mutex _protect;
 
   void start_write();
+  event_with_data::pointer pop_batch();
 
  protected:
   stream(const grpc_config::pointer& conf, const std::string_view& class_name);
@@ -122,6 +136,9 @@ class stream : public io::stream,
 
   void start_read();
 
+  void set_peer_accepts_batch(bool accepts);
+  uint64_t get_read_batch_count() const { return _read_batch_count; }
+
   // bireactor part
   void OnReadDone(bool ok) override;
 
@@ -149,6 +149,14 @@ service_impl::exchange(::grpc::CallbackServerContext* context) {
       std::make_shared<server_stream>(_conf, shared_from_this());
 
   server_stream::register_stream(next_stream);
+
+  // both sides tell they can read batch messages, old peers don't
+  if (context->client_metadata().find(batch_header) !=
+      context->client_metadata().end())
+    next_stream->set_peer_accepts_batch(true);
+  context->AddInitialMetadata(batch_header, "1");
+  next_stream->StartSendInitialMetadata();
+
   next_stream->start_read();
   {
     std::lock_guard l(_wait_m);
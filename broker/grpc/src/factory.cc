@@ -73,6 +73,34 @@ static std::string read_file(const std::string& path) {
     throw msg_fmt("Cannot open file '{}': {}", path, strerror(errno));
 }
 
+/**
+ *  Read an optional unsigned integer parameter of the endpoint.
+ *
+ *  @param[in] cfg           Endpoint configuration.
+ *  @param[in] name          Parameter name.
+ *  @param[in] default_value Value returned if parameter is absent.
+ *
+ *  @return Parameter value.
+ */
+static uint32_t read_uint_param(const config::endpoint& cfg,
+                                const std::string& name,
+                                uint32_t default_value) {
+  auto it = cfg.params.find(name);
+  if (it == cfg.params.end())
+    return default_value;
+  uint32_t value;
+  if (!absl::SimpleAtoi(it->second, &value)) {
+    log_v2::instance()
+        .get(log_v2::CORE)
+        ->error("GRPC: '{}' field should be an unsigned integer and not '{}'",
+                name, it->second);
+    throw msg_fmt(
+        "GRPC: '{}' field should be an unsigned integer and not '{}'", name,
+        it->second);
+  }
+  return value;
+}
+
 /**
  *  Create a new endpoint from a configuration.
  *
@@ -238,7 +266,11 @@ io::endpoint* factory::new_endpoint(
   grpc_config::pointer conf(std::make_shared<grpc_config>(
       hostport, encrypted, certificate, certificate_key, certificate_authority,
       authorization, ca_name, compression, keepalive_interval,
-      direct_grpc_serialized(cfg)));
+      direct_grpc_serialized(cfg),
+      read_uint_param(cfg, "batch_max_events",
+                      grpc_config::default_batch_max_events),
+      read_uint_param(cfg, "batch_max_size",
+                      grpc_config::default_batch_max_size)));
 
   std::unique_ptr<io::endpoint> endp;
 
@@ -470,7 +502,11 @@ io::endpoint* factory::_new_endpoint_bbdo_cs(
   grpc_config::pointer conf(std::make_shared<grpc_config>(
       hostport, encryption, certificate, private_key, ca_certificate,
       authorization, ca_name, compression, keepalive_interval,
-      direct_grpc_serialized(cfg)));
+      direct_grpc_serialized(cfg),
+      read_uint_param(cfg, "batch_max_events",
+                      grpc_config::default_batch_max_events),
+      read_uint_param(cfg, "batch_max_size",
+                      grpc_config::default_batch_max_size)));
 
   // Acceptor.
   std::unique_ptr<io::endpoint> endp;
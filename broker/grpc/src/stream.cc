@@ -95,6 +95,12 @@ std::ostream& operator<<(std::ostream& st,
 const std::string com::centreon::broker::grpc::authorization_header(
     "authorization");
 
+/**
+ * @brief this header is sent by a peer that can read batch messages
+ *
+ */
+const std::string com::centreon::broker::grpc::batch_header("centreon-batch");
+
 /**
  * @brief when BiReactor::OnDone is called by grpc layers, we should delete
  * this. But this object is even used by feeder or failover.
@@ -188,10 +194,23 @@ void stream<bireactor_class>::OnReadDone(bool ok) {
   if (ok) {
     {
       std::unique_lock l(_read_m);
-      SPDLOG_LOGGER_TRACE(_logger, "{:p} {} receive: {}",
-                          static_cast<const void*>(this), _class_name,
-                          *_read_current);
-      _read_queue.push(_read_current);
+      if (_read_current->batch().empty()) {
+        SPDLOG_LOGGER_TRACE(_logger, "{:p} {} receive: {}",
+                            static_cast<const void*>(this), _class_name,
+                            *_read_current);
+        _read_queue.push(_read_current);
+      } else {
+        SPDLOG_LOGGER_TRACE(_logger, "{:p} {} receive batch of {} events",
+                            static_cast<const void*>(this), _class_name,
+                            _read_current->batch().size());
+        ++_read_batch_count;
+        // events are moved out of the batch without copy
+        for (grpc_event_type& batched : *_read_current->mutable_batch()) {
+          event_ptr to_push = std::make_shared<grpc_event_type>();
+          to_push->Swap(&batched);
+          _read_queue.push(std::move(to_push));
+        }
+      }
       _read_current.reset();
     }
     _read_cond.notify_one();
@@ -257,7 +276,47 @@ bool stream<bireactor_class>::read(std::shared_ptr<io::data>& d,
 }
 
 /**
- * @brief peeks an event from write queue and pushes it on the wire
+ * @brief pops the events to send from write queue
+ * If peer accepts batches, all the events waiting in write queue are put in
+ * one batch message within configured limits, otherwise only the first one is
+ * popped.
+ * _write_m must be locked
+ *
+ * @tparam bireactor_class
+ * @return event_with_data::pointer message to send
+ */
+template <class bireactor_class>
+event_with_data::pointer stream<bireactor_class>::pop_batch() {
+  event_with_data::pointer first = _write_queue.front();
+  _write_queue.pop();
+  uint32_t max_events = _conf->get_batch_max_events();
+  if (!_peer_accepts_batch || _write_queue.empty() || max_events < 2)
+    return first;
+
+  size_t max_size = _conf->get_batch_max_size();
+  size_t batch_size = first->grpc_event.ByteSizeLong();
+  auto batch = std::make_shared<event_with_data>();
+  batch->batched.push_back(std::move(first));
+  while (!_write_queue.empty() && batch->batched.size() < max_events) {
+    size_t event_size = _write_queue.front()->grpc_event.ByteSizeLong();
+    if (batch_size + event_size > max_size)
+      break;
+    batch_size += event_size;
+    batch->batched.push_back(std::move(_write_queue.front()));
+    _write_queue.pop();
+  }
+  if (batch->batched.size() == 1)
+    return batch->batched.front();
+
+  // batched events are owned by batch->batched, they're released from
+  // grpc_event by event_with_data destructor
+  for (const event_with_data::pointer& to_add : batch->batched)
+    batch->grpc_event.mutable_batch()->AddAllocated(&to_add->grpc_event);
+  return batch;
+}
+
+/**
+ * @brief peeks events from write queue and pushes them on the wire
  * does nothing if a write is already pending
  *
  * @tparam bireactor_class
@@ -274,11 +333,15 @@ void stream<bireactor_class>::start_write() {
     if (_write_pending || _write_queue.empty()) {
       return;
     }
-    to_send = _write_queue.front();
+    to_send = _write_current = pop_batch();
     _write_pending = true;
   }
 
-  if (to_send->bbdo_event)
+  if (!to_send->batched.empty())
+    SPDLOG_LOGGER_TRACE(_logger, "{:p} {} write batch of {} events",
+                        static_cast<void*>(this), _class_name,
+                        to_send->batched.size());
+  else if (to_send->bbdo_event)
     SPDLOG_LOGGER_TRACE(_logger, "{:p} {} write: {}", static_cast<void*>(this),
                         _class_name, *to_send->bbdo_event);
   else
@@ -290,7 +353,7 @@ void stream<bireactor_class>::start_write() {
 
 /**
  * @brief write completion handler
- * if ok first element of write queue is popped and next event is pushed on the
+ * if ok the message written is released and next events are pushed on the
  * wire
  *
  * @tparam bireactor_class
@@ -301,8 +364,12 @@ void stream<bireactor_class>::OnWriteDone(bool ok) {
   if (ok) {
     {
       std::unique_lock l(_write_m);
-      event_with_data::pointer written = _write_queue.front();
-      if (written->bbdo_event)
+      event_with_data::pointer written = std::move(_write_current);
+      if (!written->batched.empty())
+        SPDLOG_LOGGER_TRACE(_logger, "{:p} {} write done: batch of {} events",
+                            static_cast<void*>(this), _class_name,
+                            written->batched.size());
+      else if (written->bbdo_event)
         SPDLOG_LOGGER_TRACE(_logger, "{:p} {} write done: {}",
                             static_cast<void*>(this), _class_name,
                             *written->bbdo_event);
@@ -311,7 +378,6 @@ void stream<bireactor_class>::OnWriteDone(bool ok) {
                             static_cast<void*>(this), _class_name,
                             written->grpc_event);
 
-      _write_queue.pop();
       _write_pending = false;
     };
     _write_cond.notify_one();
@@ -323,6 +389,21 @@ void stream<bireactor_class>::OnWriteDone(bool ok) {
   }
 }
 
+/**
+ * @brief called when peer has told it can read batch messages
+ *
+ * @tparam bireactor_class
+ * @param accepts
+ */
+template <class bireactor_class>
+void stream<bireactor_class>::set_peer_accepts_batch(bool accepts) {
+  SPDLOG_LOGGER_DEBUG(_logger, "{:p} {} peer {} batch messages",
+                      static_cast<void*>(this), _class_name,
+                      accepts ? "accepts" : "doesn't accept");
+  _peer_accepts_batch = accepts;
+  start_write();
+}
+
 /**
  * @brief push an event on write queue and start write
  *
@@ -457,7 +538,9 @@ template <class bireactor_class>
 bool stream<bireactor_class>::wait_for_all_events_written(unsigned ms_timeout) {
   std::unique_lock l(_write_m);
   return _write_cond.wait_for(l, std::chrono::milliseconds(ms_timeout),
-                              [this]() { return _write_queue.empty(); });
+                              [this]() {
+                                return _write_queue.empty() && !_write_pending;
+                              });
 }
 
 namespace com::centreon::broker::grpc {
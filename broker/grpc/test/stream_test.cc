@@ -168,6 +168,40 @@ TEST_P(grpc_test_server, ServerToClientSendReceive) {
   accepted->stop();
 }
 
+TEST_P(grpc_test_server, ClientToServerBurstSendReceive) {
+  com::centreon::broker::grpc::connector conn(conf);
+  std::shared_ptr<io::stream> client = conn.open();
+  std::shared_ptr<io::stream> accepted = s->open();
+  ASSERT_NE(accepted.get(), nullptr);
+
+  // events are written without waiting, most of them are sent in batches
+  std::vector<test_param> sent;
+  for (unsigned test_ind = 0; test_ind < 2000; ++test_ind) {
+    test_param param = GetParam();
+    param.buffer += "_";
+    param.buffer += std::to_string(test_ind);
+    client->write(create_event(param));
+    sent.push_back(std::move(param));
+  }
+
+  for (const test_param& param : sent) {
+    std::shared_ptr<io::data> receive;
+    bool read_ret = accepted->read(receive, time(nullptr) + 2);
+    COMPARE_EVENT(read_ret, receive, param);
+  }
+  ASSERT_TRUE(client->wait_for_all_events_written(1000));
+
+  // 2000 events can't be written one by one faster than they are queued
+  auto accepted_grpc = std::dynamic_pointer_cast<
+      com::centreon::broker::grpc::stream<::grpc::ServerBidiReactor<
+          com::centreon::broker::stream::CentreonEvent,
+          com::centreon::broker::stream::CentreonEvent>>>(accepted);
+  ASSERT_NE(accepted_grpc.get(), nullptr);
+  ASSERT_GT(accepted_grpc->get_read_batch_count(), 0u);
+  client->stop();
+  accepted->stop();
+}
+
 class grpc_comm_failure : public ::testing::TestWithParam<test_param> {
  protected:
   static std::unique_ptr<com::centreon::broker::grpc::acceptor> s;
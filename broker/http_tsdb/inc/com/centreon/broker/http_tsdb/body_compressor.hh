@@ -0,0 +1,63 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#ifndef CCB_HTTP_TSDB_BODY_COMPRESSOR_HH
+#define CCB_HTTP_TSDB_BODY_COMPRESSOR_HH
+
+struct z_stream_s;
+
+namespace com::centreon::broker {
+
+namespace http_tsdb {
+
+/**
+ * @brief compressor of request bodies
+ * The zlib context is allocated once and only reset between two requests.
+ * As requests can be sent by flush and write at the same time, compress is
+ * protected by a mutex.
+ *
+ */
+class body_compressor {
+ public:
+  enum algorithm { none, gzip, deflate };
+
+ private:
+  const algorithm _algorithm;
+  std::unique_ptr<z_stream_s> _stream;
+  std::mutex _protect;
+
+ public:
+  body_compressor(algorithm algo, int level);
+  body_compressor(const body_compressor&) = delete;
+  body_compressor& operator=(const body_compressor&) = delete;
+  ~body_compressor();
+
+  static algorithm parse_algorithm(const std::string_view& name);
+
+  algorithm get_algorithm() const { return _algorithm; }
+  std::string_view content_encoding() const;
+
+  void compress(const std::string& to_compress, std::string& compressed);
+};
+
+}  // namespace http_tsdb
+
+}  // namespace com::centreon::broker
+
+#endif  // !CCB_HTTP_TSDB_BODY_COMPRESSOR_HH
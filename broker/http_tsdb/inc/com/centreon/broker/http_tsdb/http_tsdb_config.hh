@@ -20,6 +20,7 @@
 #ifndef CCB_HTTP_TSDB_CONFIG_HH
 #define CCB_HTTP_TSDB_CONFIG_HH
 
+#include "body_compressor.hh"
 #include "column.hh"
 #include "com/centreon/common/http/http_config.hh"
 
@@ -33,6 +34,10 @@ class http_tsdb_config : public common::http::http_config {
   unsigned _max_queries_per_transaction;
   std::vector<column> _status_columns;
   std::vector<column> _metric_columns;
+  body_compressor::algorithm _body_compression = body_compressor::none;
+  int _body_compression_level = -1;
+  // bodies smaller than this size are not compressed
+  unsigned _body_compression_threshold = 1024;
 
  public:
   http_tsdb_config(const common::http::http_config& http_conf,
@@ -69,6 +74,21 @@ class http_tsdb_config : public common::http::http_config {
   const std::vector<column>& get_metric_columns() const {
     return _metric_columns;
   }
+
+  void set_body_compression(body_compressor::algorithm algo,
+                            int level,
+                            unsigned threshold) {
+    _body_compression = algo;
+    _body_compression_level = level;
+    _body_compression_threshold = threshold;
+  }
+  body_compressor::algorithm get_body_compression() const {
+    return _body_compression;
+  }
+  int get_body_compression_level() const { return _body_compression_level; }
+  unsigned get_body_compression_threshold() const {
+    return _body_compression_threshold;
+  }
 };
 }  // namespace http_tsdb
 
@@ -37,6 +37,11 @@ class request : public http::request_base {
  protected:
   unsigned _nb_metric;
   unsigned _nb_status;
+  // when body is compressed, uncompressed body is kept here in order to be
+  // appended to the next request in case of failure
+  std::string _raw_body;
+  // an empty body can be compressed, so _raw_body emptiness can't be used
+  bool _body_compressed = false;
 
  public:
   using pointer = std::shared_ptr<request>;
@@ -57,6 +62,13 @@ class request : public http::request_base {
 
   virtual void append(const request::pointer& data_to_append);
 
+  void compress_body(body_compressor& compressor);
+  void restore_raw_body();
+  bool is_body_compressed() const { return _body_compressed; }
+  size_t get_raw_body_size() const {
+    return is_body_compressed() ? _raw_body.length() : body().length();
+  }
+
   unsigned get_nb_metric() const { return _nb_metric; }
   unsigned get_nb_status() const { return _nb_status; }
   unsigned get_nb_data() const { return _nb_metric + _nb_status; }
@@ -84,6 +96,9 @@ class stream : public io::stream, public std::enable_shared_from_this<stream> {
 
   http::client::pointer _http_client;
 
+  // null if body compression is not configured
+  std::unique_ptr<body_compressor> _body_compressor;
+
   // number of metric and status sent to tsdb and acknowledged by a 20x response
   unsigned _acknowledged;
   // the current request that buffers metric to send
@@ -105,6 +120,8 @@ class stream : public io::stream, public std::enable_shared_from_this<stream> {
   stat _failed_request_stat;
   stat _metric_stat;
   stat _status_stat;
+  stat _raw_bytes_stat;
+  stat _sent_bytes_stat;
 
   /*
    * @brief this cless calc an average over a period
@@ -122,6 +139,8 @@ class stream : public io::stream, public std::enable_shared_from_this<stream> {
   stat_average _connect_avg;
   stat_average _send_avg;
   stat_average _recv_avg;
+  // body compression time in microseconds
+  stat_average _compress_avg;
 
   mutable std::mutex _protect;
 
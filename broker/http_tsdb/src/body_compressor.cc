@@ -0,0 +1,129 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <zlib.h>
+
+#include "com/centreon/broker/http_tsdb/body_compressor.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker::http_tsdb;
+
+/**
+ * @brief Construct a new body compressor
+ *
+ * @param algo gzip or deflate (none is accepted but compress must not be
+ * called)
+ * @param level zlib compression level from 1 to 9, -1 for default
+ */
+body_compressor::body_compressor(algorithm algo, int level)
+    : _algorithm(algo) {
+  if (_algorithm == none) {
+    return;
+  }
+  if (level < -1 || level > 9) {
+    level = Z_DEFAULT_COMPRESSION;
+  }
+  _stream = std::make_unique<z_stream_s>();
+  _stream->zalloc = Z_NULL;
+  _stream->zfree = Z_NULL;
+  _stream->opaque = Z_NULL;
+  // 15 is the max window size, +16 asks zlib to write a gzip header
+  int res = deflateInit2(_stream.get(), level, Z_DEFLATED,
+                         _algorithm == gzip ? 15 + 16 : 15, 8,
+                         Z_DEFAULT_STRATEGY);
+  if (res != Z_OK) {
+    _stream.reset();
+    throw msg_fmt("fail to initialize body compressor: {}", res);
+  }
+}
+
+body_compressor::~body_compressor() {
+  if (_stream) {
+    deflateEnd(_stream.get());
+  }
+}
+
+/**
+ * @brief convert a configuration value to an algorithm
+ *
+ * @param name none, gzip or deflate
+ * @return body_compressor::algorithm
+ * @throw msg_fmt if name is unknown
+ */
+body_compressor::algorithm body_compressor::parse_algorithm(
+    const std::string_view& name) {
+  if (name.empty() || absl::EqualsIgnoreCase(name, "none")) {
+    return none;
+  }
+  if (absl::EqualsIgnoreCase(name, "gzip")) {
+    return gzip;
+  }
+  if (absl::EqualsIgnoreCase(name, "deflate")) {
+    return deflate;
+  }
+  throw msg_fmt("unknown body compression: {}, allowed: none, gzip, deflate",
+                name);
+}
+
+/**
+ * @brief value of Content-Encoding header
+ *
+ * @return std::string_view
+ */
+std::string_view body_compressor::content_encoding() const {
+  switch (_algorithm) {
+    case gzip:
+      return "gzip";
+    case deflate:
+      return "deflate";
+    default:
+      return "identity";
+  }
+}
+
+/**
+ * @brief compress to_compress in compressed
+ * compressed buffer is reused, its content is replaced
+ *
+ * @param to_compress
+ * @param compressed
+ */
+void body_compressor::compress(const std::string& to_compress,
+                               std::string& compressed) {
+  if (!_stream) {
+    throw msg_fmt("body compressor not initialized");
+  }
+  std::lock_guard<std::mutex> l(_protect);
+  deflateReset(_stream.get());
+  compressed.resize(deflateBound(_stream.get(), to_compress.length()));
+  _stream->next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(to_compress.data()));
+  _stream->avail_in = to_compress.length();
+  _stream->next_out = reinterpret_cast<Bytef*>(compressed.data());
+  _stream->avail_out = compressed.length();
+  // output buffer is large enough to compress all in one call
+  int res = ::deflate(_stream.get(), Z_FINISH);
+  if (res != Z_STREAM_END) {
+    compressed.clear();
+    throw msg_fmt("fail to compress {} bytes: {}", to_compress.length(), res);
+  }
+  compressed.resize(_stream->total_out);
+}
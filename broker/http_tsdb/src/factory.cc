@@ -131,6 +131,13 @@ static const absl::flat_hash_map<std::string, asio::ssl::context_base::method>
  *      - tls
  *      .
  *  - "certificate_path" -> http_config._certificate_path
+ *  - "body_compression" -> http_tsdb_config._body_compression
+ *    allowed values are none (default), gzip and deflate
+ *  - "body_compression_level" -> http_tsdb_config._body_compression_level
+ *    from 1 to 9, -1 (default) for zlib default level
+ *  - "body_compression_threshold" ->
+ *    http_tsdb_config._body_compression_threshold bodies smaller than this
+ *    size in bytes are sent uncompressed (1024 by default)
  *  .
  * @throw if db_user or db_password or db_host aren't found in cfg
  * @param cfg
@@ -251,9 +258,21 @@ void factory::create_conf(const config::endpoint& cfg,
       0, default_http_keepalive_duration, max_connections, ssl_method,
       certificate_path);
 
+  body_compressor::algorithm body_compression = body_compressor::none;
+  it = cfg.params.find("body_compression");
+  if (it != cfg.params.end()) {
+    body_compression = body_compressor::parse_algorithm(it->second);
+  }
+  int body_compression_level = -1;
+  extract_int(cfg, "body_compression_level", body_compression_level);
+  unsigned body_compression_threshold = 1024;
+  extract_int(cfg, "body_compression_threshold", body_compression_threshold);
+
   conf =
       http_tsdb_config(http_cfg, target, user, passwd, queries_per_transaction,
                        status_column_list, metric_column_list);
+  conf.set_body_compression(body_compression, body_compression_level,
+                            body_compression_threshold);
 }
 
 std::vector<column> factory::get_columns(const json& cfg) {
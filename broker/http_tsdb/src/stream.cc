@@ -40,6 +40,8 @@ using namespace com::centreon::broker::http_tsdb;
  * @param data_to_append
  */
 void request::append(const request::pointer& data_to_append) {
+  restore_raw_body();
+  data_to_append->restore_raw_body();
   body() += data_to_append->body();
   _nb_metric += data_to_append->_nb_metric;
   _nb_status += data_to_append->_nb_status;
@@ -50,6 +52,43 @@ void request::dump(std::ostream& stream) const {
   stream << " nb metric: " << _nb_metric << " nb status:" << _nb_status;
 }
 
+/**
+ * @brief replace body by its compressed version and set Content-Encoding
+ * uncompressed body is kept in _raw_body
+ *
+ * @param compressor
+ */
+void request::compress_body(body_compressor& compressor) {
+  if (is_body_compressed()) {
+    return;
+  }
+  _raw_body.swap(body());
+  try {
+    compressor.compress(_raw_body, body());
+  } catch (const std::exception&) {
+    body().swap(_raw_body);
+    _raw_body.clear();
+    throw;
+  }
+  set(boost::beast::http::field::content_encoding,
+      compressor.content_encoding());
+  _body_compressed = true;
+}
+
+/**
+ * @brief if body is compressed, restore the uncompressed body and erase
+ * Content-Encoding
+ *
+ */
+void request::restore_raw_body() {
+  if (is_body_compressed()) {
+    body().swap(_raw_body);
+    _raw_body.clear();
+    erase(boost::beast::http::field::content_encoding);
+    _body_compressed = false;
+  }
+}
+
 /************************************************************************
  *      statistics
  ************************************************************************/
@@ -129,9 +168,17 @@ stream::stream(const std::string& name,
       _success_request_stat{{0, 0}, {0, 0}},
       _failed_request_stat{{0, 0}, {0, 0}},
       _metric_stat{{0, 0}, {0, 0}},
-      _status_stat{{0, 0}, {0, 0}} {
+      _status_stat{{0, 0}, {0, 0}},
+      _raw_bytes_stat{{0, 0}, {0, 0}},
+      _sent_bytes_stat{{0, 0}, {0, 0}} {
   _http_client =
       common::http::client::load(io_context, logger, conf, conn_creator);
+  if (conf->get_body_compression() != body_compressor::none) {
+    _body_compressor = std::make_unique<body_compressor>(
+        conf->get_body_compression(), conf->get_body_compression_level());
+    SPDLOG_LOGGER_INFO(logger, "{} request bodies compressed with {}", name,
+                       _body_compressor->content_encoding());
+  }
 }
 
 stream::~stream() {}
@@ -196,10 +243,13 @@ void stream::statistics(nlohmann::json& tree) const {
   tree["failed_request"] = _failed_request_stat[0].value;
   tree["metric_sent"] = _metric_stat[0].value;
   tree["status_sent"] = _status_stat[0].value;
+  tree["raw_bytes"] = _raw_bytes_stat[0].value;
+  tree["sent_bytes"] = _sent_bytes_stat[0].value;
 
   extract_stat("avg_connect_ms", _connect_avg);
   extract_stat("avg_send_ms", _send_avg);
   extract_stat("avg_connect_ms", _recv_avg);
+  extract_stat("avg_compress_us", _compress_avg);
 }
 
 /**
@@ -314,11 +364,28 @@ int32_t stream::stop() {
 
 /**
  * @brief send request to tsdb
- * it only calculates content-length of the request before sending it
+ * it compresses the body if it's configured and if body is large enough and
+ * calculates content-length of the request before sending it
  *
  * @param request
  */
 void stream::send_request(const request::pointer& request) {
+  if (_body_compressor && request->body().length() >=
+                              _conf->get_body_compression_threshold()) {
+    try {
+      auto start = std::chrono::steady_clock::now();
+      request->compress_body(*_body_compressor);
+      unsigned compress_us =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count();
+      std::lock_guard<std::mutex> l(_protect);
+      _compress_avg.add_point(compress_us);
+    } catch (const std::exception& e) {
+      SPDLOG_LOGGER_ERROR(_logger, "{} send uncompressed body: {}", get_name(),
+                          e.what());
+    }
+  }
   request->content_length(request->body().length());
   _http_client->send(request, [me = shared_from_this(), request](
                                   const boost::beast::error_code& err,
@@ -373,6 +440,8 @@ void stream::send_handler(const boost::beast::error_code& err,
     std::lock_guard<std::mutex> l(_protect);
     add_to_stat(_failed_request_stat, 1);
     actu_stat_avg();
+    // request will be compressed again when resent
+    request->restore_raw_body();
     if (_request) {  // we musn't lost any data
       request->append(_request);
     }
@@ -384,6 +453,8 @@ void stream::send_handler(const boost::beast::error_code& err,
     add_to_stat(_success_request_stat, 1);
     add_to_stat(_metric_stat, request->get_nb_metric());
     add_to_stat(_status_stat, request->get_nb_status());
+    add_to_stat(_raw_bytes_stat, request->get_raw_body_size());
+    add_to_stat(_sent_bytes_stat, request->body().length());
     actu_stat_avg();
     _acknowledged += request->get_nb_data();
   }
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include "com/centreon/broker/http_tsdb/body_compressor.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::http_tsdb;
+
+/**
+ * @brief uncompress a gzip or zlib buffer
+ *
+ */
+static std::string inflate_body(const std::string& compressed) {
+  z_stream strm{};
+  // 15 + 32 => auto detect gzip or zlib header
+  EXPECT_EQ(inflateInit2(&strm, 15 + 32), Z_OK);
+  std::string ret;
+  char buff[4096];
+  strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+  strm.avail_in = compressed.length();
+  int res;
+  do {
+    strm.next_out = reinterpret_cast<Bytef*>(buff);
+    strm.avail_out = sizeof(buff);
+    res = inflate(&strm, Z_NO_FLUSH);
+    EXPECT_TRUE(res == Z_OK || res == Z_STREAM_END);
+    ret.append(buff, sizeof(buff) - strm.avail_out);
+  } while (res == Z_OK);
+  inflateEnd(&strm);
+  return ret;
+}
+
+/**
+ * @brief generate a victoria metrics like body
+ *
+ */
+static std::string generate_body(unsigned nb_lines) {
+  std::string ret;
+  for (unsigned line = 0; line < nb_lines; ++line) {
+    ret += fmt::format(
+        "metric,id={},name=metric\\ {},host_id={},serv_id={},unit=ms,"
+        "severity_id=3 val={} {}\n",
+        1000 + line, line % 17, line / 100, line % 100, (line * 7919) % 1000,
+        1674715597 + line / 1000);
+  }
+  return ret;
+}
+
+TEST(http_tsdb_body_compressor, parse) {
+  ASSERT_EQ(body_compressor::parse_algorithm(""), body_compressor::none);
+  ASSERT_EQ(body_compressor::parse_algorithm("None"), body_compressor::none);
+  ASSERT_EQ(body_compressor::parse_algorithm("gzip"), body_compressor::gzip);
+  ASSERT_EQ(body_compressor::parse_algorithm("DEFLATE"),
+            body_compressor::deflate);
+  ASSERT_THROW(body_compressor::parse_algorithm("lz4"), msg_fmt);
+}
+
+TEST(http_tsdb_body_compressor, reuse_context) {
+  for (body_compressor::algorithm algo :
+       {body_compressor::gzip, body_compressor::deflate}) {
+    body_compressor compressor(algo, -1);
+    std::string compressed;
+    for (unsigned nb_lines : {0, 1, 10, 10000, 5}) {
+      std::string body = generate_body(nb_lines);
+      compressor.compress(body, compressed);
+      ASSERT_EQ(inflate_body(compressed), body);
+    }
+  }
+}
+
+/**
+ * @brief a 1000 points body is well compressed and higher levels don't give
+ * bigger payloads
+ *
+ */
+TEST(http_tsdb_body_compressor, size) {
+  std::string body = generate_body(1000);
+  std::string compressed;
+  size_t previous_size = body.length();
+  for (int level : {1, 6, 9}) {
+    body_compressor compressor(body_compressor::gzip, level);
+    compressor.compress(body, compressed);
+    ASSERT_LT(compressed.length(), body.length() / 3);
+    ASSERT_LE(compressed.length(), previous_size);
+    previous_size = compressed.length();
+  }
+}
@@ -114,6 +114,27 @@ TEST_F(http_tsdb_stream_test, NotRead) {
   ASSERT_THROW(test.read(d, 0), msg_fmt);
 }
 
+TEST_F(http_tsdb_stream_test, CompressEmptyBody) {
+  // Given an empty request and a gzip compressor (threshold 0)
+  request_test req;
+  http_tsdb::body_compressor compressor(http_tsdb::body_compressor::gzip, -1);
+
+  // When the empty body is compressed
+  req.compress_body(compressor);
+
+  // Then body and Content-Encoding agree
+  ASSERT_TRUE(req.is_body_compressed());
+  ASSERT_FALSE(req.body().empty());
+  ASSERT_EQ(req[boost::beast::http::field::content_encoding], "gzip");
+  ASSERT_EQ(req.get_raw_body_size(), 0u);
+
+  // And restoring it gives back an empty body without Content-Encoding
+  req.restore_raw_body();
+  ASSERT_FALSE(req.is_body_compressed());
+  ASSERT_TRUE(req.body().empty());
+  ASSERT_EQ(req.find(boost::beast::http::field::content_encoding), req.end());
+}
+
 class connection_send_bagot : public http::connection_base {
   asio::ip::tcp::socket _not_used;
 
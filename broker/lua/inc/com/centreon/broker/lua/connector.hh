@@ -38,13 +38,17 @@ class connector : public io::endpoint {
   connector& operator=(connector const&) = delete;
   void connect_to(std::string const& lua_script,
                   std::map<std::string, misc::variant> const& cfg_params,
-                  std::shared_ptr<persistent_cache> const& cache);
+                  std::shared_ptr<persistent_cache> const& cache,
+                  uint32_t shards = 1,
+                  bool shard_by_service = false);
   std::shared_ptr<io::stream> open() override;
 
  private:
   std::string _lua_script;
   std::map<std::string, misc::variant> _conf_params;
   std::shared_ptr<persistent_cache> _cache;
+  uint32_t _shards;
+  bool _shard_by_service;
 };
 
 }  // namespace com::centreon::broker::lua
@@ -41,11 +41,14 @@ namespace com::centreon::broker::lua {
  *  * the script to load (just its file name).
  *  * the configuration parameters given as a map.
  *  * a macro_cache object (used to store the cache...).
+ *  * an optional feed_cache flag, false when the cache is fed by the caller
+ *    because it is shared between several Lua states.
  *
  *  At the construction, the script is read. We check also that it contains:
  *  * a global function init(conf) : this one is mandatory. conf is a Lua table
  *    containing the configuration set in the web configuration of broker.
- *  * a global function write(d) : this one is mandatory. if the v1 api is used,
+ *  * a global function write(d) : this one is mandatory unless write_batch() is
+ *    defined. if the v1 api is used,
  *    d is a Lua table that reprensents a transformed Broker event. In case of
  *    v2 api, d is a Lua userdata containing directly the Broker event. The api
  *    allows the user to use this event as if it was a Lua table. To choose what
@@ -79,6 +82,16 @@ namespace com::centreon::broker::lua {
  *    queue and events are acknowledged so it will be possible again to call the
  *    write() function.
  *
+ *  * a global write_batch(events) : this one is not mandatory. When defined,
+ *    broker does not call write() anymore but accumulates the events accepted
+ *    by the filter and gives them to write_batch() as a Lua array, in the same
+ *    format as write() would have received them. The array is sent when it
+ *    contains broker_batch_size events (a global variable of the script, 1000
+ *    by default, 100000 at most) or when broker flushes the stream. In this
+ *    mode, filter() is called only once per event type and its result is
+ *    kept, so it must only depend on its arguments. write_batch() returns true
+ *    to acknowledge all the events received until now.
+ *
  */
 class luabinding {
   // The Lua state machine.
@@ -90,9 +103,25 @@ class luabinding {
   // True if there is a flush() function in the Lua script.
   bool _flush;
 
+  // True if there is a write_batch() function in the Lua script.
+  bool _write_batch;
+
+  // Number of events given at most to write_batch() in one call.
+  static constexpr uint32_t max_batch_size = 100000u;
+  uint32_t _batch_size;
+
+  // Events waiting to be given to write_batch().
+  std::vector<std::shared_ptr<io::data>> _batch;
+
+  // Results of filter() by event type, only used with write_batch().
+  absl::flat_hash_map<uint32_t, bool> _filter_results;
+
   // The cache.
   macro_cache& _cache;
 
+  // True if write() has to give events to the cache.
+  bool _feed_cache;
+
   // Count on events
   int32_t _total;
 
@@ -106,17 +135,21 @@ class luabinding {
   void _load_script(const std::string& lua_script);
   void _init_script(std::map<std::string, misc::variant> const& conf_params);
   void _update_lua_path(std::string const& path);
+  bool _call_filter(uint16_t cat, uint16_t elem, bool& accepted) noexcept;
+  int32_t _send_batch() noexcept;
 
  public:
   luabinding(std::string const& lua_script,
              std::map<std::string, misc::variant> const& conf_params,
-             macro_cache& cache);
+             macro_cache& cache,
+             bool feed_cache = true);
   luabinding(luabinding const&) = delete;
   luabinding& operator=(luabinding const&) = delete;
   ~luabinding() noexcept;
   bool has_filter() const noexcept;
   int32_t write(std::shared_ptr<io::data> const& data) noexcept;
   bool has_flush() const noexcept;
+  bool has_write_batch() const noexcept;
   int32_t flush() noexcept;
   int32_t stop();
 };
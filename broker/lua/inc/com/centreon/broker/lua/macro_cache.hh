@@ -19,6 +19,8 @@
 #ifndef CCB_LUA_MACRO_CACHE_HH
 #define CCB_LUA_MACRO_CACHE_HH
 
+#include <shared_mutex>
+
 #include "bbdo/bam/dimension_truncate_table_signal.hh"
 #include "com/centreon/broker/bam/internal.hh"
 #include "com/centreon/broker/lua/internal.hh"
@@ -79,12 +81,21 @@ class macro_cache {
   absl::flat_hash_map<uint64_t, std::shared_ptr<bam::pb_dimension_bv_event>>
       _dimension_bv_events;
 
+  /* Set when the cache is shared by several Lua states running in parallel.
+   * Writers then take _shared_m exclusively, readers take it with
+   * read_lock(), and hosts/services are copied before being updated so that
+   * an object already given to a Lua state never changes. */
+  bool _shared = false;
+  mutable std::shared_mutex _shared_m;
+
  public:
   macro_cache(const std::shared_ptr<persistent_cache>& cache);
   macro_cache(const macro_cache&) = delete;
   ~macro_cache();
 
   void write(std::shared_ptr<io::data> const& data);
+  void set_shared();
+  std::shared_lock<std::shared_mutex> read_lock() const;
 
   const storage::pb_index_mapping& get_index_mapping(uint64_t index_id) const;
   const std::shared_ptr<storage::pb_metric_mapping>& get_metric_mapping(
@@ -124,6 +135,22 @@ class macro_cache {
  private:
   macro_cache& operator=(macro_cache const& f);
 
+  /**
+   * @brief Get an object of the cache to update it. If the cache is shared,
+   * the object is replaced by a copy first.
+   *
+   * @tparam T The type of the object.
+   * @param d The cache entry.
+   *
+   * @return The object to update.
+   */
+  template <typename T>
+  T& _own(std::shared_ptr<io::data>& d) {
+    if (_shared)
+      d = std::make_shared<T>(*std::static_pointer_cast<T>(d));
+    return *std::static_pointer_cast<T>(d);
+  }
+
   void _process_instance(std::shared_ptr<io::data> const& data);
   void _process_pb_instance(std::shared_ptr<io::data> const& data);
   void _process_host(std::shared_ptr<io::data> const& data);
@@ -47,20 +47,84 @@ namespace com::centreon::broker::lua {
  *
  *  When the flush flag is false, and the queue is empty, if it is not time to
  *  exit, the thread waits for 500ms before rechecking events.
+ *
+ *  When configured with several shards, the script is loaded in as many Lua
+ *  states, each one running in its own thread. Events are dispatched to them
+ *  by host (or by host and service), so events concerning the same object are
+ *  always given in order to the same state. The macro cache is shared: each
+ *  shard writes an event into it just before giving it to its Lua state, so
+ *  the state of an object seen from Lua is never ahead of the event being
+ *  processed. Events without host (instances, groups, mappings...) are
+ *  written into the cache by the stream as soon as they are received, since
+ *  all the shards may need them. Shards acknowledge their own events, the
+ *  stream returns to the muxer the longest acknowledged sequence at the
+ *  beginning of its queue.
  */
 class stream : public io::stream {
-  /* The Lua engine */
-  luabinding _luabinding;
+  /* An event and true if the shard has to write it into the cache. */
+  using routed_event = std::pair<std::shared_ptr<io::data>, bool>;
+
+  /* A Lua state and its thread, used when the connector is sharded. */
+  struct shard {
+    std::unique_ptr<luabinding> binding;
+    std::thread thread;
+
+    /* Events prepared by the stream, not yet given to the shard. */
+    std::vector<routed_event> outgoing;
+
+    std::mutex queue_m;
+    std::condition_variable queue_cv;
+    std::vector<routed_event> queue;
+    bool flush = false;
+    bool exit = false;
+
+    /* Events acknowledged by the Lua script, not yet seen by the stream. */
+    std::atomic_int32_t acks{0};
+  };
+
+  /* Number of events dispatched to the shards at once. */
+  static constexpr size_t dispatch_size = 128;
 
   std::shared_ptr<spdlog::logger> _logger;
 
   /* Macro cache */
   macro_cache _cache;
 
+  /* The Lua engine, when the stream is not sharded */
+  std::unique_ptr<luabinding> _luabinding;
+
+  /* The Lua engines, when the stream is sharded */
+  std::vector<std::unique_ptr<shard>> _shards;
+  bool _shard_by_service;
+  bool _shards_stopped;
+
+  /* Number of events received but not yet dispatched to the shards. */
+  size_t _pending;
+
+  /* The shard of each event not yet acknowledged, in the queue order. */
+  std::deque<uint32_t> _routing;
+
+  /* Acknowledgements received from each shard, not yet returned. */
+  std::vector<int32_t> _shard_acks;
+
+  /* host_id and service_id fields of protobuf events, by event type. */
+  absl::flat_hash_map<uint32_t,
+                      std::pair<const google::protobuf::FieldDescriptor*,
+                                const google::protobuf::FieldDescriptor*>>
+      _key_fields;
+
+  uint32_t _shard_of(const io::data& d, bool* has_host);
+  void _dispatch();
+  int32_t _collect_acks();
+  void _stop_shards();
+  void _run(shard* s);
+
  public:
   stream(std::string const& lua_script,
          std::map<std::string, misc::variant> const& conf_params,
-         std::shared_ptr<persistent_cache> const& cache);
+         std::shared_ptr<persistent_cache> const& cache,
+         uint32_t shards = 1,
+         bool shard_by_service = false);
   ~stream() noexcept;
   stream& operator=(const stream&) = delete;
   stream(const stream&) = delete;
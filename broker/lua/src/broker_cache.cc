@@ -48,6 +48,7 @@ static int l_broker_cache_get_ba_v1(lua_State* L) {
       *static_cast<macro_cache**>(luaL_checkudata(L, 1, "lua_broker_cache")));
   int ba_id(luaL_checkinteger(L, 2));
 
+  auto lck = cache->read_lock();
   try {
     const DimensionBaEvent& ba(cache->get_dimension_ba_event(ba_id)->obj());
     lua_createtable(L, 0, 7);
@@ -72,7 +73,12 @@ static int l_broker_cache_get_ba_v2(lua_State* L) {
   int ba_id(luaL_checkinteger(L, 2));
 
   try {
-    broker_event::create(L, cache->get_dimension_ba_event(ba_id));
+    std::shared_ptr<io::data> evt;
+    {
+      auto lck = cache->read_lock();
+      evt = cache->get_dimension_ba_event(ba_id);
+    }
+    broker_event::create(L, evt);
   } catch (std::exception const& e) {
     (void)e;
     lua_pushnil(L);
@@ -97,6 +103,7 @@ static int l_broker_cache_get_bv_v1(lua_State* L) {
       *static_cast<macro_cache**>(luaL_checkudata(L, 1, "lua_broker_cache")));
   int bv_id(luaL_checkinteger(L, 2));
 
+  auto lck = cache->read_lock();
   try {
     const bam::pb_dimension_bv_event& bv(*cache->get_dimension_bv_event(bv_id));
     lua_createtable(L, 0, 3);
@@ -121,7 +128,12 @@ static int l_broker_cache_get_bv_v2(lua_State* L) {
   int bv_id(luaL_checkinteger(L, 2));
 
   try {
-    broker_event::create(L, cache->get_dimension_bv_event(bv_id));
+    std::shared_ptr<io::data> evt;
+    {
+      auto lck = cache->read_lock();
+      evt = cache->get_dimension_bv_event(bv_id);
+    }
+    broker_event::create(L, evt);
   } catch (std::exception const& e) {
     (void)e;
     lua_pushnil(L);
@@ -142,6 +154,7 @@ static int l_broker_cache_get_bvs(lua_State* L) {
       *static_cast<macro_cache**>(luaL_checkudata(L, 1, "lua_broker_cache")));
   uint32_t ba_id(luaL_checkinteger(L, 2));
 
+  auto lck = cache->read_lock();
   auto const& relations(cache->get_dimension_ba_bv_relation_events());
   auto it = relations.find(ba_id);
 
@@ -170,6 +183,7 @@ static int l_broker_cache_get_hostgroup_name(lua_State* L) {
       *static_cast<macro_cache**>(luaL_checkudata(L, 1, "lua_broker_cache")));
   int id(luaL_checkinteger(L, 2));
 
+  auto lck = cache->read_lock();
   try {
     std::string const& hg{cache->get_host_group_name(id)};
     lua_pushstring(L, hg.c_str());
@@ -193,6 +207,7 @@ static int l_broker_cache_get_hostname(lua_State* L) {
       *static_cast<macro_cache**>(luaL_checkudata(L, 1, "lua_broker_cache")));
   int id(luaL_checkinteger(L, 2));
 
+  auto lck = cache->read_lock();
   try {
     std::string const& hst{cache->get_host_name(id)};
     lua_pushstring(L, hst.c_str());
@@ -217,6 +232,7 @@ static int l_broker_cache_get_service_v1(lua_State* L) {
   uint32_t host_id(luaL_checkinteger(L, 2));
   uint32_t svc_id(luaL_checkinteger(L, 3));
 
+  auto lck = cache->read_lock();
   try {
     broker_event::create_as_table(L, *cache->get_service(host_id, svc_id));
   } catch (std::exception const& e) {
@@ -233,7 +249,12 @@ static int l_broker_cache_get_service_v2(lua_State* L) {
   uint32_t svc_id(luaL_checkinteger(L, 3));
 
   try {
-    broker_event::create(L, cache->get_service(host_id, svc_id));
+    std::shared_ptr<io::data> evt;
+    {
+      auto lck = cache->read_lock();
+      evt = cache->get_service(host_id, svc_id);
+    }
+    broker_event::create(L, evt);
   } catch (std::exception const& e) {
     (void)e;
     lua_pushnil(L);
@@ -254,6 +275,7 @@ static int l_broker_cache_get_host_v1(lua_State* L) {
       *static_cast<macro_cache**>(luaL_checkudata(L, 1, "lua_broker_cache")));
   int id(luaL_checkinteger(L, 2));
 
+  auto lck = cache->read_lock();
   try {
     broker_event::create_as_table(L, *cache->get_host(id));
   } catch (std::exception const& e) {
@@ -269,7 +291,12 @@ static int l_broker_cache_get_host_v2(lua_State* L) {
   int id(luaL_checkinteger(L, 2));
 
   try {
-    broker_event::create(L, cache->get_host(id));
+    std::shared_ptr<io::data> evt;
+    {
+      auto lck = cache->read_lock();
+      evt = cache->get_host(id);
+    }
+    broker_event::create(L, evt);
   } catch (std::exception const& e) {
     (void)e;
     lua_pushnil(L);
@@ -290,6 +317,7 @@ static int l_broker_cache_get_index_mapping(lua_State* L) {
       *static_cast<macro_cache**>(luaL_checkudata(L, 1, "lua_broker_cache")));
   int index_id(luaL_checkinteger(L, 2));
 
+  auto lck = cache->read_lock();
   try {
     const storage::pb_index_mapping& mapping{
         cache->get_index_mapping(index_id)};
@@ -324,6 +352,7 @@ static int l_broker_cache_get_instance_name(lua_State* L) {
       *static_cast<macro_cache**>(luaL_checkudata(L, 1, "lua_broker_cache")));
   int instance_id(luaL_checkinteger(L, 2));
 
+  auto lck = cache->read_lock();
   try {
     std::string const& instance{cache->get_instance(instance_id)};
     lua_pushstring(L, instance.c_str());
@@ -347,6 +376,7 @@ static int l_broker_cache_get_metric_mapping_v1(lua_State* L) {
       *static_cast<macro_cache**>(luaL_checkudata(L, 1, "lua_broker_cache")));
   int metric_id(luaL_checkinteger(L, 2));
 
+  auto lck = cache->read_lock();
   try {
     const storage::pb_metric_mapping& mapping(
         *cache->get_metric_mapping(metric_id));
@@ -371,9 +401,12 @@ static int l_broker_cache_get_metric_mapping_v2(lua_State* L) {
   int metric_id(luaL_checkinteger(L, 2));
 
   try {
-    const std::shared_ptr<storage::pb_metric_mapping>& mm{
-        cache->get_metric_mapping(metric_id)};
-    broker_event::create(L, mm);
+    std::shared_ptr<io::data> evt;
+    {
+      auto lck = cache->read_lock();
+      evt = cache->get_metric_mapping(metric_id);
+    }
+    broker_event::create(L, evt);
   } catch (std::exception const& e) {
     (void)e;
     lua_pushnil(L);
@@ -395,6 +428,7 @@ static int l_broker_cache_get_service_description(lua_State* L) {
   int host_id(luaL_checkinteger(L, 2));
   int service_id(luaL_checkinteger(L, 3));
 
+  auto lck = cache->read_lock();
   try {
     std::string const& svc{cache->get_service_description(host_id, service_id)};
     lua_pushstring(L, svc.c_str());
@@ -418,6 +452,7 @@ static int l_broker_cache_get_servicegroup_name(lua_State* L) {
       *static_cast<macro_cache**>(luaL_checkudata(L, 1, "lua_broker_cache")));
   int id(luaL_checkinteger(L, 2));
 
+  auto lck = cache->read_lock();
   try {
     std::string const& sg{cache->get_service_group_name(id)};
     lua_pushstring(L, sg.c_str());
@@ -442,6 +477,7 @@ static int l_broker_cache_get_servicegroups(lua_State* L) {
   uint64_t host_id(luaL_checkinteger(L, 2));
   uint64_t service_id(luaL_checkinteger(L, 3));
 
+  auto lck = cache->read_lock();
   auto const& members = cache->get_service_group_members();
 
   auto first(members.lower_bound(std::make_tuple(host_id, service_id, 0)));
@@ -494,6 +530,7 @@ static int l_broker_cache_get_hostgroups(lua_State* L) {
       *static_cast<macro_cache**>(luaL_checkudata(L, 1, "lua_broker_cache"))};
   uint64_t id{static_cast<uint64_t>(luaL_checkinteger(L, 2))};
 
+  auto lck = cache->read_lock();
   auto const& members = cache->get_host_group_members();
 
   auto const first = members.lower_bound({id, 0});
@@ -550,6 +587,7 @@ static int l_broker_cache_get_action_url(lua_State* L) {
   if (lua_gettop(L) >= 3)
     service_id = luaL_checkinteger(L, 3);
 
+  auto lck = cache->read_lock();
   try {
     std::string const& action_url(cache->get_action_url(host_id, service_id));
     lua_pushstring(L, action_url.c_str());
@@ -578,6 +616,7 @@ static int l_broker_cache_get_notes(lua_State* L) {
   if (lua_gettop(L) >= 3)
     service_id = luaL_checkinteger(L, 3);
 
+  auto lck = cache->read_lock();
   try {
     std::string const& notes(cache->get_notes(host_id, service_id));
     lua_pushstring(L, notes.c_str());
@@ -606,6 +645,7 @@ static int l_broker_cache_get_notes_url(lua_State* L) {
   if (lua_gettop(L) >= 3)
     service_id = luaL_checkinteger(L, 3);
 
+  auto lck = cache->read_lock();
   try {
     std::string const& notes_url(cache->get_notes_url(host_id, service_id));
     lua_pushstring(L, notes_url.c_str());
@@ -634,6 +674,7 @@ static int32_t l_broker_cache_get_severity(lua_State* L) {
   if (lua_gettop(L) >= 3)
     service_id = luaL_checkinteger(L, 3);
 
+  auto lck = cache->read_lock();
   try {
     int32_t severity = cache->get_severity(host_id, service_id);
     lua_pushinteger(L, severity);
@@ -652,6 +693,7 @@ static int32_t l_broker_cache_get_check_command(lua_State* L) {
   if (lua_gettop(L) >= 3)
     service_id = luaL_checkinteger(L, 3);
 
+  auto lck = cache->read_lock();
   try {
     std::string_view check_command =
         cache->get_check_command(host_id, service_id);
@@ -31,7 +31,9 @@ connector::connector()
           false,
           multiplexing::muxer_filter(multiplexing::muxer_filter::zero_init()),
           multiplexing::muxer_filter(multiplexing::muxer_filter::zero_init())
-              .add_category(io::local)) {}
+              .add_category(io::local)),
+      _shards{1},
+      _shard_by_service{false} {}
 
 /**
  *  Copy constructor.
@@ -42,7 +44,9 @@ connector::connector(connector const& other)
     : io::endpoint(other),
       _lua_script(other._lua_script),
       _conf_params(other._conf_params),
-      _cache(other._cache) {}
+      _cache(other._cache),
+      _shards(other._shards),
+      _shard_by_service(other._shard_by_service) {}
 
 /**
  *  Destructor.
@@ -56,14 +60,21 @@ connector::~connector() {}
  *  @param[in] cfg_params              A hash table containing the user
  *                                     parameters
  *  @param[in] cache                   The cache
+ *  @param[in] shards                  Number of Lua states running the script
+ *  @param[in] shard_by_service        true to dispatch events by host and
+ *                                     service, false to dispatch them by host
  */
 void connector::connect_to(
     const std::string& lua_script,
     const std::map<std::string, misc::variant>& cfg_params,
-    const std::shared_ptr<persistent_cache>& cache) {
+    const std::shared_ptr<persistent_cache>& cache,
+    uint32_t shards,
+    bool shard_by_service) {
   _conf_params = cfg_params;
   _lua_script = lua_script;
   _cache = cache;
+  _shards = shards;
+  _shard_by_service = shard_by_service;
 }
 
 /**
@@ -72,5 +83,6 @@ void connector::connect_to(
  *  @return a lua connection object.
  */
 std::shared_ptr<io::stream> connector::open() {
-  return std::make_unique<stream>(_lua_script, _conf_params, _cache);
+  return std::make_unique<stream>(_lua_script, _conf_params, _cache, _shards,
+                                  _shard_by_service);
 }
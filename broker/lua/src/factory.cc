@@ -21,11 +21,13 @@
 #include <nlohmann/json.hpp>
 #include "com/centreon/broker/lua/connector.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
+#include "common/log_v2/log_v2.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::exceptions;
 using namespace com::centreon::broker::lua;
 using namespace nlohmann;
+using log_v2 = com::centreon::common::log_v2::log_v2;
 
 /**
  *  Find a parameter in configuration.
@@ -145,9 +147,41 @@ io::endpoint* factory::new_endpoint(
       }
     }
   }
+
+  // Number of Lua states running the script.
+  uint32_t shards = 1;
+  auto it = cfg.params.find("shards");
+  if (it != cfg.params.end()) {
+    if (!absl::SimpleAtoi(it->second, &shards) || shards == 0)
+      throw msg_fmt("lua: 'shards' must be a positive integer and not '{}'",
+                    it->second);
+    // Each shard is a Lua state with its own thread, more than a few per core
+    // only costs memory.
+    const uint32_t max_shards =
+        std::max(1u, std::thread::hardware_concurrency()) * 4;
+    if (shards > max_shards) {
+      auto logger = log_v2::instance().get(log_v2::LUA);
+      SPDLOG_LOGGER_ERROR(
+          logger, "lua: 'shards' value {} is too big. Setting it to {}",
+          shards, max_shards);
+      shards = max_shards;
+    }
+  }
+
+  // Key used to dispatch events among shards.
+  bool shard_by_service = false;
+  it = cfg.params.find("shard_key");
+  if (it != cfg.params.end()) {
+    if (absl::EqualsIgnoreCase(it->second, "service"))
+      shard_by_service = true;
+    else if (!absl::EqualsIgnoreCase(it->second, "host"))
+      throw msg_fmt("lua: 'shard_key' must be 'host' or 'service' and not '{}'",
+                    it->second);
+  }
+
   // Connector.
   auto c{std::make_unique<lua::connector>()};
-  c->connect_to(filename, conf_map, cache);
+  c->connect_to(filename, conf_map, cache, shards, shard_by_service);
   is_acceptor = false;
   return c.release();
 }
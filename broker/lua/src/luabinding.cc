@@ -54,14 +54,19 @@ static int l_pairs(lua_State* L) {
  *  @param[in] lua_script the json parameters file
  *  @param[in] conf_params A hash table with user parameters
  *  @param[in] cache the persistent cache.
+ *  @param[in] feed_cache true if written events have to be given to the cache.
  */
 luabinding::luabinding(std::string const& lua_script,
                        std::map<std::string, misc::variant> const& conf_params,
-                       macro_cache& cache)
+                       macro_cache& cache,
+                       bool feed_cache)
     : _L{nullptr},
       _filter{false},
       _flush{false},
+      _write_batch{false},
+      _batch_size{1000},
       _cache(cache),
+      _feed_cache{feed_cache},
       _total{0},
       _broker_api_version{1},
       _logger{log_v2::instance().get(log_v2::LUA)} {
@@ -138,16 +143,25 @@ bool luabinding::has_flush() const noexcept {
   return _flush;
 }
 
+/**
+ *  Returns true if a write_batch was configured in the Lua script.
+ */
+bool luabinding::has_write_batch() const noexcept {
+  return _write_batch;
+}
+
 /**
  *  Reads the Lua script, checks its syntax and checks if
  *   - init()
  *   - write()
+ *   - write_batch()
  *   - filter()
  *   - flush()
- *  functions exist in the Lua script. The two first ones are
- *  mandatory whereas the third one is optional.
+ *  functions exist in the Lua script. init() is mandatory, and at least one
+ *  of write() and write_batch() must be defined. The others are optional.
  *
- *  It is also here that the broker_api_version variable is checked.
+ *  It is also here that the broker_api_version and broker_batch_size
+ *  variables are checked.
  *
  *  @param lua_script the file name of the lua script.
  */
@@ -169,9 +183,15 @@ void luabinding::_load_script(const std::string& lua_script) {
     throw msg_fmt("lua: '{}' init() global function is missing", lua_script);
   lua_pop(_L, 1);
 
-  // Checking for write() availability: this function is mandatory
+  // Checking for write_batch() availability: this function is optional
+  lua_getglobal(_L, "write_batch");
+  _write_batch = lua_isfunction(_L, lua_gettop(_L));
+  lua_pop(_L, 1);
+
+  // Checking for write() availability: this function is mandatory if
+  // write_batch() is not defined.
   lua_getglobal(_L, "write");
-  if (!lua_isfunction(_L, lua_gettop(_L)))
+  if (!_write_batch && !lua_isfunction(_L, lua_gettop(_L)))
     throw msg_fmt("lua: '{}' write() global function is missing", lua_script);
   lua_pop(_L, 1);
 
@@ -252,6 +272,33 @@ void luabinding::_load_script(const std::string& lua_script) {
   SPDLOG_LOGGER_INFO(_logger, "Lua broker_api_version set to {}",
                      _broker_api_version);
 
+  /* Checking the batch size, only used with write_batch() */
+  if (_write_batch) {
+    lua_getglobal(_L, "broker_batch_size");
+    if (lua_isnumber(_L, 1)) {
+      lua_Number size = lua_tonumber(_L, 1);
+      if (size >= 1 && size <= max_batch_size)
+        _batch_size = static_cast<uint32_t>(size);
+      else if (size > max_batch_size) {
+        _batch_size = max_batch_size;
+        SPDLOG_LOGGER_ERROR(_logger,
+                            "broker_batch_size '{}' is too big. Setting it to "
+                            "{}",
+                            size, _batch_size);
+      } else
+        SPDLOG_LOGGER_ERROR(_logger,
+                            "broker_batch_size must be a positive integer and "
+                            "not '{}'. Setting it to {}",
+                            size, _batch_size);
+    }
+    lua_pop(_L, 1);
+    /* The vector grows as needed beyond that. */
+    _batch.reserve(std::min<uint32_t>(_batch_size, 1000u));
+    SPDLOG_LOGGER_INFO(
+        _logger, "Lua write_batch() used with batches of {} events at most",
+        _batch_size);
+  }
+
   // Registers the broker_log object
   broker_log::broker_log_reg(_L);
 
@@ -339,7 +386,8 @@ int luabinding::write(std::shared_ptr<io::data> const& data) noexcept {
   }
 
   // Give data to cache.
-  _cache.write(data);
+  if (_feed_cache)
+    _cache.write(data);
 
   // Process event.
   uint32_t mess_type(data->type());
@@ -351,34 +399,35 @@ int luabinding::write(std::shared_ptr<io::data> const& data) noexcept {
   // Total to acknowledge incremented
   ++_total;
 
-  if (has_filter()) {
-    // Let's get the function to call
-    lua_getglobal(_L, "filter");
-    lua_pushinteger(_L, cat);
-    lua_pushinteger(_L, elem);
-
-    if (lua_pcall(_L, 2, 1, 0) != 0) {
-      const char* ret = lua_tostring(_L, -1);
-      if (ret)
-        SPDLOG_LOGGER_ERROR(
-            _logger, "lua: error while running function `filter()': {}", ret);
-      else
-        SPDLOG_LOGGER_ERROR(
-            _logger, "lua: unknown error while running function `filter()'");
-      RETURN_AND_POP(0);
+  if (_write_batch) {
+    if (has_filter()) {
+      auto found = _filter_results.find(mess_type);
+      if (found == _filter_results.end()) {
+        if (!_call_filter(cat, elem, execute_write))
+          return 0;
+        _filter_results.emplace(mess_type, execute_write);
+      } else
+        execute_write = found->second;
     }
-
-    if (!lua_isboolean(_L, -1)) {
-      SPDLOG_LOGGER_ERROR(_logger, "lua: `filter' must return a boolean");
-      RETURN_AND_POP(0);
+    if (!execute_write) {
+      /* Nothing is waiting for write_batch(), the rejected event can be
+       * acknowledged now. Otherwise, it is with the next batch. */
+      if (_batch.empty() && _total == 1) {
+        _total = 0;
+        return 1;
+      }
+      return 0;
     }
 
-    execute_write = lua_toboolean(_L, -1);
-    SPDLOG_LOGGER_DEBUG(_logger, "lua: `filter' returned {}",
-                        (execute_write ? "true" : "false"));
-    lua_pop(_L, lua_gettop(_L));
+    _batch.push_back(data);
+    if (_batch.size() < _batch_size)
+      return 0;
+    return _send_batch();
   }
 
+  if (has_filter() && !_call_filter(cat, elem, execute_write))
+    return 0;
+
   if (!execute_write)
     return 0;
 
@@ -424,6 +473,102 @@ int luabinding::write(std::shared_ptr<io::data> const& data) noexcept {
   RETURN_AND_POP(retval);
 }
 
+/**
+ *  Calls the filter() function of the Lua script.
+ *
+ *  @param cat The category of the event.
+ *  @param elem The element of the event.
+ *  @param accepted Set to the value returned by filter().
+ *
+ *  @return true on success, false if filter() failed.
+ */
+bool luabinding::_call_filter(uint16_t cat,
+                              uint16_t elem,
+                              bool& accepted) noexcept {
+  // Let's get the function to call
+  lua_getglobal(_L, "filter");
+  lua_pushinteger(_L, cat);
+  lua_pushinteger(_L, elem);
+
+  if (lua_pcall(_L, 2, 1, 0) != 0) {
+    const char* ret = lua_tostring(_L, -1);
+    if (ret)
+      SPDLOG_LOGGER_ERROR(_logger,
+                          "lua: error while running function `filter()': {}",
+                          ret);
+    else
+      SPDLOG_LOGGER_ERROR(
+          _logger, "lua: unknown error while running function `filter()'");
+    RETURN_AND_POP(false);
+  }
+
+  if (!lua_isboolean(_L, -1)) {
+    SPDLOG_LOGGER_ERROR(_logger, "lua: `filter' must return a boolean");
+    RETURN_AND_POP(false);
+  }
+
+  accepted = lua_toboolean(_L, -1);
+  SPDLOG_LOGGER_DEBUG(_logger, "lua: `filter' returned {}",
+                      (accepted ? "true" : "false"));
+  RETURN_AND_POP(true);
+}
+
+/**
+ *  Gives the pending events to the write_batch() function of the Lua script
+ *  as an array. The batch is emptied, whatever the result of the call.
+ *
+ *  @return The number of events to acknowledge.
+ */
+int32_t luabinding::_send_batch() noexcept {
+  if (_batch.empty())
+    return 0;
+
+  SPDLOG_LOGGER_DEBUG(_logger, "lua: luabinding::write_batch call with {} events",
+                      _batch.size());
+
+  // Let's get the function to call
+  lua_getglobal(_L, "write_batch");
+
+  // The events are given in an array
+  lua_createtable(_L, _batch.size(), 0);
+  int idx = 1;
+  for (auto& d : _batch) {
+    switch (_broker_api_version) {
+      case 1:
+        broker_event::create_as_table(_L, *d);
+        break;
+      case 2:
+        broker_event::create(_L, d);
+        break;
+    }
+    lua_rawseti(_L, -2, idx++);
+  }
+  _batch.clear();
+
+  if (lua_pcall(_L, 1, 1, 0) != 0) {
+    const char* ret = lua_tostring(_L, -1);
+    if (ret)
+      SPDLOG_LOGGER_ERROR(_logger,
+                          "lua: error running function `write_batch' {}", ret);
+    else
+      SPDLOG_LOGGER_ERROR(_logger,
+                          "lua: unknown error running function `write_batch'");
+    RETURN_AND_POP(0);
+  }
+
+  if (!lua_isboolean(_L, -1)) {
+    SPDLOG_LOGGER_ERROR(_logger, "lua: `write_batch' must return a boolean");
+    RETURN_AND_POP(0);
+  }
+
+  int32_t retval = 0;
+  if (lua_toboolean(_L, -1)) {
+    retval = _total;
+    _total = 0;
+  }
+  RETURN_AND_POP(retval);
+}
+
 /**
  *  Load the Lua interpreter with classical and custom libraries.
  *
@@ -438,9 +583,16 @@ lua_State* luabinding::_load_interpreter() {
   return L;
 }
 
+/**
+ *  Gives the pending events to write_batch() and then calls the flush()
+ *  function of the Lua script if they are defined.
+ *
+ *  @return The number of events to acknowledge.
+ */
 int32_t luabinding::flush() noexcept {
+  int32_t retval = _send_batch();
   if (!_flush)
-    return 0;
+    return retval;
   // Let's get the function to call
   lua_getglobal(_L, "flush");
   if (lua_pcall(_L, 0, 1, 0) != 0) {
@@ -459,9 +611,8 @@ int32_t luabinding::flush() noexcept {
   }
   bool acknowledge = lua_toboolean(_L, -1);
 
-  int32_t retval = 0;
   if (acknowledge) {
-    retval = _total;
+    retval += _total;
     _total = 0;
   }
   RETURN_AND_POP(retval);
@@ -63,6 +63,27 @@ macro_cache::~macro_cache() {
   }
 }
 
+/**
+ * @brief Declare the cache as shared by several Lua states running in
+ * parallel. From now, write() locks the cache and readers have to hold
+ * read_lock() while they use it.
+ */
+void macro_cache::set_shared() {
+  _shared = true;
+}
+
+/**
+ * @brief Lock the cache for reading. The lock is only taken if the cache is
+ * shared.
+ *
+ * @return The lock, to keep while the cache content is used.
+ */
+std::shared_lock<std::shared_mutex> macro_cache::read_lock() const {
+  if (_shared)
+    return std::shared_lock<std::shared_mutex>(_shared_m);
+  return std::shared_lock<std::shared_mutex>(_shared_m, std::defer_lock);
+}
+
 /**
  *  Get the mapping of an index.
  *
@@ -510,6 +531,10 @@ void macro_cache::write(std::shared_ptr<io::data> const& data) {
   if (!data)
     return;
 
+  std::unique_lock<std::shared_mutex> lck(_shared_m, std::defer_lock);
+  if (_shared)
+    lck.lock();
+
   switch (data->type()) {
     case neb::instance::static_type():
       _process_instance(data);
@@ -677,7 +702,7 @@ void macro_cache::_process_pb_host_status(
   }
 
   if (it->second->type() == make_type(io::neb, neb::de_host)) {
-    auto& hst = *std::static_pointer_cast<neb::host>(it->second);
+    auto& hst = _own<neb::host>(it->second);
     hst.has_been_checked = obj.checked();
     hst.check_type = obj.check_type();
     hst.current_state = obj.state();
@@ -705,7 +730,7 @@ void macro_cache::_process_pb_host_status(
     hst.acknowledgement_type = obj.acknowledgement_type();
     hst.downtime_depth = obj.scheduled_downtime_depth();
   } else if (it->second->type() == make_type(io::neb, neb::de_pb_host)) {
-    auto& hst = std::static_pointer_cast<neb::pb_host>(it->second)->mut_obj();
+    auto& hst = _own<neb::pb_host>(it->second).mut_obj();
     hst.set_checked(obj.checked());
     hst.set_check_type(static_cast<Host_CheckType>(obj.check_type()));
     hst.set_state(static_cast<Host_State>(obj.state()));
@@ -751,7 +776,7 @@ void macro_cache::_process_pb_adaptive_host(
   auto it = _hosts.find(ah.host_id());
   if (it != _hosts.end()) {
     if (it->second->type() == make_type(io::neb, neb::de_host)) {
-      auto& h = *std::static_pointer_cast<neb::host>(it->second);
+      auto& h = _own<neb::host>(it->second);
       if (ah.has_notify())
         h.notifications_enabled = ah.notify();
       if (ah.has_active_checks())
@@ -783,7 +808,7 @@ void macro_cache::_process_pb_adaptive_host(
       if (ah.has_notification_period())
         h.notification_period = ah.notification_period();
     } else {
-      auto& h = std::static_pointer_cast<neb::pb_host>(it->second)->mut_obj();
+      auto& h = _own<neb::pb_host>(it->second).mut_obj();
       if (ah.has_notify())
         h.set_notify(ah.notify());
       if (ah.has_active_checks())
@@ -999,7 +1024,7 @@ void macro_cache::_process_pb_service_status(
   }
 
   if (it->second->type() == make_type(io::neb, neb::de_service)) {
-    auto& svc = *std::static_pointer_cast<neb::service>(it->second);
+    auto& svc = _own<neb::service>(it->second);
     svc.has_been_checked = obj.checked();
     svc.check_type = obj.check_type();
     svc.current_state = obj.state();
@@ -1029,7 +1054,7 @@ void macro_cache::_process_pb_service_status(
     svc.downtime_depth = obj.scheduled_downtime_depth();
   } else if (it->second->type() == make_type(io::neb, neb::de_pb_service)) {
     auto& svc =
-        std::static_pointer_cast<neb::pb_service>(it->second)->mut_obj();
+        _own<neb::pb_service>(it->second).mut_obj();
     svc.set_checked(obj.checked());
     svc.set_check_type(static_cast<Service_CheckType>(obj.check_type()));
     svc.set_state(static_cast<Service_State>(obj.state()));
@@ -1079,7 +1104,7 @@ void macro_cache::_process_pb_adaptive_service(
   auto it = _services.find({as.host_id(), as.service_id()});
   if (it != _services.end()) {
     if (it->second->type() == make_type(io::neb, neb::de_service)) {
-      auto& s = *std::static_pointer_cast<neb::service>(it->second);
+      auto& s = _own<neb::service>(it->second);
       if (as.has_notify())
         s.notifications_enabled = as.notify();
       if (as.has_active_checks())
@@ -1112,7 +1137,7 @@ void macro_cache::_process_pb_adaptive_service(
         s.notification_period = as.notification_period();
     } else {
       auto& s =
-          std::static_pointer_cast<neb::pb_service>(it->second)->mut_obj();
+          _own<neb::pb_service>(it->second).mut_obj();
       if (as.has_notify())
         s.set_notify(as.notify());
       if (as.has_active_checks())
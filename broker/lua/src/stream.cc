@@ -19,7 +19,9 @@
 
 #include "com/centreon/broker/exceptions/shutdown.hh"
 #include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/io/protobuf.hh"
 #include "com/centreon/broker/lua/luabinding.hh"
+#include "com/centreon/broker/mapping/entry.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 #include "common/log_v2/log_v2.hh"
 
@@ -33,19 +35,50 @@ using log_v2 = com::centreon::common::log_v2::log_v2;
 /**
  *  Constructor.
  *
- *  @param[in] addr                    Address to connect to
- *  @param[in] port                    port
+ *  @param[in] lua_script        The Lua script to load.
+ *  @param[in] conf_params       The parameters given to the init() function.
+ *  @param[in] cache             The persistent cache.
+ *  @param[in] shards            Number of Lua states running the script.
+ *  @param[in] shard_by_service  true to dispatch events by host and service,
+ *                               false to dispatch them by host.
  */
 stream::stream(const std::string& lua_script,
                const std::map<std::string, misc::variant>& conf_params,
-               const std::shared_ptr<persistent_cache>& cache)
+               const std::shared_ptr<persistent_cache>& cache,
+               uint32_t shards,
+               bool shard_by_service)
     : io::stream("lua"),
-      _luabinding(lua_script, conf_params, _cache),
       _logger{cache->logger()},
-      _cache{cache} {}
+      _cache{cache},
+      _shard_by_service{shard_by_service},
+      _shards_stopped{false},
+      _pending{0} {
+  if (shards <= 1) {
+    _luabinding = std::make_unique<luabinding>(lua_script, conf_params, _cache);
+    return;
+  }
+
+  SPDLOG_LOGGER_INFO(_logger, "lua: running '{}' in {} Lua states by {}",
+                     lua_script, shards,
+                     shard_by_service ? "service" : "host");
+  _cache.set_shared();
+  _shard_acks.resize(shards, 0);
+  _shards.reserve(shards);
+  std::map<std::string, misc::variant> params(conf_params);
+  params.emplace("shard_count", misc::variant(static_cast<int32_t>(shards)));
+  for (uint32_t i = 0; i < shards; i++) {
+    params["shard_id"] = misc::variant(static_cast<int32_t>(i));
+    auto s = std::make_unique<shard>();
+    s->binding = std::make_unique<luabinding>(lua_script, params, _cache, false);
+    _shards.push_back(std::move(s));
+  }
+  for (auto& s : _shards)
+    s->thread = std::thread(&stream::_run, this, s.get());
+}
 
 stream::~stream() noexcept {
   _logger->trace("lua::stream destructor {}", static_cast<void*>(this));
+  _stop_shards();
 }
 /**
  *  Read from the connector.
@@ -71,10 +104,22 @@ bool stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
 int stream::write(std::shared_ptr<io::data> const& data) {
   assert(data);
 
-  // Give data to cache.
-  _cache.write(data);
+  if (_luabinding) {
+    // Give data to cache.
+    _cache.write(data);
+
+    return _luabinding->write(data);
+  }
 
-  return _luabinding.write(data);
+  bool has_host;
+  uint32_t idx = _shard_of(*data, &has_host);
+  if (!has_host)
+    _cache.write(data);
+  _routing.push_back(idx);
+  _shards[idx]->outgoing.emplace_back(data, has_host);
+  if (++_pending >= dispatch_size)
+    _dispatch();
+  return _collect_acks();
 }
 
 /**
@@ -82,14 +127,29 @@ int stream::write(std::shared_ptr<io::data> const& data) {
  *  been treated and can now be acknowledged by broker. This function returns
  *  how many are in that case.
  *
+ *  When the stream is sharded, the shards flush asynchronously, so their
+ *  acknowledgements are returned by the next calls.
+ *
  * @return The number of events to ack.
  */
 int32_t stream::flush() {
   int32_t retval = 0;
-  if (_luabinding.has_flush()) {
-    retval = _luabinding.flush();
-    _logger->debug("stream: flush {} events acknowledged", retval);
+  if (_luabinding) {
+    if (_luabinding->has_flush() || _luabinding->has_write_batch()) {
+      retval = _luabinding->flush();
+      _logger->debug("stream: flush {} events acknowledged", retval);
+    }
+    return retval;
+  }
+
+  _dispatch();
+  for (auto& s : _shards) {
+    std::lock_guard<std::mutex> lck(s->queue_m);
+    s->flush = true;
+    s->queue_cv.notify_one();
   }
+  retval = _collect_acks();
+  _logger->debug("stream: flush {} events acknowledged", retval);
   return retval;
 }
 
@@ -100,5 +160,188 @@ int32_t stream::flush() {
  */
 int32_t stream::stop() {
   _logger->trace("lua::stream stop {}", static_cast<void*>(this));
-  return _luabinding.stop();
+  if (_luabinding)
+    return _luabinding->stop();
+  _stop_shards();
+  return _collect_acks();
+}
+
+/**
+ * @brief Get the shard in charge of an event. Events without host are given
+ * to the first shard.
+ *
+ * @param d The event.
+ * @param has_host Set to true if the event concerns a host or a service.
+ *
+ * @return The shard index.
+ */
+uint32_t stream::_shard_of(const io::data& d, bool* has_host) {
+  uint64_t host_id = 0;
+  uint64_t service_id = 0;
+
+  *has_host = false;
+  const io::event_info* info = io::events::instance().get_event_info(d.type());
+  if (!info)
+    return 0;
+
+  if (info->get_mapping()) {
+    auto as_id = [&d](const mapping::entry& e) -> uint64_t {
+      switch (e.get_type()) {
+        case mapping::source::INT:
+          return e.get_int(d);
+        case mapping::source::UINT:
+          return e.get_uint(d);
+        case mapping::source::ULONG:
+          return e.get_ulong(d);
+        default:
+          return 0;
+      }
+    };
+    for (const mapping::entry* e = info->get_mapping(); !e->is_null(); ++e) {
+      const char* name = e->get_name_v2();
+      if (!name)
+        continue;
+      if (strcmp(name, "host_id") == 0)
+        host_id = as_id(*e);
+      else if (strcmp(name, "service_id") == 0)
+        service_id = as_id(*e);
+    }
+  } else {
+    const google::protobuf::Message* p =
+        static_cast<const io::protobuf_base&>(d).msg();
+    auto found = _key_fields.find(d.type());
+    if (found == _key_fields.end()) {
+      const google::protobuf::Descriptor* desc = p->GetDescriptor();
+      found = _key_fields
+                  .emplace(d.type(),
+                           std::make_pair(desc->FindFieldByName("host_id"),
+                                          desc->FindFieldByName("service_id")))
+                  .first;
+    }
+    auto as_id = [p](const google::protobuf::FieldDescriptor* f) -> uint64_t {
+      if (!f || f->is_repeated())
+        return 0;
+      const google::protobuf::Reflection* refl = p->GetReflection();
+      switch (f->cpp_type()) {
+        case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+          return refl->GetInt32(*p, f);
+        case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+          return refl->GetUInt32(*p, f);
+        case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+          return refl->GetInt64(*p, f);
+        case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+          return refl->GetUInt64(*p, f);
+        default:
+          return 0;
+      }
+    };
+    host_id = as_id(found->second.first);
+    service_id = as_id(found->second.second);
+  }
+
+  *has_host = host_id != 0;
+  uint64_t key = host_id;
+  if (_shard_by_service)
+    key = key * 0x9e3779b97f4a7c15ull + service_id;
+  return key % _shards.size();
+}
+
+/**
+ * @brief Give the pending events to their shards.
+ */
+void stream::_dispatch() {
+  if (!_pending)
+    return;
+  _pending = 0;
+
+  for (auto& s : _shards) {
+    if (s->outgoing.empty())
+      continue;
+    std::lock_guard<std::mutex> lck(s->queue_m);
+    if (s->queue.empty())
+      std::swap(s->queue, s->outgoing);
+    else {
+      s->queue.insert(s->queue.end(), s->outgoing.begin(), s->outgoing.end());
+      s->outgoing.clear();
+    }
+    s->queue_cv.notify_one();
+  }
+}
+
+/**
+ * @brief Gather the acknowledgements of the shards. Since each shard
+ * acknowledges its events in order, an event can be acknowledged as soon as
+ * its shard has acknowledged as many events as it has in the queue before it.
+ *
+ * @return The number of events to acknowledge from the beginning of the queue.
+ */
+int32_t stream::_collect_acks() {
+  for (size_t i = 0; i < _shards.size(); i++)
+    _shard_acks[i] += _shards[i]->acks.exchange(0);
+
+  int32_t retval = 0;
+  while (!_routing.empty() && _shard_acks[_routing.front()] > 0) {
+    --_shard_acks[_routing.front()];
+    _routing.pop_front();
+    ++retval;
+  }
+  return retval;
+}
+
+/**
+ * @brief Give the pending events to the shards and wait for them to process
+ * them and to stop.
+ */
+void stream::_stop_shards() {
+  if (_shards.empty() || _shards_stopped)
+    return;
+  _shards_stopped = true;
+
+  _dispatch();
+  for (auto& s : _shards) {
+    std::lock_guard<std::mutex> lck(s->queue_m);
+    s->exit = true;
+    s->queue_cv.notify_one();
+  }
+  for (auto& s : _shards)
+    s->thread.join();
+}
+
+/**
+ * @brief The loop of a shard thread. It gives the events of its queue to its
+ * Lua state.
+ *
+ * @param s The shard.
+ */
+void stream::_run(shard* s) {
+  std::vector<routed_event> events;
+  for (;;) {
+    bool flush;
+    bool exit;
+    {
+      std::unique_lock<std::mutex> lck(s->queue_m);
+      s->queue_cv.wait(
+          lck, [s] { return !s->queue.empty() || s->flush || s->exit; });
+      std::swap(events, s->queue);
+      flush = s->flush;
+      s->flush = false;
+      exit = s->exit;
+    }
+
+    int32_t acks = 0;
+    for (auto& e : events) {
+      if (e.second)
+        _cache.write(e.first);
+      acks += s->binding->write(e.first);
+    }
+    if (exit)
+      acks += s->binding->stop();
+    else if (flush)
+      acks += s->binding->flush();
+    events.clear();
+    s->acks += acks;
+
+    if (exit)
+      break;
+  }
 }
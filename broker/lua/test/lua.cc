@@ -29,8 +29,10 @@
 #include "bbdo/storage/status.hh"
 #include "com/centreon/broker/config/applier/init.hh"
 #include "com/centreon/broker/config/applier/modules.hh"
+#include "com/centreon/broker/lua/factory.hh"
 #include "com/centreon/broker/lua/luabinding.hh"
 #include "com/centreon/broker/lua/macro_cache.hh"
+#include "com/centreon/broker/lua/stream.hh"
 #include "com/centreon/broker/misc/variant.hh"
 #include "com/centreon/broker/neb/events.hh"
 #include "com/centreon/broker/neb/instance.hh"
@@ -4836,3 +4838,231 @@ TEST_F(LuaTest, WithBadFilter2) {
   ASSERT_FALSE(bb->has_filter());
   RemoveFile(filename);
 }
+
+// When a lua script defines write_batch() and no write() function
+// Then accepted events are given by arrays of broker_batch_size events, the
+// remaining ones on flush, and filter() is called once per event type.
+TEST_F(LuaTest, WriteBatch) {
+  config::applier::modules modules(log_v2::instance().get(log_v2::LUA));
+  modules.load_file("./broker/neb/10-neb.so");
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/write_batch.lua");
+  CreateScript(filename,
+               "broker_api_version = 2\n"
+               "broker_batch_size = 2\n"
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/test.log')\n"
+               "end\n\n"
+               "function filter(c, e)\n"
+               "  broker_log:info(0, 'filter ' .. c .. ' ' .. e)\n"
+               "  return true\n"
+               "end\n\n"
+               "function write_batch(events)\n"
+               "  broker_log:info(0, 'batch ' .. #events .. ' ' .. "
+               "events[#events].service_id)\n"
+               "  return true\n"
+               "end\n");
+  auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  ASSERT_TRUE(binding->has_write_batch());
+  int32_t acked = 0;
+  for (int i = 1; i <= 3; i++) {
+    auto s{std::make_unique<neb::service>()};
+    s->host_id = 12;
+    s->service_id = i;
+    std::shared_ptr<io::data> svc(s.release());
+    acked += binding->write(svc);
+  }
+  ASSERT_EQ(acked, 2);
+  ASSERT_EQ(binding->flush(), 1);
+
+  std::string lst(ReadFile("/tmp/test.log"));
+  ASSERT_NE(lst.find("batch 2 2"), std::string::npos);
+  ASSERT_NE(lst.find("batch 1 3"), std::string::npos);
+  size_t first = lst.find("filter ");
+  ASSERT_NE(first, std::string::npos);
+  ASSERT_EQ(lst.find("filter ", first + 1), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/test.log");
+}
+
+// When a lua script defines write_batch() and a filter rejecting events
+// Then rejected events are not given to write_batch() but are acknowledged
+// with the pending batch, or at once if no batch is pending.
+TEST_F(LuaTest, WriteBatchFiltered) {
+  config::applier::modules modules(log_v2::instance().get(log_v2::LUA));
+  modules.load_file("./broker/neb/10-neb.so");
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/write_batch.lua");
+  CreateScript(
+      filename,
+      fmt::format("broker_batch_size = 2\n"
+                  "function init(conf)\n"
+                  "  broker_log:set_parameters(3, '/tmp/test.log')\n"
+                  "end\n\n"
+                  "function filter(c, e)\n"
+                  "  return e == {}\n"
+                  "end\n\n"
+                  "function write_batch(events)\n"
+                  "  broker_log:info(0, 'batch ' .. #events)\n"
+                  "  return true\n"
+                  "end\n",
+                  element_of_type(neb::service::static_type())));
+  auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  auto make_host = [] {
+    auto hst{std::make_shared<neb::host>()};
+    hst->host_id = 12;
+    return hst;
+  };
+
+  /* Nothing waits for write_batch(), the host is acknowledged at once. */
+  ASSERT_EQ(binding->write(make_host()), 1);
+
+  /* The service is pending, the host is acknowledged with it. */
+  auto s{std::make_unique<neb::service>()};
+  s->host_id = 12;
+  s->service_id = 18;
+  std::shared_ptr<io::data> svc(s.release());
+  ASSERT_EQ(binding->write(svc), 0);
+  ASSERT_EQ(binding->write(make_host()), 0);
+  ASSERT_EQ(binding->flush(), 2);
+  ASSERT_EQ(binding->flush(), 0);
+
+  std::string lst(ReadFile("/tmp/test.log"));
+  ASSERT_NE(lst.find("batch 1"), std::string::npos);
+  ASSERT_EQ(lst.find("batch 2"), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/test.log");
+}
+
+// When a lua stream is configured with two shards
+// Then each shard runs its own Lua state, events of the same host are all
+// given to the same shard and all the events are acknowledged.
+TEST_F(LuaTest, ShardedStream) {
+  config::applier::modules modules(log_v2::instance().get(log_v2::LUA));
+  modules.load_file("./broker/neb/10-neb.so");
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/sharded.lua");
+  CreateScript(filename,
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/test_shard' .. "
+               "conf.shard_id .. '.log')\n"
+               "  broker_log:info(0, 'shards ' .. conf.shard_count)\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  broker_log:info(0, 'host ' .. d.host_id)\n"
+               "  return true\n"
+               "end\n");
+  std::shared_ptr<persistent_cache> pcache(std::make_shared<persistent_cache>(
+      "/tmp/broker_test_sharded_cache", _logger));
+  auto st{std::make_unique<lua::stream>(filename, conf, pcache, 2, false)};
+  int32_t acked = 0;
+  for (int i = 0; i < 4; i++) {
+    auto s{std::make_unique<neb::service>()};
+    s->host_id = 1 + i % 2;
+    s->service_id = i;
+    std::shared_ptr<io::data> svc(s.release());
+    acked += st->write(svc);
+  }
+  acked += st->stop();
+  ASSERT_EQ(acked, 4);
+  st.reset();
+
+  std::string lst0(ReadFile("/tmp/test_shard0.log"));
+  std::string lst1(ReadFile("/tmp/test_shard1.log"));
+  ASSERT_NE(lst0.find("shards 2"), std::string::npos);
+  ASSERT_NE(lst1.find("shards 2"), std::string::npos);
+  ASSERT_NE(lst0.find("host 2"), std::string::npos);
+  ASSERT_EQ(lst0.find("host 1"), std::string::npos);
+  ASSERT_NE(lst1.find("host 1"), std::string::npos);
+  ASSERT_EQ(lst1.find("host 2"), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/test_shard0.log");
+  RemoveFile("/tmp/test_shard1.log");
+  ::remove("/tmp/broker_test_sharded_cache");
+}
+
+// When a lua endpoint is configured with a huge number of shards
+// Then the factory limits them to four per core.
+TEST_F(LuaTest, TooManyShards) {
+  std::string filename("/tmp/too_many_shards.lua");
+  CreateScript(filename,
+               "function init(conf)\n"
+               "  if conf.shard_id == 0 then\n"
+               "    broker_log:set_parameters(3, '/tmp/test_shard_max.log')\n"
+               "    broker_log:info(0, 'shards ' .. conf.shard_count)\n"
+               "  end\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  return true\n"
+               "end\n");
+  config::endpoint cfg(config::endpoint::io_type::output);
+  cfg.params["path"] = filename;
+  cfg.params["shards"] = "1000000";
+  std::shared_ptr<persistent_cache> pcache(std::make_shared<persistent_cache>(
+      "/tmp/broker_test_max_shards_cache", _logger));
+  lua::factory f;
+  bool is_acceptor;
+  std::unique_ptr<io::endpoint> endp(f.new_endpoint(cfg, is_acceptor, pcache));
+  std::shared_ptr<io::stream> st = endp->open();
+  st->stop();
+  st.reset();
+
+  const uint32_t max_shards =
+      std::max(1u, std::thread::hardware_concurrency()) * 4;
+  std::string lst(ReadFile("/tmp/test_shard_max.log"));
+  ASSERT_NE(lst.find(fmt::format("shards {}", max_shards)), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/test_shard_max.log");
+  ::remove("/tmp/broker_test_max_shards_cache");
+}
+
+// When a lua stream is configured with two shards
+// Then the cache seen by a shard is updated event by event, a service state
+// read from the cache is the one of the event being processed.
+TEST_F(LuaTest, ShardedStreamCacheFollowsEvents) {
+  config::applier::modules modules(log_v2::instance().get(log_v2::LUA));
+  modules.load_file("./broker/neb/10-neb.so");
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/sharded_cache.lua");
+  CreateScript(filename,
+               "broker_api_version=2\n"
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/test_cache_shard' .. "
+               "conf.shard_id .. '.log')\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  local s = broker_cache:get_service(d.host_id, d.service_id)\n"
+               "  broker_log:info(0, 'state ' .. s.state)\n"
+               "  return true\n"
+               "end\n");
+  std::shared_ptr<persistent_cache> pcache(std::make_shared<persistent_cache>(
+      "/tmp/broker_test_sharded_cache", _logger));
+  auto st{std::make_unique<lua::stream>(filename, conf, pcache, 2, false)};
+
+  auto svc = std::make_shared<neb::pb_service>();
+  svc->mut_obj().set_host_id(1);
+  svc->mut_obj().set_service_id(1);
+  svc->mut_obj().set_state(Service_State_OK);
+  int32_t acked = st->write(svc);
+  for (auto state : {ServiceStatus_State_CRITICAL, ServiceStatus_State_OK}) {
+    auto ss = std::make_shared<neb::pb_service_status>();
+    ss->mut_obj().set_host_id(1);
+    ss->mut_obj().set_service_id(1);
+    ss->mut_obj().set_state(state);
+    acked += st->write(ss);
+  }
+  acked += st->stop();
+  ASSERT_EQ(acked, 3);
+  st.reset();
+
+  std::string lst(ReadFile("/tmp/test_cache_shard1.log"));
+  size_t first = lst.find("state 0");
+  ASSERT_NE(first, std::string::npos);
+  size_t second = lst.find("state 2", first);
+  ASSERT_NE(second, std::string::npos);
+  ASSERT_NE(lst.find("state 0", second), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/test_cache_shard0.log");
+  RemoveFile("/tmp/test_cache_shard1.log");
+  ::remove("/tmp/broker_test_sharded_cache");
+}
@@ -67,6 +67,7 @@ int callback_severity(int callback_type, void* data) noexcept;
 int callback_tag(int callback_type, void* data) noexcept;
 
 int callback_pb_bench(int callback_type, void* data);
+int callback_event_loop(int callback_type, void* data);
 
 int callback_otl_metrics(int callback_type, void* data);
 
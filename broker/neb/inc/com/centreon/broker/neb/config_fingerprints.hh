@@ -0,0 +1,86 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_NEB_CONFIG_FINGERPRINTS_HH
+#define CCB_NEB_CONFIG_FINGERPRINTS_HH
+
+#include "com/centreon/broker/neb/internal.hh"
+
+namespace com::centreon::broker::neb {
+/**
+ * @brief Fingerprints of the configuration objects known by broker.
+ *
+ * At startup, cbmod sends its whole configuration to broker. With this class,
+ * objects already sent by a previous run and not modified since are filtered
+ * out: each configuration object (host, service, custom variable, host parent
+ * and group membership) gets a key built from its identity fields and a hash
+ * of its non volatile fields. The set of these keys/hashes acknowledged by
+ * broker is saved in a file, the next startup only sends the objects whose
+ * hash changed, removal events for objects that disappeared and the lists of
+ * unchanged hosts and services in the InstanceConfiguration event.
+ *
+ * The configuration is acknowledged by broker with a ConfigAck event once it
+ * is stored in the database. Until then the saved file is removed, so any
+ * failure leads to a full configuration at the next startup. If broker cannot
+ * apply a diff, it acknowledges the fingerprint 0: the fingerprints are reset
+ * and the whole configuration is sent again.
+ */
+class config_fingerprints {
+ public:
+  using events = std::deque<std::shared_ptr<io::data>>;
+
+ private:
+  using object_map = absl::flat_hash_map<std::string, uint64_t>;
+
+  const std::string _path;
+  const uint64_t _poller_id;
+  const std::string _version;
+  std::shared_ptr<spdlog::logger> _logger;
+
+  /* Objects known by broker. */
+  object_map _acked;
+  uint64_t _acked_fingerprint;
+
+  /* Objects sent and not yet acknowledged. */
+  object_map _pending;
+  uint64_t _pending_fingerprint;
+  bool _waiting;
+
+  void _save() const;
+
+ public:
+  config_fingerprints(const std::string& path,
+                      uint64_t poller_id,
+                      const std::string& version);
+  config_fingerprints(const config_fingerprints&) = delete;
+  config_fingerprints& operator=(const config_fingerprints&) = delete;
+
+  bool load();
+  void diff(events* evts,
+            const std::shared_ptr<pb_instance_configuration>& marker);
+  bool acknowledge(uint64_t fingerprint);
+  void reset();
+  uint64_t fingerprint() const { return _acked_fingerprint; }
+
+  static bool object_key(const io::data& d, std::string* key, uint64_t* hash);
+  static uint64_t hash(const std::string& buffer);
+};
+
+}  // namespace com::centreon::broker::neb
+
+#endif  // !CCB_NEB_CONFIG_FINGERPRINTS_HH
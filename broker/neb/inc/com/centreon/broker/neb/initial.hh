@@ -19,9 +19,12 @@
 #ifndef CCB_NEB_INITIAL_HH_
 #define CCB_NEB_INITIAL_HH_
 
+#include "com/centreon/broker/neb/internal.hh"
+
 namespace com::centreon::broker::neb {
 void send_initial_configuration();
-void send_initial_pb_configuration();
+void send_initial_pb_configuration(const std::shared_ptr<pb_instance>& inst);
+void check_initial_pb_configuration_ack();
 }  // namespace com::centreon::broker::neb
 
 #endif /* !CCB_NEB_INITIAL_HH_ */
@@ -25,6 +25,7 @@
 #include "com/centreon/broker/io/protobuf.hh"
 #include "com/centreon/broker/multiplexing/publisher.hh"
 #include "com/centreon/broker/neb/callback.hh"
+#include "com/centreon/broker/neb/staged_publisher.hh"
 #include "opentelemetry/proto/collector/metrics/v1/metrics_service.pb.h"
 
 namespace com::centreon::broker {
@@ -37,7 +38,7 @@ class acknowledgement;
 extern std::string gl_configuration_file;
 
 // Sender object.
-extern multiplexing::publisher gl_publisher;
+extern staged_publisher gl_publisher;
 
 // Registered callbacks.
 extern std::list<std::unique_ptr<neb::callback>> gl_registered_callbacks;
@@ -47,6 +48,9 @@ using pb_downtime =
 
 using pb_host_status =
     io::protobuf<HostStatus, make_type(io::neb, neb::de_pb_host_status)>;
+using pb_host_status_delta =
+    io::protobuf<HostStatusDelta,
+                 make_type(io::neb, neb::de_pb_host_status_delta)>;
 using pb_host = io::protobuf<Host, make_type(io::neb, neb::de_pb_host)>;
 using pb_adaptive_host =
     io::protobuf<AdaptiveHost, make_type(io::neb, neb::de_pb_adaptive_host)>;
@@ -59,6 +63,9 @@ using pb_adaptive_service =
 
 using pb_service_status =
     io::protobuf<ServiceStatus, make_type(io::neb, neb::de_pb_service_status)>;
+using pb_service_status_delta =
+    io::protobuf<ServiceStatusDelta,
+                 make_type(io::neb, neb::de_pb_service_status_delta)>;
 
 using pb_severity =
     io::protobuf<Severity, make_type(io::neb, neb::de_pb_severity)>;
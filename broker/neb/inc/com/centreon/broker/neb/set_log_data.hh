@@ -21,6 +21,7 @@
 
 #include "com/centreon/broker/neb/log_entry.hh"
 #include "com/centreon/engine/host.hh"
+#include "com/centreon/engine/nebstructs.hh"
 #include "com/centreon/engine/service.hh"
 
 namespace com {
@@ -29,6 +30,7 @@ namespace broker {
 namespace neb {
 void set_log_data(neb::log_entry& le, char const* log_data);
 bool set_pb_log_data(neb::pb_log_entry& le, const std::string& output);
+void set_pb_log_data(neb::pb_log_entry& le, const nebstruct_log_record& record);
 }  // namespace neb
 }  // namespace broker
 }  // namespace centreon
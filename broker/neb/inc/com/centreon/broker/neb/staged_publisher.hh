@@ -0,0 +1,79 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_NEB_STAGED_PUBLISHER_HH
+#define CCB_NEB_STAGED_PUBLISHER_HH
+
+#include "com/centreon/broker/multiplexing/publisher.hh"
+
+namespace com::centreon::broker::neb {
+
+/**
+ * @brief publisher used by cbmod callbacks.
+ *
+ * Each call to multiplexing::engine::publish() locks the engine and wakes up
+ * its muxers. Engine callbacks produce many small events during an event
+ * loop iteration, so events written by the engine loop thread are staged and
+ * published all at once when the iteration ends (see
+ * NEBCALLBACK_EVENT_LOOP_DATA).
+ *
+ * Staging is enabled per thread by enable_staging(). Threads that never call
+ * it (or an engine that doesn't emit NEBCALLBACK_EVENT_LOOP_DATA) publish
+ * each event immediately as before.
+ * The stage is also flushed when it contains batch_size events or when its
+ * oldest event is older than batch_latency.
+ */
+class staged_publisher {
+  struct stage {
+    bool enabled = false;
+    std::chrono::steady_clock::time_point first_event;
+    std::deque<std::shared_ptr<io::data>> events;
+    std::deque<std::shared_ptr<io::data>>* capture = nullptr;
+  };
+
+  static thread_local stage _stage;
+
+  multiplexing::publisher _publisher;
+  std::atomic_uint _batch_size;
+  std::atomic<std::chrono::milliseconds::rep> _batch_latency;
+  // number of calls to the multiplexing publisher
+  std::atomic_uint64_t _publish_count;
+
+ public:
+  staged_publisher();
+  staged_publisher(const staged_publisher&) = delete;
+  staged_publisher& operator=(const staged_publisher&) = delete;
+
+  void set_limits(unsigned batch_size, std::chrono::milliseconds batch_latency);
+
+  int32_t write(const std::shared_ptr<io::data>& d);
+
+  void enable_staging();
+  void disable_staging();
+  void flush();
+
+  void start_capture(std::deque<std::shared_ptr<io::data>>* events);
+  void stop_capture();
+
+  size_t staged_size() const { return _stage.events.size(); }
+  uint64_t publish_count() const { return _publish_count; }
+};
+
+}  // namespace com::centreon::broker::neb
+
+#endif  // !CCB_NEB_STAGED_PUBLISHER_HH
@@ -152,6 +152,9 @@ void broker_module_init(void const* arg) {
       e.register_event(make_type(io::neb, neb::de_pb_service_status),
                        "ServiceStatus", &neb::pb_service_status::operations,
                        "services");
+      e.register_event(make_type(io::neb, neb::de_pb_service_status_delta),
+                       "ServiceStatusDelta",
+                       &neb::pb_service_status_delta::operations, "services");
 
       e.register_event(make_type(io::neb, neb::de_pb_host), "Host",
                        &neb::pb_host::operations, "hosts");
@@ -161,6 +164,9 @@ void broker_module_init(void const* arg) {
 
       e.register_event(make_type(io::neb, neb::de_pb_host_status), "HostStatus",
                        &neb::pb_host_status::operations, "hosts");
+      e.register_event(make_type(io::neb, neb::de_pb_host_status_delta),
+                       "HostStatusDelta", &neb::pb_host_status_delta::operations,
+                       "hosts");
 
       e.register_event(make_type(io::neb, neb::de_pb_severity), "Severity",
                        &neb::pb_severity::operations, "severities");
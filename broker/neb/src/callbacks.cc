@@ -123,7 +123,8 @@ static struct {
     {NEBCALLBACK_GROUP_DATA, &neb::callback_group},
     {NEBCALLBACK_GROUP_MEMBER_DATA, &neb::callback_group_member},
     {NEBCALLBACK_RELATION_DATA, &neb::callback_relation},
-    {NEBCALLBACK_BENCH_DATA, &neb::callback_pb_bench}};
+    {NEBCALLBACK_BENCH_DATA, &neb::callback_pb_bench},
+    {NEBCALLBACK_EVENT_LOOP_DATA, &neb::callback_event_loop}};
 
 static struct {
   uint32_t macro;
@@ -135,7 +136,8 @@ static struct {
     {NEBCALLBACK_GROUP_DATA, &neb::callback_pb_group},
     {NEBCALLBACK_GROUP_MEMBER_DATA, &neb::callback_pb_group_member},
     {NEBCALLBACK_RELATION_DATA, &neb::callback_pb_relation},
-    {NEBCALLBACK_BENCH_DATA, &neb::callback_pb_bench}};
+    {NEBCALLBACK_BENCH_DATA, &neb::callback_pb_bench},
+    {NEBCALLBACK_EVENT_LOOP_DATA, &neb::callback_event_loop}};
 
 // Registered callbacks.
 std::list<std::unique_ptr<neb::callback>> neb::gl_registered_callbacks;
@@ -2275,7 +2277,9 @@ int neb::callback_pb_log(int callback_type [[maybe_unused]], void* data) {
     log_data = static_cast<nebstruct_log_data*>(data);
     le_obj.set_ctime(log_data->entry_time);
     le_obj.set_instance_name(config::applier::state::instance().poller_name());
-    if (log_data->data) {
+    if (log_data->record)
+      set_pb_log_data(*le, *log_data->record);
+    else if (log_data->data) {
       std::string output = common::check_string_utf8(log_data->data);
       le_obj.set_output(output);
       set_pb_log_data(*le, output);
@@ -2368,6 +2372,7 @@ int neb::callback_process(int, void* data) {
 
     // Send event.
     gl_publisher.write(instance);
+    gl_publisher.disable_staging();
   }
   return 0;
 }
@@ -2434,8 +2439,7 @@ int neb::callback_pb_process(int callback_type, void* data) {
     inst.set_start_time(start_time);
 
     // Send initial event and then configuration.
-    gl_publisher.write(inst_obj);
-    send_initial_pb_configuration();
+    send_initial_pb_configuration(inst_obj);
   } else if (NEBTYPE_PROCESS_EVENTLOOPEND == process_data->type) {
     SPDLOG_LOGGER_DEBUG(neb_logger, "callbacks: generating process end event");
     // Fill output var.
@@ -2447,6 +2451,7 @@ int neb::callback_pb_process(int callback_type, void* data) {
 
     // Send event.
     gl_publisher.write(inst_obj);
+    gl_publisher.disable_staging();
   }
   SPDLOG_LOGGER_DEBUG(neb_logger, "callbacks: instance '{}' running {}",
                       inst.name(), inst.running());
@@ -3697,6 +3702,30 @@ int neb::callback_pb_bench(int, void* data) {
   return 0;
 }
 
+/**
+ * @brief called by the engine at the end of each event loop iteration.
+ * Events generated by the loop thread are staged between two calls and
+ * published here in one shot.
+ *
+ * @param data a nebstruct_event_loop_data
+ * @return int 0
+ */
+int neb::callback_event_loop(int, void* data) {
+  (void)data;
+  try {
+    gl_publisher.enable_staging();
+    check_initial_pb_configuration_ack();
+  }
+  // Avoid exception propagation in C code.
+  catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(neb_logger,
+                        "callbacks: error occurred while publishing staged "
+                        "events: {}",
+                        e.what());
+  }
+  return 0;
+}
+
 namespace com::centreon::broker::neb::otl_detail {
 /**
  * @brief the goal of this little class is to avoid copy of an
@@ -0,0 +1,488 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/neb/config_fingerprints.hh"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "common/log_v2/log_v2.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::neb;
+using com::centreon::common::log_v2::log_v2;
+
+static constexpr char file_magic[] = "CBCF";
+static constexpr uint32_t file_format = 1;
+
+/**
+ * @brief Serialize a message, the same message always gives the same buffer.
+ *
+ * @param m The message to serialize.
+ * @param buffer The string to which the serialized message is appended.
+ */
+static void serialize(const google::protobuf::Message& m, std::string* buffer) {
+  google::protobuf::io::StringOutputStream sos(buffer);
+  google::protobuf::io::CodedOutputStream cos(&sos);
+  cos.SetSerializationDeterministic(true);
+  m.SerializeToCodedStream(&cos);
+}
+
+/**
+ * @brief Build the list of fields of obj that are also in status. Those fields
+ * are updated by status events, so they are not part of the configuration.
+ *
+ * @param obj A configuration message descriptor.
+ * @param status The descriptor of its status message, nullptr if none.
+ * @param keep Fields of status that must not be listed.
+ * @param extra Fields of obj to list even if not in status.
+ *
+ * @return A list of field descriptors of obj.
+ */
+static std::vector<const google::protobuf::FieldDescriptor*> volatile_fields(
+    const google::protobuf::Descriptor* obj,
+    const google::protobuf::Descriptor* status,
+    std::initializer_list<absl::string_view> keep,
+    std::initializer_list<absl::string_view> extra) {
+  std::vector<const google::protobuf::FieldDescriptor*> retval;
+  for (int i = 0; i < obj->field_count(); ++i) {
+    const google::protobuf::FieldDescriptor* f = obj->field(i);
+    if (std::find(keep.begin(), keep.end(), f->name()) != keep.end())
+      continue;
+    if ((status && status->FindFieldByName(f->name())) ||
+        std::find(extra.begin(), extra.end(), f->name()) != extra.end())
+      retval.push_back(f);
+  }
+  return retval;
+}
+
+/**
+ * @brief Constructor.
+ *
+ * @param path The file where fingerprints are saved.
+ * @param poller_id The poller ID, a file saved by another poller is ignored.
+ * @param version The broker version, a file saved by another version is
+ * ignored since serialized events may differ.
+ */
+config_fingerprints::config_fingerprints(const std::string& path,
+                                         uint64_t poller_id,
+                                         const std::string& version)
+    : _path{path},
+      _poller_id{poller_id},
+      _version{version},
+      _logger{log_v2::instance().get(log_v2::NEB)},
+      _acked_fingerprint{0},
+      _pending_fingerprint{0},
+      _waiting{false} {}
+
+/**
+ * @brief Load fingerprints saved by a previous run. On error, the object stays
+ * empty and the next diff() will send the whole configuration.
+ *
+ * @return true if fingerprints have been loaded.
+ */
+bool config_fingerprints::load() {
+  _acked.clear();
+  _acked_fingerprint = 0;
+
+  std::ifstream f(_path, std::ios::binary);
+  if (!f) {
+    _logger->info("config fingerprints: no file '{}', full configuration sent",
+                  _path);
+    return false;
+  }
+
+  auto read_u32 = [&f]() {
+    uint32_t v = 0;
+    f.read(reinterpret_cast<char*>(&v), sizeof(v));
+    return v;
+  };
+  auto read_u64 = [&f]() {
+    uint64_t v = 0;
+    f.read(reinterpret_cast<char*>(&v), sizeof(v));
+    return v;
+  };
+  auto read_str = [&f, &read_u32]() {
+    std::string s(read_u32(), '\0');
+    f.read(s.data(), s.size());
+    return s;
+  };
+
+  char magic[sizeof(file_magic) - 1];
+  f.read(magic, sizeof(magic));
+  if (!f || memcmp(magic, file_magic, sizeof(magic)) ||
+      read_u32() != file_format) {
+    _logger->error("config fingerprints: file '{}' is corrupted", _path);
+    return false;
+  }
+  std::string version = read_str();
+  uint64_t poller_id = read_u64();
+  if (version != _version || poller_id != _poller_id) {
+    _logger->info(
+        "config fingerprints: file '{}' saved by poller {} with broker {}, "
+        "full configuration sent",
+        _path, poller_id, version);
+    return false;
+  }
+  uint64_t fingerprint = read_u64();
+  uint64_t count = read_u64();
+  object_map objects;
+  objects.reserve(count);
+  for (uint64_t i = 0; f && i < count; ++i) {
+    std::string key = read_str();
+    objects.emplace(std::move(key), read_u64());
+  }
+  if (!f || objects.size() != count || !fingerprint) {
+    _logger->error("config fingerprints: file '{}' is corrupted", _path);
+    return false;
+  }
+
+  _acked = std::move(objects);
+  _acked_fingerprint = fingerprint;
+  _logger->info(
+      "config fingerprints: {} objects loaded from '{}', fingerprint {:016x}",
+      _acked.size(), _path, _acked_fingerprint);
+  return true;
+}
+
+/**
+ * @brief Save the acknowledged fingerprints. The file is first written with a
+ * temporary name, so a crash never leaves a partial file.
+ */
+void config_fingerprints::_save() const {
+  std::string tmp = fmt::format("{}.tmp", _path);
+  {
+    std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+    auto write_u32 = [&f](uint32_t v) {
+      f.write(reinterpret_cast<const char*>(&v), sizeof(v));
+    };
+    auto write_u64 = [&f](uint64_t v) {
+      f.write(reinterpret_cast<const char*>(&v), sizeof(v));
+    };
+    auto write_str = [&f, &write_u32](const std::string& s) {
+      write_u32(s.size());
+      f.write(s.data(), s.size());
+    };
+    f.write(file_magic, sizeof(file_magic) - 1);
+    write_u32(file_format);
+    write_str(_version);
+    write_u64(_poller_id);
+    write_u64(_acked_fingerprint);
+    write_u64(_acked.size());
+    for (auto& [key, hash] : _acked) {
+      write_str(key);
+      write_u64(hash);
+    }
+    f.flush();
+    if (!f) {
+      _logger->error("config fingerprints: unable to write '{}'", tmp);
+      std::remove(tmp.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp.c_str(), _path.c_str())) {
+    _logger->error("config fingerprints: unable to rename '{}' to '{}': {}",
+                   tmp, _path, strerror(errno));
+    std::remove(tmp.c_str());
+  }
+}
+
+/**
+ * @brief Compute the fingerprints of the given configuration events and
+ * remove from evts those already known by broker. Events removing objects
+ * that disappeared since the last acknowledged configuration are appended to
+ * evts. marker is filled with the fingerprints and the unchanged hosts and
+ * services. It must be published after evts.
+ * The configuration is then waited to be acknowledged by broker.
+ *
+ * If there is no acknowledged configuration, evts is left as is and the
+ * base fingerprint in marker is 0.
+ *
+ * @param evts The whole configuration events.
+ * @param marker The InstanceConfiguration event closing the configuration.
+ */
+void config_fingerprints::diff(
+    events* evts,
+    const std::shared_ptr<pb_instance_configuration>& marker) {
+  InstanceConfiguration& ic = marker->mut_obj();
+  object_map current;
+  current.reserve(_acked.size());
+  uint64_t fingerprint = 0;
+  size_t sent = 0;
+  std::string key;
+  uint64_t h;
+
+  events kept;
+  for (auto& e : *evts) {
+    if (!object_key(*e, &key, &h)) {
+      kept.push_back(std::move(e));
+      continue;
+    }
+    fingerprint += h;
+    auto found = _acked.find(key);
+    bool unchanged = _acked_fingerprint && found != _acked.end() &&
+                     found->second == h;
+    current[key] = h;
+    if (!unchanged) {
+      ++sent;
+      kept.push_back(std::move(e));
+    } else if (e->type() == pb_host::static_type()) {
+      ic.add_unchanged_hosts(static_cast<pb_host*>(e.get())->obj().host_id());
+    } else if (e->type() == pb_service::static_type()) {
+      const Service& s = static_cast<pb_service*>(e.get())->obj();
+      ServiceId* id = ic.add_unchanged_services();
+      id->set_host_id(s.host_id());
+      id->set_service_id(s.service_id());
+    }
+  }
+
+  /* Objects that disappeared. Hosts and services are disabled by broker if
+   * not listed in the unchanged ones, other objects need an event. */
+  size_t removed = 0;
+  if (_acked_fingerprint) {
+    for (auto& [k, v] : _acked) {
+      if (current.contains(k))
+        continue;
+      uint32_t type;
+      memcpy(&type, k.data(), sizeof(type));
+      absl::string_view identity(k.data() + sizeof(type),
+                                 k.size() - sizeof(type));
+      std::shared_ptr<io::protobuf_base> e;
+      switch (type) {
+        case pb_custom_variable::static_type(): {
+          auto cv = std::make_shared<pb_custom_variable>();
+          cv->mut_obj().ParseFromArray(identity.data(), identity.size());
+          cv->mut_obj().set_enabled(false);
+          e = cv;
+        } break;
+        case pb_host_parent::static_type(): {
+          auto hp = std::make_shared<pb_host_parent>();
+          hp->mut_obj().ParseFromArray(identity.data(), identity.size());
+          hp->mut_obj().set_enabled(false);
+          e = hp;
+        } break;
+        case pb_host_group_member::static_type(): {
+          auto hgm = std::make_shared<pb_host_group_member>();
+          hgm->mut_obj().ParseFromArray(identity.data(), identity.size());
+          hgm->mut_obj().set_enabled(false);
+          e = hgm;
+        } break;
+        case pb_service_group_member::static_type(): {
+          auto sgm = std::make_shared<pb_service_group_member>();
+          sgm->mut_obj().ParseFromArray(identity.data(), identity.size());
+          sgm->mut_obj().set_enabled(false);
+          e = sgm;
+        } break;
+      }
+      ++removed;
+      if (e)
+        kept.push_back(std::move(e));
+    }
+  }
+  *evts = std::move(kept);
+
+  /* 0 means no fingerprint. */
+  if (!fingerprint)
+    fingerprint = 1;
+
+  ic.set_config_fingerprint(fingerprint);
+  ic.set_config_base_fingerprint(_acked_fingerprint);
+  if (_acked_fingerprint)
+    _logger->info(
+        "config fingerprints: configuration {:016x} sent as a diff from "
+        "{:016x}: {} objects sent, {} unchanged, {} removed",
+        fingerprint, _acked_fingerprint, sent, current.size() - sent, removed);
+  else
+    _logger->info(
+        "config fingerprints: configuration {:016x} fully sent ({} objects)",
+        fingerprint, current.size());
+
+  /* Until broker acknowledges this configuration, the saved one is no more
+   * valid. */
+  std::remove(_path.c_str());
+  _pending = std::move(current);
+  _pending_fingerprint = fingerprint;
+  _waiting = true;
+}
+
+/**
+ * @brief Handle the acknowledgement sent by broker once it has stored the
+ * configuration. If it is the configuration sent by the last diff(), it
+ * becomes the acknowledged one and is saved.
+ *
+ * @param fingerprint The fingerprint of the configuration stored by broker.
+ *
+ * @return true if the configuration has just been acknowledged.
+ */
+bool config_fingerprints::acknowledge(uint64_t fingerprint) {
+  if (!_waiting || fingerprint != _pending_fingerprint) {
+    _logger->info(
+        "config fingerprints: acknowledgement of configuration {:016x} "
+        "ignored, waiting for {:016x}",
+        fingerprint, _waiting ? _pending_fingerprint : 0);
+    return false;
+  }
+  _waiting = false;
+  _acked = std::move(_pending);
+  _acked_fingerprint = _pending_fingerprint;
+  _pending.clear();
+  _logger->info("config fingerprints: configuration {:016x} acknowledged",
+                _acked_fingerprint);
+  _save();
+  return true;
+}
+
+/**
+ * @brief Forget all the fingerprints, broker does not know the configuration
+ * and the next diff() sends it fully.
+ */
+void config_fingerprints::reset() {
+  _acked.clear();
+  _acked_fingerprint = 0;
+  _pending.clear();
+  _pending_fingerprint = 0;
+  _waiting = false;
+  std::remove(_path.c_str());
+}
+
+/**
+ * @brief FNV-1a hash of a buffer.
+ *
+ * @param buffer The buffer to hash.
+ *
+ * @return A 64 bits hash.
+ */
+uint64_t config_fingerprints::hash(const std::string& buffer) {
+  uint64_t retval = 0xcbf29ce484222325ull;
+  for (unsigned char c : buffer) {
+    retval ^= c;
+    retval *= 0x100000001b3ull;
+  }
+  return retval;
+}
+
+/**
+ * @brief Compute the key and the hash of a configuration event. The key is
+ * the event type followed by the serialized identity fields of the object,
+ * so a removal event can be rebuilt from it. The hash is computed on the key
+ * and the object without its volatile fields (header, status fields).
+ *
+ * @param d An event.
+ * @param key The key of the object.
+ * @param hash The hash of the object.
+ *
+ * @return false if d is not a configuration object that can be diffed, key
+ * and hash are then left untouched.
+ */
+bool config_fingerprints::object_key(const io::data& d,
+                                     std::string* key,
+                                     uint64_t* hash) {
+  static const auto host_volatile =
+      volatile_fields(Host::descriptor(), HostStatus::descriptor(),
+                      {"host_id"}, {"last_update", "acknowledged"});
+  static const auto service_volatile = volatile_fields(
+      Service::descriptor(), ServiceStatus::descriptor(),
+      {"host_id", "service_id", "type", "internal_id"},
+      {"last_update", "acknowledged"});
+  static const auto custom_variable_volatile = volatile_fields(
+      CustomVariable::descriptor(), nullptr, {}, {"update_time"});
+  static const std::vector<const google::protobuf::FieldDescriptor*> none;
+
+  std::unique_ptr<google::protobuf::Message> identity;
+  const std::vector<const google::protobuf::FieldDescriptor*>* to_clear =
+      &none;
+  switch (d.type()) {
+    case pb_host::static_type(): {
+      const Host& h = static_cast<const pb_host&>(d).obj();
+      auto id = std::make_unique<Host>();
+      id->set_host_id(h.host_id());
+      identity = std::move(id);
+      to_clear = &host_volatile;
+    } break;
+    case pb_service::static_type(): {
+      const Service& s = static_cast<const pb_service&>(d).obj();
+      auto id = std::make_unique<Service>();
+      id->set_host_id(s.host_id());
+      id->set_service_id(s.service_id());
+      identity = std::move(id);
+      to_clear = &service_volatile;
+    } break;
+    case pb_custom_variable::static_type(): {
+      const CustomVariable& cv =
+          static_cast<const pb_custom_variable&>(d).obj();
+      auto id = std::make_unique<CustomVariable>();
+      id->set_host_id(cv.host_id());
+      id->set_service_id(cv.service_id());
+      id->set_name(cv.name());
+      identity = std::move(id);
+      to_clear = &custom_variable_volatile;
+    } break;
+    case pb_host_parent::static_type(): {
+      const HostParent& hp = static_cast<const pb_host_parent&>(d).obj();
+      auto id = std::make_unique<HostParent>();
+      id->set_child_id(hp.child_id());
+      id->set_parent_id(hp.parent_id());
+      identity = std::move(id);
+    } break;
+    case pb_host_group_member::static_type(): {
+      const HostGroupMember& m =
+          static_cast<const pb_host_group_member&>(d).obj();
+      auto id = std::make_unique<HostGroupMember>();
+      id->set_hostgroup_id(m.hostgroup_id());
+      id->set_host_id(m.host_id());
+      id->set_poller_id(m.poller_id());
+      identity = std::move(id);
+    } break;
+    case pb_service_group_member::static_type(): {
+      const ServiceGroupMember& m =
+          static_cast<const pb_service_group_member&>(d).obj();
+      auto id = std::make_unique<ServiceGroupMember>();
+      id->set_servicegroup_id(m.servicegroup_id());
+      id->set_host_id(m.host_id());
+      id->set_service_id(m.service_id());
+      id->set_poller_id(m.poller_id());
+      identity = std::move(id);
+    } break;
+    default:
+      return false;
+  }
+
+  uint32_t type = d.type();
+  key->assign(reinterpret_cast<const char*>(&type), sizeof(type));
+  serialize(*identity, key);
+
+  const google::protobuf::Message* msg =
+      static_cast<const io::protobuf_base&>(d).msg();
+  std::unique_ptr<google::protobuf::Message> content(msg->New());
+  content->CopyFrom(*msg);
+  const google::protobuf::Reflection* refl = content->GetReflection();
+  const google::protobuf::FieldDescriptor* header =
+      content->GetDescriptor()->FindFieldByName("header");
+  if (header)
+    refl->ClearField(content.get(), header);
+  for (auto* f : *to_clear)
+    refl->ClearField(content.get(), f);
+
+  std::string buffer(*key);
+  serialize(*content, &buffer);
+  *hash = config_fingerprints::hash(buffer);
+  return true;
+}
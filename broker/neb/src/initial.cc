@@ -19,6 +19,7 @@
 #include "com/centreon/broker/neb/initial.hh"
 #include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/neb/callbacks.hh"
+#include "com/centreon/broker/neb/config_fingerprints.hh"
 #include "com/centreon/broker/neb/events.hh"
 #include "com/centreon/broker/neb/internal.hh"
 #include "com/centreon/engine/broker.hh"
@@ -42,6 +43,9 @@ extern "C" {
 nebmodule* neb_module_list;
 }
 
+// Fingerprints of the configuration sent to broker.
+static std::unique_ptr<neb::config_fingerprints> gl_config_fingerprints;
+
 /**************************************
  *                                     *
  *          Static Functions           *
@@ -423,15 +427,37 @@ static void send_instance_configuration() {
 }
 
 /**
- *  Send the instance configuration loaded event.
+ *  Capture the configuration and keep only the objects that changed since the
+ *  last configuration acknowledged by broker.
+ *
+ *  @param events Filled with the configuration events to send.
+ *
+ *  @return The instance configuration loaded event, to send after events.
  */
-static void send_pb_instance_configuration() {
-  neb_logger->info(
-      "init: sending initial instance configuration loading event");
+static std::shared_ptr<neb::pb_instance_configuration>
+capture_pb_configuration(neb::config_fingerprints::events* events) {
+  neb::gl_publisher.start_capture(events);
+  try {
+    send_severity_list();
+    send_tag_list();
+    send_pb_host_list();
+    send_pb_service_list();
+    send_pb_custom_variables_list();
+    send_pb_downtimes_list();
+    send_pb_host_parents_list();
+    send_pb_host_group_list();
+    send_pb_service_group_list();
+  } catch (...) {
+    neb::gl_publisher.stop_capture();
+    throw;
+  }
+  neb::gl_publisher.stop_capture();
+
   auto ic = std::make_shared<neb::pb_instance_configuration>();
   ic->mut_obj().set_loaded(true);
   ic->mut_obj().set_poller_id(config::applier::state::instance().poller_id());
-  neb::gl_publisher.write(ic);
+  gl_config_fingerprints->diff(events, ic);
+  return ic;
 }
 
 /**************************************
@@ -464,18 +490,64 @@ void neb::send_initial_configuration() {
  **************************************/
 
 /**
- *  Send initial configuration to the global publisher.
+ *  Send the instance event and the initial configuration to the global
+ *  publisher. The configuration is first captured, then only objects that
+ *  changed since the last configuration acknowledged by broker are sent,
+ *  followed by the instance configuration loaded event.
+ *
+ *  @param inst The instance event, its config_base_fingerprint is set here.
  */
-void neb::send_initial_pb_configuration() {
+void neb::send_initial_pb_configuration(
+    const std::shared_ptr<pb_instance>& inst) {
   SPDLOG_LOGGER_INFO(neb_logger, "init: send poller pb conf");
-  send_severity_list();
-  send_tag_list();
-  send_pb_host_list();
-  send_pb_service_list();
-  send_pb_custom_variables_list();
-  send_pb_downtimes_list();
-  send_pb_host_parents_list();
-  send_pb_host_group_list();
-  send_pb_service_group_list();
-  send_pb_instance_configuration();
+  if (!gl_config_fingerprints) {
+    gl_config_fingerprints = std::make_unique<config_fingerprints>(
+        fmt::format("{}.config_fingerprints",
+                    config::applier::state::instance().cache_dir()),
+        config::applier::state::instance().poller_id(),
+        CENTREON_BROKER_VERSION);
+    gl_config_fingerprints->load();
+  }
+
+  config_fingerprints::events events;
+  auto ic = capture_pb_configuration(&events);
+
+  neb_logger->info(
+      "init: sending initial instance configuration loading event");
+  inst->mut_obj().set_config_base_fingerprint(
+      ic->obj().config_base_fingerprint());
+  gl_publisher.write(inst);
+  for (auto& e : events)
+    gl_publisher.write(e);
+  gl_publisher.write(ic);
+}
+
+/**
+ *  Called at each event loop to handle the configuration acknowledgement sent
+ *  by broker. When broker stored the last configuration sent, its
+ *  fingerprints are saved so that the next start only sends the differences.
+ *  When broker could not apply the differences, the whole configuration is
+ *  sent again.
+ */
+void neb::check_initial_pb_configuration_ack() {
+  if (!gl_config_fingerprints)
+    return;
+  std::optional<uint64_t> fingerprint =
+      config::applier::state::instance().pop_config_ack_received();
+  if (!fingerprint)
+    return;
+  if (*fingerprint) {
+    gl_config_fingerprints->acknowledge(*fingerprint);
+    return;
+  }
+
+  neb_logger->error(
+      "init: broker does not know the configuration sent, sending the whole "
+      "configuration again");
+  gl_config_fingerprints->reset();
+  config_fingerprints::events events;
+  auto ic = capture_pb_configuration(&events);
+  for (auto& e : events)
+    gl_publisher.write(e);
+  gl_publisher.write(ic);
 }
@@ -30,4 +30,4 @@ using namespace com::centreon::broker;
 std::string neb::gl_configuration_file;
 
 // Sender object.
-multiplexing::publisher neb::gl_publisher;
+neb::staged_publisher neb::gl_publisher;
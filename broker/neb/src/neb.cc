@@ -24,6 +24,7 @@
 #include "com/centreon/broker/config/parser.hh"
 #include "com/centreon/broker/neb/callbacks.hh"
 #include "com/centreon/broker/neb/instance_configuration.hh"
+#include "com/centreon/broker/neb/internal.hh"
 #include "com/centreon/engine/nebcallbacks.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 #include "common/log_v2/log_v2.hh"
@@ -63,6 +64,9 @@ int nebmodule_deinit(int flags, int reason) {
     // Unregister callbacks.
     neb::unregister_callbacks();
 
+    // Publish events staged by this thread.
+    neb::gl_publisher.disable_staging();
+
     com::centreon::broker::config::applier::deinit();
   }
   // Avoid exception propagation in C code.
@@ -146,6 +150,9 @@ int nebmodule_init(int flags, char const* args, void* handle) {
       }
 
       com::centreon::broker::config::applier::state::instance().apply(s);
+      neb::gl_publisher.set_limits(
+          std::max(s.neb_events_batch_size(), 0),
+          std::chrono::milliseconds(std::max(s.neb_events_batch_latency(), 0)));
 
       // Register process and log callback.
       if (s.get_bbdo_version().major_v > 2) {
@@ -200,6 +207,8 @@ int nebmodule_init(int flags, char const* args, void* handle) {
  */
 int nebmodule_reload() {
   multiplexing::publisher p;
+  // events staged before reload must be received before configuration end
+  neb::gl_publisher.flush();
   if (com::centreon::broker::config::applier::state::instance()
           .get_bbdo_version()
           .major_v > 2) {
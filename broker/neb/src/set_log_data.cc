@@ -20,6 +20,7 @@
 #include <absl/strings/str_split.h>
 #include "com/centreon/broker/neb/internal.hh"
 #include "com/centreon/broker/neb/log_entry.hh"
+#include "com/centreon/common/utf8.hh"
 #include "com/centreon/engine/host.hh"
 #include "com/centreon/engine/service.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
@@ -631,3 +632,64 @@ bool neb::set_pb_log_data(neb::pb_log_entry& le, const std::string& output) {
 
   return true;
 }
+
+/**
+ *  Fill a log entry with the fields given by the engine, the log message
+ *  doesn't need to be parsed and ids are already known.
+ */
+void neb::set_pb_log_data(neb::pb_log_entry& le,
+                          const nebstruct_log_record& record) {
+  auto& le_obj = le.mut_obj();
+
+  switch (record.type) {
+    case NEBLOG_SERVICE_ALERT:
+      le_obj.set_msg_type(LogEntry_MsgType_SERVICE_ALERT);
+      break;
+    case NEBLOG_HOST_ALERT:
+      le_obj.set_msg_type(LogEntry_MsgType_HOST_ALERT);
+      break;
+    case NEBLOG_SERVICE_NOTIFICATION:
+      le_obj.set_msg_type(LogEntry_MsgType_SERVICE_NOTIFICATION);
+      break;
+    case NEBLOG_HOST_NOTIFICATION:
+      le_obj.set_msg_type(LogEntry_MsgType_HOST_NOTIFICATION);
+      break;
+    case NEBLOG_SERVICE_INITIAL_STATE:
+      le_obj.set_msg_type(LogEntry_MsgType_SERVICE_INITIAL_STATE);
+      break;
+    case NEBLOG_HOST_INITIAL_STATE:
+      le_obj.set_msg_type(LogEntry_MsgType_HOST_INITIAL_STATE);
+      break;
+    case NEBLOG_SERVICE_EVENT_HANDLER:
+      le_obj.set_msg_type(LogEntry_MsgType_SERVICE_EVENT_HANDLER);
+      break;
+    case NEBLOG_HOST_EVENT_HANDLER:
+      le_obj.set_msg_type(LogEntry_MsgType_HOST_EVENT_HANDLER);
+      break;
+    case NEBLOG_GLOBAL_SERVICE_EVENT_HANDLER:
+      le_obj.set_msg_type(LogEntry_MsgType_GLOBAL_SERVICE_EVENT_HANDLER);
+      break;
+    case NEBLOG_GLOBAL_HOST_EVENT_HANDLER:
+      le_obj.set_msg_type(LogEntry_MsgType_GLOBAL_HOST_EVENT_HANDLER);
+      break;
+  }
+
+  le_obj.set_host_id(record.host_id);
+  le_obj.set_service_id(record.service_id);
+  if (record.host_name)
+    le_obj.set_host_name(common::check_string_utf8(record.host_name));
+  if (record.service_description)
+    le_obj.set_service_description(
+        common::check_string_utf8(record.service_description));
+  le_obj.set_status(record.state);
+  le_obj.set_type(record.state_type == engine::checkable::hard
+                      ? LogEntry_LogType_HARD
+                      : LogEntry_LogType_SOFT);
+  le_obj.set_retry(record.attempt);
+  if (record.contact)
+    le_obj.set_notification_contact(common::check_string_utf8(record.contact));
+  if (record.command)
+    le_obj.set_notification_cmd(common::check_string_utf8(record.command));
+  if (record.output)
+    le_obj.set_output(common::check_string_utf8(record.output));
+}
@@ -0,0 +1,124 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/neb/staged_publisher.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::neb;
+
+thread_local staged_publisher::stage staged_publisher::_stage;
+
+staged_publisher::staged_publisher()
+    : _batch_size(1000), _batch_latency(100), _publish_count(0) {}
+
+/**
+ * @brief set flush thresholds
+ *
+ * @param batch_size stage is published when it contains batch_size events,
+ * 0 or 1 means no staging
+ * @param batch_latency stage is published when its oldest event is older
+ * than batch_latency
+ */
+void staged_publisher::set_limits(unsigned batch_size,
+                                  std::chrono::milliseconds batch_latency) {
+  _batch_size = batch_size;
+  _batch_latency = batch_latency.count();
+}
+
+/**
+ * @brief stage d if staging is enabled on the current thread, publish it
+ * otherwise. If a capture is started on the current thread, d is only
+ * appended to it.
+ *
+ * @param d
+ * @return int32_t 1
+ */
+int32_t staged_publisher::write(const std::shared_ptr<io::data>& d) {
+  stage& st = _stage;
+  if (st.capture) {
+    st.capture->push_back(d);
+    return 1;
+  }
+  if (!st.enabled || _batch_size <= 1) {
+    ++_publish_count;
+    return _publisher.write(d);
+  }
+  if (st.events.empty()) {
+    st.first_event = std::chrono::steady_clock::now();
+  }
+  st.events.push_back(d);
+  if (st.events.size() >= _batch_size ||
+      std::chrono::steady_clock::now() - st.first_event >=
+          std::chrono::milliseconds(_batch_latency)) {
+    flush();
+  }
+  return 1;
+}
+
+/**
+ * @brief called by the event loop thread, from now events written by this
+ * thread are staged. The current stage is published.
+ *
+ */
+void staged_publisher::enable_staging() {
+  _stage.enabled = true;
+  flush();
+}
+
+/**
+ * @brief publish the current stage and stop staging on this thread
+ *
+ */
+void staged_publisher::disable_staging() {
+  _stage.enabled = false;
+  flush();
+}
+
+/**
+ * @brief publish events staged by the current thread
+ *
+ */
+void staged_publisher::flush() {
+  stage& st = _stage;
+  if (!st.events.empty()) {
+    ++_publish_count;
+    _publisher.write(st.events);
+    st.events.clear();
+  }
+}
+
+/**
+ * @brief from now, events written by the current thread are neither staged nor
+ * published but appended to events. It is up to the caller to publish them
+ * later.
+ *
+ * @param events the container receiving events, it must live until
+ * stop_capture() is called.
+ */
+void staged_publisher::start_capture(
+    std::deque<std::shared_ptr<io::data>>* events) {
+  _stage.capture = events;
+}
+
+/**
+ * @brief stop capturing events written by the current thread.
+ *
+ */
+void staged_publisher::stop_capture() {
+  _stage.capture = nullptr;
+}
@@ -0,0 +1,236 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/neb/config_fingerprints.hh"
+#include <gtest/gtest.h>
+
+using namespace com::centreon::broker;
+
+static std::shared_ptr<neb::pb_host> make_host(uint64_t host_id) {
+  auto h = std::make_shared<neb::pb_host>();
+  h->mut_obj().set_host_id(host_id);
+  h->mut_obj().set_name(fmt::format("host_{}", host_id));
+  h->mut_obj().set_address("127.0.0.1");
+  h->mut_obj().set_enabled(true);
+  return h;
+}
+
+static std::shared_ptr<neb::pb_service> make_service(uint64_t host_id,
+                                                     uint64_t service_id) {
+  auto s = std::make_shared<neb::pb_service>();
+  s->mut_obj().set_host_id(host_id);
+  s->mut_obj().set_service_id(service_id);
+  s->mut_obj().set_description(fmt::format("service_{}", service_id));
+  s->mut_obj().set_enabled(true);
+  return s;
+}
+
+static std::shared_ptr<neb::pb_custom_variable> make_cv(uint64_t host_id,
+                                                        const char* name) {
+  auto cv = std::make_shared<neb::pb_custom_variable>();
+  cv->mut_obj().set_host_id(host_id);
+  cv->mut_obj().set_name(name);
+  cv->mut_obj().set_value("value");
+  cv->mut_obj().set_enabled(true);
+  return cv;
+}
+
+class ConfigFingerprints : public ::testing::Test {
+ protected:
+  std::string _path;
+
+ public:
+  void SetUp() override {
+    _path = fmt::format("/tmp/config_fingerprints_test_{}", getpid());
+    std::remove(_path.c_str());
+  }
+
+  void TearDown() override { std::remove(_path.c_str()); }
+
+  /* The whole configuration of our poller. */
+  neb::config_fingerprints::events configuration() {
+    neb::config_fingerprints::events retval;
+    retval.push_back(std::make_shared<neb::pb_severity>());
+    retval.push_back(make_host(1));
+    retval.push_back(make_host(2));
+    retval.push_back(make_service(1, 1));
+    retval.push_back(make_service(2, 2));
+    retval.push_back(make_cv(1, "CV1"));
+    retval.push_back(make_cv(2, "CV2"));
+    return retval;
+  }
+};
+
+// Given a host
+// When its status fields change
+// Then its hash does not change
+// And when its configuration changes its hash changes.
+TEST_F(ConfigFingerprints, ObjectKey) {
+  std::string key1, key2;
+  uint64_t hash1, hash2;
+  auto h = make_host(12);
+  ASSERT_TRUE(neb::config_fingerprints::object_key(*h, &key1, &hash1));
+
+  h->mut_obj().set_state(Host_State_DOWN);
+  h->mut_obj().set_output("CRITICAL");
+  h->mut_obj().set_last_check(123456);
+  h->mut_obj().set_last_update(123456);
+  ASSERT_TRUE(neb::config_fingerprints::object_key(*h, &key2, &hash2));
+  ASSERT_EQ(key1, key2);
+  ASSERT_EQ(hash1, hash2);
+
+  h->mut_obj().set_address("10.0.0.1");
+  ASSERT_TRUE(neb::config_fingerprints::object_key(*h, &key2, &hash2));
+  ASSERT_EQ(key1, key2);
+  ASSERT_NE(hash1, hash2);
+
+  auto s = make_service(12, 1);
+  ASSERT_TRUE(neb::config_fingerprints::object_key(*s, &key2, &hash2));
+  ASSERT_NE(key1, key2);
+
+  neb::pb_severity sev;
+  ASSERT_FALSE(neb::config_fingerprints::object_key(sev, &key2, &hash2));
+}
+
+// Given no saved fingerprints
+// When the configuration is sent
+// Then it is fully sent
+// And once acknowledged, the next start only sends the differences.
+TEST_F(ConfigFingerprints, FullThenDiff) {
+  uint64_t fingerprint;
+  {
+    neb::config_fingerprints fp(_path, 1, "1.0.0");
+    ASSERT_FALSE(fp.load());
+    auto events = configuration();
+    auto marker = std::make_shared<neb::pb_instance_configuration>();
+    fp.diff(&events, marker);
+    ASSERT_EQ(events.size(), 7u);
+    ASSERT_EQ(marker->obj().config_base_fingerprint(), 0u);
+    ASSERT_NE(marker->obj().config_fingerprint(), 0u);
+    fingerprint = marker->obj().config_fingerprint();
+
+    /* Acknowledgement of another configuration. */
+    ASSERT_FALSE(fp.acknowledge(fingerprint + 1));
+    ASSERT_EQ(fp.fingerprint(), 0u);
+    ASSERT_TRUE(fp.acknowledge(fingerprint));
+    ASSERT_FALSE(fp.acknowledge(fingerprint));
+    ASSERT_EQ(fp.fingerprint(), fingerprint);
+  }
+
+  neb::config_fingerprints fp(_path, 1, "1.0.0");
+  ASSERT_TRUE(fp.load());
+  ASSERT_EQ(fp.fingerprint(), fingerprint);
+
+  auto events = configuration();
+  /* host 2 modified, service 3 added, CV2 removed. */
+  static_cast<neb::pb_host*>(events[2].get())->mut_obj().set_alias("alias");
+  events.push_back(make_service(2, 3));
+  events.erase(events.begin() + 6);
+  auto marker = std::make_shared<neb::pb_instance_configuration>();
+  fp.diff(&events, marker);
+
+  ASSERT_EQ(marker->obj().config_base_fingerprint(), fingerprint);
+  ASSERT_NE(marker->obj().config_fingerprint(), fingerprint);
+  ASSERT_EQ(marker->obj().unchanged_hosts_size(), 1);
+  ASSERT_EQ(marker->obj().unchanged_hosts(0), 1u);
+  ASSERT_EQ(marker->obj().unchanged_services_size(), 2);
+
+  /* The severity, host 2, service 3 and the CV2 removal. */
+  ASSERT_EQ(events.size(), 4u);
+  ASSERT_EQ(events[0]->type(), neb::pb_severity::static_type());
+  ASSERT_EQ(events[1]->type(), neb::pb_host::static_type());
+  ASSERT_EQ(events[2]->type(), neb::pb_service::static_type());
+  ASSERT_EQ(events[3]->type(), neb::pb_custom_variable::static_type());
+  const CustomVariable& cv =
+      static_cast<neb::pb_custom_variable*>(events[3].get())->obj();
+  ASSERT_EQ(cv.host_id(), 2u);
+  ASSERT_EQ(cv.name(), "CV2");
+  ASSERT_FALSE(cv.enabled());
+}
+
+// Given saved fingerprints
+// When a diff is sent and never acknowledged
+// Then the next start sends the full configuration.
+TEST_F(ConfigFingerprints, NoAck) {
+  {
+    neb::config_fingerprints fp(_path, 1, "1.0.0");
+    fp.load();
+    auto events = configuration();
+    auto marker = std::make_shared<neb::pb_instance_configuration>();
+    fp.diff(&events, marker);
+    ASSERT_TRUE(fp.acknowledge(marker->obj().config_fingerprint()));
+  }
+  {
+    neb::config_fingerprints fp(_path, 1, "1.0.0");
+    ASSERT_TRUE(fp.load());
+    auto events = configuration();
+    auto marker = std::make_shared<neb::pb_instance_configuration>();
+    fp.diff(&events, marker);
+    ASSERT_EQ(events.size(), 1u);
+  }
+  neb::config_fingerprints fp(_path, 1, "1.0.0");
+  ASSERT_FALSE(fp.load());
+}
+
+// Given fingerprints saved by another poller or another version
+// Then they are not loaded.
+TEST_F(ConfigFingerprints, Mismatch) {
+  {
+    neb::config_fingerprints fp(_path, 1, "1.0.0");
+    auto events = configuration();
+    auto marker = std::make_shared<neb::pb_instance_configuration>();
+    fp.diff(&events, marker);
+    ASSERT_TRUE(fp.acknowledge(marker->obj().config_fingerprint()));
+  }
+  neb::config_fingerprints other_poller(_path, 2, "1.0.0");
+  ASSERT_FALSE(other_poller.load());
+  neb::config_fingerprints other_version(_path, 1, "1.0.1");
+  ASSERT_FALSE(other_version.load());
+  neb::config_fingerprints fp(_path, 1, "1.0.0");
+  ASSERT_TRUE(fp.load());
+}
+
+// Given an acknowledged configuration
+// When broker asks for the whole configuration
+// Then the fingerprints are reset and the next diff is a full configuration.
+TEST_F(ConfigFingerprints, Reset) {
+  neb::config_fingerprints fp(_path, 1, "1.0.0");
+  auto events = configuration();
+  auto marker = std::make_shared<neb::pb_instance_configuration>();
+  fp.diff(&events, marker);
+  ASSERT_TRUE(fp.acknowledge(marker->obj().config_fingerprint()));
+
+  events = configuration();
+  marker = std::make_shared<neb::pb_instance_configuration>();
+  fp.diff(&events, marker);
+  ASSERT_EQ(events.size(), 1u);
+  ASSERT_NE(marker->obj().config_base_fingerprint(), 0u);
+
+  fp.reset();
+  ASSERT_EQ(fp.fingerprint(), 0u);
+  events = configuration();
+  marker = std::make_shared<neb::pb_instance_configuration>();
+  fp.diff(&events, marker);
+  ASSERT_EQ(events.size(), 7u);
+  ASSERT_EQ(marker->obj().config_base_fingerprint(), 0u);
+  ASSERT_TRUE(fp.acknowledge(marker->obj().config_fingerprint()));
+
+  neb::config_fingerprints loaded(_path, 1, "1.0.0");
+  ASSERT_TRUE(loaded.load());
+  ASSERT_EQ(loaded.fingerprint(), marker->obj().config_fingerprint());
+}
@@ -452,3 +452,67 @@ TEST(SetLogData, GlobalServiceEventHandlerPb) {
   ASSERT_FALSE(le.obj().service_description() != "myservice");
   ASSERT_FALSE(le.obj().status() != 1);
 }
+
+/**
+ *  Check that a service alert record given by engine fills the log entry
+ *  without parsing.
+ */
+TEST(SetLogData, ServiceAlertRecordPb) {
+  // Log entry.
+  neb::pb_log_entry le;
+
+  nebstruct_log_record record{.type = NEBLOG_SERVICE_ALERT,
+                              .host_id = 12,
+                              .service_id = 34,
+                              .host_name = "myserver",
+                              .service_description = "myservice",
+                              .state = 2,
+                              .state_type = 1,
+                              .attempt = 3,
+                              .contact = nullptr,
+                              .command = nullptr,
+                              .output = "CRITICAL - disk full"};
+  neb::set_pb_log_data(le, record);
+
+  ASSERT_EQ(le.obj().msg_type(), 0);  // SERVICE ALERT
+  ASSERT_EQ(le.obj().host_id(), 12u);
+  ASSERT_EQ(le.obj().service_id(), 34u);
+  ASSERT_EQ(le.obj().host_name(), "myserver");
+  ASSERT_EQ(le.obj().service_description(), "myservice");
+  ASSERT_EQ(le.obj().status(), 2);  // CRITICAL
+  ASSERT_EQ(le.obj().type(), 1);    // HARD
+  ASSERT_EQ(le.obj().retry(), 3);
+  ASSERT_EQ(le.obj().output(), "CRITICAL - disk full");
+}
+
+/**
+ *  Check that a host notification record given by engine fills the log entry
+ *  without parsing.
+ */
+TEST(SetLogData, HostNotificationRecordPb) {
+  // Log entry.
+  neb::pb_log_entry le;
+
+  nebstruct_log_record record{.type = NEBLOG_HOST_NOTIFICATION,
+                              .host_id = 12,
+                              .service_id = 0,
+                              .host_name = "myserver",
+                              .service_description = nullptr,
+                              .state = 1,
+                              .state_type = 1,
+                              .attempt = 1,
+                              .contact = "admin",
+                              .command = "host-notify-by-email",
+                              .output = "DOWN"};
+  neb::set_pb_log_data(le, record);
+
+  ASSERT_EQ(le.obj().msg_type(), 3);  // HOST NOTIFICATION
+  ASSERT_EQ(le.obj().host_id(), 12u);
+  ASSERT_EQ(le.obj().service_id(), 0u);
+  ASSERT_EQ(le.obj().host_name(), "myserver");
+  ASSERT_EQ(le.obj().service_description(), "");
+  ASSERT_EQ(le.obj().status(), 1);  // DOWN
+  ASSERT_EQ(le.obj().notification_contact(), "admin");
+  ASSERT_EQ(le.obj().notification_cmd(), "host-notify-by-email");
+  ASSERT_EQ(le.obj().output(), "DOWN");
+}
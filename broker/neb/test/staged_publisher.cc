@@ -0,0 +1,145 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/neb/staged_publisher.hh"
+#include <gtest/gtest.h>
+#include "com/centreon/broker/file/disk_accessor.hh"
+#include "com/centreon/broker/multiplexing/engine.hh"
+#include "com/centreon/broker/neb/internal.hh"
+#include "com/centreon/broker/stats/center.hh"
+
+using namespace com::centreon::broker;
+
+class StagedPublisher : public ::testing::Test {
+ public:
+  void SetUp() override {
+    stats::center::load();
+    file::disk_accessor::load(10000);
+    multiplexing::engine::load();
+  }
+
+  void TearDown() override {
+    multiplexing::engine::unload();
+    file::disk_accessor::unload();
+    stats::center::unload();
+  }
+};
+
+TEST_F(StagedPublisher, NotStagedByDefault) {
+  neb::staged_publisher publisher;
+  publisher.write(std::make_shared<neb::pb_service_status>());
+  ASSERT_EQ(publisher.staged_size(), 0u);
+}
+
+TEST_F(StagedPublisher, FlushOnLoopAndSize) {
+  neb::staged_publisher publisher;
+  publisher.set_limits(10, std::chrono::milliseconds(100000));
+  publisher.enable_staging();
+  for (int i = 0; i < 9; ++i)
+    publisher.write(std::make_shared<neb::pb_service_status>());
+  ASSERT_EQ(publisher.staged_size(), 9u);
+
+  // size limit reached
+  publisher.write(std::make_shared<neb::pb_service_status>());
+  ASSERT_EQ(publisher.staged_size(), 0u);
+
+  // end of loop iteration
+  publisher.write(std::make_shared<neb::pb_service_status>());
+  ASSERT_EQ(publisher.staged_size(), 1u);
+  publisher.enable_staging();
+  ASSERT_EQ(publisher.staged_size(), 0u);
+
+  // other threads are not staged
+  std::thread t([&publisher] {
+    publisher.write(std::make_shared<neb::pb_service_status>());
+    ASSERT_EQ(publisher.staged_size(), 0u);
+  });
+  t.join();
+
+  publisher.write(std::make_shared<neb::pb_service_status>());
+  publisher.disable_staging();
+  ASSERT_EQ(publisher.staged_size(), 0u);
+  publisher.write(std::make_shared<neb::pb_service_status>());
+  ASSERT_EQ(publisher.staged_size(), 0u);
+}
+
+TEST_F(StagedPublisher, FlushOnLatency) {
+  neb::staged_publisher publisher;
+  publisher.set_limits(1000, std::chrono::milliseconds(10));
+  publisher.enable_staging();
+  publisher.write(std::make_shared<neb::pb_service_status>());
+  ASSERT_EQ(publisher.staged_size(), 1u);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  publisher.write(std::make_shared<neb::pb_service_status>());
+  ASSERT_EQ(publisher.staged_size(), 0u);
+  publisher.disable_staging();
+}
+
+TEST_F(StagedPublisher, Capture) {
+  neb::staged_publisher publisher;
+  publisher.set_limits(10, std::chrono::milliseconds(100000));
+  publisher.enable_staging();
+  std::deque<std::shared_ptr<io::data>> captured;
+  publisher.start_capture(&captured);
+  for (int i = 0; i < 20; ++i)
+    publisher.write(std::make_shared<neb::pb_service_status>());
+  ASSERT_EQ(captured.size(), 20u);
+  ASSERT_EQ(publisher.staged_size(), 0u);
+
+  // other threads are not captured
+  std::thread t([&publisher] {
+    publisher.write(std::make_shared<neb::pb_service_status>());
+  });
+  t.join();
+  ASSERT_EQ(captured.size(), 20u);
+
+  publisher.stop_capture();
+  publisher.write(std::make_shared<neb::pb_service_status>());
+  ASSERT_EQ(captured.size(), 20u);
+  ASSERT_EQ(publisher.staged_size(), 1u);
+  publisher.disable_staging();
+}
+
+/**
+ * @brief the engine loop thread must call the multiplexing publisher at most
+ * once per event loop iteration
+ *
+ */
+TEST_F(StagedPublisher, PublishOncePerLoop) {
+  constexpr unsigned nb_events = 10000;
+  constexpr unsigned events_per_loop = 100;
+
+  for (bool staged : {false, true}) {
+    neb::staged_publisher publisher;
+    publisher.set_limits(1000, std::chrono::milliseconds(100000));
+    if (staged)
+      publisher.enable_staging();
+    for (unsigned i = 1; i <= nb_events; ++i) {
+      publisher.write(std::make_shared<neb::pb_service_status>());
+      // end of an event loop iteration
+      if (staged && !(i % events_per_loop))
+        publisher.enable_staging();
+    }
+    publisher.disable_staging();
+    if (staged)
+      ASSERT_EQ(publisher.publish_count(), nb_events / events_per_loop);
+    else
+      ASSERT_EQ(publisher.publish_count(), nb_events);
+  }
+}
@@ -141,10 +141,18 @@ class exporter {
     std::unique_ptr<instrument_f64> file_percent_processed;
   };
 
+  struct latency_instrument {
+    std::unique_ptr<instrument_f64> p50;
+    std::unique_ptr<instrument_f64> p99;
+  };
+
   struct muxer_instrument {
     std::unique_ptr<instrument_i64> total_events;
     std::unique_ptr<instrument_i64> unacknowledged_events;
     queue_file_instrument queue_file;
+    latency_instrument enqueue_latency;
+    latency_instrument read_latency;
+    latency_instrument ack_latency;
   };
   std::vector<muxer_instrument> _muxer;
 
@@ -167,6 +175,11 @@ class exporter {
 
   void _check_connections(std::shared_ptr<metrics_api::MeterProvider> provider,
                           const boost::system::error_code& ec);
+  void _add_latency(std::shared_ptr<metrics_api::MeterProvider>& provider,
+                    latency_instrument& li,
+                    const std::string& muxer,
+                    const std::string& stage,
+                    const StageLatency& (MuxerStats::*getter)() const);
 
  public:
   exporter();
@@ -148,6 +148,13 @@ void exporter::init_metrics(
             const auto& q = s.processing().muxers().at(name).queue_file();
             return q.file_percent_processed();
           });
+
+      _add_latency(provider, mi.enqueue_latency, m.name, "enqueue",
+                   &MuxerStats::enqueue_latency);
+      _add_latency(provider, mi.read_latency, m.name, "read",
+                   &MuxerStats::read_latency);
+      _add_latency(provider, mi.ack_latency, m.name, "ack",
+                   &MuxerStats::ack_latency);
     }
   }
 
@@ -158,6 +165,42 @@ void exporter::init_metrics(
       });
 }
 
+/**
+ * @brief Create the gauges giving the median and the 99th percentile of the
+ * latencies measured by a muxer for a given stage.
+ *
+ * @param provider The meter provider.
+ * @param li The latency instrument to fill.
+ * @param muxer The muxer name.
+ * @param stage The stage name: "enqueue", "read" or "ack".
+ * @param getter The MuxerStats accessor to the stage latencies.
+ */
+void exporter::_add_latency(
+    std::shared_ptr<metrics_api::MeterProvider>& provider,
+    latency_instrument& li,
+    const std::string& muxer,
+    const std::string& stage,
+    const StageLatency& (MuxerStats::*getter)() const) {
+  li.p50 = std::make_unique<instrument_f64>(
+      provider, fmt::format("{}_muxer_{}_latency_p50", muxer, stage),
+      fmt::format("Median {} latency in seconds of the sampled events of the "
+                  "muxer '{}'",
+                  stage, muxer),
+      [name = muxer, center = _center, getter]() -> double {
+        const auto& s = center->stats();
+        return (s.processing().muxers().at(name).*getter)().p50();
+      });
+  li.p99 = std::make_unique<instrument_f64>(
+      provider, fmt::format("{}_muxer_{}_latency_p99", muxer, stage),
+      fmt::format("99th percentile of the {} latency in seconds of the "
+                  "sampled events of the muxer '{}'",
+                  stage, muxer),
+      [name = muxer, center = _center, getter]() -> double {
+        const auto& s = center->stats();
+        return (s.processing().muxers().at(name).*getter)().p99();
+      });
+}
+
 /**
  * @brief Destructor.
  */
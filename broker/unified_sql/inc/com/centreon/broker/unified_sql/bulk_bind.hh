@@ -55,6 +55,18 @@ namespace unified_sql {
  *   mysql->execute_statement(stmt);
  * }
  * @endcode
+ *
+ * When rows update a status keyed by (host_id, service_id), select_row() and
+ * next_row() can be used instead. A new status of an object already waiting
+ * in the bind replaces its row, so each execution updates an object at most
+ * once. The number of replaced rows is given by coalesced_count().
+ *
+ * @code
+ * bs.select_row(0, host_id, service_id);
+ * bs.bind(0)->set_value_as_i32(0, state);
+ * ...
+ * bs.next_row(0);
+ * @endcode
  */
 class bulk_bind {
   const uint32_t _interval;
@@ -63,6 +75,13 @@ class bulk_bind {
   mutable std::mutex _queue_m;
   std::vector<std::unique_ptr<database::mysql_bulk_bind>> _bind;
   std::vector<std::time_t> _next_time;
+  /* For each connection, the row of each object in the bind. */
+  std::vector<absl::flat_hash_map<std::pair<uint64_t, uint64_t>, size_t>>
+      _row_index;
+  /* For each connection, the row to go back to after a row replacement, or -1
+   * if the current row is a new one. */
+  std::vector<int64_t> _append_row;
+  std::atomic_uint64_t _coalesced;
   std::shared_ptr<spdlog::logger> _logger;
 
  public:
@@ -79,6 +98,9 @@ class bulk_bind {
   std::time_t next_time() const;
   std::size_t connections_count() const;
   void init_from_stmt(int32_t conn);
+  void select_row(int32_t conn, uint64_t host_id, uint64_t service_id);
+  void next_row(int32_t conn);
+  uint64_t coalesced_count() const;
   void lock();
   void unlock();
 };
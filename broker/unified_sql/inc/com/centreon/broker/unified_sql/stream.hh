@@ -267,6 +267,15 @@ class stream : public io::stream {
 
   absl::flat_hash_set<uint32_t> _cache_deleted_instance_id;
   std::unordered_map<uint32_t, uint32_t> _cache_host_instance;
+  /* Fingerprint of the configuration stored for each poller, the base of the
+   * next configuration diff it may send. */
+  absl::flat_hash_map<uint32_t, uint64_t> _cache_instance_config_fingerprint;
+  /* False if the instances table has no config_fingerprint column, the
+   * fingerprints are then only kept in memory. */
+  bool _config_fingerprint_supported = false;
+  /* Pollers whose configuration diff could not be applied, their whole
+   * configuration is waited for. */
+  absl::flat_hash_set<uint32_t> _config_resend_pollers;
   absl::flat_hash_map<uint64_t, size_t> _cache_hst_cmd;
   absl::flat_hash_map<std::pair<uint64_t, uint64_t>, size_t> _cache_svc_cmd;
   absl::flat_hash_map<std::pair<uint64_t, uint64_t>, index_info> _index_cache;
@@ -421,6 +430,7 @@ class stream : public io::stream {
   void _process_host_status(const std::shared_ptr<io::data>& d);
   void _process_instance(const std::shared_ptr<io::data>& d);
   void _process_pb_instance(const std::shared_ptr<io::data>& d);
+  void _process_pb_instance_configuration(const std::shared_ptr<io::data>& d);
   void _process_instance_status(const std::shared_ptr<io::data>& d);
   void _process_pb_instance_status(const std::shared_ptr<io::data>& d);
   void _process_log(const std::shared_ptr<io::data>& d);
@@ -456,7 +466,10 @@ class stream : public io::stream {
   void _load_deleted_instances();
   void _init_statements();
   void _load_caches();
-  void _clean_tables(uint32_t instance_id);
+  void _load_config_fingerprints();
+  void _store_config_fingerprint(uint32_t poller_id, uint64_t fingerprint);
+  void _ack_config_fingerprint(uint32_t poller_id, uint64_t fingerprint);
+  void _clean_tables(uint32_t instance_id, bool keep_configuration = false);
   void _clean_group_table() ABSL_SHARED_LOCKS_REQUIRED(_barrier_timer_m);
   void _prepare_hg_insupdate_statement();
   void _prepare_pb_hg_insupdate_statement();
@@ -42,6 +42,9 @@ bulk_bind::bulk_bind(const size_t connections_count,
       _stmt(stmt),
       _bind(connections_count),
       _next_time(connections_count),
+      _row_index(connections_count),
+      _append_row(connections_count, -1),
+      _coalesced{0},
       _logger{logger} {}
 
 /**
@@ -124,6 +127,8 @@ std::time_t bulk_bind::next_time() const {
 void bulk_bind::apply_to_stmt(int32_t conn) {
   std::lock_guard<std::mutex> lck(_queue_m);
   _stmt.set_bind(std::move(_bind[conn]));
+  _row_index[conn].clear();
+  _append_row[conn] = -1;
   _next_time[conn] = std::time(nullptr) + _interval;
 }
 
@@ -135,6 +140,59 @@ void bulk_bind::apply_to_stmt(int32_t conn) {
  */
 void bulk_bind::init_from_stmt(int32_t conn) {
   _bind[conn] = _stmt.create_bind();
+  _row_index[conn].clear();
+  _append_row[conn] = -1;
+}
+
+/**
+ * @brief Choose the row of the bind at the given connection where the status
+ * of the object (host_id, service_id) is written. If this object already has
+ * a row waiting in the bind, this row is reused so that only its last status
+ * is sent, otherwise a new row is used. Values are then set on bind(conn) as
+ * usual and next_row() must be called. This function call must be protected.
+ *
+ * @param conn The connection.
+ * @param host_id The host ID.
+ * @param service_id The service ID, 0 for a host.
+ */
+void bulk_bind::select_row(int32_t conn,
+                           uint64_t host_id,
+                           uint64_t service_id) {
+  auto* b = _bind[conn].get();
+  auto [it, inserted] =
+      _row_index[conn].try_emplace({host_id, service_id}, b->current_row());
+  if (inserted)
+    _append_row[conn] = -1;
+  else {
+    _append_row[conn] = b->current_row();
+    b->set_current_row(it->second);
+    ++_coalesced;
+  }
+}
+
+/**
+ * @brief Validate the row chosen by select_row(). This function call must be
+ * protected.
+ *
+ * @param conn The connection.
+ */
+void bulk_bind::next_row(int32_t conn) {
+  auto* b = _bind[conn].get();
+  if (_append_row[conn] >= 0) {
+    b->set_current_row(_append_row[conn]);
+    _append_row[conn] = -1;
+  } else
+    b->next_row();
+}
+
+/**
+ * @brief Number of statuses replaced by a newer one before being sent to the
+ * database.
+ *
+ * @return An unsigned integer.
+ */
+uint64_t bulk_bind::coalesced_count() const {
+  return _coalesced;
 }
 
 /**
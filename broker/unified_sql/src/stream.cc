@@ -118,7 +118,9 @@ constexpr void (stream::*const stream::neb_processing_table[])(
     &stream::_process_pb_service_group,
     &stream::_process_pb_service_group_member,
     &stream::_process_pb_host_parent,
-    nullptr  // pb_instance_configuration
+    &stream::_process_pb_instance_configuration,
+    nullptr,  // pb_service_status_delta, rebuilt by the bbdo stream
+    nullptr   // pb_host_status_delta, rebuilt by the bbdo stream
 };
 
 constexpr size_t neb_processing_table_size =
@@ -292,6 +294,65 @@ void stream::_load_deleted_instances() {
   }
 }
 
+/**
+ * @brief Load the fingerprints of the pollers configurations stored in the
+ * database. Databases not upgraded yet have no config_fingerprint column, the
+ * fingerprints are then only kept in memory and pollers send their whole
+ * configuration after a broker restart.
+ */
+void stream::_load_config_fingerprints() {
+  _cache_instance_config_fingerprint.clear();
+  std::promise<mysql_result> promise;
+  std::future<mysql_result> future = promise.get_future();
+  _mysql.run_query_and_get_result(
+      "SELECT instance_id,config_fingerprint FROM instances WHERE "
+      "config_fingerprint IS NOT NULL",
+      std::move(promise));
+  try {
+    mysql_result res(future.get());
+    while (_mysql.fetch_row(res)) {
+      int32_t instance_id = res.value_as_i32(0);
+      if (instance_id > 0)
+        _cache_instance_config_fingerprint[instance_id] = res.value_as_u64(1);
+    }
+    _config_fingerprint_supported = true;
+  } catch (const std::exception& e) {
+    _config_fingerprint_supported = false;
+    SPDLOG_LOGGER_INFO(_logger_sql,
+                       "unified_sql: pollers configuration fingerprints not "
+                       "stored in the database: {}",
+                       e.what());
+  }
+}
+
+/**
+ * @brief Store the fingerprint of the configuration broker has for a poller.
+ *
+ * @param poller_id The poller ID.
+ * @param fingerprint The configuration fingerprint, 0 if the configuration in
+ * the database is incomplete.
+ */
+void stream::_store_config_fingerprint(uint32_t poller_id,
+                                       uint64_t fingerprint) {
+  if (fingerprint)
+    _cache_instance_config_fingerprint[poller_id] = fingerprint;
+  else if (!_cache_instance_config_fingerprint.erase(poller_id))
+    return;
+
+  if (_config_fingerprint_supported) {
+    int32_t conn = _mysql.choose_connection_by_instance(poller_id);
+    _mysql.run_query(
+        fingerprint
+            ? fmt::format("UPDATE instances SET config_fingerprint={} WHERE "
+                          "instance_id={}",
+                          fingerprint, poller_id)
+            : fmt::format("UPDATE instances SET config_fingerprint=NULL WHERE "
+                          "instance_id={}",
+                          poller_id),
+        database::mysql_error::store_config_fingerprint, conn);
+  }
+}
+
 /**
  * @brief Load the unified_sql cache.
  */
@@ -303,6 +364,9 @@ void stream::_load_caches() {
   /* get deleted cache of instance ids => _cache_deleted_instance_id */
   _load_deleted_instances();
 
+  /* pollers configuration fingerprints => _cache_instance_config_fingerprint */
+  _load_config_fingerprints();
+
   std::promise<mysql_result> promise_instance_id;
   std::promise<database::mysql_result> promise_index_data;
   std::promise<mysql_result> promise_hi;
@@ -699,7 +763,13 @@ void stream::statistics(nlohmann::json& tree) const {
     sz_metrics = _metrics.size();
     count = _count;
   }
+  uint64_t coalesced = 0;
+  for (auto* b : {_hscr_bind.get(), _sscr_bind.get(),
+                  _hscr_resources_bind.get(), _sscr_resources_bind.get()})
+    if (b)
+      coalesced += b->coalesced_count();
 
+  tree["coalesced status events"] = static_cast<int32_t>(coalesced);
   tree["cv events"] = static_cast<int32_t>(sz_cv);
   tree["cvs events"] = static_cast<int32_t>(sz_cvs);
   tree["logs events"] = static_cast<int32_t>(sz_logs);
@@ -884,8 +954,12 @@ void stream::process_stop(const std::shared_ptr<io::data>& d) {
   _logger_sql->info("unified_sql: Disabling poller (id: {}, running: no)",
                     stop.poller_id());
 
-  // Clean tables.
-  _clean_tables(stop.poller_id());
+  // Clean tables. Configuration relations are kept only if broker knows the
+  // poller configuration, the poller can then send its configuration changes
+  // when it restarts.
+  auto fingerprint = _cache_instance_config_fingerprint.find(stop.poller_id());
+  _clean_tables(stop.poller_id(),
+                fingerprint != _cache_instance_config_fingerprint.end());
 
   // Processing.
   if (_is_valid_poller(stop.poller_id())) {
@@ -1152,6 +1226,10 @@ void stream::remove_poller(const std::shared_ptr<io::data>& d) {
 }
 
 void stream::_clear_instances_cache(const std::list<uint64_t>& ids) {
+  for (uint64_t id : ids) {
+    _cache_instance_config_fingerprint.erase(id);
+    _config_resend_pollers.erase(id);
+  }
   for (auto it = _cache_host_instance.begin();
        it != _cache_host_instance.end();) {
     if (std::find(ids.begin(), ids.end(), it->second) != ids.end()) {
@@ -48,8 +48,11 @@ static const std::string _insert_or_update_tags =
  *  deactivated using a specific flag.
  *
  *  @param[in] instance_id Instance ID to remove.
+ *  @param[in] keep_configuration If true, hosts and services are disabled but
+ *             their tags, group memberships, parents and custom variables are
+ *             kept, the poller will only send its configuration changes.
  */
-void stream::_clean_tables(uint32_t instance_id) {
+void stream::_clean_tables(uint32_t instance_id, bool keep_configuration) {
   // no hostgroup and servicegroup clean during this function
   {
     absl::MutexLock l(&_timer_m);
@@ -61,7 +64,7 @@ void stream::_clean_tables(uint32_t instance_id) {
   int32_t conn;
 
   _finish_action(-1, -1);
-  if (_store_in_resources) {
+  if (_store_in_resources && !keep_configuration) {
     SPDLOG_LOGGER_DEBUG(
         _logger_sql, "unified sql: remove tags memberships (instance_id: {})",
         instance_id);
@@ -91,43 +94,46 @@ void stream::_clean_tables(uint32_t instance_id) {
   _mysql.run_query(query, database::mysql_error::clean_hosts_services, conn);
   _add_action(conn, actions::hosts);
 
-  /* Remove host group memberships. */
-  SPDLOG_LOGGER_DEBUG(
-      _logger_sql,
-      "unified sql: remove host group memberships (instance_id: {})",
-      instance_id);
-  query = fmt::format(
-      "DELETE hosts_hostgroups FROM hosts_hostgroups LEFT JOIN hosts ON "
-      "hosts_hostgroups.host_id=hosts.host_id WHERE hosts.instance_id={}",
-      instance_id);
-  _mysql.run_query(query, database::mysql_error::clean_hostgroup_members, conn);
-  _add_action(conn, actions::hostgroups);
+  if (!keep_configuration) {
+    /* Remove host group memberships. */
+    SPDLOG_LOGGER_DEBUG(
+        _logger_sql,
+        "unified sql: remove host group memberships (instance_id: {})",
+        instance_id);
+    query = fmt::format(
+        "DELETE hosts_hostgroups FROM hosts_hostgroups LEFT JOIN hosts ON "
+        "hosts_hostgroups.host_id=hosts.host_id WHERE hosts.instance_id={}",
+        instance_id);
+    _mysql.run_query(query, database::mysql_error::clean_hostgroup_members,
+                     conn);
+    _add_action(conn, actions::hostgroups);
 
-  /* Remove service group memberships */
-  SPDLOG_LOGGER_DEBUG(
-      _logger_sql,
-      "unified sql: remove service group memberships (instance_id: {})",
-      instance_id);
-  query = fmt::format(
-      "DELETE services_servicegroups FROM services_servicegroups LEFT JOIN "
-      "hosts ON services_servicegroups.host_id=hosts.host_id WHERE "
-      "hosts.instance_id={}",
-      instance_id);
-  _mysql.run_query(query, database::mysql_error::clean_servicegroup_members,
-                   conn);
-  _add_action(conn, actions::servicegroups);
+    /* Remove service group memberships */
+    SPDLOG_LOGGER_DEBUG(
+        _logger_sql,
+        "unified sql: remove service group memberships (instance_id: {})",
+        instance_id);
+    query = fmt::format(
+        "DELETE services_servicegroups FROM services_servicegroups LEFT JOIN "
+        "hosts ON services_servicegroups.host_id=hosts.host_id WHERE "
+        "hosts.instance_id={}",
+        instance_id);
+    _mysql.run_query(query, database::mysql_error::clean_servicegroup_members,
+                     conn);
+    _add_action(conn, actions::servicegroups);
 
-  /* Remove host parents. */
-  SPDLOG_LOGGER_DEBUG(_logger_sql,
-                      "unified sql: remove host parents (instance_id: {})",
-                      instance_id);
-  query = fmt::format(
-      "DELETE hhp FROM hosts_hosts_parents AS hhp INNER JOIN hosts as h ON "
-      "hhp.child_id=h.host_id OR hhp.parent_id=h.host_id WHERE "
-      "h.instance_id={}",
-      instance_id);
-  _mysql.run_query(query, database::mysql_error::clean_host_parents, conn);
-  _add_action(conn, actions::host_parents);
+    /* Remove host parents. */
+    SPDLOG_LOGGER_DEBUG(_logger_sql,
+                        "unified sql: remove host parents (instance_id: {})",
+                        instance_id);
+    query = fmt::format(
+        "DELETE hhp FROM hosts_hosts_parents AS hhp INNER JOIN hosts as h ON "
+        "hhp.child_id=h.host_id OR hhp.parent_id=h.host_id WHERE "
+        "h.instance_id={}",
+        instance_id);
+    _mysql.run_query(query, database::mysql_error::clean_host_parents, conn);
+    _add_action(conn, actions::host_parents);
+  }
 
   /* Remove list of modules. */
   SPDLOG_LOGGER_DEBUG(_logger_sql,
@@ -163,18 +169,22 @@ void stream::_clean_tables(uint32_t instance_id) {
   _mysql.run_query(query, database::mysql_error::clean_comments, conn);
   _add_action(conn, actions::comments);
 
-  // Remove custom variables. No need to choose the good instance, there are
-  // no constraint between custom variables and instances.
-  SPDLOG_LOGGER_DEBUG(
-      _logger_sql, "Removing custom variables (instance_id: {})", instance_id);
-  query = fmt::format(
-      "DELETE cv FROM customvariables AS cv INNER JOIN hosts AS h ON "
-      "cv.host_id = h.host_id WHERE h.instance_id={}",
-      instance_id);
+  if (!keep_configuration) {
+    // Remove custom variables. No need to choose the good instance, there are
+    // no constraint between custom variables and instances.
+    SPDLOG_LOGGER_DEBUG(_logger_sql,
+                        "Removing custom variables (instance_id: {})",
+                        instance_id);
+    query = fmt::format(
+        "DELETE cv FROM customvariables AS cv INNER JOIN hosts AS h ON "
+        "cv.host_id = h.host_id WHERE h.instance_id={}",
+        instance_id);
 
-  _finish_action(conn, actions::custom_variables | actions::hosts);
-  _mysql.run_query(query, database::mysql_error::clean_customvariables, conn);
-  _add_action(conn, actions::custom_variables);
+    _finish_action(conn, actions::custom_variables | actions::hosts);
+    _mysql.run_query(query, database::mysql_error::clean_customvariables,
+                     conn);
+    _add_action(conn, actions::custom_variables);
+  }
 
   absl::MutexLock l(&_timer_m);
   _group_clean_timer.expires_after(std::chrono::minutes(1));
@@ -2398,6 +2408,7 @@ void stream::_process_pb_host_status(const std::shared_ptr<io::data>& d) {
         std::lock_guard<bulk_bind> lck(*_hscr_bind);
         if (!_hscr_bind->bind(conn))
           _hscr_bind->init_from_stmt(conn);
+        _hscr_bind->select_row(conn, hscr.host_id(), 0);
         auto* b = _hscr_bind->bind(conn).get();
         b->set_value_as_bool(0, hscr.checked());
         b->set_value_as_i32(1, hscr.check_type());
@@ -2445,7 +2456,7 @@ void stream::_process_pb_host_status(const std::shared_ptr<io::data>& d) {
         b->set_value_as_i32(25, hscr.acknowledgement_type());
         b->set_value_as_i32(26, hscr.scheduled_downtime_depth());
         b->set_value_as_i32(27, hscr.host_id());
-        b->next_row();
+        _hscr_bind->next_row(conn);
         SPDLOG_LOGGER_TRACE(_logger_sql,
                             "{} waiting updates for host status in hosts",
                             b->current_row());
@@ -2512,6 +2523,7 @@ void stream::_process_pb_host_status(const std::shared_ptr<io::data>& d) {
         std::lock_guard<bulk_bind> lck(*_hscr_resources_bind);
         if (!_hscr_resources_bind->bind(conn))
           _hscr_resources_bind->init_from_stmt(conn);
+        _hscr_resources_bind->select_row(conn, hscr.host_id(), 0);
         auto* b = _hscr_resources_bind->bind(conn).get();
         b->set_value_as_i32(0, hscr.state());
         b->set_value_as_i32(1, hst_ordered_status[hscr.state()]);
@@ -2529,7 +2541,7 @@ void stream::_process_pb_host_status(const std::shared_ptr<io::data>& d) {
           b->set_value_as_u64(9, hscr.last_check());
         b->set_value_as_str(10, hscr.output());
         b->set_value_as_u64(11, hscr.host_id());
-        b->next_row();
+        _hscr_resources_bind->next_row(conn);
       } else {
         _hscr_resources_update->bind_value_as_i32(0, hscr.state());
         _hscr_resources_update->bind_value_as_i32(
@@ -2644,8 +2656,34 @@ void stream::_process_pb_instance(const std::shared_ptr<io::data>& d) {
       "unified_sql: processing poller event (id: {}, name: {}, running: {})",
       inst.instance_id(), inst.name(), inst.running() ? "yes" : "no");
 
-  // Clean tables.
-  _clean_tables(inst.instance_id());
+  // Clean tables. If the poller only sends its configuration changes, the
+  // configuration of unchanged objects must be kept. It is only possible if
+  // the diff is based on the configuration broker stored, otherwise the
+  // poller is asked for its whole configuration.
+  uint64_t base = inst.config_base_fingerprint();
+  if (base) {
+    auto stored = _cache_instance_config_fingerprint.find(inst.instance_id());
+    if (stored == _cache_instance_config_fingerprint.end() ||
+        stored->second != base) {
+      SPDLOG_LOGGER_ERROR(
+          _logger_sql,
+          "unified_sql: poller {} sends a configuration diff from {:016x} "
+          "but the stored configuration is {:016x}, its whole configuration "
+          "is requested",
+          inst.instance_id(), base,
+          stored == _cache_instance_config_fingerprint.end() ? 0
+                                                             : stored->second);
+      base = 0;
+      _config_resend_pollers.insert(inst.instance_id());
+      config::applier::state::instance().add_config_ack(inst.instance_id(), 0);
+    } else
+      _config_resend_pollers.erase(inst.instance_id());
+  } else
+    _config_resend_pollers.erase(inst.instance_id());
+  _clean_tables(inst.instance_id(), base != 0);
+  // Until the configuration is fully received, the database does not contain
+  // the configuration of a fingerprint.
+  _store_config_fingerprint(inst.instance_id(), 0);
 
   // Processing.
   if (_is_valid_poller(inst.instance_id())) {
@@ -2684,6 +2722,114 @@ void stream::_process_pb_instance(const std::shared_ptr<io::data>& d) {
   }
 }
 
+/**
+ * @brief Process the instance configuration event that closes the
+ * configuration sent by a poller at its start. When the poller only sent its
+ * configuration changes, its hosts and services have been disabled by the
+ * instance event, those not sent because unchanged are enabled again here.
+ *
+ * @param d Uncasted instance configuration.
+ */
+void stream::_process_pb_instance_configuration(
+    const std::shared_ptr<io::data>& d) {
+  const InstanceConfiguration& ic =
+      static_cast<const neb::pb_instance_configuration*>(d.get())->obj();
+  if (!ic.config_base_fingerprint()) {
+    SPDLOG_LOGGER_INFO(
+        _logger_sql,
+        "unified_sql: configuration {:016x} of poller {} fully received",
+        ic.config_fingerprint(), ic.poller_id());
+    _config_resend_pollers.erase(ic.poller_id());
+    _ack_config_fingerprint(ic.poller_id(), ic.config_fingerprint());
+    return;
+  }
+
+  if (_config_resend_pollers.contains(ic.poller_id())) {
+    SPDLOG_LOGGER_INFO(_logger_sql,
+                       "unified_sql: configuration diff {:016x} of poller {} "
+                       "ignored, its whole configuration is waited for",
+                       ic.config_fingerprint(), ic.poller_id());
+    return;
+  }
+
+  SPDLOG_LOGGER_INFO(
+      _logger_sql,
+      "unified_sql: configuration {:016x} of poller {} received as a diff "
+      "from {:016x}, enabling {} unchanged hosts and {} unchanged services",
+      ic.config_fingerprint(), ic.poller_id(), ic.config_base_fingerprint(),
+      ic.unchanged_hosts_size(), ic.unchanged_services_size());
+
+  int32_t conn = _mysql.choose_connection_by_instance(ic.poller_id());
+  _finish_action(-1, actions::hosts | actions::resources);
+
+  /* Queries are split to keep them at a reasonable size. */
+  constexpr int chunk_size = 1000;
+  std::vector<uint64_t> resource_ids;
+  for (int i = 0; i < ic.unchanged_hosts_size(); i += chunk_size) {
+    int end = std::min(i + chunk_size, ic.unchanged_hosts_size());
+    std::string ids;
+    for (int j = i; j < end; ++j) {
+      uint64_t host_id = ic.unchanged_hosts(j);
+      ids.append(fmt::format("{}{}", ids.empty() ? "" : ",", host_id));
+      _cache_host_instance[host_id] = ic.poller_id();
+      auto found = _resource_cache.find({host_id, 0});
+      if (found != _resource_cache.end())
+        resource_ids.push_back(found->second);
+    }
+    _mysql.run_query(
+        fmt::format("UPDATE hosts SET enabled=1 WHERE host_id IN ({})", ids),
+        database::mysql_error::enable_hosts_services, conn);
+  }
+
+  for (int i = 0; i < ic.unchanged_services_size(); i += chunk_size) {
+    int end = std::min(i + chunk_size, ic.unchanged_services_size());
+    std::string ids;
+    for (int j = i; j < end; ++j) {
+      const ServiceId& s = ic.unchanged_services(j);
+      ids.append(fmt::format("{}({},{})", ids.empty() ? "" : ",", s.host_id(),
+                             s.service_id()));
+      auto found = _resource_cache.find({s.service_id(), s.host_id()});
+      if (found != _resource_cache.end())
+        resource_ids.push_back(found->second);
+    }
+    _mysql.run_query(
+        fmt::format("UPDATE services SET enabled=1 WHERE (host_id,service_id) "
+                    "IN ({})",
+                    ids),
+        database::mysql_error::enable_hosts_services, conn);
+  }
+  _add_action(conn, actions::hosts);
+
+  if (_store_in_resources) {
+    for (size_t i = 0; i < resource_ids.size(); i += chunk_size) {
+      size_t end = std::min(i + chunk_size, resource_ids.size());
+      _mysql.run_query(
+          fmt::format(
+              "UPDATE resources SET enabled=1 WHERE resource_id IN ({})",
+              fmt::join(resource_ids.begin() + i, resource_ids.begin() + end,
+                        ",")),
+          database::mysql_error::update_resources, conn);
+    }
+    _add_action(conn, actions::resources);
+  }
+  _ack_config_fingerprint(ic.poller_id(), ic.config_fingerprint());
+}
+
+/**
+ * @brief Store the fingerprint of the configuration fully received from a
+ * poller and acknowledge it to the poller, so that its next configuration
+ * can be sent as a diff from this one.
+ *
+ * @param poller_id The poller ID.
+ * @param fingerprint The configuration fingerprint.
+ */
+void stream::_ack_config_fingerprint(uint32_t poller_id, uint64_t fingerprint) {
+  if (!fingerprint)
+    return;
+  _store_config_fingerprint(poller_id, fingerprint);
+  config::applier::state::instance().add_config_ack(poller_id, fingerprint);
+}
+
 /**
  *  Process an instance status event. To work on an instance status, we must
  *  be sure the instance already exists in the database. So this query must
@@ -4322,6 +4468,7 @@ void stream::_process_pb_service_status(const std::shared_ptr<io::data>& d) {
         std::lock_guard<bulk_bind> lck(*_sscr_bind);
         if (!_sscr_bind->bind(conn))
           _sscr_bind->init_from_stmt(conn);
+        _sscr_bind->select_row(conn, sscr.host_id(), sscr.service_id());
         auto* b = _sscr_bind->bind(conn).get();
         b->set_value_as_bool(0, sscr.checked());
         b->set_value_as_i32(1, sscr.check_type());
@@ -4372,7 +4519,7 @@ void stream::_process_pb_service_status(const std::shared_ptr<io::data>& d) {
         b->set_value_as_i32(27, sscr.scheduled_downtime_depth());
         b->set_value_as_i32(28, sscr.host_id());
         b->set_value_as_i32(29, sscr.service_id());
-        b->next_row();
+        _sscr_bind->next_row(conn);
         SPDLOG_LOGGER_TRACE(_logger_sql,
                             "{} waiting updates for service status in services",
                             b->current_row());
@@ -4451,6 +4598,8 @@ void stream::_process_pb_service_status(const std::shared_ptr<io::data>& d) {
         std::lock_guard<bulk_bind> lck(*_sscr_resources_bind);
         if (!_sscr_resources_bind->bind(conn))
           _sscr_resources_bind->init_from_stmt(conn);
+        _sscr_resources_bind->select_row(conn, sscr.host_id(),
+                                         sscr.service_id());
         auto* b = _sscr_resources_bind->bind(conn).get();
         b->set_value_as_i32(0, sscr.state());
         b->set_value_as_i32(1, svc_ordered_status[sscr.state()]);
@@ -4471,7 +4620,7 @@ void stream::_process_pb_service_status(const std::shared_ptr<io::data>& d) {
             10, fmt::string_view(sscr.output().c_str(), output_size));
         b->set_value_as_u64(11, sscr.service_id());
         b->set_value_as_u64(12, sscr.host_id());
-        b->next_row();
+        _sscr_resources_bind->next_row(conn);
         SPDLOG_LOGGER_TRACE(
             _logger_sql, "{} waiting updates for service status in resources",
             b->current_row());
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_VICTORIA_METRICS_LABEL_CACHE_HH
+#define CCB_VICTORIA_METRICS_LABEL_CACHE_HH
+
+#include "bbdo/storage.pb.h"
+
+namespace com::centreon::broker {
+
+namespace victoria_metrics {
+
+/**
+ * @brief this class stores the rendered beginning of each line protocol line
+ * (measurement and labels) per series, so that a point only needs to append
+ * its value and timestamp.
+ * A series is a metric (key = metric_id) or a status (key = index_id).
+ * An entry is rebuilt when global_cache::generation() has changed since its
+ * rendering or when the event doesn't match the stored host, service or name.
+ * The number of entries is bounded. Each kind of series is stored in two
+ * generations of max_size / 2 entries: when the current one is full, it
+ * becomes the previous one and the former previous one is dropped. An entry
+ * found in the previous generation is moved back in the current one, so only
+ * series not seen during a whole generation are evicted.
+ * This class is not thread safe, it is used under http_tsdb::stream::_protect
+ *
+ */
+class label_cache {
+ public:
+  static constexpr size_t default_max_size = 200000;
+
+ private:
+  struct entry {
+    uint64_t generation;
+    uint64_t host_id;
+    uint64_t service_id;
+    // only used by metrics as name is given by the event
+    std::string name;
+    std::string prefix;
+  };
+
+  using series_map = absl::flat_hash_map<uint64_t, entry>;
+
+  struct generations {
+    series_map current;
+    series_map previous;
+
+    size_t size() const { return current.size() + previous.size(); }
+  };
+
+  // max size of one generation
+  const size_t _generation_size;
+  generations _metrics;
+  generations _status;
+
+  uint64_t _hit;
+  uint64_t _miss;
+
+  entry& _get_slot(generations& series, uint64_t key);
+
+ public:
+  label_cache(size_t max_size = default_max_size);
+  label_cache(const label_cache&) = delete;
+  label_cache& operator=(const label_cache&) = delete;
+
+  const std::string& get_metric_prefix(const Metric& metric);
+  const std::string& get_status_prefix(const Status& status);
+
+  size_t size() const { return _metrics.size() + _status.size(); }
+  uint64_t get_hit() const { return _hit; }
+  uint64_t get_miss() const { return _miss; }
+};
+
+}  // namespace victoria_metrics
+
+}  // namespace com::centreon::broker
+
+#endif  // !CCB_VICTORIA_METRICS_LABEL_CACHE_HH
@@ -22,6 +22,7 @@
 #include "com/centreon/broker/http_tsdb/http_tsdb_config.hh"
 #include "com/centreon/broker/http_tsdb/line_protocol_query.hh"
 #include "com/centreon/broker/http_tsdb/stream.hh"
+#include "com/centreon/broker/victoria_metrics/label_cache.hh"
 
 namespace com::centreon::broker {
 
@@ -30,10 +31,7 @@ class request : public http_tsdb::request {
   std::shared_ptr<spdlog::logger> _logger;
   const http_tsdb::line_protocol_query& _metric_formatter;
   const http_tsdb::line_protocol_query& _status_formatter;
-
-  void append_metric_info(const Metric& metric);
-
-  void append_status_info(const Status& status);
+  std::shared_ptr<label_cache> _labels;
 
  public:
   request(boost::beast::http::verb method,
@@ -43,6 +41,7 @@ class request : public http_tsdb::request {
           unsigned size_to_reserve,
           const http_tsdb::line_protocol_query& metric_formatter,
           const http_tsdb::line_protocol_query& status_formatter,
+          const std::shared_ptr<label_cache>& labels,
           const std::string& authorization = "");
 
   virtual void add_metric(const storage::pb_metric& metric) override;
@@ -21,6 +21,7 @@
 
 #include "com/centreon/broker/http_tsdb/line_protocol_query.hh"
 #include "com/centreon/broker/http_tsdb/stream.hh"
+#include "com/centreon/broker/victoria_metrics/label_cache.hh"
 
 namespace com::centreon::broker {
 
@@ -35,6 +36,9 @@ class stream : public http_tsdb::stream {
   http_tsdb::line_protocol_query _metric_formatter;
   http_tsdb::line_protocol_query _status_formatter;
 
+  // shared by all requests of this stream
+  std::shared_ptr<label_cache> _labels;
+
   std::string _authorization;
   std::string _account_id;
 
@@ -0,0 +1,170 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/victoria_metrics/label_cache.hh"
+#include "com/centreon/broker/cache/global_cache.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::victoria_metrics;
+
+/**
+ * @brief a little filter use for string labels
+ * it escape , ", space and \
+ *
+ * @param dest string where filtered label is appended
+ * @param to_filter
+ */
+template <class string_class>
+static void append_filtered(std::string& dest, const string_class& to_filter) {
+  for (char c : to_filter) {
+    if (c == ',') {
+      dest += "\\,";
+    } else if (c == '"') {
+      dest += "\\\"";
+    } else if (c == ' ') {
+      dest += "\\ ";
+    } else if (c == '\\') {
+      dest += "\\\\";
+    } else {
+      dest.push_back(c);
+    }
+  }
+}
+
+static constexpr std::string_view _sz_metric = "metric,id=";
+static constexpr std::string_view _sz_status = "status,id=";
+static constexpr std::string_view _sz_name = ",name=";
+static constexpr std::string_view _sz_unit = ",unit=";
+static constexpr std::string_view _sz_host_id = ",host_id=";
+static constexpr std::string_view _sz_serv_id = ",serv_id=";
+static constexpr std::string_view _sz_severity_id = ",severity_id=";
+
+label_cache::label_cache(size_t max_size)
+    : _generation_size(std::max<size_t>(max_size / 2, 1)), _hit(0), _miss(0) {}
+
+/**
+ * @brief return the entry of key
+ * An entry of the previous generation is moved to the current one. If the
+ * current generation is full, it replaces the previous one before insertion.
+ *
+ * @param series
+ * @param key
+ * @return entry& a new entry has its generation set to
+ * global_cache::generation() - 1 in order to be rendered
+ */
+label_cache::entry& label_cache::_get_slot(generations& series, uint64_t key) {
+  auto found = series.current.find(key);
+  if (found != series.current.end()) {
+    return found->second;
+  }
+  // empty node if key is not in previous generation
+  auto old_entry = series.previous.extract(key);
+  if (series.current.size() >= _generation_size) {
+    series.previous = std::move(series.current);
+    series.current.clear();
+  }
+  if (old_entry) {
+    return series.current.insert(std::move(old_entry)).position->second;
+  }
+  entry& ret = series.current[key];
+  ret.generation = cache::global_cache::generation() - 1;
+  ret.host_id = ret.service_id = 0;
+  return ret;
+}
+
+/**
+ * @brief return "metric,id=...,name=...,host_id=...,serv_id=..." followed by
+ * unit and severity_id if they are known by global cache
+ *
+ * @param metric
+ * @return const std::string&
+ */
+const std::string& label_cache::get_metric_prefix(const Metric& metric) {
+  // generation is read before data, so a concurrent update will be seen by
+  // the next point
+  uint64_t generation = cache::global_cache::generation();
+  entry& to_fill = _get_slot(_metrics, metric.metric_id());
+  if (to_fill.generation == generation && to_fill.host_id == metric.host_id() &&
+      to_fill.service_id == metric.service_id() &&
+      to_fill.name == metric.name()) {
+    ++_hit;
+    return to_fill.prefix;
+  }
+  ++_miss;
+  to_fill.generation = generation;
+  to_fill.host_id = metric.host_id();
+  to_fill.service_id = metric.service_id();
+  to_fill.name = metric.name();
+
+  std::string& prefix = to_fill.prefix;
+  prefix.clear();
+  absl::StrAppend(&prefix, _sz_metric, metric.metric_id(), _sz_name);
+  append_filtered(prefix, metric.name());
+  absl::StrAppend(&prefix, _sz_host_id, metric.host_id(), _sz_serv_id,
+                  metric.service_id());
+
+  cache::global_cache::lock l;
+  const cache::metric_info* metric_inf =
+      cache::global_cache::instance_ptr()->get_metric_info(metric.metric_id());
+  if (metric_inf) {
+    prefix.append(_sz_unit);
+    append_filtered(prefix, metric_inf->unit);
+    const cache::resource_info* res_info =
+        cache::global_cache::instance_ptr()->get_service(metric.host_id(),
+                                                         metric.service_id());
+    if (res_info) {
+      absl::StrAppend(&prefix, _sz_severity_id, res_info->severity_id);
+    }
+  }
+  return prefix;
+}
+
+/**
+ * @brief return "status,id=...,host_id=...,serv_id=..." followed by
+ * severity_id if it is known by global cache
+ *
+ * @param status
+ * @return const std::string&
+ */
+const std::string& label_cache::get_status_prefix(const Status& status) {
+  uint64_t generation = cache::global_cache::generation();
+  entry& to_fill = _get_slot(_status, status.index_id());
+  if (to_fill.generation == generation && to_fill.host_id == status.host_id() &&
+      to_fill.service_id == status.service_id()) {
+    ++_hit;
+    return to_fill.prefix;
+  }
+  ++_miss;
+  to_fill.generation = generation;
+  to_fill.host_id = status.host_id();
+  to_fill.service_id = status.service_id();
+
+  std::string& prefix = to_fill.prefix;
+  prefix.clear();
+  absl::StrAppend(&prefix, _sz_status, status.index_id(), _sz_host_id,
+                  status.host_id(), _sz_serv_id, status.service_id());
+
+  cache::global_cache::lock l;
+  const cache::resource_info* res_info =
+      cache::global_cache::instance_ptr()->get_service(status.host_id(),
+                                                       status.service_id());
+  if (res_info) {
+    absl::StrAppend(&prefix, _sz_severity_id, res_info->severity_id);
+  }
+  return prefix;
+}
@@ -52,6 +52,7 @@ stream::stream(const std::shared_ptr<asio::io_context>& io_context,
                         conf->get_status_columns(),
                         http_tsdb::line_protocol_query::data_type::status,
                         _logger),
+      _labels(std::make_shared<label_cache>()),
       _account_id(account_id) {
   // in order to avoid reallocation of request body
   _body_size_to_reserve = conf->get_max_queries_per_transaction() *
@@ -77,7 +78,7 @@ http_tsdb::request::pointer stream::create_request() const {
   auto ret = std::make_shared<request>(
       boost::beast::http::verb::post, _conf->get_server_name(),
       _conf->get_http_target(), _logger, _body_size_to_reserve,
-      _metric_formatter, _status_formatter, _authorization);
+      _metric_formatter, _status_formatter, _labels, _authorization);
 
   ret->set(boost::beast::http::field::content_type, "text/plain");
   ret->set(boost::beast::http::field::accept, "application/json");
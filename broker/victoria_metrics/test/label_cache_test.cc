@@ -0,0 +1,182 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <boost/beast.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/container/flat_set.hpp>
+
+using system_clock = std::chrono::system_clock;
+using time_point = system_clock::time_point;
+using duration = system_clock::duration;
+
+#include "com/centreon/broker/cache/global_cache.hh"
+#include "com/centreon/broker/victoria_metrics/label_cache.hh"
+#include "com/centreon/broker/victoria_metrics/request.hh"
+#include "common/log_v2/log_v2.hh"
+
+using namespace com::centreon::broker;
+using log_v2 = com::centreon::common::log_v2::log_v2;
+
+class victoria_label_cache_test : public ::testing::Test {
+ public:
+  static void SetUpTestSuite() {
+    ::remove("/tmp/cache_test.label_cache_test");
+    cache::global_cache::load("/tmp/cache_test.label_cache_test");
+  }
+};
+
+TEST_F(victoria_label_cache_test, hit_and_invalidation) {
+  cache::global_cache::instance_ptr()->store_service(15, 79, "my service", 2,
+                                                     3);
+  cache::global_cache::instance_ptr()->set_metric_info(1234, 46, "metric 1",
+                                                       "unit", 0, 1);
+
+  victoria_metrics::label_cache labels;
+  Metric metric;
+  metric.set_metric_id(1234);
+  metric.set_host_id(15);
+  metric.set_service_id(79);
+  metric.set_name("metric 1");
+
+  ASSERT_EQ(labels.get_metric_prefix(metric),
+            "metric,id=1234,name=metric\\ "
+            "1,host_id=15,serv_id=79,unit=unit,severity_id=3");
+  ASSERT_EQ(labels.get_miss(), 1);
+  labels.get_metric_prefix(metric);
+  ASSERT_EQ(labels.get_hit(), 1);
+
+  // same value stored again => no invalidation
+  cache::global_cache::instance_ptr()->set_metric_info(1234, 46, "metric 1",
+                                                       "unit", 0, 2);
+  labels.get_metric_prefix(metric);
+  ASSERT_EQ(labels.get_hit(), 2);
+
+  // unit changed => prefix rebuilt
+  cache::global_cache::instance_ptr()->set_metric_info(1234, 46, "metric 1",
+                                                       "unit2", 0, 2);
+  ASSERT_EQ(labels.get_metric_prefix(metric),
+            "metric,id=1234,name=metric\\ "
+            "1,host_id=15,serv_id=79,unit=unit2,severity_id=3");
+  ASSERT_EQ(labels.get_miss(), 2);
+
+  // severity changed => prefix rebuilt
+  cache::global_cache::instance_ptr()->store_service(15, 79, "my service", 2,
+                                                     4);
+  ASSERT_EQ(labels.get_metric_prefix(metric),
+            "metric,id=1234,name=metric\\ "
+            "1,host_id=15,serv_id=79,unit=unit2,severity_id=4");
+
+  // event doesn't match entry => prefix rebuilt
+  metric.set_name("metric 2");
+  ASSERT_EQ(labels.get_metric_prefix(metric),
+            "metric,id=1234,name=metric\\ "
+            "2,host_id=15,serv_id=79,unit=unit2,severity_id=4");
+  ASSERT_EQ(labels.get_miss(), 4);
+
+  Status status;
+  status.set_index_id(46);
+  status.set_host_id(15);
+  status.set_service_id(79);
+  ASSERT_EQ(labels.get_status_prefix(status),
+            "status,id=46,host_id=15,serv_id=79,severity_id=4");
+  labels.get_status_prefix(status);
+  ASSERT_EQ(labels.get_hit(), 3);
+  ASSERT_EQ(labels.size(), 2);
+}
+
+TEST_F(victoria_label_cache_test, bounded) {
+  victoria_metrics::label_cache labels(10);
+  Metric metric;
+  metric.set_host_id(15);
+  metric.set_service_id(79);
+  metric.set_name("metric");
+  for (unsigned metric_id = 1; metric_id <= 25; ++metric_id) {
+    metric.set_metric_id(metric_id);
+    labels.get_metric_prefix(metric);
+    ASSERT_LE(labels.size(), 10);
+  }
+  ASSERT_EQ(labels.get_miss(), 25);
+}
+
+TEST_F(victoria_label_cache_test, hot_series_not_evicted) {
+  // Given a small cache
+  victoria_metrics::label_cache labels(10);
+  Metric hot, cold;
+  hot.set_metric_id(1);
+  hot.set_host_id(15);
+  hot.set_service_id(79);
+  hot.set_name("hot");
+  cold.set_host_id(15);
+  cold.set_service_id(79);
+  cold.set_name("cold");
+
+  // When a series is used between many series seen only once
+  for (unsigned metric_id = 2; metric_id <= 100; ++metric_id) {
+    labels.get_metric_prefix(hot);
+    cold.set_metric_id(metric_id);
+    labels.get_metric_prefix(cold);
+    ASSERT_LE(labels.size(), 10);
+  }
+
+  // Then only its first use is a miss
+  ASSERT_EQ(labels.get_hit(), 98);
+  ASSERT_EQ(labels.get_miss(), 1 + 99);
+}
+
+/**
+ * @brief requests built from many points of the same series must render each
+ * series labels only once
+ *
+ */
+TEST_F(victoria_label_cache_test, one_render_per_series) {
+  constexpr unsigned nb_series = 10000;
+  constexpr unsigned nb_points = 1000000;
+  for (unsigned metric_id = 1; metric_id <= nb_series; ++metric_id) {
+    cache::global_cache::instance_ptr()->set_metric_info(
+        100000 + metric_id, 100000 + metric_id, "metric bench", "ms", 0, 1);
+  }
+
+  auto logger = log_v2::instance().get(log_v2::VICTORIA_METRICS);
+  http_tsdb::line_protocol_query dummy;
+  auto labels = std::make_shared<victoria_metrics::label_cache>();
+  std::unique_ptr<victoria_metrics::request> req;
+
+  storage::pb_metric metric;
+  Metric& obj = metric.mut_obj();
+  obj.set_host_id(15);
+  obj.set_service_id(79);
+  obj.set_name("metric bench");
+  obj.set_value(1.5782);
+  obj.set_time(1674715597);
+
+  for (unsigned point = 0; point < nb_points; ++point) {
+    if (!(point % 1000)) {
+      req = std::make_unique<victoria_metrics::request>(
+          boost::beast::http::verb::post, "localhost", "/", logger, 100000,
+          dummy, dummy, labels);
+    }
+    obj.set_metric_id(100001 + point % nb_series);
+    req->add_metric(metric);
+  }
+  ASSERT_EQ(labels->get_miss(), nb_series);
+  ASSERT_EQ(labels->get_hit(), nb_points - nb_series);
+  ASSERT_EQ(labels->size(), nb_series);
+}
@@ -98,8 +98,9 @@ TEST_F(victoria_request_test, request_body_test) {
   cache::global_cache::instance_ptr()->set_index_mapping(45, 14, 78);
 
   http_tsdb::line_protocol_query dummy;
-  victoria_metrics::request req(boost::beast::http::verb::post, "localhost",
-                                "/", _logger, 0, dummy, dummy, "toto");
+  victoria_metrics::request req(
+      boost::beast::http::verb::post, "localhost", "/", _logger, 0, dummy,
+      dummy, std::make_shared<victoria_metrics::label_cache>(), "toto");
 
   Metric metric;
   metric.set_metric_id(123);
@@ -177,9 +178,10 @@ TEST_F(victoria_request_test, request_body_test_default_victoria_extra_column) {
           victoria_metrics::factory::default_extra_status_column),
       http_tsdb::line_protocol_query::data_type::status, _logger);
 
-  victoria_metrics::request req(boost::beast::http::verb::post, "localhost",
-                                "/", _logger, 0, metric_columns, status_columns,
-                                "toto");
+  victoria_metrics::request req(
+      boost::beast::http::verb::post, "localhost", "/", _logger, 0,
+      metric_columns, status_columns,
+      std::make_shared<victoria_metrics::label_cache>(), "toto");
 
   Metric metric;
   metric.set_metric_id(123);
@@ -276,9 +278,10 @@ TEST_F(victoria_request_test, request_body_test_victoria_extra_column) {
       http_tsdb::factory::get_columns(column),
       http_tsdb::line_protocol_query::data_type::status, _logger);
 
-  victoria_metrics::request req(boost::beast::http::verb::post, "localhost",
-                                "/", _logger, 0, metric_columns, status_columns,
-                                "toto");
+  victoria_metrics::request req(
+      boost::beast::http::verb::post, "localhost", "/", _logger, 0,
+      metric_columns, status_columns,
+      std::make_shared<victoria_metrics::label_cache>(), "toto");
 
   Metric metric;
   metric.set_metric_id(123);
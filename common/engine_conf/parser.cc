@@ -17,7 +17,13 @@
  *
  */
 #include "parser.hh"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <future>
 #include <memory>
+#include <thread>
 #include "com/centreon/exceptions/msg_fmt.hh"
 #include "common/engine_conf/state.pb.h"
 #include "common/log_v2/log_v2.hh"
@@ -92,19 +98,156 @@ void parser::parse(std::string const& path, State* pb_config, error_cnt& err) {
   _pb_helper[pb_config] = std::move(helper);
   _parse_global_configuration(path, pb_config);
 
+  /* Object definitions files, those of the configuration directories come
+   * after the cfg_file ones. */
+  std::vector<std::string> files(pb_config->cfg_file().begin(),
+                                 pb_config->cfg_file().end());
+  for (auto& d : pb_config->cfg_dir())
+    _list_directory_configuration(d, &files);
+
+  /* If the files have not changed since the cache was written, the State is
+   * directly loaded from it. */
+  StateCache cache;
+  bool use_cache = !pb_config->config_cache_file().empty() &&
+                   _stamp_files(*pb_config, files, &cache);
+  if (use_cache && _load_cache(cache, pb_config, err))
+    return;
+  error_cnt err_before = err;
+
   // parse configuration files.
-  _apply(pb_config->cfg_file(), pb_config, &parser::_parse_object_definitions);
+  _parse_object_files(files, pb_config);
   // parse resource files.
   _apply(pb_config->resource_file(), pb_config, &parser::_parse_resource_file);
 
-  // parse configuration directories.
-  _apply(pb_config->cfg_dir(), pb_config,
-         &parser::_parse_directory_configuration);
-
   // Apply template.
   _resolve_template(pb_config, err);
 
   _cleanup(pb_config);
+
+  if (use_cache && err.config_errors == err_before.config_errors) {
+    cache.set_config_warnings(err.config_warnings -
+                              err_before.config_warnings);
+    _save_cache(&cache, *pb_config);
+  }
+}
+
+/**
+ * @brief Fill cache with the stamps of all the files the configuration is
+ * built from. The engine executable is also stamped so that an upgrade
+ * invalidates the cache.
+ *
+ * @param pb_config The configuration with the global parameters read.
+ * @param files The object definitions files.
+ * @param cache The cache to fill.
+ *
+ * @return false if a file cannot be stamped, the cache is then not used.
+ */
+bool parser::_stamp_files(const State& pb_config,
+                          const std::vector<std::string>& files,
+                          StateCache* cache) {
+  std::vector<std::string> paths{pb_config.cfg_main()};
+  paths.insert(paths.end(), pb_config.resource_file().begin(),
+               pb_config.resource_file().end());
+  paths.insert(paths.end(), files.begin(), files.end());
+
+  std::error_code ec;
+  std::filesystem::path exe =
+      std::filesystem::read_symlink("/proc/self/exe", ec);
+  if (!ec)
+    paths.push_back(exe.string());
+
+  for (auto& p : paths) {
+    uint64_t size = std::filesystem::file_size(p, ec);
+    if (ec)
+      return false;
+    auto mtime = std::filesystem::last_write_time(p, ec);
+    if (ec)
+      return false;
+    FileStamp* stamp = cache->add_files();
+    stamp->set_path(p);
+    stamp->set_size(size);
+    stamp->set_mtime(mtime.time_since_epoch().count());
+  }
+  return true;
+}
+
+/**
+ * @brief Load the State from the config_cache_file if the files stamps stored
+ * in it are the same as the given ones.
+ *
+ * @param stamps The stamps of the current files.
+ * @param pb_config The configuration replaced by the cached one.
+ * @param err The config warnings/errors counter.
+ *
+ * @return true if the configuration has been loaded from the cache.
+ */
+bool parser::_load_cache(const StateCache& stamps,
+                         State* pb_config,
+                         error_cnt& err) {
+  const std::string& path = pb_config->config_cache_file();
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  if (!in)
+    return false;
+
+  StateCache cache;
+  if (!cache.ParseFromIstream(&in)) {
+    _logger->warn("Configuration cache file '{}' is corrupted, ignored", path);
+    return false;
+  }
+
+  if (cache.files().size() != stamps.files().size())
+    return false;
+  for (int i = 0; i < stamps.files().size(); ++i) {
+    const FileStamp& a = cache.files(i);
+    const FileStamp& b = stamps.files(i);
+    if (a.path() != b.path() || a.size() != b.size() || a.mtime() != b.mtime())
+      return false;
+  }
+
+  _logger->info("Configuration loaded from the cache file '{}'", path);
+  pb_config->Swap(cache.mutable_state());
+  err.config_warnings += cache.config_warnings();
+  return true;
+}
+
+/**
+ * @brief Write the parsed configuration to the config_cache_file. The file is
+ * written aside and then renamed so that a reader never gets a partial file.
+ * Failures are only logged, the cache is just an optimization.
+ *
+ * @param cache The cache with the files stamps.
+ * @param pb_config The parsed configuration.
+ */
+void parser::_save_cache(StateCache* cache, const State& pb_config) {
+  const std::string& path = pb_config.config_cache_file();
+  std::string tmp_path = path + ".tmp";
+  *cache->mutable_state() = pb_config;
+  /* The state contains the resource macros, so the cache file is only
+   * readable by its owner, whatever the umask or an older file mode. */
+  int fd = ::open(tmp_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC,
+                  S_IRUSR | S_IWUSR);
+  if (fd < 0 || fchmod(fd, S_IRUSR | S_IWUSR) ||
+      !cache->SerializeToFileDescriptor(fd)) {
+    _logger->warn("Unable to write the configuration cache file '{}'",
+                  tmp_path);
+    if (fd >= 0)
+      ::close(fd);
+    std::remove(tmp_path.c_str());
+    return;
+  }
+  if (::close(fd)) {
+    _logger->warn("Unable to write the configuration cache file '{}'",
+                  tmp_path);
+    std::remove(tmp_path.c_str());
+    return;
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    _logger->warn("Unable to write the configuration cache file '{}': {}",
+                  path, ec.message());
+    std::remove(tmp_path.c_str());
+  }
 }
 
 /**
@@ -139,18 +282,128 @@ void parser::_cleanup(State* pb_config) {
 }
 
 /**
- *  Parse the directory configuration.
+ *  List the object definitions files of a configuration directory.
  *
- *  @param[in] path The directory path.
+ *  @param[in]  path  The directory path.
+ *  @param[out] files The list to complete.
  */
-void parser::_parse_directory_configuration(const std::string& path,
-                                            State* pb_config) {
+void parser::_list_directory_configuration(const std::string& path,
+                                           std::vector<std::string>* files) {
   for (auto& entry : std::filesystem::directory_iterator(path)) {
     if (entry.is_regular_file() && entry.path().extension() == ".cfg")
-      _parse_object_definitions(entry.path().string(), pb_config);
+      files->push_back(entry.path().string());
   }
 }
 
+/**
+ * @brief Parse the objects files. Each file is parsed by a worker thread into
+ * its own parsed_file, then results are merged into pb_config in the order of
+ * files, so the State is the same as if files were parsed one after the
+ * other. If several files fail, the error of the first one is thrown.
+ *
+ * @param files The files to parse.
+ * @param pb_config The configuration to complete.
+ */
+void parser::_parse_object_files(const std::vector<std::string>& files,
+                                 State* pb_config) {
+  std::vector<parsed_file> results(files.size());
+  std::vector<std::exception_ptr> errors(files.size());
+  std::atomic_size_t next{0};
+
+  auto work = [&] {
+    for (size_t i = next++; i < files.size(); i = next++) {
+      try {
+        _parse_object_definitions(files[i], &results[i]);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    }
+  };
+
+  size_t nb_threads = std::min<size_t>(
+      files.size(), std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < nb_threads; ++i)
+    threads.emplace_back(work);
+  work();
+  for (auto& t : threads)
+    t.join();
+
+  for (size_t i = 0; i < files.size(); ++i) {
+    if (errors[i])
+      std::rethrow_exception(errors[i]);
+    _merge_parsed_file(&results[i], pb_config);
+  }
+}
+
+/**
+ * @brief Move the objects of a RepeatedPtrField at the end of another one.
+ * Objects are not copied, so their addresses, used as keys of the helpers
+ * map, are kept.
+ *
+ * @tparam T The type of objects.
+ * @param from The objects to move.
+ * @param to The destination.
+ */
+template <typename T>
+static void move_objects(::google::protobuf::RepeatedPtrField<T>* from,
+                         ::google::protobuf::RepeatedPtrField<T>* to) {
+  std::vector<T*> objs(from->size());
+  from->ExtractSubrange(0, from->size(), objs.data());
+  to->Reserve(to->size() + objs.size());
+  for (T* o : objs)
+    to->AddAllocated(o);
+}
+
+/**
+ * @brief Merge the objects, helpers and templates of a parsed file into the
+ * parser and pb_config.
+ *
+ * @param result The parsed file, its content is moved.
+ * @param pb_config The configuration to complete.
+ */
+void parser::_merge_parsed_file(parsed_file* result, State* pb_config) {
+  for (auto& h : result->helpers)
+    _pb_helper[h.first] = std::move(h.second);
+
+  for (int otype = 0; otype < message_helper::object_type::nb_types; ++otype) {
+    pb_map_object& tmpl = _pb_templates[otype];
+    for (auto& t : result->templates[otype]) {
+      if (tmpl.contains(t.first))
+        throw msg_fmt("Parsing of '{}' failed in cfg file: {} already exists",
+                      absl::AsciiStrToLower(t.second->GetDescriptor()->name()),
+                      t.first);
+      tmpl[t.first] = std::move(t.second);
+    }
+  }
+
+  State* objects = &result->objects;
+  move_objects(objects->mutable_contacts(), pb_config->mutable_contacts());
+  move_objects(objects->mutable_hosts(), pb_config->mutable_hosts());
+  move_objects(objects->mutable_services(), pb_config->mutable_services());
+  move_objects(objects->mutable_anomalydetections(),
+               pb_config->mutable_anomalydetections());
+  move_objects(objects->mutable_hostdependencies(),
+               pb_config->mutable_hostdependencies());
+  move_objects(objects->mutable_servicedependencies(),
+               pb_config->mutable_servicedependencies());
+  move_objects(objects->mutable_timeperiods(),
+               pb_config->mutable_timeperiods());
+  move_objects(objects->mutable_commands(), pb_config->mutable_commands());
+  move_objects(objects->mutable_hostgroups(), pb_config->mutable_hostgroups());
+  move_objects(objects->mutable_servicegroups(),
+               pb_config->mutable_servicegroups());
+  move_objects(objects->mutable_tags(), pb_config->mutable_tags());
+  move_objects(objects->mutable_contactgroups(),
+               pb_config->mutable_contactgroups());
+  move_objects(objects->mutable_connectors(), pb_config->mutable_connectors());
+  move_objects(objects->mutable_severities(), pb_config->mutable_severities());
+  move_objects(objects->mutable_serviceescalations(),
+               pb_config->mutable_serviceescalations());
+  move_objects(objects->mutable_hostescalations(),
+               pb_config->mutable_hostescalations());
+}
+
 /**
  *  Parse the global configuration file.
  *
@@ -204,12 +457,14 @@ void parser::_parse_global_configuration(const std::string& path,
  *   object to set its timeranges.
  *
  * @param path The file to parse.
- * @param pb_config The configuration to complete.
+ * @param result The parsed file to complete.
  */
 void parser::_parse_object_definitions(const std::string& path,
-                                       State* pb_config) {
+                                       parsed_file* result) {
   _logger->info("Processing object config file '{}'", path);
 
+  State* objects = &result->objects;
+
   std::string content = read_file_content(path);
 
   auto tab{absl::StrSplit(content, '\n')};
@@ -254,9 +509,9 @@ void parser::_parse_object_definitions(const std::string& path,
           const Object& obj =
               *static_cast<const Object*>(&refl->GetMessage(*msg, f));
           auto otype = msg_helper->otype();
-          _pb_helper[msg.get()] = std::move(msg_helper);
+          result->helpers[msg.get()] = std::move(msg_helper);
           if (!obj.name().empty()) {
-            pb_map_object& tmpl = _pb_templates[otype];
+            pb_map_object& tmpl = result->templates[otype];
             auto it = tmpl.find(obj.name());
             if (it != tmpl.end())
               throw msg_fmt(
@@ -267,75 +522,75 @@ void parser::_parse_object_definitions(const std::string& path,
             else {
               auto copy = std::unique_ptr<Message>(msg->New());
               copy->CopyFrom(*msg);
-              _pb_helper[copy.get()] =
-                  message_helper::clone(*_pb_helper[msg.get()], copy.get());
+              result->helpers[copy.get()] = message_helper::clone(
+                  *result->helpers[msg.get()], copy.get());
               tmpl[obj.name()] = std::move(copy);
             }
           }
           if (obj.register_()) {
             switch (otype) {
               case message_helper::contact:
-                pb_config->mutable_contacts()->AddAllocated(
+                objects->mutable_contacts()->AddAllocated(
                     static_cast<Contact*>(msg.release()));
                 break;
               case message_helper::host:
-                pb_config->mutable_hosts()->AddAllocated(
+                objects->mutable_hosts()->AddAllocated(
                     static_cast<Host*>(msg.release()));
                 break;
               case message_helper::service:
-                pb_config->mutable_services()->AddAllocated(
+                objects->mutable_services()->AddAllocated(
                     static_cast<Service*>(msg.release()));
                 break;
               case message_helper::anomalydetection:
-                pb_config->mutable_anomalydetections()->AddAllocated(
+                objects->mutable_anomalydetections()->AddAllocated(
                     static_cast<Anomalydetection*>(msg.release()));
                 break;
               case message_helper::hostdependency:
-                pb_config->mutable_hostdependencies()->AddAllocated(
+                objects->mutable_hostdependencies()->AddAllocated(
                     static_cast<Hostdependency*>(msg.release()));
                 break;
               case message_helper::servicedependency:
-                pb_config->mutable_servicedependencies()->AddAllocated(
+                objects->mutable_servicedependencies()->AddAllocated(
                     static_cast<Servicedependency*>(msg.release()));
                 break;
               case message_helper::timeperiod:
-                pb_config->mutable_timeperiods()->AddAllocated(
+                objects->mutable_timeperiods()->AddAllocated(
                     static_cast<Timeperiod*>(msg.release()));
                 break;
               case message_helper::command:
-                pb_config->mutable_commands()->AddAllocated(
+                objects->mutable_commands()->AddAllocated(
                     static_cast<Command*>(msg.release()));
                 break;
               case message_helper::hostgroup:
-                pb_config->mutable_hostgroups()->AddAllocated(
+                objects->mutable_hostgroups()->AddAllocated(
                     static_cast<Hostgroup*>(msg.release()));
                 break;
               case message_helper::servicegroup:
-                pb_config->mutable_servicegroups()->AddAllocated(
+                objects->mutable_servicegroups()->AddAllocated(
                     static_cast<Servicegroup*>(msg.release()));
                 break;
               case message_helper::tag:
-                pb_config->mutable_tags()->AddAllocated(
+                objects->mutable_tags()->AddAllocated(
                     static_cast<Tag*>(msg.release()));
                 break;
               case message_helper::contactgroup:
-                pb_config->mutable_contactgroups()->AddAllocated(
+                objects->mutable_contactgroups()->AddAllocated(
                     static_cast<Contactgroup*>(msg.release()));
                 break;
               case message_helper::connector:
-                pb_config->mutable_connectors()->AddAllocated(
+                objects->mutable_connectors()->AddAllocated(
                     static_cast<Connector*>(msg.release()));
                 break;
               case message_helper::severity:
-                pb_config->mutable_severities()->AddAllocated(
+                objects->mutable_severities()->AddAllocated(
                     static_cast<Severity*>(msg.release()));
                 break;
               case message_helper::serviceescalation:
-                pb_config->mutable_serviceescalations()->AddAllocated(
+                objects->mutable_serviceescalations()->AddAllocated(
                     static_cast<Serviceescalation*>(msg.release()));
                 break;
               case message_helper::hostescalation:
-                pb_config->mutable_hostescalations()->AddAllocated(
+                objects->mutable_hostescalations()->AddAllocated(
                     static_cast<Hostescalation*>(msg.release()));
                 break;
               default:
@@ -495,36 +750,30 @@ void parser::_parse_resource_file(const std::string& path, State* pb_config) {
  * @param err The config warnings/errors counter.
  */
 void parser::_resolve_template(State* pb_config, error_cnt& err) {
-  for (Command& c : *pb_config->mutable_commands())
-    _resolve_template(_pb_helper[&c], _pb_templates[message_helper::command]);
-
-  for (Connector& c : *pb_config->mutable_connectors())
-    _resolve_template(_pb_helper[&c], _pb_templates[message_helper::connector]);
-
-  for (Contact& c : *pb_config->mutable_contacts())
-    _resolve_template(_pb_helper[&c], _pb_templates[message_helper::contact]);
-
-  for (Contactgroup& cg : *pb_config->mutable_contactgroups())
-    _resolve_template(_pb_helper[&cg],
-                      _pb_templates[message_helper::contactgroup]);
-
-  for (Host& h : *pb_config->mutable_hosts())
-    _resolve_template(_pb_helper[&h], _pb_templates[message_helper::host]);
-
-  for (Service& s : *pb_config->mutable_services())
-    _resolve_template(_pb_helper[&s], _pb_templates[message_helper::service]);
-
-  for (Anomalydetection& a : *pb_config->mutable_anomalydetections())
-    _resolve_template(_pb_helper[&a],
-                      _pb_templates[message_helper::anomalydetection]);
-
-  for (Serviceescalation& se : *pb_config->mutable_serviceescalations())
-    _resolve_template(_pb_helper[&se],
-                      _pb_templates[message_helper::serviceescalation]);
-
-  for (Hostescalation& he : *pb_config->mutable_hostescalations())
-    _resolve_template(_pb_helper[&he],
-                      _pb_templates[message_helper::hostescalation]);
+  /* An object only inherits from templates of its own type, so each type is
+   * resolved in its own thread. The _pb_helper map is only read here. */
+  std::vector<std::future<void>> tasks;
+  auto resolve = [this, &tasks](auto* objects,
+                                message_helper::object_type otype) {
+    tasks.push_back(std::async(std::launch::async, [this, objects, otype] {
+      const pb_map_object& tmpls = _pb_templates[otype];
+      for (auto& o : *objects)
+        _resolve_template(_pb_helper.at(&o), tmpls);
+    }));
+  };
+  resolve(pb_config->mutable_commands(), message_helper::command);
+  resolve(pb_config->mutable_connectors(), message_helper::connector);
+  resolve(pb_config->mutable_contacts(), message_helper::contact);
+  resolve(pb_config->mutable_contactgroups(), message_helper::contactgroup);
+  resolve(pb_config->mutable_hosts(), message_helper::host);
+  resolve(pb_config->mutable_services(), message_helper::service);
+  resolve(pb_config->mutable_anomalydetections(),
+          message_helper::anomalydetection);
+  resolve(pb_config->mutable_serviceescalations(),
+          message_helper::serviceescalation);
+  resolve(pb_config->mutable_hostescalations(), message_helper::hostescalation);
+  for (auto& t : tasks)
+    t.get();
 
   for (const Command& c : pb_config->commands())
     _pb_helper.at(&c)->check_validity(err);
@@ -611,7 +860,7 @@ void parser::_resolve_template(std::unique_ptr<message_helper>& msg_helper,
     auto it = tmpls.find(u);
     if (it == tmpls.end())
       throw msg_fmt("Cannot merge object of type '{}'", u);
-    _resolve_template(_pb_helper[it->second.get()], tmpls);
+    _resolve_template(_pb_helper.at(it->second.get()), tmpls);
     _merge(msg_helper, it->second.get());
   }
 }
@@ -46,6 +46,18 @@ using pb_map_helper =
     absl::flat_hash_map<Message*, std::unique_ptr<message_helper>>;
 
 class parser {
+  /**
+   * @brief Objects read from one object definitions file. Files are parsed
+   * in parallel, each one into its own parsed_file. These results are then
+   * merged into the State in the order of the files.
+   */
+  struct parsed_file {
+    State objects;
+    pb_map_helper helpers;
+    std::array<pb_map_object, message_helper::object_type::nb_types>
+        templates;
+  };
+
   std::shared_ptr<spdlog::logger> _logger;
 
   /**
@@ -86,14 +98,22 @@ class parser {
     for (auto& f : lst)
       (this->*pfunc)(f, pb_config);
   }
-  void _parse_directory_configuration(std::string const& path,
-                                      State* pb_config);
+  void _list_directory_configuration(const std::string& path,
+                                     std::vector<std::string>* files);
   void _parse_global_configuration(const std::string& path, State* pb_config);
-  void _parse_object_definitions(const std::string& path, State* pb_config);
+  void _parse_object_files(const std::vector<std::string>& files,
+                           State* pb_config);
+  void _parse_object_definitions(const std::string& path, parsed_file* result);
+  void _merge_parsed_file(parsed_file* result, State* pb_config);
   void _parse_resource_file(std::string const& path, State* pb_config);
   void _resolve_template(State* pb_config, error_cnt& err);
   void _resolve_template(std::unique_ptr<message_helper>& msg_helper,
                          const pb_map_object& tmpls);
+  bool _stamp_files(const State& pb_config,
+                    const std::vector<std::string>& files,
+                    StateCache* cache);
+  bool _load_cache(const StateCache& stamps, State* pb_config, error_cnt& err);
+  void _save_cache(StateCache* cache, const State& pb_config);
 
   unsigned int _current_line;
   std::string _current_path;
@@ -271,6 +271,7 @@ void state_helper::_init() {
   obj->set_max_host_check_spread(5);
   obj->set_max_log_file_size(0);
   obj->set_max_parallel_service_checks(0);
+  obj->set_max_concurrent_system_commands(50);
   obj->set_max_service_check_spread(5);
   obj->set_notification_timeout(30);
   obj->set_obsess_over_hosts(false);
@@ -30,7 +30,9 @@ using com::centreon::exceptions::msg_fmt;
 std::unordered_map<std::string, command::setter_func> const command::_setters{
     {"command_line", SETTER(std::string const&, _set_command_line)},
     {"command_name", SETTER(std::string const&, _set_command_name)},
-    {"connector", SETTER(std::string const&, _set_connector)}};
+    {"connector", SETTER(std::string const&, _set_connector)},
+    {"environment_macros",
+     SETTER(std::string const&, _set_environment_macros)}};
 
 /**
  *  Constructor.
@@ -67,6 +69,7 @@ command& command::operator=(command const& right) {
     _command_line = right._command_line;
     _command_name = right._command_name;
     _connector = right._connector;
+    _environment_macros = right._environment_macros;
   }
   return (*this);
 }
@@ -81,7 +84,8 @@ command& command::operator=(command const& right) {
 bool command::operator==(command const& right) const throw() {
   return (object::operator==(right) && _command_line == right._command_line &&
           _command_name == right._command_name &&
-          _connector == right._connector);
+          _connector == right._connector &&
+          _environment_macros == right._environment_macros);
 }
 
 /**
@@ -144,6 +148,7 @@ void command::merge(object const& obj) {
   MRG_DEFAULT(_command_line);
   MRG_DEFAULT(_command_name);
   MRG_DEFAULT(_connector);
+  MRG_DEFAULT(_environment_macros);
 }
 
 /**
@@ -189,6 +194,15 @@ std::string const& command::connector() const throw() {
   return (_connector);
 }
 
+/**
+ *  Get environment_macros.
+ *
+ *  @return The environment_macros.
+ */
+std::string const& command::environment_macros() const throw() {
+  return (_environment_macros);
+}
+
 /**
  *  Set command_line value.
  *
@@ -224,3 +238,15 @@ bool command::_set_connector(std::string const& value) {
   _connector = value;
   return (true);
 }
+
+/**
+ *  Set environment_macros value.
+ *
+ *  @param[in] value The new environment_macros value.
+ *
+ *  @return True on success, otherwise false.
+ */
+bool command::_set_environment_macros(std::string const& value) {
+  _environment_macros = value;
+  return (true);
+}
@@ -43,6 +43,7 @@ class command : public object {
   std::string const& command_line() const throw();
   std::string const& command_name() const throw();
   std::string const& connector() const throw();
+  std::string const& environment_macros() const throw();
 
  private:
   typedef bool (*setter_func)(command&, char const*);
@@ -50,10 +51,12 @@ class command : public object {
   bool _set_command_line(std::string const& value);
   bool _set_command_name(std::string const& value);
   bool _set_connector(std::string const& value);
+  bool _set_environment_macros(std::string const& value);
 
   std::string _command_line;
   std::string _command_name;
   std::string _connector;
+  std::string _environment_macros;
   static std::unordered_map<std::string, setter_func> const _setters;
 };
 
@@ -204,6 +204,8 @@ void state::_init_setter() {
   SETTER(float, low_service_flap_threshold, "low_service_flap_threshold");
   SETTER(const std::string&, macros_filter, "macros_filter");
   SETTER(unsigned int, max_parallel_service_checks, "max_concurrent_checks");
+  SETTER(unsigned int, max_concurrent_system_commands,
+         "max_concurrent_system_commands");
   SETTER(unsigned long, max_debug_file_size, "max_debug_file_size");
   SETTER(unsigned int, max_host_check_spread, "max_host_check_spread");
   SETTER(unsigned long, max_log_file_size, "max_log_file_size");
@@ -347,6 +349,7 @@ static unsigned int const default_max_host_check_spread(5);
 static unsigned long const default_max_log_file_size(0);
 static constexpr uint32_t default_log_flush_period{2u};
 static unsigned int const default_max_parallel_service_checks(0);
+static unsigned int const default_max_concurrent_system_commands(50);
 static unsigned int const default_max_service_check_spread(5);
 static unsigned int const default_notification_timeout(30);
 static bool const default_obsess_over_hosts(false);
@@ -474,6 +477,7 @@ state::state()
       _max_log_file_size(default_max_log_file_size),
       _log_flush_period(default_log_flush_period),
       _max_parallel_service_checks(default_max_parallel_service_checks),
+      _max_concurrent_system_commands(default_max_concurrent_system_commands),
       _max_service_check_spread(default_max_service_check_spread),
       _notification_timeout(default_notification_timeout),
       _obsess_over_hosts(default_obsess_over_hosts),
@@ -637,6 +641,7 @@ state& state::operator=(state const& right) {
     _max_host_check_spread = right._max_host_check_spread;
     _max_log_file_size = right._max_log_file_size;
     _max_parallel_service_checks = right._max_parallel_service_checks;
+    _max_concurrent_system_commands = right._max_concurrent_system_commands;
     _max_service_check_spread = right._max_service_check_spread;
     _notification_timeout = right._notification_timeout;
     _obsess_over_hosts = right._obsess_over_hosts;
@@ -789,6 +794,8 @@ bool state::operator==(state const& right) const noexcept {
       _max_host_check_spread == right._max_host_check_spread &&
       _max_log_file_size == right._max_log_file_size &&
       _max_parallel_service_checks == right._max_parallel_service_checks &&
+      _max_concurrent_system_commands ==
+          right._max_concurrent_system_commands &&
       _max_service_check_spread == right._max_service_check_spread &&
       _notification_timeout == right._notification_timeout &&
       _obsess_over_hosts == right._obsess_over_hosts &&
@@ -2502,6 +2509,26 @@ void state::max_parallel_service_checks(unsigned int value) {
   _max_parallel_service_checks = value;
 }
 
+/**
+ *  Get max_concurrent_system_commands value.
+ *
+ *  @return The max_concurrent_system_commands value.
+ */
+unsigned int state::max_concurrent_system_commands() const noexcept {
+  return _max_concurrent_system_commands;
+}
+
+/**
+ *  Set max_concurrent_system_commands value. It's the number of
+ *  notifications, event handlers and obsessive commands executed at the same
+ *  time, 0 means that they are executed synchronously.
+ *
+ *  @param[in] value The new max_concurrent_system_commands value.
+ */
+void state::max_concurrent_system_commands(unsigned int value) {
+  _max_concurrent_system_commands = value;
+}
+
 /**
  *  Get max_service_check_spread value.
  *
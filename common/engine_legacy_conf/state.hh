@@ -290,6 +290,8 @@ class state {
   void log_flush_period(uint32_t value);
   unsigned int max_parallel_service_checks() const noexcept;
   void max_parallel_service_checks(unsigned int value);
+  unsigned int max_concurrent_system_commands() const noexcept;
+  void max_concurrent_system_commands(unsigned int value);
   unsigned int max_service_check_spread() const noexcept;
   void max_service_check_spread(unsigned int value);
   unsigned int notification_timeout() const noexcept;
@@ -544,6 +546,7 @@ class state {
   unsigned long _max_log_file_size;
   uint32_t _log_flush_period;
   unsigned int _max_parallel_service_checks;
+  unsigned int _max_concurrent_system_commands;
   unsigned int _max_service_check_spread;
   unsigned int _notification_timeout;
   bool _obsess_over_hosts;
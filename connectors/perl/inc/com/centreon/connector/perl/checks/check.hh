@@ -40,6 +40,12 @@ class check : public std::enable_shared_from_this<check> {
  public:
   using pointer = std::shared_ptr<check>;
 
+  /**
+   * Tells if a worker still executes the check of the given command id. It's
+   * asked before signaling the worker, as it may run another check now.
+   */
+  using worker_check = std::function<bool(pid_t worker, uint64_t cmd_id)>;
+
   check(uint64_t cmd_id,
         const std::string& cmds,
         const time_point& tmt,
@@ -54,8 +60,16 @@ class check : public std::enable_shared_from_this<check> {
   void dump(std::ostream& s) const;
 
   void set_exit_code(int exit_code);
+  void fail(const std::string& error);
+  bool is_timed_out() const { return _timed_out; }
+  const std::string& get_cmd() const { return _cmd; }
+  uint64_t get_cmd_id() const { return _cmd_id; }
 
   pid_t execute();
+  void execute_in_worker(pid_t worker,
+                         int out_fd,
+                         int err_fd,
+                         worker_check&& runs_check);
 
   static void close_all_father_fd();
   static unsigned get_nb_check() { return _active_check.size(); }
@@ -64,6 +78,7 @@ class check : public std::enable_shared_from_this<check> {
   void _start_read_out();
   void _start_read_err();
   void _send_result();
+  void _start(int out_fd, int err_fd);
 
   static constexpr size_t buff_size = 4096;
   using recv_buff = std::array<char, buff_size>;
@@ -78,9 +93,10 @@ class check : public std::enable_shared_from_this<check> {
   std::string _stderr;
   std::string _stdout;
   time_point _timeout;
-  bool _out_eof, _err_eof, _exit_code_set;
+  bool _out_eof, _err_eof, _exit_code_set, _timed_out, _result_sent;
   int _exit_code;
   asio::system_timer _timeout_timer;
+  worker_check _worker_runs_check;
   std::shared_ptr<com::centreon::connector::reporter> _reporter;
   shared_io_context _io_context;
 
@@ -43,15 +43,30 @@ class embedded_perl {
   pid_t run(std::string const& cmd,
             int fds[3],
             const shared_io_context& io_context);
+  pid_t start_worker(int sock,
+                     const std::vector<int>& fds_to_close,
+                     const shared_io_context& io_context);
   static void unload();
 
  private:
-  using cmd_to_perl_map = absl::flat_hash_map<std::string, SV*>;
+  /**
+   *  Compiled plugin and modification time of its file when it was compiled.
+   */
+  struct compiled_script {
+    time_t mtime;
+    SV* handle;
+  };
+  using cmd_to_perl_map = absl::flat_hash_map<std::string, compiled_script>;
 
   embedded_perl(int argc, char** argv, char** env, char const* code = NULL);
   embedded_perl(embedded_perl const& ep);
   embedded_perl& operator=(embedded_perl const& ep);
 
+  SV* _compile(std::string const& file);
+  void _set_process_name(std::string const& name);
+  [[noreturn]] void _run_worker(int sock);
+  bool _receive_order(int sock, std::string& cmd, int& out_fd, int& err_fd);
+
   cmd_to_perl_map _parsed;
   static char const* const _script;
   pid_t _self;
@@ -22,6 +22,7 @@
 #include "com/centreon/connector/ipolicy.hh"
 #include "com/centreon/connector/perl/checks/check.hh"
 #include "com/centreon/connector/perl/orders/parser.hh"
+#include "com/centreon/connector/perl/worker_pool.hh"
 #include "com/centreon/connector/reporter.hh"
 
 namespace com::centreon::connector::perl {
@@ -38,9 +39,13 @@ class policy : public com::centreon::connector::policy_interface {
   reporter::pointer _reporter;
   shared_io_context _io_context;
   asio::system_timer _second_timer, _end_timer;
+  // null if each check is executed in a forked process
+  worker_pool::pointer _pool;
 
   policy(const shared_io_context& io_context);
-  void start(const std::string& test_cmd_file);
+  void start(const std::string& test_cmd_file,
+             unsigned workers,
+             unsigned max_executions);
 
   void on_sigchild();
 
@@ -59,7 +64,9 @@ class policy : public com::centreon::connector::policy_interface {
   }
 
   static void create(const shared_io_context& io_context,
-                     const std::string& test_cmd_file);
+                     const std::string& test_cmd_file,
+                     unsigned workers = 0,
+                     unsigned max_executions = 0);
 
   void on_eof() override;
   void on_error(uint64_t cmd_id, const std::string& msg) override;
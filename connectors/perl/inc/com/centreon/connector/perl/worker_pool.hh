@@ -0,0 +1,111 @@
+/*
+** Copyright 2024 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCCP_WORKER_POOL_HH
+#define CCCP_WORKER_POOL_HH
+
+#include "com/centreon/connector/perl/checks/check.hh"
+
+namespace com::centreon::connector::perl {
+
+/**
+ *  @class worker_pool worker_pool.hh
+ * "com/centreon/connector/perl/worker_pool.hh"
+ *  @brief Pool of preforked Perl workers.
+ *
+ *  Instead of forking a process per check, checks are executed by persistent
+ *  workers that keep compiled plugins. A worker executes one check at a time,
+ *  other checks wait for a free worker. A worker is replaced after
+ *  max_executions checks, when it has been killed by a timeout or when it
+ *  exits by itself.
+ */
+class worker_pool : public std::enable_shared_from_this<worker_pool> {
+ public:
+  /**
+   *  Order sent by the connector to a worker, followed by the command line.
+   *  Plugin's stdout and stderr are passed with the order (SCM_RIGHTS).
+   */
+  struct order {
+    uint32_t cmd_size;
+  };
+
+  /**
+   *  Reply of a worker, followed by an error message if error_size > 0.
+   */
+  struct reply {
+    int32_t exit_code;
+    uint32_t error_size;
+  };
+
+ private:
+  struct worker {
+    pid_t pid;
+    asio::local::stream_protocol::socket socket;
+    unsigned executions;
+    bool retired;
+    checks::check::pointer running;
+    reply header;
+    std::string error;
+
+    worker(const shared_io_context& io_context)
+        : pid(-1), socket(*io_context), executions(0), retired(false) {}
+  };
+  using worker_ptr = std::shared_ptr<worker>;
+
+  shared_io_context _io_context;
+  unsigned _size;
+  unsigned _max_executions;
+
+  // all alive workers, retired ones are kept until they're reaped
+  absl::flat_hash_map<pid_t, worker_ptr> _workers;
+  std::deque<worker_ptr> _idle;
+  // number of workers not retired
+  unsigned _active;
+  std::deque<checks::check::pointer> _waiting;
+
+  worker_pool(const shared_io_context& io_context,
+              unsigned size,
+              unsigned max_executions);
+
+  void _spawn();
+  void _fill();
+  void _dispatch();
+  void _send(const worker_ptr& w, const checks::check::pointer& check);
+  void _read_reply(const worker_ptr& w);
+  void _read_error(const worker_ptr& w);
+  void _on_reply(const worker_ptr& w);
+  void _retire(const worker_ptr& w);
+
+ public:
+  using pointer = std::shared_ptr<worker_pool>;
+
+  worker_pool(worker_pool const&) = delete;
+  worker_pool& operator=(worker_pool const&) = delete;
+
+  static pointer create(const shared_io_context& io_context,
+                        unsigned size,
+                        unsigned max_executions);
+
+  void execute(const checks::check::pointer& check);
+  bool runs(pid_t pid, uint64_t cmd_id) const;
+  bool on_worker_exit(pid_t pid, int status);
+};
+
+}  // namespace com::centreon::connector::perl
+
+#endif  // !CCCP_WORKER_POOL_HH
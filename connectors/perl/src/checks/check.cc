@@ -65,6 +65,8 @@ check::check(uint64_t cmd_id,
       _out_eof(false),
       _err_eof(false),
       _exit_code_set(false),
+      _timed_out(false),
+      _result_sent(false),
       _timeout_timer(*io_context),
       _reporter(reporter),
       _io_context(io_context) {
@@ -99,26 +101,7 @@ pid_t check::execute() {
     int fds[3];
     _child = embedded_perl::instance().run(_cmd, fds, _io_context);
     ::close(fds[0]);
-    _all_child_fd.insert(fds[1]);
-    _all_child_fd.insert(fds[2]);
-    _out_fd = fds[1];
-    _err_fd = fds[2];
-    _out.assign(fds[1]);
-    _err.assign(fds[2]);
-    _start_read_out();
-    _start_read_err();
-
-    // Store command ID.
-    log::core()->debug("execute {} _out_fd={} _err_fd={}", *this, _out_fd,
-                       _err_fd);
-
-    _active_check.insert(this);
-
-    _timeout_timer.expires_at(_timeout);
-    _timeout_timer.async_wait(
-        [me = shared_from_this()](const boost::system::error_code& err) {
-          me->on_timeout(err, false);
-        });
+    _start(fds[1], fds[2]);
   } catch (const std::exception& e) {
     log::core()->error("{} fail to start perl : {}", *this, e.what());
     throw;
@@ -126,6 +109,54 @@ pid_t check::execute() {
   return _child;
 }
 
+/**
+ * @brief the Perl script is run by a persistent worker, exit code will be
+ * given by the worker pool
+ *
+ * @param worker pid of the worker, it's killed on timeout
+ * @param out_fd read end of plugin's stdout
+ * @param err_fd read end of plugin's stderr
+ * @param runs_check tells if the worker still runs this check before it's
+ * killed
+ */
+void check::execute_in_worker(pid_t worker,
+                              int out_fd,
+                              int err_fd,
+                              worker_check&& runs_check) {
+  _child = worker;
+  _worker_runs_check = std::move(runs_check);
+  _start(out_fd, err_fd);
+}
+
+/**
+ * @brief start reading plugin's outputs and arm timeout timer
+ *
+ * @param out_fd
+ * @param err_fd
+ */
+void check::_start(int out_fd, int err_fd) {
+  _all_child_fd.insert(out_fd);
+  _all_child_fd.insert(err_fd);
+  _out_fd = out_fd;
+  _err_fd = err_fd;
+  _out.assign(out_fd);
+  _err.assign(err_fd);
+  _start_read_out();
+  _start_read_err();
+
+  // Store command ID.
+  log::core()->debug("execute {} _out_fd={} _err_fd={}", *this, _out_fd,
+                     _err_fd);
+
+  _active_check.insert(this);
+
+  _timeout_timer.expires_at(_timeout);
+  _timeout_timer.async_wait(
+      [me = shared_from_this()](const boost::system::error_code& err) {
+        me->on_timeout(err, false);
+      });
+}
+
 /**
  * @brief start read on child's stdout
  *
@@ -187,10 +218,19 @@ void check::on_timeout(const boost::system::error_code& err, bool final) {
     return;
   }
 
-  if (_child <= 0)
+  // result may have been sent while this handler was queued
+  if (_child <= 0 || _result_sent)
     return;
 
+  // the worker may have been reaped or reused for another check
+  if (_worker_runs_check && !_worker_runs_check(_child, _cmd_id)) {
+    log::core()->debug("{} worker doesn't run this check anymore, not killed",
+                       *this);
+    return;
+  }
+
   _stderr += " time out";
+  _timed_out = true;
 
   if (final) {
     log::core()->error("{} reached timeout kill -9", *this);
@@ -221,13 +261,30 @@ void check::set_exit_code(int exit_code) {
   _send_result();
 }
 
+/**
+ * @brief the script couldn't be executed, an error is sent to engine
+ * instead of the check result
+ *
+ * @param error
+ */
+void check::fail(const std::string& error) {
+  if (_result_sent)
+    return;
+  log::core()->error("{} fail: {}", *this, error);
+  _result_sent = true;
+  _reporter->send_result({_cmd_id, -1, error});
+  _timeout_timer.cancel();
+  _active_check.erase(this);
+}
+
 /**
  * @brief if exit_code is set and if we have received an eof on child stdin and
  * stderr this method send result to engine
  *
  */
 void check::_send_result() {
-  if (_err_eof && _out_eof && _exit_code_set) {
+  if (_err_eof && _out_eof && _exit_code_set && !_result_sent) {
+    _result_sent = true;
     _reporter->send_result({_cmd_id, _exit_code, _stdout, _stderr});
     _timeout_timer.cancel();
     _active_check.erase(this);
@@ -19,9 +19,13 @@
 #include "com/centreon/connector/perl/embedded_perl.hh"
 #include "com/centreon/connector/log.hh"
 #include "com/centreon/connector/perl/checks/check.hh"
+#include "com/centreon/connector/perl/worker_pool.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 
+#include <fcntl.h>
 #include <perl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
 
 using namespace com::centreon;
 using namespace com::centreon::connector::perl;
@@ -112,33 +116,8 @@ pid_t embedded_perl::run(std::string const& cmd,
   log::core()->debug("  - file {}", file);
   log::core()->debug("  - args {}", args);
 
-  // Check if file has already been compiled.
-  SV* handle;
-  cmd_to_perl_map::const_iterator it(_parsed.find(file));
-  dSP;
-  if (it == _parsed.end()) {
-    // Compile Perl file.
-    {
-      log::core()->debug("parsing file {}", file);
-      char const* argv[3];
-      argv[0] = file.c_str();
-      argv[1] = "0";
-      argv[2] = nullptr;
-      if (call_argv("Embed::Persistent::eval_file", G_EVAL | G_SCALAR,
-                    (char**)argv) != 1)
-        throw exceptions::msg_fmt("could not compile Perl script {}", file);
-    }
-    SPAGAIN;
-    handle = POPs;
-    if (SvTRUE(ERRSV))
-      throw exceptions::msg_fmt("Embedded Perl error: {}", SvPV_nolen(ERRSV));
-
-    // Insert in parsed file list.
-    _parsed.insert(std::make_pair(file, handle));
-  }
-  // Already parsed.
-  else
-    handle = it->second;
+  // Compile file if it has not been compiled yet or if it has changed.
+  SV* handle = _compile(file);
 
   // Open pipes.
   int in_pipe[2];
@@ -176,14 +155,7 @@ pid_t embedded_perl::run(std::string const& cmd,
     fds[2] = err_pipe[0];
   } else if (!child) {  // Child
     io_context->notify_fork(asio::io_context::fork_child);
-    unsigned father_process_name_length = strlen(_argv[0]);
-    std::string new_process_name("c_");
-    new_process_name += basename(file.c_str());
-    if (new_process_name.length() > father_process_name_length) {
-      new_process_name.resize(father_process_name_length);
-    }
-    memset(_argv[0], 0, father_process_name_length);
-    strcpy(_argv[0], new_process_name.c_str());
+    _set_process_name(std::string("c_") + basename(file.c_str()));
 
     if (log::instance().is_log_to_file()) {
       log::core()->debug("son started pid={}", getpid());
@@ -224,6 +196,7 @@ pid_t embedded_perl::run(std::string const& cmd,
     close(out_pipe[1]);
 
     // Run check.
+    dSP;
     ENTER;
     SAVETMPS;
     PUSHMARK(SP);
@@ -251,6 +224,45 @@ pid_t embedded_perl::run(std::string const& cmd,
   return child;
 }
 
+/**
+ *  Start a persistent worker. The worker is a child process that waits for
+ *  orders on sock, runs plugins with its own compiled plugin cache and
+ *  replies the exit code of each one. It exits when sock is closed.
+ *
+ *  @param[in] sock         Worker side of the connector/worker socket.
+ *  @param[in] fds_to_close Connector fds that the worker must not keep.
+ *  @param[in] io_context   Connector's io_context.
+ *
+ *  @return Worker's process ID.
+ */
+pid_t embedded_perl::start_worker(int sock,
+                                  const std::vector<int>& fds_to_close,
+                                  const shared_io_context& io_context) {
+  io_context->notify_fork(asio::io_context::fork_prepare);
+  log::core()->flush();
+  pid_t child(fork());
+  if (child > 0) {  // Parent
+    io_context->notify_fork(asio::io_context::fork_parent);
+    log::core()->debug("perl worker started pid={}", child);
+  } else if (!child) {  // Child
+    io_context->notify_fork(asio::io_context::fork_child);
+    _set_process_name("c_perl_worker");
+    // default signal handler
+    sigset(SIGCHLD, SIG_DFL);
+    sigset(SIGTERM, SIG_DFL);
+    // close all father fds
+    checks::check::close_all_father_fd();
+    for (int fd : fds_to_close)
+      ::close(fd);
+    io_context->stop();
+    _run_worker(sock);
+  } else {  // Error
+    char const* msg(strerror(errno));
+    throw exceptions::msg_fmt("{}", msg);
+  }
+  return child;
+}
+
 /**
  *  Unload Embedded Perl.
  */
@@ -265,6 +277,186 @@ void embedded_perl::unload() {
  *                                     *
  **************************************/
 
+/**
+ *  Compile a Perl script. Scripts are compiled once per path and modification
+ *  time, so a plugin updated on disk is compiled again.
+ *
+ *  @param[in] file Path of the script.
+ *
+ *  @return Handle of the compiled script.
+ */
+SV* embedded_perl::_compile(std::string const& file) {
+  struct stat file_stat;
+  time_t mtime = stat(file.c_str(), &file_stat) ? 0 : file_stat.st_mtime;
+
+  cmd_to_perl_map::iterator it(_parsed.find(file));
+  if (it != _parsed.end() && it->second.mtime == mtime)
+    return it->second.handle;
+
+  // Compile Perl file.
+  log::core()->debug("parsing file {}", file);
+  dSP;
+  {
+    char const* argv[3];
+    argv[0] = file.c_str();
+    argv[1] = "0";
+    argv[2] = nullptr;
+    if (call_argv("Embed::Persistent::eval_file", G_EVAL | G_SCALAR,
+                  (char**)argv) != 1)
+      throw exceptions::msg_fmt("could not compile Perl script {}", file);
+  }
+  SPAGAIN;
+  SV* handle = newSVsv(POPs);
+  PUTBACK;
+  if (SvTRUE(ERRSV)) {
+    SvREFCNT_dec(handle);
+    throw exceptions::msg_fmt("Embedded Perl error: {}", SvPV_nolen(ERRSV));
+  }
+
+  // Insert in parsed file list.
+  if (it != _parsed.end()) {
+    SvREFCNT_dec(it->second.handle);
+    it->second = {mtime, handle};
+  } else
+    _parsed.emplace(file, compiled_script{mtime, handle});
+  return handle;
+}
+
+/**
+ *  Change process name displayed by ps, it can't be longer than the original
+ *  one.
+ *
+ *  @param[in] name New process name.
+ */
+void embedded_perl::_set_process_name(std::string const& name) {
+  unsigned father_process_name_length = strlen(_argv[0]);
+  std::string new_process_name(name);
+  if (new_process_name.length() > father_process_name_length) {
+    new_process_name.resize(father_process_name_length);
+  }
+  memset(_argv[0], 0, father_process_name_length);
+  strcpy(_argv[0], new_process_name.c_str());
+}
+
+/**
+ *  Read an order sent by the connector.
+ *
+ *  @param[in]  sock   Worker socket.
+ *  @param[out] cmd    Command line to execute.
+ *  @param[out] out_fd Plugin's stdout.
+ *  @param[out] err_fd Plugin's stderr.
+ *
+ *  @return false if connector has closed the socket.
+ */
+bool embedded_perl::_receive_order(int sock,
+                                   std::string& cmd,
+                                   int& out_fd,
+                                   int& err_fd) {
+  worker_pool::order order;
+  char control[CMSG_SPACE(2 * sizeof(int))];
+  iovec iov{&order, sizeof(order)};
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  ssize_t received;
+  do {
+    received = recvmsg(sock, &msg, MSG_WAITALL);
+  } while (received < 0 && errno == EINTR);
+  if (received != sizeof(order))
+    return false;
+
+  out_fd = err_fd = -1;
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  if (cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS &&
+      cmsg->cmsg_len == CMSG_LEN(2 * sizeof(int))) {
+    int fds[2];
+    memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+    out_fd = fds[0];
+    err_fd = fds[1];
+  }
+
+  cmd.resize(order.cmd_size);
+  size_t offset = 0;
+  while (offset < cmd.size()) {
+    ssize_t rb = read(sock, cmd.data() + offset, cmd.size() - offset);
+    if (rb < 0 && errno == EINTR)
+      continue;
+    if (rb <= 0)
+      return false;
+    offset += rb;
+  }
+  return out_fd >= 0 && err_fd >= 0;
+}
+
+/**
+ *  Worker main loop: execute plugins ordered by the connector until the
+ *  connector closes the socket. Plugin's stdout and stderr are plugged on the
+ *  pipes received with the order while it runs, then they're plugged again on
+ *  /dev/null so that the connector gets end of file on them.
+ *
+ *  @param[in] sock Worker socket.
+ */
+void embedded_perl::_run_worker(int sock) {
+  // Worker must neither read orders of engine nor write on engine's pipe.
+  int null_fd = open("/dev/null", O_RDWR);
+  dup2(null_fd, STDIN_FILENO);
+  dup2(null_fd, STDOUT_FILENO);
+  dup2(null_fd, STDERR_FILENO);
+
+  std::string cmd;
+  int out_fd, err_fd;
+  while (_receive_order(sock, cmd, out_fd, err_fd)) {
+    dup2(out_fd, STDOUT_FILENO);
+    dup2(err_fd, STDERR_FILENO);
+    ::close(out_fd);
+    ::close(err_fd);
+
+    size_t pos(cmd.find(' '));
+    std::string file(cmd.substr(0, pos));
+    std::string args(pos != std::string::npos ? cmd.substr(pos + 1) : "");
+
+    worker_pool::reply reply{0, 0};
+    std::string error;
+    try {
+      SV* handle = _compile(file);
+
+      // Run check.
+      dSP;
+      ENTER;
+      SAVETMPS;
+      PUSHMARK(SP);
+      XPUSHs(sv_2mortal(newSVpv(file.c_str(), 0)));
+      XPUSHs(handle);
+      XPUSHs(sv_2mortal(newSVpv(args.c_str(), 0)));
+      PUTBACK;
+      int count =
+          call_pv("Embed::Persistent::run_file_in_worker", G_SCALAR | G_EVAL);
+      SPAGAIN;
+      reply.exit_code = count == 1 ? POPi : 3;
+      PUTBACK;
+      FREETMPS;
+      LEAVE;
+    } catch (const std::exception& e) {
+      error = e.what();
+    }
+
+    PerlIO_flush(PerlIO_stdout());
+    PerlIO_flush(PerlIO_stderr());
+    dup2(null_fd, STDOUT_FILENO);
+    dup2(null_fd, STDERR_FILENO);
+
+    reply.error_size = error.size();
+    error.insert(0, reinterpret_cast<const char*>(&reply), sizeof(reply));
+    if (send(sock, error.data(), error.size(), MSG_NOSIGNAL) !=
+        static_cast<ssize_t>(error.size()))
+      break;
+  }
+  _exit(EXIT_SUCCESS);
+}
+
 /**
  *  Constructor.
  *
@@ -16,6 +16,8 @@
  * For more information : contact@centreon.com
  */
 
+#include <absl/strings/numbers.h>
+
 #include "com/centreon/connector/log.hh"
 #include "com/centreon/connector/perl/embedded_perl.hh"
 #include "com/centreon/connector/perl/options.hh"
@@ -102,9 +104,19 @@ int main(int argc, char** argv, char** env) {
                                ? opts.get_argument("code").get_value().c_str()
                                : nullptr));
 
+      // Persistent workers.
+      unsigned workers, max_executions;
+      if (!absl::SimpleAtoi(opts.get_argument("workers").get_value(),
+                            &workers) ||
+          !absl::SimpleAtoi(opts.get_argument("max-executions").get_value(),
+                            &max_executions)) {
+        std::cout << "bad workers or max-executions value" << std::endl
+                  << opts.usage() << std::endl;
+        return EXIT_FAILURE;
+      }
+
       // Program policy.
-      // Program policy.
-      policy::create(io_context, test_file_path);
+      policy::create(io_context, test_file_path, workers, max_executions);
 
       io_context->run();
     }
@@ -34,6 +34,12 @@ static char const* const log_file_description =
     "Specifies the log file (default: stderr).";
 static char const* const test_file_description =
     "Specifies the file used instead of stdin.";
+static char const* const workers_description =
+    "Number of persistent Perl workers that execute checks (default: 0, a "
+    "process is forked for each check).";
+static char const* const max_executions_description =
+    "Number of checks executed by a worker before it is replaced (default: "
+    "1000, 0 means no limit).";
 
 /**************************************
  *                                     *
@@ -64,7 +70,9 @@ std::string options::help() const {
       << "  --version  " << version_description << "\n"
       << "  --code     " << code_description << "\n"
       << "  --log-file " << log_file_description << "\n"
-      << "  --test-file " << test_file_description << "\n";
+      << "  --test-file " << test_file_description << "\n"
+      << "  --workers  " << workers_description << "\n"
+      << "  --max-executions " << max_executions_description << "\n";
   return oss.str();
 }
 
@@ -144,4 +152,22 @@ void options::_init() {
     arg.set_description(test_file_description);
     arg.set_has_value(true);
   }
+  // workers
+  {
+    misc::argument& arg(_arguments['w']);
+    arg.set_name('w');
+    arg.set_long_name("workers");
+    arg.set_description(workers_description);
+    arg.set_has_value(true);
+    arg.set_value("0");
+  }
+  // max executions per worker
+  {
+    misc::argument& arg(_arguments['m']);
+    arg.set_name('m');
+    arg.set_long_name("max-executions");
+    arg.set_description(max_executions_description);
+    arg.set_has_value(true);
+    arg.set_value("1000");
+  }
 }
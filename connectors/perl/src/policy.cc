@@ -32,13 +32,29 @@ policy::policy(const shared_io_context& io_context)
       _second_timer(*io_context),
       _end_timer(*io_context) {}
 
+/**
+ * @brief create and start policy
+ *
+ * @param io_context
+ * @param test_cmd_file file used instead of stdin
+ * @param workers number of persistent workers, if 0, a process is forked for
+ * each check
+ * @param max_executions number of checks executed by a worker before it's
+ * replaced (0: no limit)
+ */
 void policy::create(const shared_io_context& io_context,
-                    const std::string& test_cmd_file) {
+                    const std::string& test_cmd_file,
+                    unsigned workers,
+                    unsigned max_executions) {
   std::shared_ptr<policy> ret(new policy(io_context));
-  ret->start(test_cmd_file);
+  ret->start(test_cmd_file, workers, max_executions);
 }
 
-void policy::start(const std::string& test_cmd_file) {
+void policy::start(const std::string& test_cmd_file,
+                   unsigned workers,
+                   unsigned max_executions) {
+  if (workers)
+    _pool = worker_pool::create(_io_context, workers, max_executions);
   orders::parser::create(_io_context, shared_from_this(), test_cmd_file);
   checks::shared_signal_set signal(
       std::make_shared<asio::signal_set>(*_io_context, SIGCHLD));
@@ -78,6 +94,11 @@ void policy::wait_pid() {
     if (!child_info.si_pid) {  // no exited child
       break;
     }
+    if (_pool &&
+        _pool->on_worker_exit(child_info.si_pid, child_info.si_status)) {
+      child_info.si_pid = 0;
+      continue;
+    }
     pid_to_check_map::iterator ended = _checks.find(child_info.si_pid);
     if (ended == _checks.end()) {
       log::core()->error("pid {} inconnu", child_info.si_pid);
@@ -132,9 +153,13 @@ void policy::on_execute(
       cmd_id, *opt, timeout, _reporter, _io_context);
 
   try {
-    pid_t child = check->execute();
-    if (child > 0) {
-      _checks[child] = check;
+    if (_pool) {
+      _pool->execute(check);
+    } else {
+      pid_t child = check->execute();
+      if (child > 0) {
+        _checks[child] = check;
+      }
     }
   } catch (const std::exception& e) {
     _reporter->send_result({cmd_id, -1, e.what()});
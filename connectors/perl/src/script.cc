@@ -26,12 +26,24 @@ char const* const com::centreon::connector::perl::embedded_perl::_script =
     "use Text::ParseWords qw(parse_line);\n"
     "\n"
     "our %Cache;\n"
+    "our $trap_exit = 0;\n"
     "\n"
     "use constant MTIME_IDX  => 0;\n"
     "use constant HANDLE_IDX => 1;\n"
     "\n"
     "$| = 1;\n"
     "\n"
+    "# In persistent workers, exit must not end the process: it's turned into\n"
+    "# an exception caught by run_file_in_worker.\n"
+    "BEGIN {\n"
+    "  *CORE::GLOBAL::exit = sub {\n"
+    "    my $code = @_ ? $_[0] : 0;\n"
+    "    die bless({ code => $code }, 'Embed::Persistent::Exit') if "
+    "$trap_exit;\n"
+    "    CORE::exit($code);\n"
+    "  };\n"
+    "}\n"
+    "\n"
     "sub valid_package_name {\n"
     "  my ($string) = @_;\n"
     "  # First pass.\n"
@@ -108,4 +120,27 @@ char const* const com::centreon::connector::perl::embedded_perl::_script =
     "    die \"could not run '$filename': $@\";\n"
     "  }\n"
     "  return ($res);\n"
+    "}\n"
+    "\n"
+    "sub run_file_in_worker {\n"
+    "  # Fetch arguments.\n"
+    "  my ($filename, $handle, $args) = @_;\n"
+    "\n"
+    "  # Parse arguments.\n"
+    "  my @parsed_args = (\"$filename\");\n"
+    "  push(@parsed_args, parse_line('\\s+', 0, $args));\n"
+    "\n"
+    "  # Run subroutine, exit is trapped to get the return code.\n"
+    "  local $trap_exit = 1;\n"
+    "  local $@;\n"
+    "  eval { $handle->(@parsed_args) };\n"
+    "  if (ref($@) eq 'Embed::Persistent::Exit') {\n"
+    "    return int($@->{code});\n"
+    "  }\n"
+    "  if ($@) {\n"
+    "    chomp($@);\n"
+    "    print STDERR \"could not run '$filename': $@\\n\";\n"
+    "    return 3;\n"
+    "  }\n"
+    "  return 0;\n"
     "}\n\n";
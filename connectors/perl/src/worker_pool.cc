@@ -0,0 +1,364 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/connector/perl/worker_pool.hh"
+
+#include <sys/socket.h>
+
+#include <algorithm>
+
+#include "com/centreon/connector/log.hh"
+#include "com/centreon/connector/perl/embedded_perl.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::connector;
+using namespace com::centreon::connector::perl;
+
+/**
+ * @brief Construct a new worker pool object, workers are started by create
+ *
+ * @param io_context
+ * @param size number of workers
+ * @param max_executions number of checks executed by a worker before it's
+ * replaced, 0 means no limit
+ */
+worker_pool::worker_pool(const shared_io_context& io_context,
+                         unsigned size,
+                         unsigned max_executions)
+    : _io_context(io_context),
+      _size(size),
+      _max_executions(max_executions),
+      _active(0) {}
+
+/**
+ * @brief create a pool and start its workers
+ *
+ * @param io_context
+ * @param size number of workers
+ * @param max_executions number of checks executed by a worker before it's
+ * replaced, 0 means no limit
+ * @return worker_pool::pointer
+ */
+worker_pool::pointer worker_pool::create(const shared_io_context& io_context,
+                                         unsigned size,
+                                         unsigned max_executions) {
+  pointer ret(new worker_pool(io_context, size, max_executions));
+  ret->_fill();
+  log::core()->info("{} perl workers started, {} executions max per worker",
+                    ret->_active, max_executions);
+  return ret;
+}
+
+/**
+ * @brief fork a new worker
+ *
+ */
+void worker_pool::_spawn() {
+  int fds[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds)) {
+    char const* msg(strerror(errno));
+    throw exceptions::msg_fmt("fail to create worker socket: {}", msg);
+  }
+
+  // new worker mustn't keep sockets of other workers
+  std::vector<int> fds_to_close{fds[0]};
+  for (const auto& pid_worker : _workers) {
+    if (pid_worker.second->socket.is_open())
+      fds_to_close.push_back(pid_worker.second->socket.native_handle());
+  }
+
+  pid_t pid;
+  try {
+    pid = embedded_perl::instance().start_worker(fds[1], fds_to_close,
+                                                 _io_context);
+  } catch (const std::exception&) {
+    ::close(fds[0]);
+    ::close(fds[1]);
+    throw;
+  }
+  ::close(fds[1]);
+
+  worker_ptr w = std::make_shared<worker>(_io_context);
+  w->pid = pid;
+  w->socket.assign(asio::local::stream_protocol(), fds[0]);
+  _workers.emplace(pid, w);
+  _idle.push_back(w);
+  ++_active;
+  _read_reply(w);
+}
+
+/**
+ * @brief start workers until pool is full
+ * If no worker can be started, an exception is thrown
+ *
+ */
+void worker_pool::_fill() {
+  while (_active < _size) {
+    try {
+      _spawn();
+    } catch (const std::exception& e) {
+      log::core()->error("fail to start perl worker: {}", e.what());
+      if (!_active)
+        throw;
+      return;
+    }
+  }
+}
+
+/**
+ * @brief execute a check as soon as a worker is free
+ *
+ * @param check
+ */
+void worker_pool::execute(const checks::check::pointer& check) {
+  if (!_active)
+    _fill();
+  _waiting.push_back(check);
+  _dispatch();
+}
+
+/**
+ * @brief give waiting checks to idle workers
+ *
+ */
+void worker_pool::_dispatch() {
+  while (!_idle.empty() && !_waiting.empty()) {
+    worker_ptr w = _idle.front();
+    _idle.pop_front();
+    checks::check::pointer check = _waiting.front();
+    _waiting.pop_front();
+    try {
+      _send(w, check);
+    } catch (const std::exception& e) {
+      check->fail(e.what());
+      _retire(w);
+      kill(w->pid, SIGKILL);
+    }
+  }
+}
+
+/**
+ * @brief send an order to a worker with pipes of plugin's outputs
+ *
+ * @param w
+ * @param check
+ */
+void worker_pool::_send(const worker_ptr& w,
+                        const checks::check::pointer& check) {
+  int out_pipe[2];
+  int err_pipe[2];
+  if (pipe(out_pipe)) {
+    char const* msg(strerror(errno));
+    throw exceptions::msg_fmt("{}", msg);
+  }
+  if (pipe(err_pipe)) {
+    char const* msg(strerror(errno));
+    ::close(out_pipe[0]);
+    ::close(out_pipe[1]);
+    throw exceptions::msg_fmt("{}", msg);
+  }
+
+  const std::string& cmd = check->get_cmd();
+  order header{static_cast<uint32_t>(cmd.size())};
+  iovec iov[2];
+  iov[0].iov_base = &header;
+  iov[0].iov_len = sizeof(header);
+  iov[1].iov_base = const_cast<char*>(cmd.data());
+  iov[1].iov_len = cmd.size();
+
+  char control[CMSG_SPACE(2 * sizeof(int))] = {};
+  msghdr msg{};
+  msg.msg_iov = iov;
+  msg.msg_iovlen = 2;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(2 * sizeof(int));
+  int fds[2] = {out_pipe[1], err_pipe[1]};
+  memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+  ssize_t sent;
+  do {
+    sent = sendmsg(w->socket.native_handle(), &msg, MSG_NOSIGNAL);
+  } while (sent < 0 && errno == EINTR);
+  // worker side ends are now owned by worker
+  ::close(out_pipe[1]);
+  ::close(err_pipe[1]);
+  if (sent != static_cast<ssize_t>(sizeof(header) + cmd.size())) {
+    char const* err_msg(sent < 0 ? strerror(errno) : "partial write");
+    ::close(out_pipe[0]);
+    ::close(err_pipe[0]);
+    throw exceptions::msg_fmt("fail to send order to perl worker {}: {}",
+                              w->pid, err_msg);
+  }
+
+  w->running = check;
+  ++w->executions;
+  check->execute_in_worker(
+      w->pid, out_pipe[0], err_pipe[0],
+      [me = weak_from_this()](pid_t pid, uint64_t cmd_id) {
+        pointer pool = me.lock();
+        return pool && pool->runs(pid, cmd_id);
+      });
+}
+
+/**
+ * @brief tells if a worker is alive and executes a check
+ *
+ * @param pid pid of the worker
+ * @param cmd_id command id of the check
+ * @return true if the worker hasn't been reaped and runs this check
+ */
+bool worker_pool::runs(pid_t pid, uint64_t cmd_id) const {
+  auto found = _workers.find(pid);
+  return found != _workers.end() && found->second->running &&
+         found->second->running->get_cmd_id() == cmd_id;
+}
+
+/**
+ * @brief wait for the reply of a worker
+ * An error means that worker has exited, this is handled by on_worker_exit
+ *
+ * @param w
+ */
+void worker_pool::_read_reply(const worker_ptr& w) {
+  asio::async_read(
+      w->socket, asio::buffer(&w->header, sizeof(w->header)),
+      [me = shared_from_this(), w](const boost::system::error_code& err,
+                                   std::size_t) {
+        if (err) {
+          log::core()->debug("perl worker {} socket closed: {}", w->pid,
+                             err.message());
+          // worker is dying, it mustn't receive any order
+          me->_retire(w);
+          return;
+        }
+        if (w->header.error_size)
+          me->_read_error(w);
+        else
+          me->_on_reply(w);
+      });
+}
+
+/**
+ * @brief read the error message that follows a reply
+ *
+ * @param w
+ */
+void worker_pool::_read_error(const worker_ptr& w) {
+  w->error.resize(w->header.error_size);
+  asio::async_read(
+      w->socket, asio::buffer(w->error),
+      [me = shared_from_this(), w](const boost::system::error_code& err,
+                                   std::size_t) {
+        if (err) {
+          log::core()->debug("perl worker {} socket closed: {}", w->pid,
+                             err.message());
+          me->_retire(w);
+          return;
+        }
+        me->_on_reply(w);
+      });
+}
+
+/**
+ * @brief a worker has finished its check
+ * The worker is reused unless it has reached max executions or it's being
+ * killed because of a timeout
+ *
+ * @param w
+ */
+void worker_pool::_on_reply(const worker_ptr& w) {
+  checks::check::pointer check = std::move(w->running);
+  if (check) {
+    if (w->header.error_size)
+      check->fail(w->error);
+    else
+      check->set_exit_code(w->header.exit_code);
+  }
+  w->error.clear();
+
+  if ((check && check->is_timed_out()) ||
+      (_max_executions && w->executions >= _max_executions)) {
+    log::core()->debug("perl worker {} recycled after {} executions", w->pid,
+                       w->executions);
+    _retire(w);
+    try {
+      _fill();
+    } catch (const std::exception&) {
+    }
+  } else {
+    _idle.push_back(w);
+    _read_reply(w);
+  }
+  _dispatch();
+}
+
+/**
+ * @brief worker won't receive any order, closing its socket makes it exit
+ *
+ * @param w
+ */
+void worker_pool::_retire(const worker_ptr& w) {
+  if (w->retired)
+    return;
+  w->retired = true;
+  --_active;
+  _idle.erase(std::remove(_idle.begin(), _idle.end(), w), _idle.end());
+  boost::system::error_code err;
+  w->socket.close(err);
+}
+
+/**
+ * @brief called by policy when a child process has been reaped
+ * If worker was running a check (killed by timeout or plugin ended worker
+ * process), exit status is given to the check. Then worker is replaced.
+ *
+ * @param pid
+ * @param status exit code or signal number
+ * @return true if pid is one of our workers
+ */
+bool worker_pool::on_worker_exit(pid_t pid, int status) {
+  auto found = _workers.find(pid);
+  if (found == _workers.end())
+    return false;
+  worker_ptr w = found->second;
+  _workers.erase(found);
+  log::core()->debug("perl worker {} exited status={}", pid, status);
+
+  _retire(w);
+  if (w->running) {
+    w->running->set_exit_code(status);
+    w->running.reset();
+  }
+
+  try {
+    _fill();
+  } catch (const std::exception& e) {
+    // no worker left to execute waiting checks
+    while (!_waiting.empty()) {
+      _waiting.front()->fail(e.what());
+      _waiting.pop_front();
+    }
+  }
+  _dispatch();
+  return true;
+}
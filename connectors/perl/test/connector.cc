@@ -756,3 +756,116 @@ TEST_F(TestConnector, TimeoutTerm) {
       TimeoutKillTermRESULT + sizeof(TimeoutKillTermRESULT) - 1);
   ASSERT_EQ(output, expected);
 }
+
+static std::string perl_connector_workers =
+    perl_connector + " --workers=4 --max-executions=20";
+
+TEST_F(TestConnector, ExecuteSingleWarningScriptWithWorkers) {
+  // Write Perl script.
+  std::string script_path(com::centreon::io::file_stream::temp_path());
+  _write_file(script_path.c_str(),
+              "#!/usr/bin/perl\n"
+              "\n"
+              "print \"Centreon is wonderful\\n\";\n"
+              "exit 1;\n");
+  log::core()->info("write perl code to {}", script_path);
+
+  // Process.
+  process::pointer p =
+      std::make_shared<process>(perl_connector_workers, _io_context);
+  p->start();
+
+  // Write command.
+  std::ostringstream oss;
+  oss.write(cmd1, sizeof(cmd1) - 1);
+  oss << script_path;
+  oss.write(cmd2, sizeof(cmd2) - 1);
+  write_cmd(*p, oss.str());
+
+  // Read reply.
+  std::string output{read_reply(*p)};
+
+  int retval{wait_for_termination(*p)};
+
+  // Remove temporary files.
+  remove(script_path.c_str());
+
+  ASSERT_EQ(retval, 0);
+  std::string expected(result_warning,
+                       result_warning + sizeof(result_warning) - 1);
+  ASSERT_EQ(output, expected);
+}
+
+TEST_F(TestConnector, ExecuteMultipleScriptsWithWorkers) {
+  // Write Perl scripts.
+  std::string script_paths[10];
+  for (auto& script_path : script_paths) {
+    script_path = com::centreon::io::file_stream::temp_path();
+    log::core()->info("write perl code to {}", script_path);
+    _write_file(script_path.c_str(), scripts, sizeof(scripts) - 1);
+  }
+
+  // Process.
+  process::pointer p =
+      std::make_shared<process>(perl_connector_workers, _io_context);
+  p->start();
+
+  // Generate command string.
+  std::string cmd;
+  {
+    std::ostringstream oss;
+    for (unsigned int i = 0; i < count; ++i) {
+      oss.write(cmd3, sizeof(cmd3) - 1);
+      oss << i + 1;
+      oss.write(cmd4, sizeof(cmd4) - 1);
+      oss << script_paths[i % (sizeof(script_paths) / sizeof(*script_paths))];
+      oss.write(cmd5, sizeof(cmd5) - 1);
+    }
+    cmd = oss.str();
+  }
+  write_cmd(*p, cmd);
+
+  // Read reply.
+  std::string output, out_read;
+  do {
+    out_read = read_reply(*p);
+    output += out_read;
+  } while (out_read != "eof");
+
+  int retval{wait_for_termination(*p)};
+
+  // Remove temporary files.
+  for (auto& script_path : script_paths)
+    remove(script_path.c_str());
+
+  unsigned int nb_right_output(0);
+  for (size_t pos(0); (pos = output.find(result2, pos)) != std::string::npos;
+       ++nb_right_output, ++pos)
+    ;
+
+  ASSERT_EQ(nb_right_output, count);
+  ASSERT_EQ(retval, 0);
+}
+
+TEST_F(TestConnector, TimeoutTermWithWorkers) {
+  // Process.
+  process::pointer p =
+      std::make_shared<process>(perl_connector_workers, _io_context);
+  p->start();
+
+  // Write command.
+  std::ostringstream oss;
+  oss.write(TimeoutTermCMD, sizeof(TimeoutTermCMD) - 1);
+  write_cmd(*p, oss.str());
+
+  // Read reply.
+  std::string output(p->read_std_out(std::chrono::seconds(5)));
+
+  int retval{wait_for_termination(*p)};
+
+  ASSERT_EQ(retval, 0);
+  std::string expected(
+      TimeoutKillTermRESULT,
+      TimeoutKillTermRESULT + sizeof(TimeoutKillTermRESULT) - 1);
+  ASSERT_EQ(output, expected);
+}
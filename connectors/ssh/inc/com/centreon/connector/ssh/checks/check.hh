@@ -26,6 +26,7 @@
 namespace com::centreon::connector::ssh {
 
 namespace sessions {
+class remote_shell;
 class session;
 }
 
@@ -35,7 +36,8 @@ namespace checks {
  *  @class check check.hh "com/centreon/connector/ssh/checks/check.hh"
  *  @brief Execute a check on a host.
  *
- *  Execute a check by opening a new channel on a SSH session.
+ *  Execute a check by opening a new channel on a SSH session, or on the
+ *  remote shell of the session when there is one.
  */
 class check : public std::enable_shared_from_this<check> {
   using callback = std::function<void(const result&)>;
@@ -73,6 +75,8 @@ class check : public std::enable_shared_from_this<check> {
   void _exec();
   void _open();
   void _read(bool read_stdout);
+  void _send_result(int exitcode);
+  void _shell_exec(const std::shared_ptr<sessions::remote_shell>& shell);
   static std::string& _skip_data(std::string& data, int nb_line);
 
   LIBSSH2_CHANNEL* _channel;
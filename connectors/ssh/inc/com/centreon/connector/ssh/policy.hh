@@ -58,8 +58,9 @@ class policy : public com::centreon::connector::policy_interface {
       _connect_waiting_session;
 
   shared_io_context _io_context;
+  bool _persistent_shell;
 
-  policy(const shared_io_context& io_context);
+  policy(const shared_io_context& io_context, bool persistent_shell);
   policy(policy const& p) = delete;
   policy& operator=(policy const& p) = delete;
 
@@ -76,7 +77,8 @@ class policy : public com::centreon::connector::policy_interface {
   }
 
   static pointer create(const shared_io_context& io_context,
-                        const std::string& test_cmd_file);
+                        const std::string& test_cmd_file,
+                        bool persistent_shell = false);
 
   void on_eof() override;
   void on_error(uint64_t cmd_id, const std::string& msg) override;
@@ -0,0 +1,110 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCCS_SESSIONS_REMOTE_SHELL_HH
+#define CCCS_SESSIONS_REMOTE_SHELL_HH
+
+#include <libssh2.h>
+
+namespace com::centreon::connector::ssh::sessions {
+
+class session;
+
+/**
+ *  @class remote_shell remote_shell.hh
+ * "com/centreon/connector/ssh/sessions/remote_shell.hh"
+ *  @brief Long-lived command runner on a remote host.
+ *
+ *  Instead of opening a channel and spawning a remote shell for each check,
+ *  a single channel runs a small sh script that executes commands sent on its
+ *  standard input. Each command runs in background, so many of them are
+ *  executed concurrently.
+ *
+ *  Protocol, one line per order on the script standard input:
+ *    * "X <id> <command>": execute command.
+ *    * "K <id>": kill command.
+ *  On its standard output, the script answers:
+ *    * "S": the script is started.
+ *    * "R <id> <exit code> <stdout size> <stderr size>" followed by the
+ *      stdout and stderr contents: result of a command.
+ *
+ *  Timeouts are handled on our side, a timed out command is killed and its
+ *  result, if any, is ignored.
+ */
+class remote_shell : public std::enable_shared_from_this<remote_shell> {
+ public:
+  enum class run_status { ok, timeout, error, unavailable };
+  /* The error detail is given in err when status is not ok. */
+  using run_callback = std::function<
+      void(run_status status, int exit_code, std::string& out, std::string& err)>;
+
+  struct frame {
+    uint64_t id;
+    int exit_code;
+    std::string out;
+    std::string err;
+  };
+  enum class frame_type { none, started, result, invalid };
+
+ private:
+  enum class e_step { chan_open, chan_exec, starting, running, closed };
+
+  struct pending_run {
+    run_callback callback;
+    time_point timeout;
+  };
+
+  std::weak_ptr<session> _session;
+  LIBSSH2_CHANNEL* _channel;
+  e_step _step;
+  uint64_t _next_id;
+  std::map<uint64_t, pending_run> _pending;
+  std::string _to_send;
+  bool _sending;
+  std::string _received;
+  asio::system_timer _timeout_timer;
+
+  void _open();
+  void _exec();
+  void _start_send();
+  void _start_read();
+  void _on_data();
+  void _check_timeouts();
+  void _close(const std::string& reason);
+
+ public:
+  using pointer = std::shared_ptr<remote_shell>;
+
+  remote_shell(const std::shared_ptr<session>& sess);
+  ~remote_shell() noexcept;
+  remote_shell(const remote_shell&) = delete;
+  remote_shell& operator=(const remote_shell&) = delete;
+
+  void start();
+  void run(const std::string& cmd,
+           const time_point& timeout,
+           run_callback&& callback);
+  size_t pending_count() const { return _pending.size(); }
+
+  static const char* script();
+  static frame_type extract_frame(std::string* data, frame* f);
+};
+
+}  // namespace com::centreon::connector::ssh::sessions
+
+#endif  // !CCCS_SESSIONS_REMOTE_SHELL_HH
@@ -24,6 +24,9 @@
 #include "com/centreon/connector/ssh/sessions/credentials.hh"
 
 namespace com::centreon::connector::ssh::sessions {
+
+class remote_shell;
+
 /**
  *  @class session session.hh "com/centreon/connector/ssh/session.hh"
  *  @brief SSH session.
@@ -45,7 +48,9 @@ class session : public std::enable_shared_from_this<session> {
   using connect_callback =
       std::function<void(const boost::system::error_code&)>;
 
-  session(credentials const& creds, const shared_io_context& io_context);
+  session(credentials const& creds,
+          const shared_io_context& io_context,
+          bool persistent_shell = false);
   ~session() noexcept;
   session(session const& s) = delete;
   session& operator=(session const& s) = delete;
@@ -55,6 +60,8 @@ class session : public std::enable_shared_from_this<session> {
   credentials const& get_credentials() const noexcept { return _creds; };
   LIBSSH2_SESSION* get_libssh2_session() const noexcept { return _session; };
   int new_channel(LIBSSH2_CHANNEL*&);
+  std::shared_ptr<remote_shell> get_shell();
+  void on_shell_closed(bool started);
 
   template <class action_type, class callback_type>
   void async_wait(action_type&& action, callback_type&& callback,
@@ -178,6 +185,11 @@ class session : public std::enable_shared_from_this<session> {
   using async_list = std::list<ssh2_action::pointer>;
   async_list _async_listeners;
   asio::system_timer _second_timer, _connect_timer;
+
+  /* Checks are executed by a long-lived remote shell instead of a channel
+   * each. Disabled if the shell cannot be started on this host. */
+  bool _persistent_shell;
+  std::shared_ptr<remote_shell> _shell;
 };  // namespace sessions
 
 template <class action_type, class callback_type>
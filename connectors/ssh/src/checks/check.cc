@@ -20,6 +20,7 @@
 #include "com/centreon/exceptions/msg_fmt.hh"
 
 #include "com/centreon/connector/ssh/checks/check.hh"
+#include "com/centreon/connector/ssh/sessions/remote_shell.hh"
 #include "com/centreon/connector/ssh/sessions/session.hh"
 
 using namespace com::centreon::connector::ssh::checks;
@@ -107,6 +108,10 @@ void check::_execute() {
 void check::_process() {
   switch (_step) {
     case e_step::chan_open:
+      if (auto shell = _session->get_shell()) {
+        _shell_exec(shell);
+        break;
+      }
       log::core()->info("attempting to open channel for check {}", _cmd_id);
       _open();
       // if (!_open()) {
@@ -206,21 +211,65 @@ void check::_close_handler(int retval) {
     // Method should not be called again.
     retval = false;
 
-    if (_skip_stdout != -1)
-      _skip_data(_stdout, _skip_stdout);
-    if (_skip_stderr != -1)
-      _skip_data(_stderr, _skip_stderr);
+    _send_result(exitcode);
+  }
+}
+
+/**
+ *  Send the result of the current command and execute the next one.
+ *
+ *  @param[in] exitcode The command exit code.
+ */
+void check::_send_result(int exitcode) {
+  if (_skip_stdout != -1)
+    _skip_data(_stdout, _skip_stdout);
+  if (_skip_stderr != -1)
+    _skip_data(_stderr, _skip_stderr);
 
-    // Send results to parent process.
-    _cmds.pop_front();
-    _callback({_cmd_id, exitcode, _stdout, _stderr});
-    if (!_cmds.empty()) {
-      _step = e_step::chan_open;
-      _process();
-    }
+  // Send results to parent process.
+  _cmds.pop_front();
+  _callback({_cmd_id, exitcode, _stdout, _stderr});
+  if (!_cmds.empty()) {
+    _step = e_step::chan_open;
+    _process();
   }
 }
 
+/**
+ *  Execute the current command on the remote shell of the session. If the
+ *  shell cannot execute it, it is executed on its own channel.
+ *
+ *  @param[in] shell The remote shell.
+ */
+void check::_shell_exec(const std::shared_ptr<sessions::remote_shell>& shell) {
+  log::core()->info("executing check {} on the remote shell", _cmd_id);
+  shell->run(
+      _cmds.front(), _timeout,
+      [me = shared_from_this(), this](
+          sessions::remote_shell::run_status status, int exit_code,
+          std::string& out, std::string& err) {
+        switch (status) {
+          case sessions::remote_shell::run_status::ok:
+            log::core()->info("check {} was successfully executed", _cmd_id);
+            _stdout.append(out);
+            _stderr.append(err);
+            _send_result(exit_code);
+            break;
+          case sessions::remote_shell::run_status::unavailable:
+            log::core()->info("attempting to open channel for check {}",
+                              _cmd_id);
+            _open();
+            break;
+          default:
+            log::core()->error(
+                "fail to execute {} for creds:{} for check {} : {}",
+                _cmds.front(), _session->get_credentials(), _cmd_id, err);
+            _callback(
+                {_cmd_id, -1, "fail to execute " + _cmds.front() + " " + err});
+        }
+      });
+}
+
 /**
  *  Attempt to execute the command.
  *
@@ -103,7 +103,8 @@ int main(int argc, char* argv[]) {
           });
 
       // Program policy.
-      policy::create(io_context, test_file_path);
+      policy::create(io_context, test_file_path,
+                     opts.get_argument("persistent-shell").get_is_set());
 
       io_context->run();
     }
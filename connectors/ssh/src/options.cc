@@ -32,6 +32,9 @@ static char const* const log_file_description =
     "Specifies the log file (default: stderr).";
 static char const* const test_file_description =
     "Specifies the file used instead of stdin.";
+static char const* const persistent_shell_description =
+    "Execute checks on a shell started once per SSH session instead of "
+    "opening a channel for each check.";
 
 /**************************************
  *                                     *
@@ -84,6 +87,7 @@ std::string options::help() const {
       << "  --version  " << version_description << "\n"
       << "  --log-file " << log_file_description << "\n"
       << "  --test-file " << test_file_description << "\n"
+      << "  --persistent-shell " << persistent_shell_description << "\n"
       << "\n"
       << "Commands must be sent on the connector's standard input.\n"
       << "They must be sent using Centreon Connector protocol version\n"
@@ -163,4 +167,12 @@ void options::_init() {
     arg.set_description(test_file_description);
     arg.set_has_value(true);
   }
+
+  // Persistent shell.
+  {
+    misc::argument& arg(_arguments['p']);
+    arg.set_name('p');
+    arg.set_long_name("persistent-shell");
+    arg.set_description(persistent_shell_description);
+  }
 }
@@ -38,13 +38,19 @@ using namespace com::centreon::connector;
 
 /**
  *  Default constructor.
+ *
+ *  @param[in] io_context       The io_context.
+ *  @param[in] persistent_shell Execute checks on a remote shell per session.
  */
-policy::policy(const shared_io_context& io_context)
-    : _reporter(reporter::create(io_context)), _io_context(io_context) {}
+policy::policy(const shared_io_context& io_context, bool persistent_shell)
+    : _reporter(reporter::create(io_context)),
+      _io_context(io_context),
+      _persistent_shell(persistent_shell) {}
 
 policy::pointer policy::create(const shared_io_context& io_context,
-                               const std::string& test_cmd_file) {
-  pointer ret(new policy(io_context));
+                               const std::string& test_cmd_file,
+                               bool persistent_shell) {
+  pointer ret(new policy(io_context, persistent_shell));
   ret->start(test_cmd_file);
   return ret;
 }
@@ -127,7 +133,8 @@ void policy::on_execute(
 
     log::core()->info("creating session for {}", creds);
     std::shared_ptr<sessions::session> sess(
-        std::make_shared<sessions::session>(creds, _io_context));
+        std::make_shared<sessions::session>(creds, _io_context,
+                                            _persistent_shell));
 
     connect_waiting_session& connecting = _connect_waiting_session[creds];
     connecting._connecting = sess;
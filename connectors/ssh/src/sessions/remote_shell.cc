@@ -0,0 +1,389 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/connector/ssh/sessions/remote_shell.hh"
+
+#include <absl/strings/numbers.h>
+#include <absl/strings/str_split.h>
+
+#include "com/centreon/connector/log.hh"
+#include "com/centreon/connector/ssh/sessions/session.hh"
+
+using namespace com::centreon::connector;
+using namespace com::centreon::connector::ssh::sessions;
+
+/* Actions on the channel have no real deadline, they are just restarted when
+ * this one expires. */
+static constexpr std::chrono::hours channel_action_timeout(1);
+
+/**
+ * @brief The script run on the remote host. It is given to /bin/sh -c between
+ * single quotes, so it must not contain any.
+ *
+ * Each command runs in a background subshell that stores its outputs and exit
+ * code in a temporary directory and then writes its id in a fifo. A single
+ * reader subshell sends the results in the fifo order, so results are never
+ * interleaved on the standard output.
+ */
+static constexpr const char* shell_script =
+    "d=$(mktemp -d) || exit 1; "
+    "exec 2>/dev/null; "
+    "trap \"rm -rf $d\" EXIT; "
+    "mkfifo $d/q || exit 1; "
+    "exec 3<>$d/q; "
+    "s=${SHELL:-/bin/sh}; "
+    "(while read -r i <&3; do "
+    "printf \"R %s %s %s %s\\n\" $i $(cat $d/$i.rc) $(wc -c <$d/$i.out) "
+    "$(wc -c <$d/$i.err); "
+    "cat $d/$i.out $d/$i.err; "
+    "rm -f $d/$i.*; "
+    "done) & "
+    "r=$!; "
+    "echo S; "
+    "while read -r o i c; do "
+    "case $o in "
+    "X) ($s -c \"$c\" </dev/null >$d/$i.out 2>$d/$i.err 3>&- & "
+    "echo $! >$d/$i.pid; wait $!; echo $? >$d/$i.rc; echo $i >&3) & ;; "
+    "K) kill $(cat $d/$i.pid) ;; "
+    "esac; "
+    "done; "
+    "kill $r";
+
+/**
+ * @brief Constructor. The shell is not started until start() is called.
+ *
+ * @param sess The session on which the shell runs.
+ */
+remote_shell::remote_shell(const std::shared_ptr<session>& sess)
+    : _session(sess),
+      _channel(nullptr),
+      _step(e_step::chan_open),
+      _next_id(1),
+      _sending(false),
+      _timeout_timer(*sess->get_io_context()) {}
+
+/**
+ * @brief Destructor. The channel is closed if the session is still alive,
+ * otherwise libssh2 already freed it with the session.
+ */
+remote_shell::~remote_shell() noexcept {
+  _timeout_timer.cancel();
+  if (_channel) {
+    std::shared_ptr<session> sess = _session.lock();
+    if (sess)
+      sess->async_wait(
+          [channel = _channel]() { return libssh2_channel_close(channel); },
+          [channel = _channel](int) { libssh2_channel_free(channel); },
+          system_clock::now() + std::chrono::minutes(1),
+          "remote_shell::~remote_shell");
+  }
+}
+
+/**
+ * @brief The script executed on the remote host.
+ */
+const char* remote_shell::script() {
+  return shell_script;
+}
+
+/**
+ * @brief Open the channel and execute the script on it.
+ */
+void remote_shell::start() {
+  log::core()->info("starting remote shell");
+  _open();
+}
+
+/**
+ * @brief Run a command on the remote shell. Commands sent before the shell is
+ * started are queued on our side.
+ *
+ * @param cmd The command to execute.
+ * @param timeout The time after which the command is killed.
+ * @param callback Called with the command result. Its status is unavailable
+ * if the command cannot be executed by the shell, it must then be executed
+ * another way.
+ */
+void remote_shell::run(const std::string& cmd,
+                       const time_point& timeout,
+                       run_callback&& callback) {
+  if (_step == e_step::closed ||
+      cmd.find_first_of("\r\n") != std::string::npos) {
+    std::string out, err;
+    callback(run_status::unavailable, -1, out, err);
+    return;
+  }
+
+  uint64_t id = _next_id++;
+  log::core()->debug("remote shell command {}: {}", id, cmd);
+  bool first = _pending.empty();
+  _pending.emplace(id, pending_run{std::move(callback), timeout});
+  _to_send.append(fmt::format("X {} {}\n", id, cmd));
+  if (_step == e_step::running)
+    _start_send();
+  if (first)
+    _check_timeouts();
+}
+
+/**
+ * @brief Open the channel of the shell.
+ */
+void remote_shell::_open() {
+  std::shared_ptr<session> sess = _session.lock();
+  if (!sess)
+    return;
+  sess->async_wait(
+      [me = shared_from_this()]() {
+        std::shared_ptr<session> sess = me->_session.lock();
+        return sess ? sess->new_channel(me->_channel)
+                    : LIBSSH2_ERROR_SOCKET_DISCONNECT;
+      },
+      [me = shared_from_this()](int retval) {
+        if (retval == 0) {
+          me->_step = e_step::chan_exec;
+          me->_exec();
+        } else
+          me->_close(fmt::format("fail to open channel: {}", retval));
+      },
+      system_clock::now() + channel_action_timeout, "remote_shell::_open");
+}
+
+/**
+ * @brief Execute the script on the channel.
+ */
+void remote_shell::_exec() {
+  std::shared_ptr<session> sess = _session.lock();
+  if (!sess)
+    return;
+  auto cmd = std::make_shared<std::string>(
+      fmt::format("/bin/sh -c '{}'", shell_script));
+  sess->async_wait(
+      [me = shared_from_this(), cmd]() {
+        return libssh2_channel_exec(me->_channel, cmd->c_str());
+      },
+      [me = shared_from_this()](int retval) {
+        if (retval == 0) {
+          me->_step = e_step::starting;
+          me->_start_read();
+        } else
+          me->_close(fmt::format("fail to execute shell: {}", retval));
+      },
+      system_clock::now() + channel_action_timeout, "remote_shell::_exec");
+}
+
+/**
+ * @brief Write the pending orders on the shell standard input. There is only
+ * one write at a time, orders queued meanwhile are sent after it.
+ */
+void remote_shell::_start_send() {
+  if (_sending || _to_send.empty() || _step != e_step::running)
+    return;
+  std::shared_ptr<session> sess = _session.lock();
+  if (!sess)
+    return;
+
+  _sending = true;
+  auto data = std::make_shared<std::string>(std::move(_to_send));
+  _to_send.clear();
+  auto offset = std::make_shared<size_t>(0);
+  sess->async_wait(
+      [me = shared_from_this(), data, offset]() {
+        return static_cast<int>(
+            libssh2_channel_write(me->_channel, data->data() + *offset,
+                                  data->size() - *offset));
+      },
+      [me = shared_from_this(), data, offset](int retval) {
+        me->_sending = false;
+        if (retval < 0) {
+          me->_close(fmt::format("fail to write to shell: {}", retval));
+          return;
+        }
+        *offset += retval;
+        if (*offset < data->size())
+          me->_to_send.insert(0, *data, *offset);
+        me->_start_send();
+      },
+      system_clock::now() + channel_action_timeout,
+      "remote_shell::_start_send");
+}
+
+/**
+ * @brief Read the shell standard output until the channel is closed.
+ */
+void remote_shell::_start_read() {
+  std::shared_ptr<session> sess = _session.lock();
+  if (!sess)
+    return;
+
+  boost::shared_array<char> buff(new char[BUFSIZ]);
+  sess->async_wait(
+      [me = shared_from_this(), buff]() {
+        return static_cast<int>(
+            libssh2_channel_read(me->_channel, buff.get(), BUFSIZ));
+      },
+      [me = shared_from_this(), buff](int retval) {
+        if (retval >= 0) {
+          me->_received.append(buff.get(), retval);
+          me->_on_data();
+          if (me->_step == e_step::closed)
+            return;
+          if (libssh2_channel_eof(me->_channel))
+            me->_close("end of shell output");
+          else
+            me->_start_read();
+        } else if (retval == LIBSSH2_ERROR_TIMEOUT) {
+          std::shared_ptr<session> sess = me->_session.lock();
+          if (sess && sess->get_state() != session::e_step::session_error)
+            me->_start_read();
+          else
+            me->_close("session error");
+        } else
+          me->_close(fmt::format("fail to read from shell: {}", retval));
+      },
+      system_clock::now() + channel_action_timeout,
+      "remote_shell::_start_read");
+}
+
+/**
+ * @brief Handle frames received from the shell.
+ */
+void remote_shell::_on_data() {
+  frame f;
+  for (;;) {
+    switch (extract_frame(&_received, &f)) {
+      case frame_type::none:
+        return;
+      case frame_type::started:
+        log::core()->info("remote shell started");
+        _step = e_step::running;
+        _start_send();
+        break;
+      case frame_type::result: {
+        auto found = _pending.find(f.id);
+        if (found == _pending.end()) {
+          log::core()->debug("result of timed out command {} ignored", f.id);
+          break;
+        }
+        run_callback callback = std::move(found->second.callback);
+        _pending.erase(found);
+        callback(run_status::ok, f.exit_code, f.out, f.err);
+      } break;
+      case frame_type::invalid:
+        _close("invalid data received from shell");
+        return;
+    }
+  }
+}
+
+/**
+ * @brief Every second while commands are running, commands that have timed
+ * out are killed and their callbacks are called.
+ */
+void remote_shell::_check_timeouts() {
+  _timeout_timer.expires_after(std::chrono::seconds(1));
+  _timeout_timer.async_wait([weak_me = weak_from_this()](
+                                const boost::system::error_code& err) {
+    std::shared_ptr<remote_shell> me = weak_me.lock();
+    if (err || !me)
+      return;
+    time_point now = system_clock::now();
+    for (auto it = me->_pending.begin(); it != me->_pending.end();) {
+      if (it->second.timeout < now) {
+        log::core()->error("remote shell command {} timed out", it->first);
+        if (me->_step == e_step::running)
+          me->_to_send.append(fmt::format("K {}\n", it->first));
+        run_callback callback = std::move(it->second.callback);
+        it = me->_pending.erase(it);
+        std::string out, err_msg{"time out expired"};
+        callback(run_status::timeout, -1, out, err_msg);
+      } else
+        ++it;
+    }
+    me->_start_send();
+    if (!me->_pending.empty())
+      me->_check_timeouts();
+  });
+}
+
+/**
+ * @brief Stop using the shell. If it never started, the pending commands are
+ * unavailable and will be executed on their own channels, otherwise they
+ * fail. The session then forgets this shell.
+ *
+ * @param reason Why the shell is closed.
+ */
+void remote_shell::_close(const std::string& reason) {
+  if (_step == e_step::closed)
+    return;
+  bool started = _step == e_step::running;
+  log::core()->error("remote shell closed: {}", reason);
+  _step = e_step::closed;
+  _timeout_timer.cancel();
+
+  std::map<uint64_t, pending_run> pending;
+  pending.swap(_pending);
+  for (auto& p : pending) {
+    std::string out, err{reason};
+    p.second.callback(started ? run_status::error : run_status::unavailable,
+                      -1, out, err);
+  }
+
+  std::shared_ptr<session> sess = _session.lock();
+  if (sess)
+    sess->on_shell_closed(started);
+}
+
+/**
+ * @brief Extract the first frame of data.
+ *
+ * @param data The data received from the shell, the extracted frame is
+ * removed from it.
+ * @param f The frame to fill when a result is extracted.
+ *
+ * @return none if data do not contain a complete frame, invalid if they are
+ * not understood.
+ */
+remote_shell::frame_type remote_shell::extract_frame(std::string* data,
+                                                     frame* f) {
+  size_t eol = data->find('\n');
+  if (eol == std::string::npos)
+    return frame_type::none;
+  std::string_view line(data->data(), eol);
+
+  if (line == "S") {
+    data->erase(0, eol + 1);
+    return frame_type::started;
+  }
+
+  std::vector<std::string_view> fields =
+      absl::StrSplit(line, ' ', absl::SkipEmpty());
+  size_t out_size, err_size;
+  if (fields.size() != 5 || fields[0] != "R" ||
+      !absl::SimpleAtoi(fields[1], &f->id) ||
+      !absl::SimpleAtoi(fields[2], &f->exit_code) ||
+      !absl::SimpleAtoi(fields[3], &out_size) ||
+      !absl::SimpleAtoi(fields[4], &err_size))
+    return frame_type::invalid;
+
+  if (data->size() < eol + 1 + out_size + err_size)
+    return frame_type::none;
+  f->out = data->substr(eol + 1, out_size);
+  f->err = data->substr(eol + 1 + out_size, err_size);
+  data->erase(0, eol + 1 + out_size + err_size);
+  return frame_type::result;
+}
@@ -22,6 +22,7 @@
 #include "com/centreon/exceptions/msg_fmt.hh"
 
 #include "com/centreon/connector/ssh/sessions/session.hh"
+#include "com/centreon/connector/ssh/sessions/remote_shell.hh"
 
 using namespace com::centreon;
 using namespace com::centreon::connector;
@@ -51,9 +52,13 @@ struct formatter<asio::ip::tcp::endpoint> : ostream_formatter {};
 /**
  *  Constructor.
  *
- *  @param[in] creds Connection credentials.
+ *  @param[in] creds            Connection credentials.
+ *  @param[in] io_context       The io_context used by the session.
+ *  @param[in] persistent_shell Execute checks on a remote_shell.
  */
-session::session(credentials const& creds, const shared_io_context& io_context)
+session::session(credentials const& creds,
+                 const shared_io_context& io_context,
+                 bool persistent_shell)
     : _creds(creds),
       _session(nullptr),
       _socket(*io_context),
@@ -63,7 +68,8 @@ session::session(credentials const& creds, const shared_io_context& io_context)
       _step_string("startup"),
       _writing(false),
       _second_timer(*io_context),
-      _connect_timer(*io_context) {
+      _connect_timer(*io_context),
+      _persistent_shell(persistent_shell) {
   // Create session instance.
   _session = libssh2_session_init_ex(nullptr, nullptr, nullptr, this);
   if (!_session)
@@ -450,6 +456,38 @@ int session::new_channel(LIBSSH2_CHANNEL*& chan) {
   return libssh2_session_last_error(_session, &msg, nullptr, 0);
 }
 
+/**
+ *  Get the remote shell of the session, it is started on the first call.
+ *
+ *  @return The remote shell or nullptr if checks must be executed on their
+ *          own channel.
+ */
+std::shared_ptr<remote_shell> session::get_shell() {
+  if (!_persistent_shell || _step != e_step::session_keepalive)
+    return nullptr;
+  if (!_shell) {
+    _shell = std::make_shared<remote_shell>(shared_from_this());
+    _shell->start();
+  }
+  return _shell;
+}
+
+/**
+ *  Called by the remote shell when it stops. A new one will be started by
+ *  the next check, unless this one could not start.
+ *
+ *  @param[in] started true if the shell was running before being closed.
+ */
+void session::on_shell_closed(bool started) {
+  if (!started) {
+    log::core()->error(
+        "remote shell cannot be used on {}, checks will use their own channel",
+        _creds);
+    _persistent_shell = false;
+  }
+  _shell.reset();
+}
+
 /****************************************************************************
  *              authentication
  ****************************************************************************/
@@ -0,0 +1,136 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "com/centreon/connector/ssh/sessions/remote_shell.hh"
+
+using namespace com::centreon::connector::ssh::sessions;
+
+TEST(SSHRemoteShell, ExtractStarted) {
+  std::string data("S\nR 1");
+  remote_shell::frame f;
+  ASSERT_EQ(remote_shell::extract_frame(&data, &f),
+            remote_shell::frame_type::started);
+  ASSERT_EQ(data, "R 1");
+  ASSERT_EQ(remote_shell::extract_frame(&data, &f),
+            remote_shell::frame_type::none);
+}
+
+TEST(SSHRemoteShell, ExtractResult) {
+  std::string data("R 12 3 6 4\nhello\nerr\nR 13");
+  remote_shell::frame f;
+  ASSERT_EQ(remote_shell::extract_frame(&data, &f),
+            remote_shell::frame_type::result);
+  ASSERT_EQ(f.id, 12u);
+  ASSERT_EQ(f.exit_code, 3);
+  ASSERT_EQ(f.out, "hello\n");
+  ASSERT_EQ(f.err, "err\n");
+  ASSERT_EQ(data, "R 13");
+}
+
+TEST(SSHRemoteShell, ExtractIncompleteResult) {
+  std::string data("R 12 0 6 0\nhel");
+  remote_shell::frame f;
+  ASSERT_EQ(remote_shell::extract_frame(&data, &f),
+            remote_shell::frame_type::none);
+  data.append("lo\n");
+  ASSERT_EQ(remote_shell::extract_frame(&data, &f),
+            remote_shell::frame_type::result);
+  ASSERT_EQ(f.out, "hello\n");
+  ASSERT_TRUE(data.empty());
+}
+
+TEST(SSHRemoteShell, ExtractInvalid) {
+  std::string data("Last login: yesterday\n");
+  remote_shell::frame f;
+  ASSERT_EQ(remote_shell::extract_frame(&data, &f),
+            remote_shell::frame_type::invalid);
+}
+
+// Given the remote shell script executed by a local sh
+// When commands are sent to it
+// Then results are received with their exit code, stdout and stderr
+// And a killed command returns a result too.
+TEST(SSHRemoteShell, Script) {
+  int in[2], out[2];
+  ASSERT_EQ(pipe(in), 0);
+  ASSERT_EQ(pipe(out), 0);
+  pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (!pid) {
+    dup2(in[0], 0);
+    dup2(out[1], 1);
+    close(in[1]);
+    close(out[0]);
+    execl("/bin/sh", "sh", "-c", remote_shell::script(), nullptr);
+    _exit(1);
+  }
+  close(in[0]);
+  close(out[1]);
+
+  std::string orders(
+      "X 1 echo hello; echo err >&2; exit 3\n"
+      "X 2 sleep 1; echo late\n"
+      "X 3 sleep 30\n"
+      "X 4 printf abc\n");
+  ASSERT_EQ(write(in[1], orders.data(), orders.size()),
+            static_cast<ssize_t>(orders.size()));
+
+  std::string data;
+  std::map<uint64_t, remote_shell::frame> results;
+  bool started = false;
+  bool killed = false;
+  char buff[1024];
+  while (results.size() < 4) {
+    /* Once the second command is over, the third is surely started. */
+    if (!killed && results.count(2)) {
+      ASSERT_EQ(write(in[1], "K 3\n", 4), 4);
+      killed = true;
+    }
+    ssize_t rb = read(out[0], buff, sizeof(buff));
+    ASSERT_GT(rb, 0);
+    data.append(buff, rb);
+    remote_shell::frame f;
+    for (;;) {
+      remote_shell::frame_type t = remote_shell::extract_frame(&data, &f);
+      if (t == remote_shell::frame_type::none)
+        break;
+      ASSERT_NE(t, remote_shell::frame_type::invalid);
+      if (t == remote_shell::frame_type::started)
+        started = true;
+      else
+        results[f.id] = f;
+    }
+  }
+  close(in[1]);
+  close(out[0]);
+  waitpid(pid, nullptr, 0);
+
+  ASSERT_TRUE(started);
+  ASSERT_EQ(results[1].exit_code, 3);
+  ASSERT_EQ(results[1].out, "hello\n");
+  ASSERT_EQ(results[1].err, "err\n");
+  ASSERT_EQ(results[2].exit_code, 0);
+  ASSERT_EQ(results[2].out, "late\n");
+  ASSERT_NE(results[3].exit_code, 0);
+  ASSERT_EQ(results[4].out, "abc");
+  ASSERT_TRUE(results[4].err.empty());
+}
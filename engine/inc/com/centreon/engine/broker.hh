@@ -455,7 +455,9 @@ int broker_host_check(int type,
                       const char* cmdline,
                       char* output);
 void broker_host_status(int type, com::centreon::engine::host* hst);
-void broker_log_data(char* data, time_t entry_time);
+void broker_log_data(char* data,
+                     time_t entry_time,
+                     const struct nebstruct_log_record_struct* record);
 int broker_notification_data(int type,
                              int flags,
                              int attr,
@@ -516,6 +518,7 @@ struct timeval get_broker_timestamp(struct timeval const* timestamp);
 
 void broker_bench(unsigned id,
                   const std::chrono::system_clock::time_point& mess_create);
+void broker_event_loop_iteration(time_t current_time);
 
 #ifdef __cplusplus
 }
@@ -110,6 +110,8 @@ class checkable {
   // whitelist cache
   whitelist_last_result _whitelist_last_result;
 
+  static uint64_t _freshness_settings_version;
+
  public:
   /**
    * This structure is used by the static command_is_allowed_by_whitelist()
@@ -268,6 +270,9 @@ class checkable {
       const std::string& process_cmd,
       static_whitelist_last_result& cached_cmd);
 
+  static uint64_t freshness_settings_version();
+  static void freshness_settings_changed();
+
   timeperiod* check_period_ptr;
 };
 
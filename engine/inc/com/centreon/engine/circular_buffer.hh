@@ -33,7 +33,10 @@ class circular_buffer : protected boost::circular_buffer<T> {
  public:
   circular_buffer();
   void push(const T& to_push);
+  template <class It>
+  It push(It first, It last);
   boost::optional<T> pop();
+  void pop_all(std::vector<T>& out);
 
   void set_capacity(size_t capacity);
   void clear();
@@ -55,6 +58,24 @@ void circular_buffer<T>::push(const T& to_push) {
   }
 }
 
+/**
+ *  Move as many elements of [first, last) as the free capacity allows under
+ *  a single lock.
+ *
+ *  @return Iterator on the first element that was not pushed.
+ */
+template <class T>
+template <class It>
+It circular_buffer<T>::push(It first, It last) {
+  std::lock_guard<std::mutex> l(_protect);
+  for (; first != last && !base_class::full(); ++first)
+    base_class::push_back(std::move(*first));
+  if (base_class::size() > _high) {
+    _high = base_class::size();
+  }
+  return first;
+}
+
 template <class T>
 boost::optional<T> circular_buffer<T>::pop() {
   std::lock_guard<std::mutex> l(_protect);
@@ -66,6 +87,18 @@ boost::optional<T> circular_buffer<T>::pop() {
   return ret;
 }
 
+/**
+ *  Move all the elements of the buffer at the end of out under a single lock.
+ */
+template <class T>
+void circular_buffer<T>::pop_all(std::vector<T>& out) {
+  std::lock_guard<std::mutex> l(_protect);
+  out.reserve(out.size() + base_class::size());
+  for (auto it = base_class::begin(); it != base_class::end(); ++it)
+    out.push_back(std::move(*it));
+  base_class::clear();
+}
+
 template <class T>
 void circular_buffer<T>::clear() {
   std::lock_guard<std::mutex> l(_protect);
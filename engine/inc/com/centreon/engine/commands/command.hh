@@ -22,6 +22,7 @@
 #include "com/centreon/engine/commands/command_listener.hh"
 #include "com/centreon/engine/commands/result.hh"
 #include "com/centreon/engine/macros/defines.hh"
+#include "com/centreon/engine/macros/template.hh"
 
 namespace com::centreon::engine {
 namespace commands {
@@ -57,6 +58,14 @@ class command {
   command_listener* _listener;
   std::string _name;
 
+  /**
+   * @brief command line with its macros parsed, built at the first use and
+   * rebuilt when the command line changes (configuration reload)
+   *
+   */
+  mutable std::mutex _template_lock;
+  mutable macros::macro_template::pointer _template;
+
   /**
    * @brief the goal of this structure is to ensure that checks shared by
    * anomalydetection and service are not called to often
@@ -104,6 +113,7 @@ class command {
   virtual const std::string& get_name() const noexcept;
   e_type get_type() const { return _type; }
   virtual std::string process_cmd(nagios_macros* macros) const;
+  macros::macro_template::pointer get_macro_template() const;
   virtual uint64_t run(const std::string& processed_cmd,
                        nagios_macros& macors,
                        uint32_t timeout,
@@ -54,6 +54,7 @@ class environment {
   void add(const char* name, const char* value);
   void add(const std::string& line);
   void add(const std::string& name, const std::string& value);
+  void clear();
   char** data() const noexcept;
 };
 }  // namespace commands
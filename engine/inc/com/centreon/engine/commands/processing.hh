@@ -49,8 +49,8 @@ struct command_info {
 
 class processing {
  public:
-  static bool execute(std::string const& cmd);
-  static bool is_thread_safe(char const* cmd);
+  static bool execute(std::string_view cmd);
+  static bool is_thread_safe(std::string_view cmd);
 
   static void wrapper_enable_host_and_child_notifications(host* hst);
   static void wrapper_disable_host_and_child_notifications(host* hst);
@@ -150,7 +150,7 @@ class processing {
                                            time_t entry_time,
                                            char* args);
 
-  static const std::unordered_map<std::string, detail::command_info>
+  static const absl::flat_hash_map<std::string, detail::command_info>
       _lst_command;
 };
 }  // namespace commands
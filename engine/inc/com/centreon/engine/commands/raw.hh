@@ -36,8 +36,23 @@ class environment;
  *  Raw is a specific implementation of command.
  */
 class raw : public command, public process_listener {
+  /**
+   * @brief Environment macros exported to the processes of the command when
+   * they are restricted with set_environment_macros().
+   *
+   */
+  struct environment_filter {
+    std::vector<uint32_t> macros_x;
+    std::vector<uint32_t> argv;
+    std::vector<uint32_t> contact_addresses;
+    // Custom variables macros (_HOSTxxx, _SERVICExxx, _CONTACTxxx).
+    std::vector<std::string> custom_vars;
+  };
+
   std::unordered_map<process*, uint64_t> _processes_busy;
   std::deque<process*> _processes_free;
+  // Null if every macro is exported.
+  std::unique_ptr<environment_filter> _env_filter;
 
   void data_is_available(process& p) noexcept override;
   void data_is_available_err(process& p) noexcept override;
@@ -52,11 +67,21 @@ class raw : public command, public process_listener {
                                                    environment& env);
   static void _build_custom_service_macro_environment(nagios_macros& macros,
                                                       environment& env);
-  static void _build_environment_macros(nagios_macros& macros,
+  bool _build_environment_macros(nagios_macros& macros,
+                                 environment& env) const;
+  void _build_filtered_environment(nagios_macros& macros,
+                                   environment& env) const;
+  static void _build_macrox_environment(nagios_macros& macros,
+                                        uint32_t macro_type,
+                                        bool use_large_installation_tweaks,
                                         environment& env);
   static void _build_macrosx_environment(nagios_macros& macros,
                                          environment& env);
   process* _get_free_process();
+  void _exec(uint64_t command_id,
+             const std::string& processed_cmd,
+             const environment& env,
+             uint32_t timeout);
 
  public:
   raw(const std::string& name,
@@ -74,6 +99,11 @@ class raw : public command, public process_listener {
            nagios_macros& macros,
            uint32_t timeout,
            result& res) override;
+  uint64_t run(const std::string& processed_cmd,
+               const environment& env,
+               uint32_t timeout);
+  void build_environment(nagios_macros& macros, environment& env) const;
+  void set_environment_macros(const std::string& macros);
 };
 }  // namespace commands
 
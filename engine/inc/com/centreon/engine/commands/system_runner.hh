@@ -0,0 +1,94 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCE_COMMANDS_SYSTEM_RUNNER_HH
+#define CCE_COMMANDS_SYSTEM_RUNNER_HH
+
+#include "com/centreon/engine/commands/environment.hh"
+#include "com/centreon/engine/commands/raw.hh"
+
+namespace com::centreon::engine::commands {
+
+/**
+ *  @class system_runner system_runner.hh
+ *  @brief Execute notifications, event handlers and obsessive commands
+ *  without blocking the main loop.
+ *
+ *  Commands are started by a raw command, at most
+ *  max_concurrent_system_commands at the same time; the others wait in a
+ *  queue with the environment computed when they were submitted. Completion
+ *  handlers are called from the main loop with what my_system_r() would have
+ *  returned. If max_concurrent_system_commands is 0, commands are executed
+ *  synchronously by my_system_r().
+ */
+class system_runner : public command_listener {
+ public:
+  using completion_handler = std::function<
+      void(int result, bool early_timeout, double exectime,
+           const std::string& output)>;
+
+ private:
+  static system_runner* _instance;
+
+  struct pending {
+    std::string cmd;
+    std::unique_ptr<environment> env;
+    uint32_t timeout;
+    completion_handler handler;
+  };
+
+  struct running {
+    std::string cmd;
+    uint32_t timeout;
+    timeval start_time;
+    completion_handler handler;
+  };
+
+  std::unique_ptr<raw> _raw;
+  // only accessed from the main loop
+  absl::flat_hash_map<uint64_t, running> _running;
+  std::deque<pending> _waiting;
+
+  system_runner();
+  void finished(const result& res) noexcept override;
+  void _start(pending&& cmd);
+  void _start_waiting();
+  void _on_finished(const result& res);
+  static uint32_t _max_concurrent();
+
+ public:
+  static system_runner& instance();
+  static void init();
+  static void deinit();
+
+  system_runner(const system_runner&) = delete;
+  system_runner& operator=(const system_runner&) = delete;
+  ~system_runner() noexcept override;
+
+  void run(nagios_macros* mac,
+           const std::string& cmd,
+           uint32_t timeout,
+           completion_handler&& handler);
+
+  size_t running_count() const { return _running.size(); }
+  size_t waiting_count() const { return _waiting.size(); }
+};
+
+}  // namespace com::centreon::engine::commands
+
+#endif  // !CCE_COMMANDS_SYSTEM_RUNNER_HH
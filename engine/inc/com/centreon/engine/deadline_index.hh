@@ -0,0 +1,136 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#ifndef CCE_DEADLINE_INDEX_HH
+#define CCE_DEADLINE_INDEX_HH
+
+#include <absl/container/flat_hash_map.h>
+#include <ctime>
+#include <queue>
+#include <vector>
+
+namespace com::centreon::engine {
+
+/**
+ * @brief Objects indexed by the time at which they have to be examined again.
+ *
+ * It is used by the freshness and orphan checks so that they only visit the
+ * hosts/services whose deadline is reached instead of all of them. Objects are
+ * referenced by their ID, so an object removed by a reload is just not found
+ * when its deadline is reached.
+ *
+ * Each object has at most one deadline. The heap is not updated when a
+ * deadline is changed or removed, old entries are just ignored when popped and
+ * the heap is rebuilt when there are too many of them.
+ *
+ * The index is also stamped with a version. Callers use it to know when the
+ * index has to be fully rebuilt (configuration reload, settings changed from
+ * an external command...).
+ *
+ * @tparam Key The object ID type.
+ */
+template <typename Key>
+class deadline_index {
+  using entry = std::pair<std::time_t, Key>;
+  using heap = std::priority_queue<entry, std::vector<entry>, std::greater<>>;
+
+  heap _heap;
+  absl::flat_hash_map<Key, std::time_t> _deadlines;
+  uint64_t _version = static_cast<uint64_t>(-1);
+
+  void _compact() {
+    std::vector<entry> entries;
+    entries.reserve(_deadlines.size());
+    for (auto& p : _deadlines)
+      entries.emplace_back(p.second, p.first);
+    _heap = heap(std::greater<>(), std::move(entries));
+  }
+
+ public:
+  /**
+   * @brief Set the deadline of an object, its previous deadline is forgotten.
+   *
+   * @param key The object ID.
+   * @param deadline The time at which the object has to be examined.
+   */
+  void schedule(const Key& key, std::time_t deadline) {
+    auto found = _deadlines.find(key);
+    if (found != _deadlines.end()) {
+      if (found->second == deadline)
+        return;
+      found->second = deadline;
+    } else
+      _deadlines.emplace(key, deadline);
+    _heap.emplace(deadline, key);
+    if (_heap.size() > 2 * _deadlines.size() + 1024)
+      _compact();
+  }
+
+  /**
+   * @brief Forget the deadline of an object.
+   *
+   * @param key The object ID.
+   */
+  void remove(const Key& key) { _deadlines.erase(key); }
+
+  /**
+   * @brief Extract the objects whose deadline is before or at the given time.
+   * Their deadlines are removed, it is up to the caller to schedule them again.
+   *
+   * @param now The current time.
+   * @param due The vector filled with the IDs of the objects to examine, sorted
+   * by deadline.
+   */
+  void pop_due(std::time_t now, std::vector<Key>* due) {
+    while (!_heap.empty() && _heap.top().first <= now) {
+      const entry& e = _heap.top();
+      auto found = _deadlines.find(e.second);
+      if (found != _deadlines.end() && found->second == e.first) {
+        due->push_back(e.second);
+        _deadlines.erase(found);
+      }
+      _heap.pop();
+    }
+  }
+
+  /**
+   * @brief Remove all the deadlines.
+   */
+  void clear() {
+    _heap = heap();
+    _deadlines.clear();
+  }
+
+  /**
+   * @brief Tell if the index has been built for the given version.
+   *
+   * @param version A version number.
+   *
+   * @return true if the index must be rebuilt.
+   */
+  bool outdated(uint64_t version) const { return _version != version; }
+  void set_version(uint64_t version) { _version = version; }
+
+  size_t size() const { return _deadlines.size(); }
+  size_t heap_size() const { return _heap.size(); }
+};
+
+}  // namespace com::centreon::engine
+
+#endif  // !CCE_DEADLINE_INDEX_HH
@@ -19,6 +19,7 @@
 #ifndef CCE_HOST_HH
 #define CCE_HOST_HH
 
+#include "com/centreon/engine/deadline_index.hh"
 #include "com/centreon/engine/service.hh"
 
 /* Forward declaration. */
@@ -36,6 +37,7 @@ using host_map_unsafe =
     absl::flat_hash_map<std::string, com::centreon::engine::host*>;
 using host_id_map =
     absl::flat_hash_map<uint64_t, std::shared_ptr<com::centreon::engine::host>>;
+using host_deadline_index = com::centreon::engine::deadline_index<uint64_t>;
 
 namespace com::centreon::engine {
 class host : public notifier {
@@ -142,7 +144,10 @@ class host : public notifier {
   void grab_macros_r(nagios_macros* mac) override;
   bool operator==(host const& other) = delete;  // throw ();
   bool operator!=(host const& other) = delete;  // throw ();
-  bool is_result_fresh(time_t current_time, int log_this);
+  bool is_result_fresh(time_t current_time,
+                       int log_this,
+                       time_t* expiration_time_out = nullptr);
+  void update_freshness_deadline();
 
   int run_sync_check_3x(enum host::host_state* check_result_code,
                         int check_options,
@@ -254,6 +259,8 @@ class host : public notifier {
   host_map_unsafe child_hosts;
   static host_map hosts;
   static host_id_map hosts_by_id;
+  static host_deadline_index freshness_deadlines;
+  static host_deadline_index orphan_deadlines;
 
   service_map_unsafe services;
   std::list<hostgroup*> const& get_parent_groups() const;
@@ -263,6 +270,9 @@ class host : public notifier {
 
  private:
   void _switch_all_services_to_unknown();
+  time_t _orphan_expected_time() const;
+  void _check_for_orphaned(time_t current_time);
+  void _check_result_freshness(time_t current_time);
 
   uint64_t _id;
   std::string _alias;
@@ -22,9 +22,37 @@
 #include <thread>
 #include "com/centreon/logging/backend.hh"
 
+struct nebstruct_log_record_struct;
+
 namespace com::centreon::engine {
 
 namespace logging {
+/**
+ *  @class log_record_scope broker.hh
+ *  @brief Attach a record to log messages.
+ *
+ *  While this object lives, log messages emitted by the current thread are
+ *  sent to broker with the given record, so that broker gets their fields
+ *  without parsing the message.
+ */
+class log_record_scope {
+  static thread_local const nebstruct_log_record_struct* _current;
+  const nebstruct_log_record_struct* _previous;
+
+ public:
+  log_record_scope(const nebstruct_log_record_struct& record)
+      : _previous(_current) {
+    _current = &record;
+  }
+  ~log_record_scope() noexcept { _current = _previous; }
+  log_record_scope(const log_record_scope&) = delete;
+  log_record_scope& operator=(const log_record_scope&) = delete;
+
+  static const nebstruct_log_record_struct* current() noexcept {
+    return _current;
+  }
+};
+
 /**
  *  @class broker broker.hh
  *  @brief Call broker for all logging message.
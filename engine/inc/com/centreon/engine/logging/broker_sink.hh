@@ -41,7 +41,8 @@ class broker_sink : public spdlog::sinks::base_sink<Mutex> {
     if (this->should_log(msg.level)) {
       std::string message{fmt::to_string(msg.payload)};
       nebstruct_log_data ds{.entry_time = time(nullptr),
-                            .data = message.c_str()};
+                            .data = message.c_str(),
+                            .record = log_record_scope::current()};
 
       // Make callbacks.
       neb_make_callbacks(NEBCALLBACK_LOG_DATA, &ds);
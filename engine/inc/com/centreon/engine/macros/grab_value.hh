@@ -38,6 +38,7 @@ int grab_macrox_value_r(nagios_macros* mac,
                         std::string const& arg2,
                         std::string& output,
                         int* free_macro);
+int grab_macrox_clean_options(int macro_type);
 
 #ifdef __cplusplus
 }
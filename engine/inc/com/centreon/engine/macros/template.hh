@@ -0,0 +1,76 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CCE_MACROS_TEMPLATE_HH
+#define CCE_MACROS_TEMPLATE_HH
+
+#include "com/centreon/engine/macros/defines.hh"
+
+namespace com::centreon::engine::macros {
+
+/**
+ *  @class macro_template template.hh
+ *  @brief Command line with its macros parsed once.
+ *
+ *  The command line is split into literal segments and macro slots. Macro
+ *  names are looked up when the template is built, so expanding it is a
+ *  single pass filling the slots. The result is the same as the one of
+ *  process_macros_r() on the same command line.
+ */
+class macro_template {
+  enum class slot_type {
+    literal,  // text copied as is
+    macro_x,  // macro of macro_x_names, with its on-demand arguments
+    argv,     // $ARGn$
+    user,     // $USERn$
+    other     // custom variables, contact addresses... resolved at expansion
+  };
+
+  struct slot {
+    slot_type type;
+    // Macro id or index in argv/macro_user.
+    unsigned int id;
+    // Cleaning options of a macro_x.
+    int clean_options;
+    // Literal text or macro name.
+    std::string text;
+    std::string arg1;
+    std::string arg2;
+  };
+
+  const std::string _source;
+  std::vector<slot> _slots;
+
+  void _add_literal(std::string_view text);
+  void _add_macro(std::string_view token);
+
+ public:
+  using pointer = std::shared_ptr<const macro_template>;
+
+  explicit macro_template(const std::string& source);
+  macro_template(const macro_template&) = delete;
+  macro_template& operator=(const macro_template&) = delete;
+
+  const std::string& source() const noexcept { return _source; }
+  void expand(nagios_macros* mac, std::string& output, int options) const;
+};
+
+}  // namespace com::centreon::engine::macros
+
+#endif  // !CCE_MACROS_TEMPLATE_HH
@@ -189,10 +189,41 @@ typedef struct nebstruct_host_status_struct {
   void* object_ptr;
 } nebstruct_host_status_data;
 
+/* Log record types. */
+enum nebstruct_log_record_type {
+  NEBLOG_SERVICE_ALERT,
+  NEBLOG_HOST_ALERT,
+  NEBLOG_SERVICE_NOTIFICATION,
+  NEBLOG_HOST_NOTIFICATION,
+  NEBLOG_SERVICE_INITIAL_STATE,
+  NEBLOG_HOST_INITIAL_STATE,
+  NEBLOG_SERVICE_EVENT_HANDLER,
+  NEBLOG_HOST_EVENT_HANDLER,
+  NEBLOG_GLOBAL_SERVICE_EVENT_HANDLER,
+  NEBLOG_GLOBAL_HOST_EVENT_HANDLER
+};
+
+/* Log record structure, fields of a log entry known by the engine. */
+typedef struct nebstruct_log_record_struct {
+  nebstruct_log_record_type type;
+  uint64_t host_id;
+  uint64_t service_id;
+  const char* host_name;
+  const char* service_description;
+  int state;
+  int state_type;
+  int attempt;
+  const char* contact;
+  const char* command;
+  const char* output;
+} nebstruct_log_record;
+
 /* Log data structure. */
 typedef struct nebstruct_log_struct {
   time_t entry_time;
   const char* data;
+  /* nullptr if the log entry has no record */
+  const nebstruct_log_record* record;
 } nebstruct_log_data;
 
 /* Module data structure. */
@@ -255,4 +286,9 @@ typedef struct nebstruct_bench_struct {
   std::chrono::system_clock::time_point mess_create;
 } nebstruct_bench_data;
 
+/* Event loop structure, sent at the end of each event loop iteration. */
+typedef struct nebstruct_event_loop_struct {
+  time_t current_time;
+} nebstruct_event_loop_data;
+
 #endif /* !CCE_NEBSTRUCTS_HH */
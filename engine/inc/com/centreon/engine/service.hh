@@ -21,6 +21,7 @@
 
 #include "com/centreon/engine/check_result.hh"
 #include "com/centreon/engine/common.hh"
+#include "com/centreon/engine/deadline_index.hh"
 #include "com/centreon/engine/hash.hh"
 #include "com/centreon/engine/logging.hh"
 #include "com/centreon/engine/notifier.hh"
@@ -90,6 +91,8 @@ using service_map_unsafe = absl::flat_hash_map<host_serv_pair,
 using service_id_map =
     absl::btree_map<std::pair<uint64_t, uint64_t>,
                     std::shared_ptr<com::centreon::engine::service>>;
+using service_deadline_index =
+    com::centreon::engine::deadline_index<std::pair<uint64_t, uint64_t>>;
 
 namespace com::centreon::engine {
 
@@ -238,7 +241,10 @@ class service : public notifier {
   bool operator!=(service const&) = delete;
   bool is_valid_escalation_for_notification(escalation const* e,
                                             int options) const override;
-  bool is_result_fresh(time_t current_time, int log_this);
+  bool is_result_fresh(time_t current_time,
+                       int log_this,
+                       time_t* expiration_time_out = nullptr);
+  void update_freshness_deadline();
   void handle_flap_detection_disabled();
   timeperiod* get_notification_timeperiod() const override;
   bool get_notify_on_current_state() const override;
@@ -262,10 +268,16 @@ class service : public notifier {
 
   static service_map services;
   static service_id_map services_by_id;
+  static service_deadline_index freshness_deadlines;
+  static service_deadline_index orphan_deadlines;
 
   std::string get_check_command_line(nagios_macros* macros);
 
  private:
+  time_t _orphan_expected_time() const;
+  void _check_for_orphaned(time_t current_time);
+  void _check_result_freshness(time_t current_time);
+
   uint64_t _host_id;
   uint64_t _service_id;
   std::string _hostname;
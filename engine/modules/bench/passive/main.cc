@@ -17,6 +17,7 @@
 * <http://www.gnu.org/licenses/>.
 */
 
+#include <chrono>
 #include <csignal>
 #include <fstream>
 #ifdef HAVE_GETOPT_H
@@ -49,6 +50,7 @@ int main(int argc, char* argv[]) {
       {"passivehosts", required_argument, NULL, 'H'},
       {"passiveservices", required_argument, NULL, 'S'},
       {"count", required_argument, NULL, 'c'},
+      {"nodelay", no_argument, NULL, 'n'},
       // Benchmark options.
       {"engine", required_argument, NULL, 'e'},
       {"module", required_argument, NULL, 'm'},
@@ -60,16 +62,17 @@ int main(int argc, char* argv[]) {
   int passiveservices(100);
   std::string mode;
   int count(1000);
+  bool nodelay(false);
   std::string engine("/usr/sbin/centengine");
   std::string module("/usr/lib64/centreon-engine/externalcmd.so");
 
   // Process command line arguments.
   int c;
 #ifdef HAVE_GETOPT_H
-  while ((c = getopt_long(argc, argv, "+?h:M:s:H:S:c:e:m:", long_options,
+  while ((c = getopt_long(argc, argv, "+?h:M:s:H:S:c:ne:m:", long_options,
                           &option_index)) != -1) {
 #else
-  while ((c = getopt(argc, argv, "+?h:M:s:H:S:c:e:m:")) != -1) {
+  while ((c = getopt(argc, argv, "+?h:M:s:H:S:c:ne:m:")) != -1) {
 #endif  // HAVE_GETOPT_H
     switch (c) {
       case '?':
@@ -93,6 +96,9 @@ int main(int argc, char* argv[]) {
       case 'c':
         count = strtol(optarg, NULL, 0);
         break;
+      case 'n':
+        nodelay = true;
+        break;
       case 'e':
         engine = optarg;
         break;
@@ -132,7 +138,8 @@ int main(int argc, char* argv[]) {
     centengine.exec(cmdline);
     while (access(cfg_files.command_file().c_str(), F_OK))
       sleep(1);
-    time_t start_time(time(NULL));  // Perform benchmark.
+    std::chrono::steady_clock::time_point start_time(
+        std::chrono::steady_clock::now());  // Perform benchmark.
     std::cout << "Done\n";
 
     // Send external commands.
@@ -150,7 +157,7 @@ int main(int argc, char* argv[]) {
                       << i << "/" << count;
             std::cout.flush();
           }
-          if (!(i % slice))
+          if (!nodelay && !(i % slice))
             sleep(1);
           if (centengine.wait(0))
             break;
@@ -162,7 +169,8 @@ int main(int argc, char* argv[]) {
         ofs.close();
       }
     }
-    time_t send_time(time(NULL));
+    std::chrono::steady_clock::time_point send_time(
+        std::chrono::steady_clock::now());
     std::cout << "\rSending passive check results...                Done       "
                  "        \n";
 
@@ -170,24 +178,29 @@ int main(int argc, char* argv[]) {
     std::cout << "Waiting for Centreon Engine...                  ";
     std::cout.flush();
     centengine.wait();
-    time_t end_time(time(NULL));
+    std::chrono::steady_clock::time_point end_time(
+        std::chrono::steady_clock::now());
     std::cout << "Done\n";
 
     // Print results.
+    double send_duration(
+        std::chrono::duration<double>(send_time - start_time).count());
+    double processing_duration(
+        std::chrono::duration<double>(end_time - start_time).count());
     std::cout << "\n"
               << "  Total passive check results                   " << count
               << "\n"
               << "  Total send time in seconds                    "
-              << send_time - start_time << "\n"
+              << send_duration << "\n"
               << "  Total processing time in seconds              "
-              << end_time - start_time << "\n"
+              << processing_duration << "\n"
               << "  Average check results sent per second         "
               << static_cast<double>(count) /
-                     ((send_time != start_time) ? (send_time - start_time) : 1)
+                     (send_duration > 0 ? send_duration : 1)
               << "\n"
               << "  Average check results processed per second    "
               << static_cast<double>(count) /
-                     ((end_time != start_time) ? (end_time - start_time) : 1)
+                     (processing_duration > 0 ? processing_duration : 1)
               << "\n";
   }
   // Generate configuration files.
@@ -242,6 +255,11 @@ int main(int argc, char* argv[]) {
            "(default is "
         << count << ")\n"
         << "Benchmark options\n"
+        << "  -n --nodelay          Write external commands as fast as "
+           "possible\n"
+        << "                        instead of in 100 slices sent every "
+           "second, to\n"
+        << "                        measure the command file throughput.\n"
         << "  -e --engine           Centreon Engine binary (default is "
         << engine << ")\n"
         << "  -m --module           Centreon Engine external command module "
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#ifndef CCE_MOD_EXTCMD_COMMAND_SPLITTER_HH
+#define CCE_MOD_EXTCMD_COMMAND_SPLITTER_HH
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+namespace com::centreon::engine::modules::external_commands {
+
+/**
+ * @brief Buffer the command file is read into. Commands are split in place,
+ * the data after the last newline is kept until the next read.
+ *
+ * The buffer is linear: the incomplete trailing command is moved at its
+ * beginning before each read.
+ */
+class command_splitter {
+  const size_t _size;
+  const size_t _max_command_length;
+  std::unique_ptr<char[]> _buffer;
+  /* [_begin, _end) is the data not yet processed, an incomplete command */
+  size_t _begin;
+  size_t _end;
+
+ public:
+  /**
+   * @brief Constructor.
+   *
+   * @param size Size of the buffer.
+   * @param max_command_length Commands longer than this are cut, as fgets()
+   * did with a buffer of this size.
+   */
+  command_splitter(size_t size, size_t max_command_length)
+      : _size{size},
+        _max_command_length{max_command_length},
+        _buffer{new char[size]},
+        _begin{0},
+        _end{0} {}
+  command_splitter(const command_splitter&) = delete;
+  command_splitter& operator=(const command_splitter&) = delete;
+
+  /**
+   * @brief Move the incomplete command at the beginning of the buffer and
+   * return where to read new data.
+   *
+   * @return A pointer to at least available() bytes.
+   */
+  char* write_position() {
+    if (_begin > 0) {
+      memmove(_buffer.get(), _buffer.get() + _begin, _end - _begin);
+      _end -= _begin;
+      _begin = 0;
+    }
+    return _buffer.get() + _end;
+  }
+
+  /**
+   * @brief Free space after write_position().
+   */
+  size_t available() const { return _size - _end; }
+
+  /**
+   * @brief Size of the incomplete command waiting for its newline.
+   */
+  size_t pending() const { return _end - _begin; }
+
+  /**
+   * @brief Account for length bytes written at write_position() and call
+   * on_command for each complete command, without its trailing newline.
+   *
+   * @param length Number of bytes written.
+   * @param on_command Callable taking a std::string_view.
+   */
+  template <typename F>
+  void commit(size_t length, F&& on_command) {
+    _end += length;
+    const size_t max_length = _max_command_length - 2;
+    for (;;) {
+      const char* line = _buffer.get() + _begin;
+      const char* nl = static_cast<const char*>(
+          memchr(line, '\n', std::min(_end - _begin, max_length + 1)));
+      if (nl) {
+        on_command(std::string_view(line, nl - line));
+        _begin += nl - line + 1;
+      }
+      /* too long command, it is cut as fgets() used to do */
+      else if (_end - _begin > max_length) {
+        on_command(std::string_view(line, max_length));
+        _begin += max_length;
+      } else
+        break;
+    }
+  }
+
+  /**
+   * @brief Give the incomplete command to on_command and empty the buffer.
+   * It is used when no more data comes in: the last writer did not end its
+   * command with a newline, it must not be glued to the next writer's data.
+   *
+   * @param on_command Callable taking a std::string_view.
+   */
+  template <typename F>
+  void flush(F&& on_command) {
+    if (_end > _begin)
+      on_command(std::string_view(_buffer.get() + _begin, _end - _begin));
+    _begin = _end = 0;
+  }
+};
+
+}  // namespace com::centreon::engine::modules::external_commands
+
+#endif  // !CCE_MOD_EXTCMD_COMMAND_SPLITTER_HH
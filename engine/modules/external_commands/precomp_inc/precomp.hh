@@ -32,6 +32,7 @@
 #include <unordered_map>
 
 #include <absl/container/btree_map.h>
+#include <absl/container/flat_hash_map.h>
 
 #include <boost/circular_buffer.hpp>
 #include <boost/container/flat_map.hpp>
@@ -18,6 +18,7 @@
  *
  */
 #include "com/centreon/engine/modules/external_commands/utils.hh"
+#include "com/centreon/engine/modules/external_commands/command_splitter.hh"
 #include "com/centreon/engine/commands/processing.hh"
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/globals.hh"
@@ -27,10 +28,10 @@
 
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
+using com::centreon::engine::modules::external_commands::command_splitter;
 
 static int command_file_fd = -1;
 static int command_file_created = false;
-static FILE* command_file_fp = NULL;
 
 static std::unique_ptr<std::thread> worker;
 static std::atomic_bool should_exit{false};
@@ -125,19 +126,6 @@ int open_command_file(void) {
     }
   }
 
-  /* re-open the FIFO for use with fgets() */
-  if ((command_file_fp = (FILE*)fdopen(command_file_fd, "r")) == NULL) {
-    engine_logger(log_runtime_error, basic)
-        << "Error: Could not open external command file for "
-           "reading via fdopen(): ("
-        << errno << ") -> " << strerror(errno);
-    runtime_logger->error(
-        "Error: Could not open external command file for "
-        "reading via fdopen(): ({}) -> {}",
-        errno, strerror(errno));
-    return ERROR;
-  }
-
   /* initialize worker thread */
   if (init_command_file_worker_thread() == ERROR) {
     engine_logger(log_runtime_error, basic)
@@ -145,7 +133,8 @@ int open_command_file(void) {
     runtime_logger->error(
         "Error: Could not initialize command file worker thread.");
     /* close the command file */
-    fclose(command_file_fp);
+    close(command_file_fd);
+    command_file_fd = -1;
 
     /* delete the named pipe */
     unlink(command_file.c_str());
@@ -178,16 +167,73 @@ int close_command_file(void) {
   command_file_created = false;
 
   /* close the command file */
-  fclose(command_file_fp);
+  close(command_file_fd);
+  command_file_fd = -1;
 
   return OK;
 }
 
+/* size of the buffer the named pipe is read into, several pipe buffers are
+ * drained by each read() */
+static constexpr size_t read_buffer_size = 32 * MAX_EXTERNAL_COMMAND_LENGTH;
+
+/* poll() timeout, an incomplete command is executed after such a period
+ * without data */
+static constexpr int poll_timeout_ms = 500;
+
+/**
+ *  Execute a thread-safe command or append it to the batch of commands to
+ *  give to the main loop.
+ *
+ *  @param[in]  cmd    Command line, without its trailing newline.
+ *  @param[out] batch  Commands waiting for external_command_buffer.
+ */
+static void dispatch_command(std::string_view cmd,
+                             std::vector<std::string>& batch) {
+  if (cmd.empty())
+    return;
+  // Check if command is thread-safe (for immediate execution).
+  if (commands::processing::is_thread_safe(cmd)) {
+    external_command_logger->debug("direct execute {}", cmd);
+    commands::processing::execute(cmd);
+  } else {
+    external_command_logger->debug("push execute {}", cmd);
+    batch.emplace_back(cmd);
+  }
+}
+
+/**
+ *  Give a batch of commands to external_command_buffer, waiting for free
+ *  slots if needed.
+ *
+ *  @param[in,out] batch  Commands to submit, emptied on return unless the
+ *                        thread is stopped.
+ */
+static void submit_commands(std::vector<std::string>& batch) {
+  auto first = batch.begin();
+  while (!should_exit) {
+    first = external_command_buffer.push(first, batch.end());
+    if (first == batch.end())
+      break;
+    // Wait a bit.
+    struct timeval tv;
+    tv.tv_sec = 0;
+    tv.tv_usec = 250000;
+    select(0, nullptr, nullptr, nullptr, &tv);
+  }
+  batch.clear();
+}
+
 /* worker thread - artificially increases buffer of named pipe */
 static void command_file_worker_thread() {
   external_command_logger->info("start command_file_worker_thread");
 
-  char input_buffer[MAX_EXTERNAL_COMMAND_LENGTH];
+  /* commands are split in place in this buffer */
+  command_splitter input(read_buffer_size, MAX_EXTERNAL_COMMAND_LENGTH);
+  std::vector<std::string> batch;
+  auto dispatch = [&batch](std::string_view cmd) {
+    dispatch_command(cmd, batch);
+  };
   struct pollfd pfd;
   int pollval;
   struct timeval tv;
@@ -203,11 +249,24 @@ static void command_file_worker_thread() {
      * down */
     pfd.fd = command_file_fd;
     pfd.events = POLLIN;
-    pollval = poll(&pfd, 1, 500);
+    pollval = poll(&pfd, 1, poll_timeout_ms);
 
     /* loop if no data */
-    if (pollval == 0)
+    if (pollval == 0) {
+      /* The pipe is opened in read/write mode, so read() never reports the
+       * end of file. After an idle period, a command not terminated by a
+       * newline is executed, it would be glued to the next writer's data
+       * otherwise. */
+      if (input.pending()) {
+        external_command_logger->warn(
+            "command_file_worker_thread(): command without trailing newline "
+            "executed after {} ms without data",
+            poll_timeout_ms);
+        input.flush(dispatch);
+        submit_commands(batch);
+      }
       continue;
+    }
 
     /* check for errors */
     if (pollval == -1) {
@@ -273,36 +332,23 @@ static void command_file_worker_thread() {
 
     /* process all commands in the file (named pipe) if there's some space in
      * the buffer */
-    if (!external_command_buffer.full()) {
-      /* clear EOF condition from prior run (FreeBSD fix) */
-      /* FIXME: use_poll_on_cmd_pipe: Still needed? */
-      clearerr(command_file_fp);
-
-      /* read and process the next command in the file */
-      while (!should_exit &&
-             fgets(input_buffer, (int)(sizeof(input_buffer) - 1),
-                   command_file_fp) != nullptr) {
-        // Check if command is thread-safe (for immediate execution).
-        if (commands::processing::is_thread_safe(input_buffer)) {
-          external_command_logger->debug("direct execute {}", input_buffer);
-          commands::processing::execute(input_buffer);
-        }
-        // Submit the external command for processing
-        // (retry if buffer is full).
-        else {
-          while (!should_exit && external_command_buffer.full()) {
-            // Wait a bit.
-            tv.tv_sec = 0;
-            tv.tv_usec = 250000;
-            select(0, nullptr, nullptr, nullptr, &tv);
-          }
-          external_command_logger->debug("push execute {}", input_buffer);
-          external_command_buffer.push(input_buffer);
-          // Bail if the circular buffer is full.
-          if (external_command_buffer.full())
-            break;
-        }
+    while (!should_exit && !external_command_buffer.full()) {
+      ssize_t rb =
+          read(command_file_fd, input.write_position(), input.available());
+      if (rb <= 0) {
+        if (rb < 0 && errno != EAGAIN && errno != EINTR)
+          external_command_logger->error(
+              "command_file_worker_thread(): read(): ({}) -> {}", errno,
+              strerror(errno));
+        break;
       }
+
+      /* split commands in place */
+      input.commit(rb, dispatch);
+
+      /* Submit the external commands for processing
+       * (retry if buffer is full). */
+      submit_commands(batch);
     }
   }
   external_command_logger->info("end command_file_worker_thread");
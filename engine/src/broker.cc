@@ -767,8 +767,11 @@ void broker_host_status(int type, host* hst) {
  *
  *  @param[in] data       Log entry.
  *  @param[in] entry_time Entry time.
+ *  @param[in] record     Fields of the log entry, may be nullptr.
  */
-void broker_log_data(char* data, time_t entry_time) {
+void broker_log_data(char* data,
+                     time_t entry_time,
+                     const nebstruct_log_record* record) {
   // Config check.
 #ifdef LEGACY_CONF
   if (!(config->event_broker_options() & BROKER_LOGGED_DATA) ||
@@ -784,6 +787,7 @@ void broker_log_data(char* data, time_t entry_time) {
   nebstruct_log_data ds;
   ds.entry_time = entry_time;
   ds.data = data;
+  ds.record = record;
 
   // Make callbacks.
   neb_make_callbacks(NEBCALLBACK_LOG_DATA, &ds);
@@ -1118,4 +1122,15 @@ void broker_bench(unsigned id,
   // Make callbacks.
   neb_make_callbacks(NEBCALLBACK_BENCH_DATA, &ds);
 }
+
+/**
+ *  Tells modules that an event loop iteration is over. Modules that
+ *  stage events can use it as a checkpoint to flush them.
+ *
+ *  @param[in] current_time  time of the iteration.
+ */
+void broker_event_loop_iteration(time_t current_time) {
+  nebstruct_event_loop_data ds = {current_time};
+  neb_make_callbacks(NEBCALLBACK_EVENT_LOOP_DATA, &ds);
+}
 }
@@ -26,6 +26,8 @@
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
 
+uint64_t checkable::_freshness_settings_version = 0;
+
 checkable::checkable(const std::string& name,
                      const std::string& display_name,
                      const std::string& check_command,
@@ -141,6 +143,7 @@ uint32_t checkable::check_interval() const {
 
 void checkable::set_check_interval(uint32_t check_interval) {
   _check_interval = check_interval;
+  freshness_settings_changed();
 }
 
 double checkable::retry_interval() const {
@@ -149,6 +152,7 @@ double checkable::retry_interval() const {
 
 void checkable::set_retry_interval(double retry_interval) {
   _retry_interval = retry_interval;
+  freshness_settings_changed();
 }
 
 time_t checkable::get_last_state_change() const {
@@ -181,6 +185,7 @@ const std::string& checkable::check_period() const {
 
 void checkable::set_check_period(const std::string& check_period) {
   _check_period = check_period;
+  freshness_settings_changed();
 }
 
 const std::string& checkable::get_action_url() const {
@@ -285,6 +290,7 @@ const std::string& checkable::get_timezone() const {
 
 void checkable::set_timezone(const std::string& timezone) {
   _timezone = timezone;
+  freshness_settings_changed();
 }
 
 uint32_t checkable::get_state_history_index() const {
@@ -301,6 +307,7 @@ bool checkable::active_checks_enabled() const {
 
 void checkable::set_checks_enabled(bool checks_enabled) {
   _checks_enabled = checks_enabled;
+  freshness_settings_changed();
 }
 
 bool checkable::check_freshness_enabled() const {
@@ -309,6 +316,7 @@ bool checkable::check_freshness_enabled() const {
 
 void checkable::set_check_freshness(bool check_freshness) {
   _check_freshness = check_freshness;
+  freshness_settings_changed();
 }
 
 enum checkable::check_type checkable::get_check_type() const {
@@ -353,6 +361,7 @@ bool checkable::passive_checks_enabled() const {
 
 void checkable::set_accept_passive_checks(bool accept_passive_checks) {
   _accept_passive_checks = accept_passive_checks;
+  freshness_settings_changed();
 }
 
 int checkable::get_scheduled_downtime_depth() const {
@@ -386,6 +395,7 @@ int checkable::get_freshness_threshold() const {
 
 void checkable::set_freshness_threshold(int freshness_threshold) {
   _freshness_threshold = freshness_threshold;
+  freshness_settings_changed();
 }
 
 bool checkable::get_is_flapping() const {
@@ -589,3 +599,23 @@ bool checkable::command_is_allowed_by_whitelist(const std::string& process_cmd,
       configuration::whitelist::instance().instance_id();
   return cmd.allowed;
 }
+
+/**
+ * @brief Version of the settings used by the freshness and orphan checks. It
+ * changes each time one of them is modified on a host or a service, the
+ * deadline indexes of the freshness and orphan checks are then rebuilt.
+ *
+ * @return A version number.
+ */
+uint64_t checkable::freshness_settings_version() {
+  return _freshness_settings_version;
+}
+
+/**
+ * @brief Tell the freshness and orphan checks their deadline indexes have to
+ * be rebuilt (configuration reload, system time change, check settings
+ * modified by an external command...).
+ */
+void checkable::freshness_settings_changed() {
+  ++_freshness_settings_version;
+}
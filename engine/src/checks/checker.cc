@@ -302,6 +302,7 @@ void checker::run_sync(host* hst,
 
   // Clear the freshness flag.
   hst->set_is_being_freshened(false);
+  hst->update_freshness_deadline();
 
   // Clear check options - we don't want old check options retained.
   hst->set_check_options(CHECK_OPTION_NONE);
@@ -138,10 +138,25 @@ void commands::command::set_listener(
  */
 std::string commands::command::process_cmd(nagios_macros* macros) const {
   std::string command_line;
-  process_macros_r(macros, this->get_command_line(), command_line, 0);
+  get_macro_template()->expand(macros, command_line, 0);
   return command_line;
 }
 
+/**
+ *  Get the command line with its macros parsed. It is parsed again only if
+ *  the command line has changed since the last call.
+ *
+ *  @return The macro template of the command line.
+ */
+macros::macro_template::pointer commands::command::get_macro_template()
+    const {
+  const std::string& command_line = this->get_command_line();
+  std::lock_guard<std::mutex> l(_template_lock);
+  if (!_template || _template->source() != command_line)
+    _template = std::make_shared<macros::macro_template>(command_line);
+  return _template;
+}
+
 /**
  *  Get the unique command id.
  *
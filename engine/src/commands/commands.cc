@@ -76,16 +76,13 @@ int check_for_external_commands() {
     update_program_status(false);
   }
 
-  /* process all commands found in the buffer */
-  for (;;) {
-    boost::optional<std::string> cmd = external_command_buffer.pop();
-    if (!cmd) {
-      break;
-    }
-
-    /* process the command */
-    process_external_command(cmd->c_str());
-  }
+  /* process all commands found in the buffer, they are taken in one batch to
+   * avoid locking the buffer for each of them */
+  static std::vector<std::string> cmds;
+  external_command_buffer.pop_all(cmds);
+  for (const std::string& cmd : cmds)
+    commands::processing::execute(cmd);
+  cmds.clear();
 
   return OK;
 }
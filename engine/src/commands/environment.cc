@@ -138,8 +138,24 @@ void environment::add(std::string const& name, std::string const& value) {
   _pos_buffer += name.size() + value.size() + 2;
 }
 
+/**
+ *  Remove all the environment variables. Memory is kept to be reused. The
+ *  environment is then set but empty: data() returns an empty array.
+ */
+void environment::clear() {
+  _pos_buffer = 0;
+  _pos_env = 0;
+  if (!_env)
+    _realloc_env(EXTRA_SIZE_ENV);
+  _env[0] = nullptr;
+}
+
 /**
  *  Get environment.
+ *
+ *  @return The null-terminated environment array, nullptr if no variable was
+ *          ever added nor the environment cleared: the process then inherits
+ *          the engine environment.
  */
 char** environment::data() const noexcept {
   return _env;
@@ -18,6 +18,7 @@
  */
 
 #include "com/centreon/engine/commands/processing.hh"
+#include <charconv>
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/commands/commands.hh"
 #include "com/centreon/engine/flapping.hh"
@@ -37,7 +38,7 @@ using namespace com::centreon::engine::commands::detail;
 // Dummy command.
 void dummy_command() {}
 
-const std::unordered_map<std::string, command_info> processing::_lst_command(
+const absl::flat_hash_map<std::string, command_info> processing::_lst_command(
     {{"ENTER_STANDBY_MODE",
       command_info(CMD_DISABLE_NOTIFICATIONS,
                    &_redirector<&disable_all_notifications>)},
@@ -788,53 +789,47 @@ void processing::_redirector_anomalydetection(int id,
   (*fptr)(ano.get(), args + name.length() + description.length() + 2);
 }
 
-bool processing::execute(const std::string& cmdstr) {
+bool processing::execute(std::string_view cmdstr) {
   engine_logger(dbg_functions, basic) << "processing external command";
   functions_logger->trace("processing external command {}", cmdstr);
 
-  char const* cmd{cmdstr.c_str()};
-  size_t len{cmdstr.size()};
-
-  // Left trim command
-  while (*cmd && isspace(*cmd))
-    ++cmd;
-  if (*cmd != '[')
+  // Trim command
+  while (!cmdstr.empty() && isspace(cmdstr.front()))
+    cmdstr.remove_prefix(1);
+  while (!cmdstr.empty() && isspace(cmdstr.back()))
+    cmdstr.remove_suffix(1);
+  if (cmdstr.empty() || cmdstr[0] != '[')
     return false;
-
-  // Right trim just by recomputing the optimal length value.
-  char const* end{cmd + len - 1};
-  while (end != cmd && isspace(*end))
-    --end;
-
-  cmd++;
-  char* tmp;
-  time_t entry_time{static_cast<time_t>(strtoul(cmd, &tmp, 10))};
-
-  while (*tmp && isspace(*tmp))
-    ++tmp;
-
-  if (*tmp != ']' || tmp[1] != ' ')
+  cmdstr.remove_prefix(1);
+
+  while (!cmdstr.empty() && isspace(cmdstr.front()))
+    cmdstr.remove_prefix(1);
+  time_t entry_time = 0;
+  const char* tmp =
+      std::from_chars(cmdstr.data(), cmdstr.data() + cmdstr.size(), entry_time)
+          .ptr;
+  cmdstr.remove_prefix(tmp - cmdstr.data());
+
+  while (!cmdstr.empty() && isspace(cmdstr.front()))
+    cmdstr.remove_prefix(1);
+  if (cmdstr.size() < 2 || cmdstr[0] != ']' || cmdstr[1] != ' ')
     return false;
+  cmdstr.remove_prefix(2);
 
-  cmd = tmp + 2;
-  char const* a;
-  for (a = cmd; *a && *a != ';'; ++a)
-    ;
-
-  std::string command_name(cmd, a - cmd);
+  // Command name is looked up without any copy, only arguments are copied
+  // because handlers tokenize them in place.
+  size_t semicolon = cmdstr.find(';');
+  std::string_view command_name = cmdstr.substr(0, semicolon);
   std::string args;
-  if (*a == ';') {
-    a++;
-    args = std::string(a, end - a + 1);
-  }
+  if (semicolon != std::string_view::npos)
+    args = cmdstr.substr(semicolon + 1);
 
   int command_id(CMD_CUSTOM_COMMAND);
 
-  std::unordered_map<std::string, command_info>::const_iterator it =
-      _lst_command.find(command_name);
+  auto it = _lst_command.find(command_name);
   if (it != _lst_command.end())
     command_id = it->second.id;
-  else if (command_name[0] != '_') {
+  else if (command_name.empty() || command_name[0] != '_') {
     engine_logger(log_external_command | log_runtime_warning, basic)
         << "Warning: Unrecognized external command -> " << command_name;
     external_command_logger->warn(
@@ -900,11 +895,12 @@ bool processing::execute(const std::string& cmdstr) {
  *
  *  @return True if command is thread-safe.
  */
-bool processing::is_thread_safe(char const* cmd) {
-  char const* ptr = cmd + strspn(cmd, "[]0123456789 ");
-  std::string short_cmd(ptr, strcspn(ptr, ";"));
-  std::unordered_map<std::string, command_info>::const_iterator it =
-      _lst_command.find(short_cmd);
+bool processing::is_thread_safe(std::string_view cmd) {
+  size_t start = cmd.find_first_not_of("[]0123456789 ");
+  if (start == std::string_view::npos)
+    return false;
+  cmd.remove_prefix(start);
+  auto it = _lst_command.find(cmd.substr(0, cmd.find(';')));
   return it != _lst_command.end() && it->second.thread_safe;
 }
 
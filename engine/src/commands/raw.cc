@@ -17,6 +17,7 @@
  */
 
 #include "com/centreon/engine/commands/raw.hh"
+#include <absl/strings/strip.h>
 #include "com/centreon/engine/commands/environment.hh"
 #include "com/centreon/engine/exceptions/error.hh"
 #include "com/centreon/engine/globals.hh"
@@ -88,13 +89,70 @@ uint64_t raw::run(std::string const& processed_cmd,
   SPDLOG_LOGGER_TRACE(commands_logger, "raw::run: cmd='{}', timeout={}",
                       processed_cmd, timeout);
 
-  // Get process and put into the busy list.
-  process* p;
   uint64_t command_id(get_uniq_id());
 
   if (!gest_call_interval(command_id, to_push_to_checker, caller)) {
     return command_id;
   }
+
+  // Setup environnement macros if is necessary. The environment is reused
+  // from one execution to the other to keep its memory.
+  static thread_local environment env;
+  static const environment inherited;
+  bool use_env = _build_environment_macros(macros, env);
+
+  _exec(command_id, processed_cmd, use_env ? env : inherited, timeout);
+  return command_id;
+}
+
+/**
+ *  Run a command with an environment built before by build_environment().
+ *  Result is given to the listener, the check result cache is not used.
+ *
+ *  @param[in] processed_cmd The command line.
+ *  @param[in] env           The process environment.
+ *  @param[in] timeout       The command timeout.
+ *
+ *  @return The command id.
+ */
+uint64_t raw::run(const std::string& processed_cmd,
+                  const environment& env,
+                  uint32_t timeout) {
+  engine_logger(dbg_commands, basic)
+      << "raw::run: cmd='" << processed_cmd << "', timeout=" << timeout;
+  SPDLOG_LOGGER_TRACE(commands_logger, "raw::run: cmd='{}', timeout={}",
+                      processed_cmd, timeout);
+
+  uint64_t command_id(get_uniq_id());
+  _exec(command_id, processed_cmd, env, timeout);
+  return command_id;
+}
+
+/**
+ *  Build the environment of a future execution, this allows to execute it
+ *  later while the macros have changed.
+ *
+ *  @param[in]  macros The macros data struct.
+ *  @param[out] env    The environment to fill.
+ */
+void raw::build_environment(nagios_macros& macros, environment& env) const {
+  _build_environment_macros(macros, env);
+}
+
+/**
+ *  Start a process of the busy list.
+ *
+ *  @param[in] command_id    The command id.
+ *  @param[in] processed_cmd The command line.
+ *  @param[in] env           The process environment.
+ *  @param[in] timeout       The command timeout.
+ */
+void raw::_exec(uint64_t command_id,
+                const std::string& processed_cmd,
+                const environment& env,
+                uint32_t timeout) {
+  // Get process and put into the busy list.
+  process* p;
   {
     std::lock_guard<std::mutex> lock(_lock);
     p = _get_free_process();
@@ -106,10 +164,6 @@ uint64_t raw::run(std::string const& processed_cmd,
   SPDLOG_LOGGER_TRACE(commands_logger, "raw::run: id={} , process={}",
                       command_id, (void*)p);
 
-  // Setup environnement macros if is necessary.
-  environment env;
-  _build_environment_macros(macros, env);
-
   try {
     // Start process.
     p->exec(processed_cmd.c_str(), env.data(), timeout);
@@ -128,7 +182,6 @@ uint64_t raw::run(std::string const& processed_cmd,
     delete p;
     throw;
   }
-  return command_id;
 }
 
 /**
@@ -158,12 +211,12 @@ void raw::run(std::string const& processed_cmd,
                       command_id, (void*)&p);
 
   // Setup environement macros if is necessary.
-  environment env;
-  _build_environment_macros(macros, env);
+  static thread_local environment env;
+  bool use_env = _build_environment_macros(macros, env);
 
   // Start process.
   try {
-    p.exec(processed_cmd.c_str(), env.data(), timeout);
+    p.exec(processed_cmd.c_str(), use_env ? env.data() : nullptr, timeout);
     engine_logger(dbg_commands, basic)
         << "raw::run: start process success: id=" << command_id;
     SPDLOG_LOGGER_TRACE(commands_logger,
@@ -478,14 +531,26 @@ void raw::_build_custom_service_macro_environment(nagios_macros& macros,
  *
  *  @param[in,out] macros  The macros data struct.
  *  @param[out]    env     The environment to fill.
+ *
+ *  @return false if environment macros are disabled, env is then left
+ *          untouched and the process must inherit the engine environment.
  */
-void raw::_build_environment_macros(nagios_macros& macros, environment& env) {
+bool raw::_build_environment_macros(nagios_macros& macros,
+                                    environment& env) const {
 #ifdef LEGACY_CONF
   bool enable_environment_macros = config->enable_environment_macros();
 #else
   bool enable_environment_macros = pb_config.enable_environment_macros();
 #endif
-  if (enable_environment_macros) {
+  if (!enable_environment_macros)
+    return false;
+
+  /* even if no macro is exported, the process gets an empty environment */
+  env.clear();
+
+  if (_env_filter)
+    _build_filtered_environment(macros, env);
+  else {
     _build_macrosx_environment(macros, env);
     _build_argv_macro_environment(macros, env);
     _build_custom_host_macro_environment(macros, env);
@@ -493,6 +558,7 @@ void raw::_build_environment_macros(nagios_macros& macros, environment& env) {
     _build_custom_contact_macro_environment(macros, env);
     _build_contact_address_environment(macros, env);
   }
+  return true;
 }
 
 /**
@@ -508,33 +574,187 @@ void raw::_build_macrosx_environment(nagios_macros& macros, environment& env) {
   bool use_large_installation_tweaks =
       pb_config.use_large_installation_tweaks();
 #endif
-  for (uint32_t i = 0; i < MACRO_X_COUNT; ++i) {
-    int release_memory(0);
-
-    // Need to grab macros?
-    if (macros.x[i].empty()) {
-      // Skip summary macro in lage instalation tweaks.
-      if (i < MACRO_TOTALHOSTSUP || i > MACRO_TOTALSERVICEPROBLEMSUNHANDLED ||
-          !use_large_installation_tweaks) {
-        grab_macrox_value_r(&macros, i, "", "", macros.x[i], &release_memory);
-      }
-    }
+  for (uint32_t i = 0; i < MACRO_X_COUNT; ++i)
+    _build_macrox_environment(macros, i, use_large_installation_tweaks, env);
+}
 
-    // Add into the environment.
-    if (!macro_x_names[i].empty()) {
-      std::string line;
-      line.append(MACRO_ENV_VAR_PREFIX);
-      line.append(macro_x_names[i]);
-      line.append("=");
-      line.append(macros.x[i]);
-      env.add(line);
+/**
+ *  Build one macrox environment variable.
+ *
+ *  @param[in,out] macros                         The macros data struct.
+ *  @param[in]     macro_type                     The macro to export.
+ *  @param[in]     use_large_installation_tweaks  Skip summary macros.
+ *  @param[out]    env                            The environment to fill.
+ */
+void raw::_build_macrox_environment(nagios_macros& macros,
+                                    uint32_t macro_type,
+                                    bool use_large_installation_tweaks,
+                                    environment& env) {
+  int release_memory(0);
+
+  // Need to grab macros?
+  if (macros.x[macro_type].empty()) {
+    // Skip summary macro in lage instalation tweaks.
+    if (macro_type < MACRO_TOTALHOSTSUP ||
+        macro_type > MACRO_TOTALSERVICEPROBLEMSUNHANDLED ||
+        !use_large_installation_tweaks) {
+      grab_macrox_value_r(&macros, macro_type, "", "", macros.x[macro_type],
+                          &release_memory);
     }
+  }
+
+  // Add into the environment.
+  if (!macro_x_names[macro_type].empty()) {
+    std::string line;
+    line.append(MACRO_ENV_VAR_PREFIX);
+    line.append(macro_x_names[macro_type]);
+    line.append("=");
+    line.append(macros.x[macro_type]);
+    env.add(line);
+  }
 
-    // Release memory if necessary.
-    if (release_memory) {
-      macros.x[i] = "";
+  // Release memory if necessary.
+  if (release_memory) {
+    macros.x[macro_type] = "";
+  }
+}
+
+/**
+ *  Build only the environment variables of the filter.
+ *
+ *  @param[in,out] macros  The macros data struct.
+ *  @param[out]    env     The environment to fill.
+ */
+void raw::_build_filtered_environment(nagios_macros& macros,
+                                      environment& env) const {
+#ifdef LEGACY_CONF
+  bool use_large_installation_tweaks = config->use_large_installation_tweaks();
+#else
+  bool use_large_installation_tweaks =
+      pb_config.use_large_installation_tweaks();
+#endif
+  for (uint32_t i : _env_filter->macros_x)
+    _build_macrox_environment(macros, i, use_large_installation_tweaks, env);
+
+  for (uint32_t i : _env_filter->argv)
+    env.add(
+        fmt::format(MACRO_ENV_VAR_PREFIX "ARG{}={}", i + 1, macros.argv[i]));
+
+  if (macros.contact_ptr) {
+    const std::vector<std::string>& address =
+        macros.contact_ptr->get_addresses();
+    for (uint32_t i : _env_filter->contact_addresses)
+      if (i < address.size())
+        env.add(fmt::format(MACRO_ENV_VAR_PREFIX "CONTACTADDRESS{}={}", i,
+                            address[i]));
+  }
+
+  for (const std::string& name : _env_filter->custom_vars) {
+    // Variables of the object are used first, then the ones already in the
+    // macros data struct.
+    const map_customvar* object_vars = nullptr;
+    const map_customvar* macros_vars = nullptr;
+    std::string_view var_name(name);
+    if (absl::ConsumePrefix(&var_name, "_HOST")) {
+      if (macros.host_ptr)
+        object_vars = &macros.host_ptr->custom_variables;
+      macros_vars = &macros.custom_host_vars;
+    } else if (absl::ConsumePrefix(&var_name, "_SERVICE")) {
+      if (macros.service_ptr)
+        object_vars = &macros.service_ptr->custom_variables;
+      macros_vars = &macros.custom_service_vars;
+    } else if (absl::ConsumePrefix(&var_name, "_CONTACT")) {
+      if (macros.contact_ptr)
+        object_vars = &macros.contact_ptr->get_custom_variables();
+      macros_vars = &macros.custom_contact_vars;
+    } else
+      continue;
+
+    const customvariable* cv = nullptr;
+    if (object_vars) {
+      auto found = object_vars->find(std::string(var_name));
+      if (found != object_vars->end())
+        cv = &found->second;
+    }
+    if (!cv) {
+      auto found = macros_vars->find(name);
+      if (found != macros_vars->end())
+        cv = &found->second;
     }
+    if (cv)
+      env.add(fmt::format(
+          MACRO_ENV_VAR_PREFIX "{}={}", name,
+          clean_macro_chars(cv->value(),
+                            STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS)));
+  }
+}
+
+/**
+ *  Restrict the environment macros exported to the processes of this
+ *  command. The macros are the ones of the list and the ones the command
+ *  line reads itself (NAGIOS_xxx variables). An empty list exports all the
+ *  macros.
+ *
+ *  @param[in] macros  Macros names separated by commas or spaces, with or
+ *                     without the NAGIOS_ prefix. "auto" exports only the
+ *                     macros of the command line.
+ */
+void raw::set_environment_macros(const std::string& macros) {
+  if (macros.empty()) {
+    _env_filter.reset();
+    return;
+  }
+
+  absl::btree_set<std::string> names;
+  for (std::string_view name :
+       absl::StrSplit(macros, absl::ByAnyChar(", \t"), absl::SkipEmpty())) {
+    if (name == "auto")
+      continue;
+    absl::ConsumePrefix(&name, MACRO_ENV_VAR_PREFIX);
+    if (!name.empty())
+      names.emplace(name);
+  }
+
+  // Variables referenced by the command line itself.
+  std::string_view line(_command_line);
+  constexpr std::string_view prefix(MACRO_ENV_VAR_PREFIX);
+  for (size_t pos = line.find(prefix); pos != std::string_view::npos;
+       pos = line.find(prefix, pos)) {
+    pos += prefix.size();
+    size_t end = pos;
+    while (end < line.size() &&
+           (isalnum(static_cast<unsigned char>(line[end])) || line[end] == '_'))
+      ++end;
+    if (end > pos)
+      names.emplace(line.substr(pos, end - pos));
+  }
+
+  auto filter = std::make_unique<environment_filter>();
+  for (const std::string& name : names) {
+    uint32_t x;
+    for (x = 0; x < MACRO_X_COUNT; ++x)
+      if (macro_x_names[x] == name)
+        break;
+
+    std::string_view index(name);
+    if (x < MACRO_X_COUNT)
+      filter->macros_x.push_back(x);
+    else if (name[0] == '_')
+      filter->custom_vars.push_back(name);
+    else if (absl::ConsumePrefix(&index, "ARG") &&
+             absl::SimpleAtoi(index, &x) && x > 0 &&
+             x <= MAX_COMMAND_ARGUMENTS)
+      filter->argv.push_back(x - 1);
+    else if (absl::ConsumePrefix(&index, "CONTACTADDRESS") &&
+             absl::SimpleAtoi(index, &x) && x < MAX_CONTACT_ADDRESSES)
+      filter->contact_addresses.push_back(x);
+    else
+      SPDLOG_LOGGER_WARN(commands_logger,
+                         "Warning: command '{}': unknown environment macro "
+                         "'{}'",
+                         _name, name);
   }
+  _env_filter = std::move(filter);
 }
 
 /**
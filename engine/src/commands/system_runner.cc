@@ -0,0 +1,236 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/engine/commands/system_runner.hh"
+
+#include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/command_manager.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/service.hh"
+#include "com/centreon/engine/utils.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::commands;
+using namespace com::centreon::engine::logging;
+
+system_runner* system_runner::_instance = nullptr;
+
+/**
+ *  Get instance of the system_runner singleton.
+ *
+ *  @return This singleton.
+ */
+system_runner& system_runner::instance() {
+  /* Like checker, we need to control when to destroy it. */
+  assert(_instance);
+  return *_instance;
+}
+
+void system_runner::init() {
+  if (!_instance)
+    _instance = new system_runner;
+}
+
+void system_runner::deinit() {
+  if (_instance) {
+    delete _instance;
+    _instance = nullptr;
+  }
+}
+
+system_runner::system_runner()
+    : _raw(std::make_unique<raw>("system", "system", this)) {}
+
+/**
+ *  Destructor, it waits for running commands, their handlers are not called.
+ */
+system_runner::~system_runner() noexcept {
+  _raw.reset();
+}
+
+uint32_t system_runner::_max_concurrent() {
+#ifdef LEGACY_CONF
+  return config->max_concurrent_system_commands();
+#else
+  return pb_config.max_concurrent_system_commands();
+#endif
+}
+
+/**
+ *  Execute a command. handler is called from the main loop when the command
+ *  is over, or before this method returns if commands are executed
+ *  synchronously.
+ *
+ *  @param[in] mac     Macros used to build the environment of the command.
+ *  @param[in] cmd     Processed command line.
+ *  @param[in] timeout Command timeout.
+ *  @param[in] handler Completion handler.
+ */
+void system_runner::run(nagios_macros* mac,
+                        const std::string& cmd,
+                        uint32_t timeout,
+                        completion_handler&& handler) {
+  // if no command was passed, return with no error.
+  if (cmd.empty()) {
+    handler(service::state_ok, false, 0.0, "");
+    return;
+  }
+
+  uint32_t max_concurrent = _max_concurrent();
+  if (!max_concurrent) {
+    bool early_timeout;
+    double exectime;
+    std::string output;
+    int result = my_system_r(mac, cmd, timeout, &early_timeout, &exectime,
+                             output, 0);
+    handler(result, early_timeout, exectime, output);
+    return;
+  }
+
+  pending to_run{cmd, std::make_unique<environment>(), timeout,
+                 std::move(handler)};
+  _raw->build_environment(*mac, *to_run.env);
+  if (_running.size() < max_concurrent)
+    _start(std::move(to_run));
+  else {
+    SPDLOG_LOGGER_DEBUG(commands_logger,
+                        "{} system commands running, '{}' delayed",
+                        _running.size(), cmd);
+    _waiting.push_back(std::move(to_run));
+  }
+}
+
+/**
+ *  Start a command.
+ *
+ *  @param[in] to_run Command to start.
+ */
+void system_runner::_start(pending&& to_run) {
+  engine_logger(dbg_commands, more)
+      << "Running command '" << to_run.cmd << "'...";
+  SPDLOG_LOGGER_DEBUG(commands_logger, "Running command '{}'...", to_run.cmd);
+
+  timeval start_time = timeval();
+  timeval end_time = timeval();
+  gettimeofday(&start_time, nullptr);
+
+  // send event broker.
+  broker_system_command(NEBTYPE_SYSTEM_COMMAND_START, NEBFLAG_NONE,
+                        NEBATTR_NONE, start_time, end_time, 0.0,
+                        to_run.timeout, false, service::state_ok,
+                        const_cast<char*>(to_run.cmd.c_str()), nullptr,
+                        nullptr);
+
+  uint64_t command_id = _raw->run(to_run.cmd, *to_run.env, to_run.timeout);
+  _running.emplace(command_id,
+                   running{std::move(to_run.cmd), to_run.timeout, start_time,
+                           std::move(to_run.handler)});
+}
+
+/**
+ *  Start waiting commands while the limit is not reached. If the limit has
+ *  been set to 0 by a reload, all waiting commands are started.
+ */
+void system_runner::_start_waiting() {
+  uint32_t max_concurrent = _max_concurrent();
+  while (!_waiting.empty() &&
+         (!max_concurrent || _running.size() < max_concurrent)) {
+    pending to_run = std::move(_waiting.front());
+    _waiting.pop_front();
+    std::string cmd = to_run.cmd;
+    try {
+      _start(std::move(to_run));
+    } catch (const std::exception& e) {
+      engine_logger(log_runtime_error, basic)
+          << "Error: can't execute command line '" << cmd
+          << "' : " << e.what();
+      runtime_logger->error("Error: can't execute command line '{}' : {}",
+                            cmd, e.what());
+    }
+  }
+}
+
+/**
+ *  Called by the raw command from the process thread, the result is handled
+ *  by the main loop.
+ *
+ *  @param[in] res Result of the command.
+ */
+void system_runner::finished(const result& res) noexcept {
+  try {
+    command_manager::instance().enqueue(std::packaged_task<int()>([res]() {
+      // runner may have been destroyed and rebuilt since
+      if (_instance)
+        _instance->_on_finished(res);
+      return 0;
+    }));
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(commands_logger,
+                        "fail to handle end of system command {}: {}",
+                        res.command_id, e.what());
+  }
+}
+
+/**
+ *  Result of a command, from the main loop.
+ *
+ *  @param[in] res Result of the command.
+ */
+void system_runner::_on_finished(const result& res) {
+  auto found = _running.find(res.command_id);
+  if (found == _running.end())
+    return;
+  running ended = std::move(found->second);
+  _running.erase(found);
+
+  timeval end_time = timeval();
+  end_time.tv_sec = res.end_time.to_seconds();
+  end_time.tv_usec = res.end_time.to_useconds() - end_time.tv_sec * 1000000ull;
+  double exectime = (res.end_time - res.start_time).to_seconds();
+  bool early_timeout = res.exit_status == process::timeout;
+  int result = res.exit_code;
+
+  engine_logger(dbg_commands, more)
+      << com::centreon::logging::setprecision(3)
+      << "Execution time=" << exectime
+      << " sec, early timeout=" << early_timeout << ", result=" << result
+      << ", output=" << res.output;
+  SPDLOG_LOGGER_DEBUG(
+      commands_logger,
+      "Execution time={:.3f} sec, early timeout={}, result={}, output={}",
+      exectime, early_timeout, result, res.output);
+
+  // send event broker.
+  broker_system_command(NEBTYPE_SYSTEM_COMMAND_END, NEBFLAG_NONE, NEBATTR_NONE,
+                        ended.start_time, end_time, exectime, ended.timeout,
+                        early_timeout, result,
+                        const_cast<char*>(ended.cmd.c_str()),
+                        const_cast<char*>(res.output.c_str()), nullptr);
+
+  try {
+    ended.handler(result, early_timeout, exectime, res.output);
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(commands_logger,
+                        "error in end handler of command '{}': {}", ended.cmd,
+                        e.what());
+  }
+
+  _start_waiting();
+}
@@ -20,10 +20,13 @@
 #include "com/centreon/engine/logging.hh"
 #include <sys/time.h>
 #include <cstdarg>
+#include <optional>
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/host.hh"
+#include "com/centreon/engine/logging/broker.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/nebstructs.hh"
 #include "com/centreon/engine/service.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/logging/file.hh"
@@ -47,6 +50,21 @@ void log_host_state(unsigned int type, com::centreon::engine::host* hst) {
       (unsigned int)hst->get_current_state() < host::tab_host_states.size())
     state = host::tab_host_states[hst->get_current_state()].second.c_str();
   std::string const& state_type{host::tab_state_type[hst->get_state_type()]};
+  nebstruct_log_record record{.type = NEBLOG_HOST_INITIAL_STATE,
+                              .host_id = hst->host_id(),
+                              .service_id = 0,
+                              .host_name = hst->name().c_str(),
+                              .service_description = nullptr,
+                              .state = hst->get_current_state(),
+                              .state_type = hst->get_state_type(),
+                              .attempt = hst->get_current_attempt(),
+                              .contact = nullptr,
+                              .command = nullptr,
+                              .output = hst->get_plugin_output().c_str()};
+  // broker only knows initial states
+  std::optional<log_record_scope> record_scope;
+  if (type == INITIAL_STATES)
+    record_scope.emplace(record);
   engine_logger(log_info_message, basic)
       << type_str << " HOST STATE: " << hst->name() << ";" << state << ";"
       << state_type << ";" << hst->get_current_attempt() << ";"
@@ -71,6 +89,22 @@ void log_service_state(unsigned int type, com::centreon::engine::service* svc) {
         service::tab_service_states[svc->get_current_state()].second.c_str();
   std::string const& state_type(service::tab_state_type[svc->get_state_type()]);
   std::string const& output{svc->get_plugin_output()};
+  nebstruct_log_record record{
+      .type = NEBLOG_SERVICE_INITIAL_STATE,
+      .host_id = svc->host_id(),
+      .service_id = svc->service_id(),
+      .host_name = svc->get_hostname().c_str(),
+      .service_description = svc->description().c_str(),
+      .state = svc->get_current_state(),
+      .state_type = svc->get_state_type(),
+      .attempt = svc->get_current_attempt(),
+      .contact = nullptr,
+      .command = nullptr,
+      .output = output.c_str()};
+  // broker only knows initial states
+  std::optional<log_record_scope> record_scope;
+  if (type == INITIAL_STATES)
+    record_scope.emplace(record);
   engine_logger(log_info_message, basic)
       << type_str << " SERVICE STATE: " << svc->get_hostname() << ";"
       << svc->description() << ";" << state << ";" << state_type << ";"
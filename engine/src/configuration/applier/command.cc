@@ -49,6 +49,7 @@ void applier::command::add_object(configuration::command const& obj) {
   if (obj.connector().empty()) {
     std::shared_ptr<commands::raw> raw = std::make_shared<commands::raw>(
         obj.command_name(), obj.command_line(), &checks::checker::instance());
+    raw->set_environment_macros(obj.environment_macros());
     commands::command::commands[raw->get_name()] = raw;
   } else {  // connector or otel, we search it to create the forward command
             // that will use it
@@ -93,6 +94,7 @@ void applier::command::add_object(const configuration::Command& obj) {
   if (obj.connector().empty()) {
     auto raw = std::make_shared<commands::raw>(
         obj.command_name(), obj.command_line(), &checks::checker::instance());
+    raw->set_environment_macros(obj.environment_macros());
     commands::command::commands[raw->get_name()] = std::move(raw);
   } else {
     connector_map::iterator found_con{
@@ -187,6 +189,7 @@ void applier::command::modify_object(configuration::command const& obj) {
   if (obj.connector().empty()) {
     auto raw = std::make_shared<commands::raw>(
         obj.command_name(), obj.command_line(), &checks::checker::instance());
+    raw->set_environment_macros(obj.environment_macros());
     commands::command::commands[raw->get_name()] = raw;
   } else {
     connector_map::iterator found_con{
@@ -249,6 +252,7 @@ void applier::command::modify_object(configuration::Command* to_modify,
     auto raw = std::make_shared<commands::raw>(new_obj.command_name(),
                                                new_obj.command_line(),
                                                &checks::checker::instance());
+    raw->set_environment_macros(new_obj.environment_macros());
     it_obj->second = raw;
   } else {
     connector_map::iterator found_con{
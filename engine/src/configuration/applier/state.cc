@@ -98,6 +98,8 @@ void applier::state::apply(configuration::state& new_cfg,
       _processing(save, err, state);
     }
   }
+  // Hosts and services may have been added, removed or modified.
+  checkable::freshness_settings_changed();
 }
 #else
 /**
@@ -129,6 +131,8 @@ void applier::state::apply(configuration::State& new_cfg,
       _processing(save, err, state);
     }
   }
+  // Hosts and services may have been added, removed or modified.
+  checkable::freshness_settings_changed();
 }
 #endif
 
@@ -365,6 +369,8 @@ void applier::state::_apply(configuration::state const& new_cfg,
   config->max_host_check_spread(new_cfg.max_host_check_spread());
   config->max_log_file_size(new_cfg.max_log_file_size());
   config->max_parallel_service_checks(new_cfg.max_parallel_service_checks());
+  config->max_concurrent_system_commands(
+      new_cfg.max_concurrent_system_commands());
   config->max_service_check_spread(new_cfg.max_service_check_spread());
   config->notification_timeout(new_cfg.notification_timeout());
   config->obsess_over_hosts(new_cfg.obsess_over_hosts());
@@ -655,6 +661,8 @@ void applier::state::_apply(const configuration::State& new_cfg,
   pb_config.set_max_log_file_size(new_cfg.max_log_file_size());
   pb_config.set_max_parallel_service_checks(
       new_cfg.max_parallel_service_checks());
+  pb_config.set_max_concurrent_system_commands(
+      new_cfg.max_concurrent_system_commands());
   pb_config.set_max_service_check_spread(new_cfg.max_service_check_spread());
   pb_config.set_notification_timeout(new_cfg.notification_timeout());
   pb_config.set_obsess_over_hosts(new_cfg.obsess_over_hosts());
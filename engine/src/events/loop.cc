@@ -479,6 +479,9 @@ void loop::_dispatching() {
           static_cast<uint64_t>(1000000000 * sleep_time));
       command_manager::instance().execute();
 
+      // Events staged by modules must not wait for the end of the sleep.
+      broker_event_loop_iteration(current_time);
+
       // Set time to sleep so we don't hog the CPU...
       timespec stime;
       stime.tv_sec = (time_t)sleep_time;
@@ -500,6 +503,9 @@ void loop::_dispatching() {
         std::this_thread::sleep_for(delay);
       }
     }
+    // Checkpoint for modules: events produced during this iteration are
+    // flushed before another thread can take the configuration lock.
+    broker_event_loop_iteration(current_time);
     configuration::applier::state::instance().unlock();
   }
 }
@@ -854,6 +860,9 @@ void loop::compensate_for_system_time_change(unsigned long last_time,
   last_command_check =
       adjust_timestamp_for_time_change(time_difference, last_command_check);
 
+  // freshness and orphan deadlines are computed from these timestamps.
+  checkable::freshness_settings_changed();
+
   // update the status data.
   update_program_status(false);
 }
@@ -24,6 +24,7 @@
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/checkable.hh"
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/commands/system_runner.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/configuration/whitelist.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
@@ -32,10 +33,12 @@
 #include "com/centreon/engine/flapping.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging.hh"
+#include "com/centreon/engine/logging/broker.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
 #include "com/centreon/engine/macros/grab_host.hh"
 #include "com/centreon/engine/neberrors.hh"
+#include "com/centreon/engine/nebstructs.hh"
 #include "com/centreon/engine/notification.hh"
 #include "com/centreon/engine/objects.hh"
 #include "com/centreon/engine/sehandlers.hh"
@@ -58,6 +61,8 @@ std::array<std::pair<uint32_t, std::string>, 3> const host::tab_host_states{
 
 host_map host::hosts;
 host_id_map host::hosts_by_id;
+host_deadline_index host::freshness_deadlines;
+host_deadline_index host::orphan_deadlines;
 
 /*
  *  @param[in] name                          Host name.
@@ -1219,6 +1224,18 @@ int host::log_event() {
   }
   const std::string& state_type(tab_state_type[get_state_type()]);
 
+  nebstruct_log_record record{.type = NEBLOG_HOST_ALERT,
+                              .host_id = host_id(),
+                              .service_id = 0,
+                              .host_name = name().c_str(),
+                              .service_description = nullptr,
+                              .state = get_current_state(),
+                              .state_type = get_state_type(),
+                              .attempt = get_current_attempt(),
+                              .contact = nullptr,
+                              .command = nullptr,
+                              .output = get_plugin_output().c_str()};
+  log_record_scope record_scope(record);
   engine_logger(log_options, basic)
       << "HOST ALERT: " << name() << ";" << state << ";" << state_type << ";"
       << get_current_attempt() << ";" << get_plugin_output();
@@ -1366,6 +1383,7 @@ int host::handle_async_check_result_3x(
         checks_logger,
         "Discarding host freshness check result because the host is "
         "currently fresh (race condition avoided).");
+    update_freshness_deadline();
     return OK;
   }
 
@@ -1411,11 +1429,14 @@ int host::handle_async_check_result_3x(
   set_has_been_checked(true);
 
   /* clear the execution flag if this was an active check */
-  if (queued_check_result.get_check_type() == check_active)
+  if (queued_check_result.get_check_type() == check_active) {
     set_is_executing(false);
+    orphan_deadlines.remove(_id);
+  }
 
   /* get the last check time */
   set_last_check(queued_check_result.get_start_time().tv_sec);
+  update_freshness_deadline();
 
   /* was this check passive or active? */
   set_check_type((queued_check_result.get_check_type() == check_active)
@@ -1823,6 +1844,7 @@ int host::run_async_check(int check_options,
 
   // Set the execution flag.
   set_is_executing(true);
+  orphan_deadlines.schedule(_id, _orphan_expected_time() + 1);
 
   // Send event broker.
   broker_host_check(NEBTYPE_HOSTCHECK_INITIATE, this, checkable::check_active,
@@ -2614,8 +2636,6 @@ int host::notify_contact(nagios_macros* mac,
                          int escalated) {
   std::string raw_command;
   std::string processed_command;
-  bool early_timeout = false;
-  double exectime;
   struct timeval start_time, end_time;
   struct timeval method_start_time, method_end_time;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
@@ -2682,7 +2702,7 @@ int host::notify_contact(nagios_macros* mac,
     notifications_logger->debug("Raw notification command: {}", raw_command);
 
     /* process any macros contained in the argument */
-    process_macros_r(mac, raw_command, processed_command, macro_options);
+    cmd->get_macro_template()->expand(mac, processed_command, macro_options);
     if (processed_command.empty())
       continue;
 
@@ -2719,6 +2739,18 @@ int host::notify_contact(nagios_macros* mac,
             .append(host_state_str)
             .append(")");
 
+      nebstruct_log_record record{.type = NEBLOG_HOST_NOTIFICATION,
+                                  .host_id = host_id(),
+                                  .service_id = 0,
+                                  .host_name = name().c_str(),
+                                  .service_description = nullptr,
+                                  .state = _current_state,
+                                  .state_type = get_state_type(),
+                                  .attempt = get_current_attempt(),
+                                  .contact = cntct->get_name().c_str(),
+                                  .command = cmd->get_name().c_str(),
+                                  .output = get_plugin_output().c_str()};
+      log_record_scope record_scope(record);
       engine_logger(log_host_notification, basic)
           << "HOST NOTIFICATION: " << cntct->get_name() << ';' << this->name()
           << ';' << host_notification_state << ";" << cmd->get_name() << ';'
@@ -2729,12 +2761,50 @@ int host::notify_contact(nagios_macros* mac,
                                  this->get_plugin_output(), info);
     }
 
-    /* run the notification command */
+    /* run the notification command, the end of the method is sent to the
+     * broker once the command is over */
+    bool method_pending = false;
     if (command_is_allowed_by_whitelist(processed_command, NOTIF_TYPE)) {
       try {
-        std::string out;
-        my_system_r(mac, processed_command, notification_timeout,
-                    &early_timeout, &exectime, out, 0);
+        commands::system_runner::instance().run(
+            mac, processed_command, notification_timeout,
+            [processed_command, notification_timeout, type, escalated,
+             method_start_time, not_author, not_data, host_name = name(),
+             contact_name = cntct->get_name()](
+                int, bool early_timeout, double, const std::string&) {
+              /* check to see if the notification timed out */
+              if (early_timeout) {
+                engine_logger(log_host_notification | log_runtime_warning,
+                              basic)
+                    << "Warning: Contact '" << contact_name
+                    << "' host notification command '" << processed_command
+                    << "' timed out after " << notification_timeout
+                    << " seconds";
+                notifications_logger->info(
+                    "Warning: Contact '{}' host notification command '{}' "
+                    "timed out after {} seconds",
+                    contact_name, processed_command, notification_timeout);
+              }
+
+              /* host or contact may have been removed by a reload */
+              host_map::const_iterator hst = host::hosts.find(host_name);
+              contact_map::const_iterator ct =
+                  contact::contacts.find(contact_name);
+              if (hst == host::hosts.end() || ct == contact::contacts.end())
+                return;
+
+              /* get end time */
+              struct timeval method_end_time;
+              gettimeofday(&method_end_time, nullptr);
+
+              /* send data to event broker */
+              broker_contact_notification_method_data(
+                  NEBTYPE_CONTACTNOTIFICATIONMETHOD_END, NEBFLAG_NONE,
+                  NEBATTR_NONE, host_notification, type, method_start_time,
+                  method_end_time, (void*)hst->second.get(), ct->second.get(),
+                  not_author.c_str(), not_data.c_str(), escalated, nullptr);
+            });
+        method_pending = true;
       } catch (std::exception const& e) {
         engine_logger(log_runtime_error, basic)
             << "Error: can't execute host notification for contact '"
@@ -2750,27 +2820,17 @@ int host::notify_contact(nagios_macros* mac,
           cntct->get_name());
     }
 
-    /* check to see if the notification timed out */
-    if (early_timeout) {
-      engine_logger(log_host_notification | log_runtime_warning, basic)
-          << "Warning: Contact '" << cntct->get_name()
-          << "' host notification command '" << processed_command
-          << "' timed out after " << notification_timeout << " seconds";
-      notifications_logger->info(
-          "Warning: Contact '{}' host notification command '{}' timed out "
-          "after {} seconds",
-          cntct->get_name(), processed_command, notification_timeout);
-    }
-
-    /* get end time */
-    gettimeofday(&method_end_time, nullptr);
+    if (!method_pending) {
+      /* get end time */
+      gettimeofday(&method_end_time, nullptr);
 
-    /* send data to event broker */
-    broker_contact_notification_method_data(
-        NEBTYPE_CONTACTNOTIFICATIONMETHOD_END, NEBFLAG_NONE, NEBATTR_NONE,
-        host_notification, type, method_start_time, method_end_time,
-        (void*)this, cntct, not_author.c_str(), not_data.c_str(), escalated,
-        nullptr);
+      /* send data to event broker */
+      broker_contact_notification_method_data(
+          NEBTYPE_CONTACTNOTIFICATIONMETHOD_END, NEBFLAG_NONE, NEBATTR_NONE,
+          host_notification, type, method_start_time, method_end_time,
+          (void*)this, cntct, not_author.c_str(), not_data.c_str(), escalated,
+          nullptr);
+    }
   }
 
   /* get end time */
@@ -2922,8 +2982,19 @@ bool host::is_valid_escalation_for_notification(escalation const* e,
   return true;
 }
 
-/* checks to see if a hosts's check results are fresh */
-bool host::is_result_fresh(time_t current_time, int log_this) {
+/**
+ * @brief Checks to see if a host's check results are fresh.
+ *
+ * @param current_time The current time.
+ * @param log_this Should a warning be logged if results are stale.
+ * @param expiration_time_out If not null, filled with the time after which the
+ * results are stale.
+ *
+ * @return true if results are fresh.
+ */
+bool host::is_result_fresh(time_t current_time,
+                           int log_this,
+                           time_t* expiration_time_out) {
   time_t expiration_time = 0L;
   int freshness_threshold = 0;
   int days = 0;
@@ -3001,6 +3072,9 @@ bool host::is_result_fresh(time_t current_time, int log_this) {
                       has_been_checked(), program_start, event_start,
                       get_last_check(), current_time, expiration_time);
 
+  if (expiration_time_out)
+    *expiration_time_out = expiration_time;
+
   /* the results for the last check of this host are stale */
   if (expiration_time < current_time) {
     get_time_breakdown((current_time - expiration_time), &days, &hours,
@@ -3843,6 +3917,89 @@ bool host::authorized_by_dependencies(dependency::types dependency_type) const {
   return true;
 }
 
+/**
+ * @brief Index the host so that the freshness check examines it again when
+ * its results may have become stale. This is called when a check result
+ * arrives, the state of the host is not yet updated at this time, so the
+ * deadline is computed with the shortest possible threshold. The exact one is
+ * computed when this deadline is reached.
+ */
+void host::update_freshness_deadline() {
+  uint32_t interval_length;
+  int32_t additional_freshness_latency;
+#ifdef LEGACY_CONF
+  interval_length = config->interval_length();
+  additional_freshness_latency = config->additional_freshness_latency();
+#else
+  interval_length = pb_config.interval_length();
+  additional_freshness_latency = pb_config.additional_freshness_latency();
+#endif
+
+  int freshness_threshold = get_freshness_threshold();
+  if (freshness_threshold == 0)
+    freshness_threshold = static_cast<int>(
+        std::min<double>(check_interval(), retry_interval()) *
+            interval_length +
+        additional_freshness_latency);
+  freshness_deadlines.schedule(_id, get_last_check() + freshness_threshold + 1);
+}
+
+/**
+ * @brief Check the freshness of this host results and force a check if they
+ * are stale. If they are fresh, the host is indexed again at the time they
+ * will be stale. Hosts whose check is running or being freshened are examined
+ * again at the next pass. Hosts that cannot be checked for freshness are not
+ * indexed again, a check result or a change of their settings will do it.
+ *
+ * @param current_time The current time.
+ */
+void host::_check_result_freshness(time_t current_time) {
+  /* skip hosts we shouldn't be checking for freshness */
+  if (!check_freshness_enabled())
+    return;
+
+  /* skip hosts that have both active and passive checks disabled */
+  if (!active_checks_enabled() && !passive_checks_enabled())
+    return;
+
+  /* skip hosts that are currently executing (problems here will be caught by
+   * orphaned host check), they are examined again at the next pass */
+  if (get_is_executing()) {
+    freshness_deadlines.schedule(_id, current_time + 1);
+    return;
+  }
+
+  /* skip hosts that are already being freshened */
+  if (get_is_being_freshened()) {
+    freshness_deadlines.schedule(_id, current_time + 1);
+    return;
+  }
+
+  // See if the time is right...
+  {
+    timezone_locker lock(get_timezone());
+    if (!check_time_against_period(current_time, check_period_ptr)) {
+      time_t next_valid_time;
+      get_next_valid_time(current_time, &next_valid_time, check_period_ptr);
+      freshness_deadlines.schedule(_id,
+                                   std::max(next_valid_time, current_time + 1));
+      return;
+    }
+  }
+
+  /* the results for the last check of this host are stale */
+  time_t expiration_time;
+  if (!is_result_fresh(current_time, true, &expiration_time)) {
+    /* set the freshen flag */
+    set_is_being_freshened(true);
+
+    /* schedule an immediate forced check of the host */
+    schedule_check(current_time,
+                   CHECK_OPTION_FORCE_EXECUTION | CHECK_OPTION_FRESHNESS_CHECK);
+  } else
+    freshness_deadlines.schedule(_id, expiration_time + 1);
+}
+
 /* check freshness of host results */
 void host::check_result_freshness() {
   time_t current_time = 0L;
@@ -3872,44 +4029,22 @@ void host::check_result_freshness() {
   /* get the current time */
   time(&current_time);
 
-  /* check all hosts... */
-  for (host_map::iterator it{host::hosts.begin()}, end{host::hosts.end()};
-       it != end; ++it) {
-    /* skip hosts we shouldn't be checking for freshness */
-    if (!it->second->check_freshness_enabled())
-      continue;
-
-    /* skip hosts that have both active and passive checks disabled */
-    if (!it->second->active_checks_enabled() &&
-        !it->second->passive_checks_enabled())
-      continue;
-
-    /* skip hosts that are currently executing (problems here will be caught by
-     * orphaned host check) */
-    if (it->second->get_is_executing())
-      continue;
-
-    /* skip hosts that are already being freshened */
-    if (it->second->get_is_being_freshened())
-      continue;
-
-    // See if the time is right...
-    {
-      timezone_locker lock(it->second->get_timezone());
-      if (!check_time_against_period(current_time,
-                                     it->second->check_period_ptr))
-        continue;
-    }
-
-    /* the results for the last check of this host are stale */
-    if (!it->second->is_result_fresh(current_time, true)) {
-      /* set the freshen flag */
-      it->second->set_is_being_freshened(true);
-
-      /* schedule an immediate forced check of the host */
-      it->second->schedule_check(
-          current_time,
-          CHECK_OPTION_FORCE_EXECUTION | CHECK_OPTION_FRESHNESS_CHECK);
+  uint64_t version = checkable::freshness_settings_version();
+  if (freshness_deadlines.outdated(version)) {
+    /* check all hosts... */
+    freshness_deadlines.clear();
+    for (host_map::iterator it{host::hosts.begin()}, end{host::hosts.end()};
+         it != end; ++it)
+      it->second->_check_result_freshness(current_time);
+    freshness_deadlines.set_version(version);
+  } else {
+    /* ...or only those whose results may be stale */
+    std::vector<uint64_t> due;
+    freshness_deadlines.pop_due(current_time, &due);
+    for (uint64_t id : due) {
+      auto found = host::hosts_by_id.find(id);
+      if (found != host::hosts_by_id.end())
+        found->second->_check_result_freshness(current_time);
     }
   }
 }
@@ -3957,14 +4092,13 @@ void host::adjust_check_attempt(bool is_active) {
                       get_current_attempt());
 }
 
-/* check for hosts that never returned from a check... */
-void host::check_for_orphaned() {
-  time_t current_time = 0L;
-  time_t expected_time = 0L;
-
-  engine_logger(dbg_functions, basic) << "check_for_orphaned_hosts()";
-  SPDLOG_LOGGER_TRACE(functions_logger, "check_for_orphaned_hosts()");
-
+/**
+ * @brief Determine the time at which the results of the running check should
+ * have come in (allow 10 minutes slack time).
+ *
+ * @return A timestamp.
+ */
+time_t host::_orphan_expected_time() const {
   int32_t host_check_timeout;
   uint32_t check_reaper_interval;
 #ifdef LEGACY_CONF
@@ -3974,60 +4108,91 @@ void host::check_for_orphaned() {
   host_check_timeout = pb_config.host_check_timeout();
   check_reaper_interval = pb_config.check_reaper_interval();
 #endif
+  return (time_t)(get_next_check() + get_latency() + host_check_timeout +
+                  check_reaper_interval + 600);
+}
 
-  /* get the current time */
-  time(&current_time);
+/**
+ * @brief Check if the running check of this host is orphaned. If it is still
+ * running and not yet orphaned, the host is indexed again at the time it will
+ * be.
+ *
+ * @param current_time The current time.
+ */
+void host::_check_for_orphaned(time_t current_time) {
+  /* skip hosts that don't have a set check interval (on-demand checks are
+   * missed by the orphan logic) */
+  if (get_next_check() == (time_t)0L)
+    return;
 
-  /* check all hosts... */
-  for (host_map::iterator it{host::hosts.begin()}, end{host::hosts.end()};
-       it != end; ++it) {
-    /* skip hosts that don't have a set check interval (on-demand checks are
-     * missed by the orphan logic) */
-    if (it->second->get_next_check() == (time_t)0L)
-      continue;
+  /* skip hosts that are not currently executing */
+  if (!get_is_executing())
+    return;
 
-    /* skip hosts that are not currently executing */
-    if (!it->second->get_is_executing())
-      continue;
+  time_t expected_time = _orphan_expected_time();
 
-    /* determine the time at which the check results should have come in (allow
-     * 10 minutes slack time) */
-    expected_time =
-        (time_t)(it->second->get_next_check() + it->second->get_latency() +
-                 host_check_timeout + check_reaper_interval + 600);
+  /* this host was supposed to have executed a while ago, but for some reason
+   * the results haven't come back in... */
+  if (expected_time < current_time) {
+    /* log a warning */
+    engine_logger(log_runtime_warning, basic)
+        << "Warning: The check of host '" << name()
+        << "' looks like it was orphaned (results never came back).  "
+           "I'm scheduling an immediate check of the host...";
+    SPDLOG_LOGGER_WARN(
+        runtime_logger,
+        "Warning: The check of host '{}' looks like it was orphaned (results "
+        "never came back).  "
+        "I'm scheduling an immediate check of the host...",
+        name());
 
-    /* this host was supposed to have executed a while ago, but for some reason
-     * the results haven't come back in... */
-    if (expected_time < current_time) {
-      /* log a warning */
-      engine_logger(log_runtime_warning, basic)
-          << "Warning: The check of host '" << it->second->name()
-          << "' looks like it was orphaned (results never came back).  "
-             "I'm scheduling an immediate check of the host...";
-      SPDLOG_LOGGER_WARN(
-          runtime_logger,
-          "Warning: The check of host '{}' looks like it was orphaned (results "
-          "never came back).  "
-          "I'm scheduling an immediate check of the host...",
-          it->second->name());
+    engine_logger(dbg_checks, more)
+        << "Host '" << name()
+        << "' was orphaned, so we're scheduling an immediate check...";
+    SPDLOG_LOGGER_DEBUG(
+        checks_logger,
+        "Host '{}' was orphaned, so we're scheduling an immediate check...",
+        name());
 
-      engine_logger(dbg_checks, more)
-          << "Host '" << it->second->name()
-          << "' was orphaned, so we're scheduling an immediate check...";
-      SPDLOG_LOGGER_DEBUG(
-          checks_logger,
-          "Host '{}' was orphaned, so we're scheduling an immediate check...",
-          it->second->name());
+    /* decrement the number of running host checks */
+    if (currently_running_host_checks > 0)
+      currently_running_host_checks--;
 
-      /* decrement the number of running host checks */
-      if (currently_running_host_checks > 0)
-        currently_running_host_checks--;
+    /* disable the executing flag */
+    set_is_executing(false);
+
+    /* schedule an immediate check of the host */
+    schedule_check(current_time, CHECK_OPTION_ORPHAN_CHECK);
+  } else
+    orphan_deadlines.schedule(_id, expected_time + 1);
+}
+
+/* check for hosts that never returned from a check... */
+void host::check_for_orphaned() {
+  time_t current_time = 0L;
 
-      /* disable the executing flag */
-      it->second->set_is_executing(false);
+  engine_logger(dbg_functions, basic) << "check_for_orphaned_hosts()";
+  SPDLOG_LOGGER_TRACE(functions_logger, "check_for_orphaned_hosts()");
 
-      /* schedule an immediate check of the host */
-      it->second->schedule_check(current_time, CHECK_OPTION_ORPHAN_CHECK);
+  /* get the current time */
+  time(&current_time);
+
+  uint64_t version = checkable::freshness_settings_version();
+  if (orphan_deadlines.outdated(version)) {
+    /* check all hosts... */
+    orphan_deadlines.clear();
+    for (host_map::iterator it{host::hosts.begin()}, end{host::hosts.end()};
+         it != end; ++it)
+      it->second->_check_for_orphaned(current_time);
+    orphan_deadlines.set_version(version);
+  } else {
+    /* ...or only those whose results should have come in */
+    std::vector<uint64_t> due;
+    orphan_deadlines.pop_due(current_time, &due);
+    for (uint64_t id : due) {
+      auto found = host::hosts_by_id.find(id);
+      if (found != host::hosts_by_id.end())
+        found->second->_check_for_orphaned(current_time);
     }
   }
 }
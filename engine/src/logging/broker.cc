@@ -24,6 +24,9 @@
 using namespace com::centreon;
 using namespace com::centreon::engine::logging;
 
+thread_local const nebstruct_log_record_struct* log_record_scope::_current =
+    nullptr;
+
 /**
  *  Default constructor.
  */
@@ -101,7 +104,7 @@ void engine::logging::broker::log(uint64_t types [[maybe_unused]],
       copy.get()[size] = 0;
 
       // Event broker callback.
-      broker_log_data(copy.get(), time(NULL));
+      broker_log_data(copy.get(), time(NULL), log_record_scope::current());
       _thread_id = std::thread::id();
     }
   }
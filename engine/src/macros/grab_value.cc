@@ -959,11 +959,8 @@ int grab_macro_value_r(nagios_macros* mac,
                                    arg[1] ? arg[1] : "", output, free_macro);
 
       /* post-processing */
-      /* host/service output/perfdata and author/comment macros should get
-       * cleaned */
-      if ((x >= 16 && x <= 19) || (x >= 49 && x <= 52) ||
-          (x >= 99 && x <= 100) || (x >= 124 && x <= 127)) {
-        *clean_options |= (STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS);
+      if (int options = grab_macrox_clean_options(x)) {
+        *clean_options |= options;
         engine_logger(dbg_macros, most)
             << "  New clean options: " << *clean_options;
         macros_logger->trace("  New clean options: {}", *clean_options);
@@ -1152,3 +1149,21 @@ int grab_macrox_value_r(nagios_macros* mac,
   }
   return retval;
 }
+
+/**
+ *  Get the cleaning options to apply to the value of a macro.
+ *
+ *  @param[in] macro_type Macro to get.
+ *
+ *  @return Cleaning options of the macro.
+ */
+int grab_macrox_clean_options(int macro_type) {
+  /* host/service output/perfdata and author/comment macros should get
+   * cleaned */
+  if ((macro_type >= 16 && macro_type <= 19) ||
+      (macro_type >= 49 && macro_type <= 52) ||
+      (macro_type >= 99 && macro_type <= 100) ||
+      (macro_type >= 124 && macro_type <= 127))
+    return STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
+  return 0;
+}
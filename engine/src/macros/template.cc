@@ -0,0 +1,166 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/centreon/engine/macros/template.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/macros/grab_value.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
+using namespace com::centreon::engine::macros;
+
+/**
+ *  Parse a command line, with the same rules as process_macros_r().
+ *
+ *  @param[in] source The command line.
+ */
+macro_template::macro_template(const std::string& source) : _source(source) {
+  std::string_view input(_source);
+  std::string literal;
+  for (size_t i = 0; i < input.size(); ++i) {
+    if (input[i] != '$')
+      literal.push_back(input[i]);
+    // A dollar as last character is ignored.
+    else if (i + 1 == input.size())
+      ;
+    // $$ => $ escape
+    else if (input[i + 1] == '$') {
+      literal.push_back('$');
+      ++i;
+    } else {
+      size_t pos = input.find('$', i + 1);
+      // An unterminated macro only loses its dollar.
+      if (pos != std::string_view::npos) {
+        _add_literal(literal);
+        literal.clear();
+        _add_macro(input.substr(i + 1, pos - i - 1));
+        i = pos;
+      }
+    }
+  }
+  _add_literal(literal);
+}
+
+/**
+ *  Append a literal segment to the template.
+ *
+ *  @param[in] text The literal text.
+ */
+void macro_template::_add_literal(std::string_view text) {
+  if (!text.empty())
+    _slots.push_back({slot_type::literal, 0, 0, std::string(text), {}, {}});
+}
+
+/**
+ *  Append a macro slot to the template. The lookups done here are the ones
+ *  grab_macro_value_r() does at each call.
+ *
+ *  @param[in] token The macro without its dollars.
+ */
+void macro_template::_add_macro(std::string_view token) {
+  slot s{slot_type::other, 0, 0, std::string(token), {}, {}};
+
+  // On-demand macros have one or two arguments.
+  std::string_view name = token;
+  size_t colon = token.find(':');
+  if (colon != std::string_view::npos) {
+    name = token.substr(0, colon);
+    std::string_view args = token.substr(colon + 1);
+    colon = args.find(':');
+    s.arg1 = args.substr(0, colon);
+    if (colon != std::string_view::npos)
+      s.arg2 = args.substr(colon + 1);
+  }
+
+  unsigned int x;
+  for (x = 0; x < MACRO_X_COUNT; ++x)
+    if (!macro_x_names[x].empty() && macro_x_names[x] == name)
+      break;
+
+  if (x < MACRO_X_COUNT) {
+    s.type = slot_type::macro_x;
+    s.id = x;
+    s.clean_options = grab_macrox_clean_options(x);
+  } else if (token.size() > 3 && token.substr(0, 3) == "ARG" &&
+             absl::SimpleAtoi(token.substr(3), &x) && x &&
+             x <= MAX_COMMAND_ARGUMENTS) {
+    s.type = slot_type::argv;
+    s.id = x - 1;
+  } else if (token.size() > 4 && token.substr(0, 4) == "USER" &&
+             absl::SimpleAtoi(token.substr(4), &x) && x &&
+             x <= MAX_USER_MACROS) {
+    s.type = slot_type::user;
+    s.id = x - 1;
+  }
+  // Anything else, including invalid macros, is left to
+  // grab_macro_value_r().
+  _slots.push_back(std::move(s));
+}
+
+/**
+ *  Replace the macros of the template with their values.
+ *
+ *  @param[in]  mac     Macro object.
+ *  @param[out] output  The expanded command line.
+ *  @param[in]  options Cleaning options applied to every macro.
+ */
+void macro_template::expand(nagios_macros* mac,
+                            std::string& output,
+                            int options) const {
+  output.clear();
+  std::string value;
+  for (const slot& s : _slots) {
+    int clean_options = 0;
+    int free_macro = false;
+    value.clear();
+    switch (s.type) {
+      case slot_type::literal:
+        output.append(s.text);
+        continue;
+      case slot_type::macro_x:
+        grab_macrox_value_r(mac, s.id, s.arg1, s.arg2, value, &free_macro);
+        clean_options = s.clean_options;
+        break;
+      case slot_type::argv:
+        value = mac->argv[s.id];
+        break;
+      case slot_type::user:
+        value = macro_user[s.id];
+        break;
+      case slot_type::other:
+        if (grab_macro_value_r(mac, s.text, value, &clean_options,
+                               &free_macro) == ERROR)
+          macros_logger->trace(
+              " WARNING: An error occurred processing macro '{}'!", s.text);
+        break;
+    }
+
+    if (value.empty())
+      continue;
+
+    int macro_options = options | clean_options;
+    if (macro_options & (STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS))
+      output.append(clean_macro_chars(value, macro_options));
+    else
+      output.append(value);
+  }
+  macros_logger->trace("  Expanded template '{}' to '{}'", _source, output);
+}
@@ -47,6 +47,7 @@ namespace asio = boost::asio;
 #include "com/centreon/engine/broker/loader.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/commands/connector.hh"
+#include "com/centreon/engine/commands/system_runner.hh"
 #include "com/centreon/engine/config.hh"
 #include "com/centreon/engine/configuration/applier/logging.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
@@ -213,6 +214,7 @@ int main(int argc, char* argv[]) {
 
     // Checker init
     checks::checker::init();
+    commands::system_runner::init();
 
     // Just display the license.
     if (display_license) {
@@ -23,13 +23,16 @@
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/checkable.hh"
 #include "com/centreon/engine/comment.hh"
+#include "com/centreon/engine/commands/system_runner.hh"
 #include "com/centreon/engine/downtimes/downtime.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging.hh"
+#include "com/centreon/engine/logging/broker.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
 #include "com/centreon/engine/neberrors.hh"
+#include "com/centreon/engine/nebstructs.hh"
 #include "com/centreon/engine/utils.hh"
 
 using namespace com::centreon::engine;
@@ -45,8 +48,6 @@ int obsessive_compulsive_host_check_processor(
     com::centreon::engine::host* hst) {
   std::string raw_command;
   std::string processed_command;
-  bool early_timeout = false;
-  double exectime = 0.0;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
   nagios_macros* mac(get_global_macros());
 
@@ -97,7 +98,8 @@ int obsessive_compulsive_host_check_processor(
       "Raw obsessive compulsive host processor command line: {}", raw_command);
 
   /* process any macros in the raw command line */
-  process_macros_r(mac, raw_command, processed_command, macro_options);
+  ochp_command_ptr->get_macro_template()->expand(mac, processed_command,
+                                                 macro_options);
   if (processed_command.empty()) {
     clear_volatile_macros_r(mac);
     return ERROR;
@@ -116,9 +118,22 @@ int obsessive_compulsive_host_check_processor(
                                            checkable::OBSESS_TYPE)) {
     /* run the command */
     try {
-      std::string tmp;
-      my_system_r(mac, processed_command, ochp_timeout,
-                  &early_timeout, &exectime, tmp, 0);
+      commands::system_runner::instance().run(
+          mac, processed_command, ochp_timeout,
+          [processed_command, host_name = hst->name(), ochp_timeout](
+              int, bool early_timeout, double, const std::string&) {
+            /* check to see if the command timed out */
+            if (early_timeout) {
+              engine_logger(log_runtime_warning, basic)
+                  << "Warning: OCHP command '" << processed_command
+                  << "' for host '" << host_name << "' timed out after "
+                  << ochp_timeout << " seconds";
+              runtime_logger->warn(
+                  "Warning: OCHP command '{}' for host '{}' timed out after {} "
+                  "seconds",
+                  processed_command, host_name, ochp_timeout);
+            }
+          });
     } catch (std::exception const& e) {
       engine_logger(log_runtime_error, basic)
           << "Error: can't execute compulsive host processor command line '"
@@ -136,16 +151,6 @@ int obsessive_compulsive_host_check_processor(
   }
   clear_volatile_macros_r(mac);
 
-  /* check to see if the command timed out */
-  if (early_timeout)
-    engine_logger(log_runtime_warning, basic)
-        << "Warning: OCHP command '" << processed_command << "' for host '"
-        << hst->name() << "' timed out after " << ochp_timeout
-        << " seconds";
-  runtime_logger->warn(
-      "Warning: OCHP command '{}' for host '{}' timed out after {} seconds",
-      processed_command, hst->name(), ochp_timeout);
-
   return OK;
 }
 
@@ -159,9 +164,6 @@ int run_global_service_event_handler(nagios_macros* mac,
   std::string raw_command;
   std::string processed_command;
   std::string processed_logentry;
-  std::string command_output;
-  bool early_timeout = false;
-  double exectime = 0.0;
   struct timeval start_time;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
 
@@ -217,7 +219,8 @@ int run_global_service_event_handler(nagios_macros* mac,
                        raw_command);
 
   /* process any macros in the raw command line */
-  process_macros_r(mac, raw_command, processed_command, macro_options);
+  global_service_event_handler_ptr->get_macro_template()->expand(
+      mac, processed_command, macro_options);
   if (processed_command.empty())
     return ERROR;
 
@@ -236,6 +239,24 @@ int run_global_service_event_handler(nagios_macros* mac,
         << ";$SERVICESTATE$;$SERVICESTATETYPE$;$SERVICEATTEMPT$;"
         << global_service_event_handler;
     process_macros_r(mac, oss.str(), processed_logentry, macro_options);
+    /* The log output is the handler as in the log line, not the command
+     * line that may contain resource macros. */
+    std::string processed_handler;
+    process_macros_r(mac, global_service_event_handler, processed_handler,
+                     macro_options);
+    nebstruct_log_record record{
+        .type = NEBLOG_GLOBAL_SERVICE_EVENT_HANDLER,
+        .host_id = svc->host_id(),
+        .service_id = svc->service_id(),
+        .host_name = svc->get_hostname().c_str(),
+        .service_description = svc->description().c_str(),
+        .state = svc->get_current_state(),
+        .state_type = svc->get_state_type(),
+        .attempt = svc->get_current_attempt(),
+        .contact = nullptr,
+        .command = nullptr,
+        .output = processed_handler.c_str()};
+    log_record_scope record_scope(record);
     engine_logger(log_event_handler, basic) << processed_logentry;
     events_logger->debug(processed_logentry);
   }
@@ -246,8 +267,22 @@ int run_global_service_event_handler(nagios_macros* mac,
                                                  cached_cmd)) {
     /* run the command */
     try {
-      my_system_r(mac, processed_command, event_handler_timeout,
-                  &early_timeout, &exectime, command_output, 0);
+      commands::system_runner::instance().run(
+          mac, processed_command, event_handler_timeout,
+          [processed_command, event_handler_timeout](
+              int, bool early_timeout, double, const std::string&) {
+            /* check to see if the event handler timed out */
+            if (early_timeout) {
+              engine_logger(log_event_handler | log_runtime_warning, basic)
+                  << "Warning: Global service event handler command '"
+                  << processed_command << "' timed out after "
+                  << event_handler_timeout << " seconds";
+              events_logger->info(
+                  "Warning: Global service event handler command '{}' timed "
+                  "out after {} seconds",
+                  processed_command, event_handler_timeout);
+            }
+          });
     } catch (std::exception const& e) {
       engine_logger(log_runtime_error, basic)
           << "Error: can't execute global service event handler "
@@ -264,18 +299,6 @@ int run_global_service_event_handler(nagios_macros* mac,
         "command line '{}' : it is not allowed by the whitelist",
         processed_command);
   }
-
-  /* check to see if the event handler timed out */
-  if (early_timeout) {
-    engine_logger(log_event_handler | log_runtime_warning, basic)
-        << "Warning: Global service event handler command '"
-        << processed_command << "' timed out after "
-        << event_handler_timeout << " seconds";
-    events_logger->info(
-        "Warning: Global service event handler command '{}' timed out after {} "
-        "seconds",
-        processed_command, event_handler_timeout);
-  }
   return OK;
 }
 
@@ -285,9 +308,6 @@ int run_service_event_handler(nagios_macros* mac,
   std::string raw_command;
   std::string processed_command;
   std::string processed_logentry;
-  std::string command_output;
-  bool early_timeout = false;
-  double exectime = 0.0;
   struct timeval start_time;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
 
@@ -333,7 +353,8 @@ int run_service_event_handler(nagios_macros* mac,
                        raw_command);
 
   /* process any macros in the raw command line */
-  process_macros_r(mac, raw_command, processed_command, macro_options);
+  svc->get_event_handler_ptr()->get_macro_template()->expand(
+      mac, processed_command, macro_options);
   if (processed_command.empty())
     return ERROR;
 
@@ -349,6 +370,22 @@ int run_service_event_handler(nagios_macros* mac,
         << ";$SERVICESTATE$;$SERVICESTATETYPE$;$SERVICEATTEMPT$;"
         << svc->event_handler();
     process_macros_r(mac, oss.str(), processed_logentry, macro_options);
+    std::string processed_handler;
+    process_macros_r(mac, svc->event_handler(), processed_handler,
+                     macro_options);
+    nebstruct_log_record record{
+        .type = NEBLOG_SERVICE_EVENT_HANDLER,
+        .host_id = svc->host_id(),
+        .service_id = svc->service_id(),
+        .host_name = svc->get_hostname().c_str(),
+        .service_description = svc->description().c_str(),
+        .state = svc->get_current_state(),
+        .state_type = svc->get_state_type(),
+        .attempt = svc->get_current_attempt(),
+        .contact = nullptr,
+        .command = nullptr,
+        .output = processed_handler.c_str()};
+    log_record_scope record_scope(record);
     engine_logger(log_event_handler, basic) << processed_logentry;
     events_logger->info(processed_logentry);
   }
@@ -357,8 +394,22 @@ int run_service_event_handler(nagios_macros* mac,
                                            checkable::EVH_TYPE)) {
     /* run the command */
     try {
-      my_system_r(mac, processed_command, event_handler_timeout,
-                  &early_timeout, &exectime, command_output, 0);
+      commands::system_runner::instance().run(
+          mac, processed_command, event_handler_timeout,
+          [processed_command, event_handler_timeout](
+              int, bool early_timeout, double, const std::string&) {
+            /* check to see if the event handler timed out */
+            if (early_timeout) {
+              engine_logger(log_event_handler | log_runtime_warning, basic)
+                  << "Warning: Service event handler command '"
+                  << processed_command << "' timed out after "
+                  << event_handler_timeout << " seconds";
+              events_logger->info(
+                  "Warning: Service event handler command '{}' timed out "
+                  "after {} seconds",
+                  processed_command, event_handler_timeout);
+            }
+          });
     } catch (std::exception const& e) {
       engine_logger(log_runtime_error, basic)
           << "Error: can't execute service event handler command line '"
@@ -373,18 +424,6 @@ int run_service_event_handler(nagios_macros* mac,
         "not allowed by the whitelist",
         processed_command);
   }
-
-  /* check to see if the event handler timed out */
-  if (early_timeout) {
-    engine_logger(log_event_handler | log_runtime_warning, basic)
-        << "Warning: Service event handler command '" << processed_command
-        << "' timed out after " << event_handler_timeout
-        << " seconds";
-    events_logger->info(
-        "Warning: Service event handler command '{}' timed out after {} "
-        "seconds",
-        processed_command, event_handler_timeout);
-  }
   return OK;
 }
 
@@ -447,9 +486,6 @@ int run_global_host_event_handler(nagios_macros* mac,
   std::string raw_command;
   std::string processed_command;
   std::string processed_logentry;
-  std::string command_output;
-  bool early_timeout = false;
-  double exectime = 0.0;
   struct timeval start_time;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
 
@@ -503,7 +539,8 @@ int run_global_host_event_handler(nagios_macros* mac,
                        raw_command);
 
   /* process any macros in the raw command line */
-  process_macros_r(mac, raw_command, processed_command, macro_options);
+  global_host_event_handler_ptr->get_macro_template()->expand(
+      mac, processed_command, macro_options);
   if (processed_command.empty())
     return ERROR;
 
@@ -520,6 +557,22 @@ int run_global_host_event_handler(nagios_macros* mac,
         << "$HOSTSTATE$;$HOSTSTATETYPE$;$HOSTATTEMPT$;"
         << global_host_event_handler;
     process_macros_r(mac, oss.str(), processed_logentry, macro_options);
+    std::string processed_handler;
+    process_macros_r(mac, global_host_event_handler, processed_handler,
+                     macro_options);
+    nebstruct_log_record record{
+        .type = NEBLOG_GLOBAL_HOST_EVENT_HANDLER,
+        .host_id = hst->host_id(),
+        .service_id = 0,
+        .host_name = hst->name().c_str(),
+        .service_description = nullptr,
+        .state = hst->get_current_state(),
+        .state_type = hst->get_state_type(),
+        .attempt = hst->get_current_attempt(),
+        .contact = nullptr,
+        .command = nullptr,
+        .output = processed_handler.c_str()};
+    log_record_scope record_scope(record);
     engine_logger(log_event_handler, basic) << processed_logentry;
     events_logger->info(processed_logentry);
   }
@@ -529,8 +582,23 @@ int run_global_host_event_handler(nagios_macros* mac,
   if (host::command_is_allowed_by_whitelist(processed_command, cached_cmd)) {
     /* run the command */
     try {
-      my_system_r(mac, processed_command, event_handler_timeout,
-                  &early_timeout, &exectime, command_output, 0);
+      commands::system_runner::instance().run(
+          mac, processed_command, event_handler_timeout,
+          [processed_command, event_handler_timeout](
+              int, bool early_timeout, double, const std::string&) {
+            /* check for a timeout in the execution of the event handler
+             * command */
+            if (early_timeout) {
+              engine_logger(log_event_handler | log_runtime_warning, basic)
+                  << "Warning: Global host event handler command '"
+                  << processed_command << "' timed out after "
+                  << event_handler_timeout << " seconds";
+              events_logger->info(
+                  "Warning: Global host event handler command '{}' timed out "
+                  "after {} seconds",
+                  processed_command, event_handler_timeout);
+            }
+          });
     } catch (std::exception const& e) {
       engine_logger(log_runtime_error, basic)
           << "Error: can't execute global host event handler command line '"
@@ -547,18 +615,6 @@ int run_global_host_event_handler(nagios_macros* mac,
         processed_command);
   }
 
-  /* check for a timeout in the execution of the event handler command */
-  if (early_timeout) {
-    engine_logger(log_event_handler | log_runtime_warning, basic)
-        << "Warning: Global host event handler command '" << processed_command
-        << "' timed out after " << event_handler_timeout
-        << " seconds";
-    events_logger->info(
-        "Warning: Global host event handler command '{}' timed out after {} "
-        "seconds",
-        processed_command, event_handler_timeout);
-  }
-
   return OK;
 }
 
@@ -568,9 +624,6 @@ int run_host_event_handler(nagios_macros* mac,
   std::string raw_command;
   std::string processed_command;
   std::string processed_logentry;
-  std::string command_output;
-  bool early_timeout = false;
-  double exectime = 0.0;
   struct timeval start_time;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
 
@@ -613,7 +666,8 @@ int run_host_event_handler(nagios_macros* mac,
   events_logger->debug("Raw host event handler command line: {}", raw_command);
 
   /* process any macros in the raw command line */
-  process_macros_r(mac, raw_command, processed_command, macro_options);
+  hst->get_event_handler_ptr()->get_macro_template()->expand(
+      mac, processed_command, macro_options);
   if (processed_command.empty())
     return ERROR;
 
@@ -628,6 +682,22 @@ int run_host_event_handler(nagios_macros* mac,
         << ";$HOSTSTATE$;$HOSTSTATETYPE$;$HOSTATTEMPT$;"
         << hst->event_handler();
     process_macros_r(mac, oss.str(), processed_logentry, macro_options);
+    std::string processed_handler;
+    process_macros_r(mac, hst->event_handler(), processed_handler,
+                     macro_options);
+    nebstruct_log_record record{
+        .type = NEBLOG_HOST_EVENT_HANDLER,
+        .host_id = hst->host_id(),
+        .service_id = 0,
+        .host_name = hst->name().c_str(),
+        .service_description = nullptr,
+        .state = hst->get_current_state(),
+        .state_type = hst->get_state_type(),
+        .attempt = hst->get_current_attempt(),
+        .contact = nullptr,
+        .command = nullptr,
+        .output = processed_handler.c_str()};
+    log_record_scope record_scope(record);
     engine_logger(log_event_handler, basic) << processed_logentry;
     events_logger->info(processed_logentry);
   }
@@ -636,8 +706,22 @@ int run_host_event_handler(nagios_macros* mac,
                                            checkable::EVH_TYPE)) {
     /* run the command */
     try {
-      my_system_r(mac, processed_command, event_handler_timeout,
-                  &early_timeout, &exectime, command_output, 0);
+      commands::system_runner::instance().run(
+          mac, processed_command, event_handler_timeout,
+          [processed_command, event_handler_timeout](
+              int, bool early_timeout, double, const std::string&) {
+            /* check to see if the event handler timed out */
+            if (early_timeout) {
+              engine_logger(log_event_handler | log_runtime_warning, basic)
+                  << "Warning: Host event handler command '"
+                  << processed_command << "' timed out after "
+                  << event_handler_timeout << " seconds";
+              events_logger->info(
+                  "Warning: Host event handler command '{}' timed out after "
+                  "{} seconds",
+                  processed_command, event_handler_timeout);
+            }
+          });
     } catch (std::exception const& e) {
       engine_logger(log_runtime_error, basic)
           << "Error: can't execute host event handler command line '"
@@ -652,16 +736,5 @@ int run_host_event_handler(nagios_macros* mac,
         "allowed by the whitelist",
         processed_command);
   }
-
-  /* check to see if the event handler timed out */
-  if (early_timeout) {
-    engine_logger(log_event_handler | log_runtime_warning, basic)
-        << "Warning: Host event handler command '" << processed_command
-        << "' timed out after " << event_handler_timeout
-        << " seconds";
-    events_logger->info(
-        "Warning: Host event handler command '{}' timed out after {} seconds",
-        processed_command, event_handler_timeout);
-  }
   return OK;
 }
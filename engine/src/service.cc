@@ -24,6 +24,7 @@
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/checkable.hh"
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/commands/system_runner.hh"
 #include "com/centreon/engine/configuration/whitelist.hh"
 #include "com/centreon/engine/deleter/listmember.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
@@ -33,10 +34,12 @@
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/hostdependency.hh"
 #include "com/centreon/engine/logging.hh"
+#include "com/centreon/engine/logging/broker.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
 #include "com/centreon/engine/macros/grab_host.hh"
 #include "com/centreon/engine/neberrors.hh"
+#include "com/centreon/engine/nebstructs.hh"
 #include "com/centreon/engine/notification.hh"
 #include "com/centreon/engine/objects.hh"
 #include "com/centreon/engine/sehandlers.hh"
@@ -57,6 +60,8 @@ std::array<std::pair<uint32_t, std::string>, 4> const
 
 service_map service::services;
 service_id_map service::services_by_id;
+service_deadline_index service::freshness_deadlines;
+service_deadline_index service::orphan_deadlines;
 
 service::service(const std::string& hostname,
                  const std::string& description,
@@ -1196,8 +1201,10 @@ int service::handle_async_check_result(
     set_is_being_freshened(false);
 
   /* clear the execution flag if this was an active check */
-  if (queued_check_result.get_check_type() == check_active)
+  if (queued_check_result.get_check_type() == check_active) {
     set_is_executing(false);
+    orphan_deadlines.remove({_host_id, _service_id});
+  }
 
   /* DISCARD INVALID FRESHNESS CHECK RESULTS */
   /* If a services goes stale, Engine will initiate a forced check in
@@ -1218,6 +1225,7 @@ int service::handle_async_check_result(
         checks_logger,
         "Discarding service freshness check result because the service "
         "is currently fresh (race condition avoided).");
+    update_freshness_deadline();
     return OK;
   }
 
@@ -1228,6 +1236,7 @@ int service::handle_async_check_result(
 
   /* get the last check time */
   set_last_check(queued_check_result.get_start_time().tv_sec);
+  update_freshness_deadline();
 
   /* was this check passive or active? */
   set_check_type(queued_check_result.get_check_type());
@@ -2130,6 +2139,18 @@ int service::log_event() {
   }
   const std::string& state_type{tab_state_type[get_state_type()]};
 
+  nebstruct_log_record record{.type = NEBLOG_SERVICE_ALERT,
+                              .host_id = host_id(),
+                              .service_id = service_id(),
+                              .host_name = _hostname.c_str(),
+                              .service_description = name().c_str(),
+                              .state = _current_state,
+                              .state_type = get_state_type(),
+                              .attempt = get_current_attempt(),
+                              .contact = nullptr,
+                              .command = nullptr,
+                              .output = get_plugin_output().c_str()};
+  log_record_scope record_scope(record);
   engine_logger(log_options, basic)
       << "SERVICE ALERT: " << _hostname << ";" << name() << ";" << state << ";"
       << state_type << ";" << get_current_attempt() << ";"
@@ -2350,8 +2371,6 @@ int service::obsessive_compulsive_service_check_processor() {
   std::string raw_command;
   std::string processed_command;
   host* temp_host{get_host_ptr()};
-  bool early_timeout = false;
-  double exectime = 0.0;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
   nagios_macros* mac(get_global_macros());
 
@@ -2408,7 +2427,8 @@ int service::obsessive_compulsive_service_check_processor() {
                       raw_command);
 
   /* process any macros in the raw command line */
-  process_macros_r(mac, raw_command, processed_command, macro_options);
+  ocsp_command_ptr->get_macro_template()->expand(mac, processed_command,
+                                                 macro_options);
   if (processed_command.empty()) {
     clear_volatile_macros_r(mac);
     return ERROR;
@@ -2425,9 +2445,24 @@ int service::obsessive_compulsive_service_check_processor() {
   if (command_is_allowed_by_whitelist(processed_command, OBSESS_TYPE)) {
     /* run the command */
     try {
-      std::string tmp;
-      my_system_r(mac, processed_command, ocsp_timeout, &early_timeout,
-                  &exectime, tmp, 0);
+      commands::system_runner::instance().run(
+          mac, processed_command, ocsp_timeout,
+          [processed_command, description = name(), host_name = _hostname,
+           ocsp_timeout](int, bool early_timeout, double, const std::string&) {
+            /* check to see if the command timed out */
+            if (early_timeout) {
+              engine_logger(log_runtime_warning, basic)
+                  << "Warning: OCSP command '" << processed_command
+                  << "' for service '" << description << "' on host '"
+                  << host_name << "' timed out after " << ocsp_timeout
+                  << " seconds";
+              SPDLOG_LOGGER_WARN(
+                  runtime_logger,
+                  "Warning: OCSP command '{}' for service '{}' on host '{}' "
+                  "timed out after {} seconds",
+                  processed_command, description, host_name, ocsp_timeout);
+            }
+          });
     } catch (std::exception const& e) {
       engine_logger(log_runtime_error, basic)
           << "Error: can't execute compulsive service processor command line '"
@@ -2447,18 +2482,6 @@ int service::obsessive_compulsive_service_check_processor() {
 
   clear_volatile_macros_r(mac);
 
-  /* check to see if the command timed out */
-  if (early_timeout)
-    engine_logger(log_runtime_warning, basic)
-        << "Warning: OCSP command '" << processed_command << "' for service '"
-        << name() << "' on host '" << _hostname << "' timed out after "
-        << ocsp_timeout << " seconds";
-  SPDLOG_LOGGER_WARN(
-      runtime_logger,
-      "Warning: OCSP command '{}' for service '{}' on host '{}' timed out "
-      "after {} seconds",
-      processed_command, name(), _hostname, ocsp_timeout);
-
   return OK;
 }
 
@@ -2736,6 +2759,8 @@ int service::run_async_check_local(int check_options,
 
   // Set the execution flag.
   set_is_executing(true);
+  orphan_deadlines.schedule({_host_id, _service_id},
+                            _orphan_expected_time() + 1);
 
   // Send event broker.
   res = broker_service_check(NEBTYPE_SERVICECHECK_INITIATE, this,
@@ -3288,8 +3313,6 @@ int service::notify_contact(nagios_macros* mac,
                             int escalated) {
   std::string raw_command;
   std::string processed_command;
-  bool early_timeout = false;
-  double exectime;
   struct timeval start_time, end_time;
   struct timeval method_start_time, method_end_time;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
@@ -3346,7 +3369,7 @@ int service::notify_contact(nagios_macros* mac,
     notifications_logger->debug("Raw notification command: {}", raw_command);
 
     /* process any macros contained in the argument */
-    process_macros_r(mac, raw_command, processed_command, macro_options);
+    cmd->get_macro_template()->expand(mac, processed_command, macro_options);
     if (processed_command.empty())
       continue;
 
@@ -3387,6 +3410,19 @@ int service::notify_contact(nagios_macros* mac,
             .append(service_state_str)
             .append(")");
 
+      nebstruct_log_record record{
+          .type = NEBLOG_SERVICE_NOTIFICATION,
+          .host_id = host_id(),
+          .service_id = service_id(),
+          .host_name = get_hostname().c_str(),
+          .service_description = description().c_str(),
+          .state = _current_state,
+          .state_type = get_state_type(),
+          .attempt = get_current_attempt(),
+          .contact = cntct->get_name().c_str(),
+          .command = cmd->get_name().c_str(),
+          .output = get_plugin_output().c_str()};
+      log_record_scope record_scope(record);
       engine_logger(log_service_notification, basic)
           << "SERVICE NOTIFICATION: " << cntct->get_name() << ';'
           << get_hostname() << ';' << description() << ';'
@@ -3398,7 +3434,9 @@ int service::notify_contact(nagios_macros* mac,
                                  cmd->get_name(), get_plugin_output(), info);
     }
 
-    /* run the notification command */
+    /* run the notification command, the end of the method is sent to the
+     * broker once the command is over */
+    bool method_pending = false;
     if (command_is_allowed_by_whitelist(processed_command, NOTIF_TYPE)) {
 #ifdef LEGACY_CONF
       uint32_t notification_timeout = config->notification_timeout();
@@ -3406,9 +3444,48 @@ int service::notify_contact(nagios_macros* mac,
       uint32_t notification_timeout = pb_config.notification_timeout();
 #endif
       try {
-        std::string tmp;
-        my_system_r(mac, processed_command, notification_timeout,
-                    &early_timeout, &exectime, tmp, 0);
+        commands::system_runner::instance().run(
+            mac, processed_command, notification_timeout,
+            [processed_command, notification_timeout, type, escalated,
+             method_start_time, not_author, not_data,
+             host_name = get_hostname(), svc_description = description(),
+             contact_name = cntct->get_name()](
+                int, bool early_timeout, double, const std::string&) {
+              /* check to see if the notification command timed out */
+              if (early_timeout) {
+                engine_logger(log_service_notification | log_runtime_warning,
+                              basic)
+                    << "Warning: Contact '" << contact_name
+                    << "' service notification command '" << processed_command
+                    << "' timed out after " << notification_timeout
+                    << " seconds";
+                notifications_logger->info(
+                    "Warning: Contact '{}' service notification command '{}' "
+                    "timed out after {} seconds",
+                    contact_name, processed_command, notification_timeout);
+              }
+
+              /* service or contact may have been removed by a reload */
+              service_map::const_iterator svc =
+                  service::services.find({host_name, svc_description});
+              contact_map::const_iterator ct =
+                  contact::contacts.find(contact_name);
+              if (svc == service::services.end() ||
+                  ct == contact::contacts.end())
+                return;
+
+              /* get end time */
+              struct timeval method_end_time;
+              gettimeofday(&method_end_time, nullptr);
+
+              /* send data to event broker */
+              broker_contact_notification_method_data(
+                  NEBTYPE_CONTACTNOTIFICATIONMETHOD_END, NEBFLAG_NONE,
+                  NEBATTR_NONE, service_notification, type, method_start_time,
+                  method_end_time, (void*)svc->second.get(), ct->second.get(),
+                  not_author.c_str(), not_data.c_str(), escalated, nullptr);
+            });
+        method_pending = true;
       } catch (std::exception const& e) {
         engine_logger(log_runtime_error, basic)
             << "Error: can't execute service notification for contact '"
@@ -3425,27 +3502,17 @@ int service::notify_contact(nagios_macros* mac,
                           cntct->get_name());
     }
 
-    /* check to see if the notification command timed out */
-    if (early_timeout) {
-      engine_logger(log_service_notification | log_runtime_warning, basic)
-          << "Warning: Contact '" << cntct->get_name()
-          << "' service notification command '" << processed_command
-          << "' timed out after " << notification_timeout << " seconds";
-      notifications_logger->info(
-          "Warning: Contact '{}' service notification command '{}' timed out "
-          "after {} seconds",
-          cntct->get_name(), processed_command, notification_timeout);
-    }
-
-    /* get end time */
-    gettimeofday(&method_end_time, nullptr);
+    if (!method_pending) {
+      /* get end time */
+      gettimeofday(&method_end_time, nullptr);
 
-    /* send data to event broker */
-    broker_contact_notification_method_data(
-        NEBTYPE_CONTACTNOTIFICATIONMETHOD_END, NEBFLAG_NONE, NEBATTR_NONE,
-        service_notification, type, method_start_time, method_end_time,
-        (void*)this, cntct, not_author.c_str(), not_data.c_str(), escalated,
-        nullptr);
+      /* send data to event broker */
+      broker_contact_notification_method_data(
+          NEBTYPE_CONTACTNOTIFICATIONMETHOD_END, NEBFLAG_NONE, NEBATTR_NONE,
+          service_notification, type, method_start_time, method_end_time,
+          (void*)this, cntct, not_author.c_str(), not_data.c_str(), escalated,
+          nullptr);
+    }
   }
 
   /* get end time */
@@ -3540,8 +3607,19 @@ bool service::is_valid_escalation_for_notification(escalation const* e,
   return true;
 }
 
-/* tests whether or not a service's check results are fresh */
-bool service::is_result_fresh(time_t current_time, int log_this) {
+/**
+ * @brief Tests whether or not a service's check results are fresh.
+ *
+ * @param current_time The current time.
+ * @param log_this Should a warning be logged if results are stale.
+ * @param expiration_time_out If not null, filled with the time after which the
+ * results are stale.
+ *
+ * @return true if results are fresh.
+ */
+bool service::is_result_fresh(time_t current_time,
+                              int log_this,
+                              time_t* expiration_time_out) {
   int freshness_threshold;
   time_t expiration_time = 0L;
   int days = 0;
@@ -3625,6 +3703,9 @@ bool service::is_result_fresh(time_t current_time, int log_this) {
                       this->has_been_checked(), program_start, event_start,
                       get_last_check(), current_time, expiration_time);
 
+  if (expiration_time_out)
+    *expiration_time_out = expiration_time;
+
   /* the results for the last check of this service are stale */
   if (expiration_time < current_time) {
     get_time_breakdown((current_time - expiration_time), &days, &hours,
@@ -3801,17 +3882,41 @@ bool service::authorized_by_dependencies(
   return true;
 }
 
-/* check for services that never returned from a check... */
-void service::check_for_orphaned() {
-  time_t current_time{0L};
-  time_t expected_time{0L};
-
-  engine_logger(dbg_functions, basic) << "check_for_orphaned_services()";
-  SPDLOG_LOGGER_TRACE(functions_logger, "check_for_orphaned_services()");
+/**
+ * @brief Index the service so that the freshness check examines it again when
+ * its results may have become stale. This is called when a check result
+ * arrives, the state of the service is not yet updated at this time, so the
+ * deadline is computed with the shortest possible threshold. The exact one is
+ * computed when this deadline is reached.
+ */
+void service::update_freshness_deadline() {
+  uint32_t interval_length;
+  int32_t additional_freshness_latency;
+#ifdef LEGACY_CONF
+  interval_length = config->interval_length();
+  additional_freshness_latency = config->additional_freshness_latency();
+#else
+  interval_length = pb_config.interval_length();
+  additional_freshness_latency = pb_config.additional_freshness_latency();
+#endif
 
-  /* get the current time */
-  time(&current_time);
+  int freshness_threshold = get_freshness_threshold();
+  if (freshness_threshold == 0)
+    freshness_threshold = static_cast<int>(
+        std::min<double>(check_interval(), retry_interval()) *
+            interval_length +
+        additional_freshness_latency);
+  freshness_deadlines.schedule({_host_id, _service_id},
+                               get_last_check() + freshness_threshold + 1);
+}
 
+/**
+ * @brief Determine the time at which the results of the running check should
+ * have come in (allow 10 minutes slack time).
+ *
+ * @return A timestamp.
+ */
+time_t service::_orphan_expected_time() const {
   uint32_t service_check_timeout;
   uint32_t check_reaper_interval;
 #ifdef LEGACY_CONF
@@ -3821,60 +3926,159 @@ void service::check_for_orphaned() {
   service_check_timeout = pb_config.service_check_timeout();
   check_reaper_interval = pb_config.check_reaper_interval();
 #endif
-  /* check all services... */
-  for (service_map::iterator it(service::services.begin()),
-       end(service::services.end());
-       it != end; ++it) {
-    /* skip services that are not currently executing */
-    if (!it->second->get_is_executing())
-      continue;
+  return (time_t)(get_next_check() + get_latency() + service_check_timeout +
+                  check_reaper_interval + 600);
+}
 
-    /* determine the time at which the check results should have come in (allow
-     * 10 minutes slack time) */
-    expected_time =
-        (time_t)(it->second->get_next_check() + it->second->get_latency() +
-                 service_check_timeout + check_reaper_interval + 600);
+/**
+ * @brief Check if the running check of this service is orphaned. If it is
+ * still running and not yet orphaned, the service is indexed again at the
+ * time it will be.
+ *
+ * @param current_time The current time.
+ */
+void service::_check_for_orphaned(time_t current_time) {
+  /* skip services that are not currently executing */
+  if (!get_is_executing())
+    return;
 
-    /* this service was supposed to have executed a while ago, but for some
-     * reason the results haven't come back in... */
-    if (expected_time < current_time) {
-      /* log a warning */
-      engine_logger(log_runtime_warning, basic)
-          << "Warning: The check of service '" << it->first.second
-          << "' on host '" << it->first.first
-          << "' looks like it was orphaned "
-             "(results never came back).  I'm scheduling an immediate check "
-             "of the service...";
-      SPDLOG_LOGGER_WARN(
-          runtime_logger,
-          "Warning: The check of service '{}' on host '{}' looks like it was "
-          "orphaned "
-          "(results never came back).  I'm scheduling an immediate check "
-          "of the service...",
-          it->first.second, it->first.first);
+  time_t expected_time = _orphan_expected_time();
 
-      engine_logger(dbg_checks, more)
-          << "Service '" << it->first.second << "' on host '" << it->first.first
-          << "' was orphaned, so we're scheduling an immediate check...";
-      SPDLOG_LOGGER_DEBUG(
-          checks_logger,
-          "Service '{}' on host '{}' was orphaned, so we're scheduling an "
-          "immediate check...",
-          it->first.second, it->first.first);
+  /* this service was supposed to have executed a while ago, but for some
+   * reason the results haven't come back in... */
+  if (expected_time < current_time) {
+    /* log a warning */
+    engine_logger(log_runtime_warning, basic)
+        << "Warning: The check of service '" << description() << "' on host '"
+        << get_hostname()
+        << "' looks like it was orphaned "
+           "(results never came back).  I'm scheduling an immediate check "
+           "of the service...";
+    SPDLOG_LOGGER_WARN(
+        runtime_logger,
+        "Warning: The check of service '{}' on host '{}' looks like it was "
+        "orphaned "
+        "(results never came back).  I'm scheduling an immediate check "
+        "of the service...",
+        description(), get_hostname());
 
-      /* decrement the number of running service checks */
-      if (currently_running_service_checks > 0)
-        currently_running_service_checks--;
+    engine_logger(dbg_checks, more)
+        << "Service '" << description() << "' on host '" << get_hostname()
+        << "' was orphaned, so we're scheduling an immediate check...";
+    SPDLOG_LOGGER_DEBUG(
+        checks_logger,
+        "Service '{}' on host '{}' was orphaned, so we're scheduling an "
+        "immediate check...",
+        description(), get_hostname());
+
+    /* decrement the number of running service checks */
+    if (currently_running_service_checks > 0)
+      currently_running_service_checks--;
+
+    /* disable the executing flag */
+    set_is_executing(false);
 
-      /* disable the executing flag */
-      it->second->set_is_executing(false);
+    /* schedule an immediate check of the service */
+    schedule_check(current_time, CHECK_OPTION_ORPHAN_CHECK);
+  } else
+    orphan_deadlines.schedule({_host_id, _service_id}, expected_time + 1);
+}
 
-      /* schedule an immediate check of the service */
-      it->second->schedule_check(current_time, CHECK_OPTION_ORPHAN_CHECK);
+/* check for services that never returned from a check... */
+void service::check_for_orphaned() {
+  time_t current_time{0L};
+
+  engine_logger(dbg_functions, basic) << "check_for_orphaned_services()";
+  SPDLOG_LOGGER_TRACE(functions_logger, "check_for_orphaned_services()");
+
+  /* get the current time */
+  time(&current_time);
+
+  uint64_t version = checkable::freshness_settings_version();
+  if (orphan_deadlines.outdated(version)) {
+    /* check all services... */
+    orphan_deadlines.clear();
+    for (service_map::iterator it(service::services.begin()),
+         end(service::services.end());
+         it != end; ++it)
+      it->second->_check_for_orphaned(current_time);
+    orphan_deadlines.set_version(version);
+  } else {
+    /* ...or only those whose results should have come in */
+    std::vector<std::pair<uint64_t, uint64_t>> due;
+    orphan_deadlines.pop_due(current_time, &due);
+    for (auto& id : due) {
+      auto found = service::services_by_id.find(id);
+      if (found != service::services_by_id.end())
+        found->second->_check_for_orphaned(current_time);
     }
   }
 }
 
+/**
+ * @brief Check the freshness of this service results and force a check if
+ * they are stale. If they are fresh, the service is indexed again at the time
+ * they will be stale. Services whose check is running or being freshened are
+ * examined again at the next pass. Services that cannot be checked for
+ * freshness are not indexed again, a check result or a change of their
+ * settings will do it.
+ *
+ * @param current_time The current time.
+ */
+void service::_check_result_freshness(time_t current_time) {
+  /* skip services we shouldn't be checking for freshness */
+  if (!check_freshness_enabled())
+    return;
+
+  /* skip services that are currently executing (problems here will be caught
+   * by orphaned service check), they are examined again at the next pass */
+  if (get_is_executing()) {
+    freshness_deadlines.schedule({_host_id, _service_id}, current_time + 1);
+    return;
+  }
+
+  /* skip services that have both active and passive checks disabled */
+  if (!active_checks_enabled() && !passive_checks_enabled())
+    return;
+
+  /* skip services that are already being freshened */
+  if (get_is_being_freshened()) {
+    freshness_deadlines.schedule({_host_id, _service_id}, current_time + 1);
+    return;
+  }
+
+  // See if the time is right...
+  {
+    timezone_locker lock(get_timezone());
+    if (!check_time_against_period(current_time, check_period_ptr)) {
+      time_t next_valid_time;
+      get_next_valid_time(current_time, &next_valid_time, check_period_ptr);
+      freshness_deadlines.schedule(
+          {_host_id, _service_id},
+          std::max(next_valid_time, current_time + 1));
+      return;
+    }
+  }
+
+  /* EXCEPTION */
+  /* don't check freshness of services without regular check intervals if
+   * we're using auto-freshness threshold */
+  if (check_interval() == 0 && get_freshness_threshold() == 0)
+    return;
+
+  /* the results for the last check of this service are stale! */
+  time_t expiration_time;
+  if (!is_result_fresh(current_time, true, &expiration_time)) {
+    /* set the freshen flag */
+    set_is_being_freshened(true);
+
+    /* schedule an immediate forced check of the service */
+    schedule_check(current_time,
+                   CHECK_OPTION_FORCE_EXECUTION | CHECK_OPTION_FRESHNESS_CHECK);
+  } else
+    freshness_deadlines.schedule({_host_id, _service_id}, expiration_time + 1);
+}
+
 /* check freshness of service results */
 void service::check_result_freshness() {
   time_t current_time{0L};
@@ -3903,52 +4107,23 @@ void service::check_result_freshness() {
   /* get the current time */
   time(&current_time);
 
-  /* check all services... */
-  for (service_map::iterator it(service::services.begin()),
-       end(service::services.end());
-       it != end; ++it) {
-    /* skip services we shouldn't be checking for freshness */
-    if (!it->second->check_freshness_enabled())
-      continue;
-
-    /* skip services that are currently executing (problems here will be caught
-     * by orphaned service check) */
-    if (it->second->get_is_executing())
-      continue;
-
-    /* skip services that have both active and passive checks disabled */
-    if (!it->second->active_checks_enabled() &&
-        !it->second->passive_checks_enabled())
-      continue;
-
-    /* skip services that are already being freshened */
-    if (it->second->get_is_being_freshened())
-      continue;
-
-    // See if the time is right...
-    {
-      timezone_locker lock(it->second->get_timezone());
-      if (!check_time_against_period(current_time,
-                                     it->second->check_period_ptr))
-        continue;
-    }
-
-    /* EXCEPTION */
-    /* don't check freshness of services without regular check intervals if
-     * we're using auto-freshness threshold */
-    if (it->second->check_interval() == 0 &&
-        it->second->get_freshness_threshold() == 0)
-      continue;
-
-    /* the results for the last check of this service are stale! */
-    if (!it->second->is_result_fresh(current_time, true)) {
-      /* set the freshen flag */
-      it->second->set_is_being_freshened(true);
-
-      /* schedule an immediate forced check of the service */
-      it->second->schedule_check(
-          current_time,
-          CHECK_OPTION_FORCE_EXECUTION | CHECK_OPTION_FRESHNESS_CHECK);
+  uint64_t version = checkable::freshness_settings_version();
+  if (freshness_deadlines.outdated(version)) {
+    /* check all services... */
+    freshness_deadlines.clear();
+    for (service_map::iterator it(service::services.begin()),
+         end(service::services.end());
+         it != end; ++it)
+      it->second->_check_result_freshness(current_time);
+    freshness_deadlines.set_version(version);
+  } else {
+    /* ...or only those whose results may be stale */
+    std::vector<std::pair<uint64_t, uint64_t>> due;
+    freshness_deadlines.pop_due(current_time, &due);
+    for (auto& id : due) {
+      auto found = service::services_by_id.find(id);
+      if (found != service::services_by_id.end())
+        found->second->_check_result_freshness(current_time);
     }
   }
 }
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/engine/deadline_index.hh"
+#include <gtest/gtest.h>
+
+using namespace com::centreon::engine;
+
+// Given a deadline_index with three objects
+// When due objects are popped
+// Then only those whose deadline is reached are returned, by deadline.
+TEST(DeadlineIndex, PopDue) {
+  deadline_index<uint64_t> idx;
+  idx.schedule(1, 300);
+  idx.schedule(2, 100);
+  idx.schedule(3, 200);
+  ASSERT_EQ(idx.size(), 3u);
+
+  std::vector<uint64_t> due;
+  idx.pop_due(50, &due);
+  ASSERT_TRUE(due.empty());
+
+  idx.pop_due(200, &due);
+  ASSERT_EQ(due, (std::vector<uint64_t>{2, 3}));
+  ASSERT_EQ(idx.size(), 1u);
+
+  due.clear();
+  idx.pop_due(1000, &due);
+  ASSERT_EQ(due, (std::vector<uint64_t>{1}));
+  ASSERT_EQ(idx.size(), 0u);
+}
+
+// Given a deadline_index
+// When deadlines are moved or removed
+// Then old deadlines are ignored.
+TEST(DeadlineIndex, RescheduleAndRemove) {
+  deadline_index<std::pair<uint64_t, uint64_t>> idx;
+  idx.schedule({1, 1}, 100);
+  idx.schedule({1, 1}, 500);
+  idx.schedule({1, 2}, 500);
+  idx.schedule({1, 2}, 150);
+  idx.schedule({1, 3}, 120);
+  idx.remove({1, 3});
+
+  std::vector<std::pair<uint64_t, uint64_t>> due;
+  idx.pop_due(200, &due);
+  ASSERT_EQ(due.size(), 1u);
+  ASSERT_EQ(due[0], std::make_pair(uint64_t(1), uint64_t(2)));
+
+  due.clear();
+  idx.pop_due(500, &due);
+  ASSERT_EQ(due.size(), 1u);
+  ASSERT_EQ(due[0], std::make_pair(uint64_t(1), uint64_t(1)));
+  ASSERT_EQ(idx.heap_size(), 0u);
+}
+
+// Given a deadline_index whose objects are rescheduled many times
+// Then its heap does not grow indefinitely.
+TEST(DeadlineIndex, Compaction) {
+  deadline_index<uint64_t> idx;
+  for (time_t t = 0; t < 100000; ++t)
+    idx.schedule(t % 10, t);
+  ASSERT_EQ(idx.size(), 10u);
+  ASSERT_LT(idx.heap_size(), 2000u);
+
+  std::vector<uint64_t> due;
+  idx.pop_due(100000, &due);
+  ASSERT_EQ(due.size(), 10u);
+}
+
+// Given a deadline_index
+// Then it is outdated until it is built for the current version.
+TEST(DeadlineIndex, Version) {
+  deadline_index<uint64_t> idx;
+  ASSERT_TRUE(idx.outdated(0));
+  idx.set_version(0);
+  ASSERT_FALSE(idx.outdated(0));
+  ASSERT_TRUE(idx.outdated(1));
+}
@@ -34,9 +34,18 @@
 #include "com/centreon/engine/configuration/applier/serviceescalation.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/configuration/applier/timeperiod.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/broker.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/macros/misc.hh"
+#include "com/centreon/engine/nebstructs.hh"
+#include "com/centreon/engine/sehandlers.hh"
 #include "com/centreon/engine/serviceescalation.hh"
 #include "com/centreon/engine/timezone_manager.hh"
+#include "common/engine_conf/command_helper.hh"
 #include "common/engine_conf/message_helper.hh"
+#include "com/centreon/logging/backend.hh"
+#include "com/centreon/logging/engine.hh"
 #include "helper.hh"
 
 using namespace com::centreon;
@@ -596,3 +605,81 @@ TEST_F(PbServiceCheck, CheckUpdateMultilineOutput) {
   ASSERT_EQ(_svc->get_long_plugin_output(), "line2\\nline3\\nline4\\nline5");
   ASSERT_EQ(_svc->get_perf_data(), "res;2;5;5");
 }
+
+// Given a service whose results are checked for freshness
+// When its freshness deadline is reached while its check is running
+// Then it stays in the freshness index
+// And its results are found stale once the check is no more running.
+TEST_F(PbServiceCheck, FreshnessOfExecutingServiceIsCheckedAgain) {
+  pb_config.set_check_service_freshness(true);
+  set_time(50000);
+  _svc->set_check_freshness(true);
+  _svc->set_freshness_threshold(60);
+  _svc->set_has_been_checked(true);
+  _svc->set_last_check(50000);
+  _svc->set_is_being_freshened(false);
+  checkable::freshness_settings_changed();
+
+  /* The index is built, the results are fresh until 50060. */
+  engine::service::check_result_freshness();
+  ASSERT_EQ(engine::service::freshness_deadlines.size(), 1u);
+
+  _svc->set_is_executing(true);
+  set_time(50100);
+  engine::service::check_result_freshness();
+  ASSERT_EQ(engine::service::freshness_deadlines.size(), 1u);
+  ASSERT_FALSE(_svc->get_is_being_freshened());
+
+  _svc->set_is_executing(false);
+  set_time(50200);
+  engine::service::check_result_freshness();
+  ASSERT_TRUE(_svc->get_is_being_freshened());
+}
+
+/* Keeps the output of the log records attached to the logged messages. */
+class record_output_catcher : public com::centreon::logging::backend {
+ public:
+  std::vector<std::string> outputs;
+
+  void close() noexcept override {}
+  void log(uint64_t types [[maybe_unused]],
+           uint32_t verbose [[maybe_unused]],
+           char const* msg [[maybe_unused]],
+           uint32_t size [[maybe_unused]]) noexcept override {
+    const nebstruct_log_record* record =
+        engine::logging::log_record_scope::current();
+    if (record && record->output)
+      outputs.emplace_back(record->output);
+  }
+  void open() override {}
+  void reopen() override {}
+};
+
+// Given a service event handler whose command line contains a $USERn$ macro
+// When the event handler is run
+// Then the log record output is the handler as written in the log line
+// And it does not contain the expanded command line.
+TEST_F(PbServiceCheck, EventHandlerLogRecordOutput) {
+  configuration::Command cmd;
+  configuration::command_helper cmd_hlp(&cmd);
+  cmd.set_command_name("event_cmd");
+  cmd.set_command_line("/bin/true $USER1$ $ARG1$");
+  configuration::applier::command cmd_aply;
+  cmd_aply.add_object(cmd);
+  macro_user[0] = "secret_password";
+
+  _svc->set_event_handler("event_cmd!arg1");
+  _svc->set_event_handler_ptr(commands::command::commands["event_cmd"].get());
+  pb_config.set_log_event_handlers(true);
+
+  record_output_catcher catcher;
+  com::centreon::logging::engine::instance().add(
+      &catcher, engine::logging::log_event_handler, engine::logging::basic);
+  run_service_event_handler(get_global_macros(), _svc.get());
+  com::centreon::logging::engine::instance().remove(&catcher);
+  macro_user[0].clear();
+
+  ASSERT_EQ(catcher.outputs.size(), 1u);
+  ASSERT_EQ(catcher.outputs[0], "event_cmd!arg1");
+  ASSERT_EQ(catcher.outputs[0].find("secret_password"), std::string::npos);
+}
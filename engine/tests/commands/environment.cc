@@ -102,3 +102,27 @@ TEST(env_utils, add_name_value_string) {
   ASSERT_EQ("toto=", v[1]);
   ASSERT_TRUE(v.size() == 2);
 }
+
+TEST(env_utils, clear_and_reuse) {
+  environment env;
+  for (int i = 0; i < 1000; i++)
+    env.add(fmt::format("foo{}", i));
+  env.clear();
+  ASSERT_NE(env.data(), nullptr);
+  ASSERT_EQ(env.data()[0], nullptr);
+  env.add("bar");
+  auto v = to_vector(env.data());
+  ASSERT_EQ("bar", v[0]);
+  ASSERT_TRUE(v.size() == 1);
+}
+
+// Given a new environment
+// Then it is not set and the process inherits the engine environment
+// And once cleared, it is an empty array: nothing is inherited.
+TEST(env_utils, empty_but_set) {
+  environment env;
+  ASSERT_EQ(env.data(), nullptr);
+  env.clear();
+  ASSERT_NE(env.data(), nullptr);
+  ASSERT_TRUE(to_vector(env.data()).empty());
+}
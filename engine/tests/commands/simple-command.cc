@@ -256,3 +256,18 @@ TEST_F(SimpleCommand, WithOneArgument) {
   ASSERT_TRUE(timeout < max_timeout);
   ASSERT_EQ(lstnr->get_result().output, "Hello\n");
 }
+
+// Given a raw command restricted to one environment macro
+// When it is executed with environment macros enabled
+// Then only this macro is in the environment of the process.
+TEST_F(SimpleCommand, FilteredEnvironmentMacros) {
+  config->enable_environment_macros(true);
+  auto cmd = std::make_unique<commands::raw>("test", "/usr/bin/env");
+  cmd->set_environment_macros("NAGIOS_ARG2");
+  nagios_macros* mac(get_global_macros());
+  mac->argv[0] = "Hello";
+  mac->argv[1] = "World";
+  commands::result res;
+  cmd->run(cmd->process_cmd(mac), *mac, 2, res);
+  ASSERT_EQ(res.output, "NAGIOS_ARG2=World\n");
+}
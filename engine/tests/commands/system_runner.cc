@@ -0,0 +1,131 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "com/centreon/engine/command_manager.hh"
+#include "com/centreon/engine/commands/system_runner.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros.hh"
+#include "helper.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::commands;
+
+class SystemRunner : public ::testing::Test {
+ public:
+  void SetUp() override { init_config_state(); }
+
+  void TearDown() override { deinit_config_state(); }
+
+  static void set_max_concurrent(uint32_t max) {
+#ifdef LEGACY_CONF
+    config->max_concurrent_system_commands(max);
+#else
+    pb_config.set_max_concurrent_system_commands(max);
+#endif
+  }
+
+  /* Execute main loop tasks until pred is true or 10s have elapsed. */
+  template <typename pred_type>
+  static bool wait_for(pred_type pred) {
+    for (int i = 0; i < 1000 && !pred(); ++i) {
+      command_manager::instance().execute();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return pred();
+  }
+};
+
+// Given a system runner with commands executed synchronously
+// When a command is run
+// Then its handler is called before run() returns.
+TEST_F(SystemRunner, Synchronous) {
+  set_max_concurrent(0);
+  std::string output;
+  int result = -1;
+  system_runner::instance().run(
+      get_global_macros(), "/bin/echo sync", 5,
+      [&](int res, bool early_timeout, double, const std::string& out) {
+        result = res;
+        ASSERT_FALSE(early_timeout);
+        output = out;
+      });
+  ASSERT_EQ(result, 0);
+  ASSERT_EQ(output, "sync\n");
+  ASSERT_EQ(system_runner::instance().running_count(), 0u);
+}
+
+// Given a system runner with asynchronous commands
+// When a command is run
+// Then its handler is called later from the main loop with the command output.
+TEST_F(SystemRunner, Asynchronous) {
+  set_max_concurrent(10);
+  std::string output;
+  bool called = false;
+  system_runner::instance().run(
+      get_global_macros(), "/bin/echo async", 5,
+      [&](int res, bool early_timeout, double, const std::string& out) {
+        called = true;
+        ASSERT_EQ(res, 0);
+        ASSERT_FALSE(early_timeout);
+        output = out;
+      });
+  ASSERT_TRUE(wait_for([&] { return called; }));
+  ASSERT_EQ(output, "async\n");
+  ASSERT_EQ(system_runner::instance().running_count(), 0u);
+}
+
+// Given a system runner limited to one running command
+// When three commands are run
+// Then two of them wait and all handlers are eventually called.
+TEST_F(SystemRunner, ConcurrencyLimit) {
+  set_max_concurrent(1);
+  std::vector<std::string> outputs;
+  for (int i = 0; i < 3; ++i)
+    system_runner::instance().run(
+        get_global_macros(), fmt::format("/bin/echo {}", i), 5,
+        [&](int, bool, double, const std::string& out) {
+          ASSERT_LE(system_runner::instance().running_count(), 1u);
+          outputs.push_back(out);
+        });
+  ASSERT_EQ(system_runner::instance().running_count(), 1u);
+  ASSERT_EQ(system_runner::instance().waiting_count(), 2u);
+  ASSERT_TRUE(wait_for([&] { return outputs.size() == 3; }));
+  ASSERT_EQ(outputs, std::vector<std::string>({"0\n", "1\n", "2\n"}));
+  ASSERT_EQ(system_runner::instance().waiting_count(), 0u);
+}
+
+// Given a system runner
+// When a command runs longer than its timeout
+// Then its handler is called with early_timeout set.
+TEST_F(SystemRunner, Timeout) {
+  set_max_concurrent(10);
+  bool called = false;
+  bool timed_out = false;
+  system_runner::instance().run(
+      get_global_macros(), "/bin/sleep 5", 1,
+      [&](int, bool early_timeout, double, const std::string&) {
+        called = true;
+        timed_out = early_timeout;
+      });
+  ASSERT_TRUE(wait_for([&] { return called; }));
+  ASSERT_TRUE(timed_out);
+}
@@ -61,7 +61,17 @@ class ApplierState : public ::testing::Test {
     }
   }
 
-  void TearDown() override { deinit_config_state(); }
+  void TearDown() override {
+    if (!_cache_file.empty()) {
+      std::remove(_cache_file.c_str());
+      std::remove((_cache_file + ".tmp").c_str());
+    }
+    deinit_config_state();
+  }
+
+ protected:
+  /* Configuration cache file of the test, removed by TearDown(). */
+  std::string _cache_file;
 };
 
 using MessageDifferencer = ::google::protobuf::util::MessageDifferencer;
@@ -999,3 +1009,63 @@ TEST_F(ApplierState, StateParsingContactgroupWithoutName) {
   configuration::error_cnt err;
   ASSERT_THROW(p.parse("/tmp/centengine.cfg", &cfg, err), std::exception);
 }
+
+// Given a configuration with a config_cache_file
+// When it is parsed twice
+// Then the second parsing loads the State from the cache
+// And the cache is no more used once an object file changed.
+TEST_F(ApplierState, StateParsingWithCache) {
+  CreateConf(1);
+  const char* test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  _cache_file = (std::filesystem::temp_directory_path() /
+                 fmt::format("centengine-{}-{}.cache", test_name, getpid()))
+                    .string();
+  std::ofstream ofs("/tmp/centengine.cfg", std::ios::app);
+  ofs << "config_cache_file=" << _cache_file << std::endl;
+  ofs.close();
+
+  configuration::error_cnt err;
+  configuration::State cfg;
+  {
+    configuration::parser p;
+    p.parse("/tmp/centengine.cfg", &cfg, err);
+  }
+  ASSERT_TRUE(std::filesystem::exists(_cache_file));
+  /* It contains the resource macros. */
+  ASSERT_EQ(std::filesystem::status(_cache_file).permissions(),
+            std::filesystem::perms::owner_read |
+                std::filesystem::perms::owner_write);
+
+  /* The cache content is altered to check it is really used. */
+  configuration::StateCache cache;
+  {
+    std::ifstream in(_cache_file, std::ios::binary);
+    ASSERT_TRUE(cache.ParseFromIstream(&in));
+  }
+  ASSERT_TRUE(MessageDifferencer::Equals(cache.state(), cfg));
+  cache.mutable_state()->set_poller_name("from-cache");
+  {
+    std::ofstream out(_cache_file, std::ios::trunc | std::ios::binary);
+    ASSERT_TRUE(cache.SerializeToOstream(&out));
+  }
+
+  configuration::State cached_cfg;
+  {
+    configuration::parser p;
+    p.parse("/tmp/centengine.cfg", &cached_cfg, err);
+  }
+  ASSERT_EQ(cached_cfg.poller_name(), "from-cache");
+  ASSERT_EQ(cached_cfg.hosts().size(), cfg.hosts().size());
+
+  ofs.open("/tmp/hosts.cfg", std::ios::app);
+  ofs << "# a new comment" << std::endl;
+  ofs.close();
+  configuration::State new_cfg;
+  {
+    configuration::parser p;
+    p.parse("/tmp/centengine.cfg", &new_cfg, err);
+  }
+  ASSERT_TRUE(MessageDifferencer::Equals(new_cfg, cfg));
+  RmConf();
+}
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/engine/modules/external_commands/command_splitter.hh"
+#include <gtest/gtest.h>
+
+using com::centreon::engine::modules::external_commands::command_splitter;
+
+class CommandSplitter : public ::testing::Test {
+ protected:
+  command_splitter _splitter{64, 32};
+  std::vector<std::string> _commands;
+
+  void write(std::string_view data) {
+    ASSERT_LE(data.size(), _splitter.available());
+    memcpy(_splitter.write_position(), data.data(), data.size());
+    _splitter.commit(data.size(), [this](std::string_view cmd) {
+      _commands.emplace_back(cmd);
+    });
+  }
+
+  void flush() {
+    _splitter.flush(
+        [this](std::string_view cmd) { _commands.emplace_back(cmd); });
+  }
+};
+
+// Given several commands in one read
+// Then they are all split.
+TEST_F(CommandSplitter, SeveralCommands) {
+  write("[1] CMD_A;h\n[2] CMD_B;h;s\n[3] CMD_C\n");
+  ASSERT_EQ(_commands, (std::vector<std::string>{"[1] CMD_A;h", "[2] CMD_B;h;s",
+                                                 "[3] CMD_C"}));
+  ASSERT_EQ(_splitter.pending(), 0u);
+}
+
+// Given a command written in several pieces
+// Then it is split only once complete.
+TEST_F(CommandSplitter, PartialWrites) {
+  write("[1] CMD_A;h\n[2] CM");
+  ASSERT_EQ(_commands, (std::vector<std::string>{"[1] CMD_A;h"}));
+  ASSERT_EQ(_splitter.pending(), 6u);
+  write("D_B;");
+  ASSERT_EQ(_commands.size(), 1u);
+  write("h\n");
+  ASSERT_EQ(_commands,
+            (std::vector<std::string>{"[1] CMD_A;h", "[2] CMD_B;h"}));
+  ASSERT_EQ(_splitter.pending(), 0u);
+}
+
+// Given a command without trailing newline
+// When the splitter is flushed
+// Then it is given alone and not glued to the next command.
+TEST_F(CommandSplitter, Flush) {
+  write("[1] CMD_A;h");
+  ASSERT_TRUE(_commands.empty());
+  flush();
+  write("[2] CMD_B;h\n");
+  ASSERT_EQ(_commands,
+            (std::vector<std::string>{"[1] CMD_A;h", "[2] CMD_B;h"}));
+  flush();
+  ASSERT_EQ(_commands.size(), 2u);
+}
+
+// Given a command longer than the maximum length
+// Then it is cut as fgets() did.
+TEST_F(CommandSplitter, TooLong) {
+  write(std::string(40, 'x') + "\n");
+  ASSERT_EQ(_commands, (std::vector<std::string>{std::string(30, 'x'),
+                                                 std::string(10, 'x')}));
+}
+
+// Given many commands going through a small buffer
+// Then the incomplete ones are moved and none is lost.
+TEST_F(CommandSplitter, Compaction) {
+  std::string expected_last;
+  for (int i = 0; i < 100; ++i) {
+    std::string cmd = fmt::format("[{}] CMD;{}\n", i, i * 7);
+    /* two writes per command to keep a fragment in the buffer */
+    write(std::string_view(cmd).substr(0, 4));
+    write(std::string_view(cmd).substr(4));
+  }
+  ASSERT_EQ(_commands.size(), 100u);
+  ASSERT_EQ(_commands[99], "[99] CMD;693");
+}
@@ -20,6 +20,7 @@
 #include "helper.hh"
 
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/commands/system_runner.hh"
 #include "com/centreon/engine/configuration/applier/logging.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/globals.hh"
@@ -55,6 +56,7 @@ void init_config_state() {
   configuration::applier::logging::instance().apply(*config);
 
   checks::checker::init(true);
+  commands::system_runner::init();
 }
 #else
 void init_config_state() {
@@ -76,6 +78,7 @@ void init_config_state() {
   configuration::applier::logging::instance().apply(pb_config);
 
   checks::checker::init(true);
+  commands::system_runner::init();
 }
 #endif
 
@@ -88,5 +91,6 @@ void deinit_config_state(void) {
 #endif
 
   configuration::applier::state::instance().clear();
+  commands::system_runner::deinit();
   checks::checker::deinit();
 }
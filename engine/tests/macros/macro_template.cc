@@ -0,0 +1,80 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "../helper.hh"
+#include "../test_engine.hh"
+#include "com/centreon/engine/commands/raw.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/macros/process.hh"
+#include "com/centreon/engine/macros/template.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+class MacroTemplate : public TestEngine {
+ public:
+  void SetUp() override {
+    init_config_state();
+    init_macros();
+  }
+
+  void TearDown() override { deinit_config_state(); }
+};
+
+// Given command lines with arguments, user macros, escaped and invalid macros
+// When they are expanded through a macro_template
+// Then the result is the same as the one of process_macros_r().
+TEST_F(MacroTemplate, SameAsProcessMacros) {
+  nagios_macros* mac(get_global_macros());
+  mac->argv[0] = "arg1 value";
+  mac->argv[1] = "a`rg2|";
+  macro_user[0] = "/usr/lib/nagios/plugins";
+
+  for (const char* line :
+       {"$USER1$/check_ping -H $ARG1$ -w $ARG2$", "echo $$HOME $",
+        "unterminated $ARG1", "$ARG0$$ARG33$$ARGx$$USER0$$ARG1:foo$",
+        "$UNKNOWN_MACRO$ $_HOSTFOO$ $$$ARG1$$$", "no macro", "$"}) {
+    for (int options : {0, STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS}) {
+      std::string expected;
+      process_macros_r(mac, line, expected, options);
+      std::string out;
+      macros::macro_template tpl(line);
+      tpl.expand(mac, out, options);
+      ASSERT_EQ(out, expected) << "command line: " << line;
+    }
+  }
+}
+
+// Given a command
+// When its command line changes
+// Then its macro template is rebuilt.
+TEST_F(MacroTemplate, RebuiltOnNewCommandLine) {
+  nagios_macros* mac(get_global_macros());
+  mac->argv[0] = "foo";
+  commands::raw cmd("cmd", "echo $ARG1$");
+  macros::macro_template::pointer tpl = cmd.get_macro_template();
+  ASSERT_EQ(tpl, cmd.get_macro_template());
+  ASSERT_EQ(cmd.process_cmd(mac), "echo foo");
+
+  cmd.set_command_line("echo $ARG1$ $ARG1$");
+  ASSERT_NE(tpl, cmd.get_macro_template());
+  ASSERT_EQ(cmd.process_cmd(mac), "echo foo foo");
+}